@@ -0,0 +1,117 @@
+% benchmark_engine_model.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script measures the call rate of the MEX engine model. Each
+% converged operating point stored in outputs.mat (written by
+% solve_at_points.m) is evaluated repeatedly and the number of model calls
+% per second is reported. Run it before and after changes to the engine
+% model to compare throughput.
+
+clear; clc;
+
+%% Definition of constants
+NUM_CALLS_PER_POINT = 20000; % number of model calls timed at each operating point
+ENABLE_DEBUG = false; % warnings are disabled so that printing is not timed
+
+%% Setup
+addpath('engine_model');
+load('outputs.mat', 'outputs');
+
+bleeds = [0; 0.02; 0.0693; 0.0625]; % same HPC bleeds as solve_at_points.m
+targets = [NaN; NaN; NaN];
+
+num_points = numel(outputs);
+calls_per_sec = NaN(num_points, 1);
+
+%% Time the model at each operating point
+for point = 1:num_points
+    environmental_conditions = [outputs(point).altitude; outputs(point).mach_number; outputs(point).dTamb];
+    cmd = outputs(point).solver_independents_solution(:);
+    health_params = outputs(point).health_params(:);
+
+    % Warm-up call, so one-time model construction is not timed
+    [DEP,X,U,Y,E] = MEX_engine_model(environmental_conditions, cmd, targets, health_params, bleeds, ENABLE_DEBUG);
+
+    tic;
+    for call = 1:NUM_CALLS_PER_POINT
+        [DEP,X,U,Y,E] = MEX_engine_model(environmental_conditions, cmd, targets, health_params, bleeds, ENABLE_DEBUG);
+    end
+    calls_per_sec(point) = NUM_CALLS_PER_POINT / toc;
+
+    fprintf('Point %d: %8.0f calls/sec (%6.2f us/call)\n', point, calls_per_sec(point), 1e6/calls_per_sec(point));
+end
+
+fprintf('Mean: %8.0f calls/sec\n', mean(calls_per_sec));
+
+%% Time batched evaluation of all operating points in one call
+environmental_conditions = [[outputs.altitude]; [outputs.mach_number]; [outputs.dTamb]];
+cmd = reshape([outputs.solver_independents_solution], 14, num_points);
+health_params = reshape([outputs.health_params], 13, num_points);
+num_batches = NUM_CALLS_PER_POINT;
+
+% Scalar component bodies and lane kernels (SETTINGS_IN(3)), single-threaded
+% and then using every core (SETTINGS_IN(2) = 0)
+kernel_names = {'scalar', 'lanes'};
+Y_kernel = cell(1, 2);
+for use_lanes = [0 1]
+    for num_threads = [1 0]
+        tic;
+        for batch = 1:num_batches
+            [DEP,X,U,Y,E] = MEX_engine_model(environmental_conditions, cmd, targets, health_params, bleeds, [ENABLE_DEBUG num_threads use_lanes]);
+        end
+        points_per_sec = num_batches * num_points / toc;
+
+        fprintf('Batched %s (%d points per call, threads = %d): %8.0f points/sec (%6.2f us/point)\n', ...
+            kernel_names{use_lanes+1}, num_points, num_threads, points_per_sec, 1e6/points_per_sec);
+    end
+    Y_kernel{use_lanes+1} = [DEP; X; U; Y; E];
+end
+
+% The lane kernels perform the same operations as the scalar bodies
+fprintf('Max relative difference lanes vs scalar: %g\n', ...
+    max(max(abs(Y_kernel{2} - Y_kernel{1}) ./ max(abs(Y_kernel{1}), eps))));
+
+%% Time the evaluation levels (SETTINGS_IN(4)) with the lane kernels, single-threaded
+% Residuals only (0) skip the HPC exit static pressure and the fan and HPC
+% stall margins, map diagnostics (1) the static pressure alone. DEP, X, U
+% and E are the same at every level.
+level_names = {'residuals', 'diagnostics', 'full'};
+sec_per_level = NaN(1, 3);
+DEP_level = cell(1, 3);
+for eval_level = [2 1 0]
+    tic;
+    for batch = 1:num_batches
+        [DEP,X,U,Y,E] = MEX_engine_model(environmental_conditions, cmd, targets, health_params, bleeds, [ENABLE_DEBUG 1 1 eval_level]);
+    end
+    sec_per_level(eval_level+1) = toc;
+    DEP_level{eval_level+1} = [DEP; X; U; E];
+
+    fprintf('Evaluation level %d (%s): %6.2f us/point, %.2fx the full outputs\n', eval_level, ...
+        level_names{eval_level+1}, 1e6*sec_per_level(eval_level+1) / (num_batches * num_points), ...
+        sec_per_level(3) / sec_per_level(eval_level+1));
+end
+fprintf('Dependents identical at every level: %d\n', isequal(DEP_level{:}));
+
+%% Time a trim with nr_solver.m and with MEX_nr_solver
+% Each solve starts from the stored solution with the solver independents
+% offset by 1%.
+Ivec = logical([1 1 1 1 1 1 1 1 0 0 0 1 0 0]'); % same selections as solve_at_points.m
+Dvec = logical([1 1 1 1 1 1 1 1 1 0 0 0]');
+solvers = {@nr_solver, @MEX_nr_solver};
+solver_names = {'nr_solver', 'MEX_nr_solver'};
+sec_per_trim = NaN(1, 2);
+iterations = NaN(num_points, 2);
+for s = 1:2
+    tic;
+    for point = 1:num_points
+        environmental_conditions = [outputs(point).altitude; outputs(point).mach_number; outputs(point).dTamb];
+        guess = outputs(point).solver_independents_solution(:);
+        guess(Ivec) = guess(Ivec) * 1.01;
+        [~,~,~,~,~,~,~,iterations(point, s)] = solvers{s}(environmental_conditions, guess, targets, ...
+            outputs(point).health_params(:), bleeds, Ivec, Dvec, ENABLE_DEBUG);
+    end
+    sec_per_trim(s) = toc / num_points;
+    fprintf('%s: %8.4f s/trim\n', solver_names{s}, sec_per_trim(s));
+end
+fprintf('Speedup %.1fx, iteration counts identical at %d of %d points\n', ...
+    sec_per_trim(1) / sec_per_trim(2), sum(iterations(:,1) == iterations(:,2)), num_points);
@@ -0,0 +1,89 @@
+% benchmark_engine_session.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script compares repeated single-point calls to MEX_engine_model,
+% which creates the five output arrays DEP, X, U, Y and E on every call,
+% with calls to a MEX_engine_session session, which evaluates into output
+% buffers it keeps between calls. The session is called with no outputs
+% (the results stay in the session) and with DEP alone, as a solver
+% needs. Reported are the time per call and the allocations made by the
+% MEX functions over NUM_CALLS calls at the first converged operating
+% point stored in outputs.mat (written by solve_at_points.m). A last
+% section times a session that collects the component error flags
+% (SETTINGS_IN(5) = 1) instead of printing them, and shows them.
+
+clear; clc;
+
+%% Definition of constants
+NUM_CALLS = 1e6; % number of model calls timed per variant
+ENABLE_DEBUG = false; % warnings are disabled so that printing is not timed
+
+%% Setup
+addpath('engine_model');
+load('outputs.mat', 'outputs');
+
+bleeds = [0; 0.02; 0.0693; 0.0625]; % same HPC bleeds as solve_at_points.m
+targets = [NaN; NaN; NaN];
+
+environmental_conditions = [outputs(1).altitude; outputs(1).mach_number; outputs(1).dTamb];
+cmd = outputs(1).solver_independents_solution(:);
+health_params = outputs(1).health_params(:);
+
+%% MEX_engine_model: five output arrays per call
+[DEP_model,~,~,Y_model] = MEX_engine_model(environmental_conditions, cmd, targets, health_params, bleeds, ENABLE_DEBUG);
+tic;
+for call = 1:NUM_CALLS
+    [DEP,X,U,Y,E] = MEX_engine_model(environmental_conditions, cmd, targets, health_params, bleeds, ENABLE_DEBUG);
+end
+sec_model = toc;
+fprintf('MEX_engine_model:             %6.2f us/call, %d allocations per call (DEP, X, U, Y, E)\n', ...
+    1e6 * sec_model / NUM_CALLS, 5);
+
+%% Session, outputs kept in the session
+h = MEX_engine_session('open', 1, [ENABLE_DEBUG 1]);
+MEX_engine_session('eval', h, environmental_conditions, cmd, targets, health_params, bleeds);
+stats0 = MEX_engine_session('stats', h);
+tic;
+for call = 1:NUM_CALLS
+    MEX_engine_session('eval', h, environmental_conditions, cmd, targets, health_params, bleeds);
+end
+sec_session = toc;
+stats1 = MEX_engine_session('stats', h);
+fprintf('Session, no outputs:          %6.2f us/call, %d allocations in %d calls\n', ...
+    1e6 * sec_session / NUM_CALLS, stats1(3) - stats0(3), NUM_CALLS);
+
+%% Session, DEP returned
+tic;
+for call = 1:NUM_CALLS
+    DEP = MEX_engine_session('eval', h, environmental_conditions, cmd, targets, health_params, bleeds);
+end
+sec_session_dep = toc;
+stats2 = MEX_engine_session('stats', h);
+fprintf('Session, DEP returned:        %6.2f us/call, %d allocations in %d calls\n', ...
+    1e6 * sec_session_dep / NUM_CALLS, stats2(3) - stats1(3), NUM_CALLS);
+
+% The session evaluates the same model
+[DEP_session,~,~,Y_session] = MEX_engine_session('get', h);
+MEX_engine_session('close', h);
+fprintf('Outputs identical to MEX_engine_model: %d\n', isequaln(DEP_session, DEP_model) && isequaln(Y_session, Y_model));
+fprintf('Speedup %.2fx without outputs, %.2fx with DEP\n', sec_model / sec_session, sec_model / sec_session_dep);
+
+%% Session with diagnostics: error flags collected instead of printed
+h = MEX_engine_session('open', 1, [ENABLE_DEBUG 1 1 2 1]);
+tic;
+for call = 1:NUM_CALLS
+    MEX_engine_session('eval', h, environmental_conditions, cmd, targets, health_params, bleeds);
+end
+sec_session_diag = toc;
+fprintf('Session with diagnostics:     %6.2f us/call\n', 1e6 * sec_session_diag / NUM_CALLS);
+
+% A command far outside the maps raises flags
+MEX_engine_session('eval', h, environmental_conditions, 1.5 * cmd, targets, health_params, bleeds);
+[~, events, counts, lost] = MEX_engine_session('diag', h);
+component_names = {'ambient', 'inlet', 'fan', 'LPC', 'VBV', 'bypass nozzle', 'HPC', 'HPC static', 'HPT', ...
+    'LPT', 'core nozzle'};
+for k = 1:size(events, 2)
+    fprintf('  point %d: %s IWork(%d) = %d\n', events(1,k), component_names{events(2,k)}, events(3,k), events(4,k));
+end
+fprintf('  %d flags raised since open, %d events lost\n', sum(counts(:)), lost);
+MEX_engine_session('close', h);
@@ -0,0 +1,31 @@
+% benchmark_gas_properties.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script times the gas property routines t2hc, h2tc, pt2sc, sp2tc and
+% PcalcStat against their GasMix versions (engine_model/properties_TMATS.c),
+% which take the gas composition precomputed for a fuel-air ratio. It also
+% counts the results that are not bit for bit identical and gives the
+% largest difference. h2tc and sp2tc are secant iterations. Built with
+% -DTMATS_PROPERTIES_CONVERGED, their GasMix versions use inverse tables
+% and one Newton step instead, so they differ by the iteration error of
+% the originals (degR); in the default build they iterate the same way.
+% Building the MEX files with -DTMATS_PROPERTIES_REFERENCE selects the
+% original routines (reference mode), in which no result differs.
+
+clear; clc;
+
+%% Definition of constants
+NUM_REPEATS = 500; % passes over the grid of test points
+
+%% Setup
+addpath('engine_model');
+
+%% Time the routines
+results = MEX_gas_properties_benchmark(NUM_REPEATS);
+
+routine_names = {'t2hc', 'h2tc', 'pt2sc', 'sp2tc', 'PcalcStat'};
+fprintf('%-10s %14s %14s %8s %12s %12s\n', 'routine', 'original', 'GasMix', 'speedup', 'differences', 'max diff');
+for r = 1:numel(routine_names)
+    fprintf('%-10s %8.2f M/s %8.2f M/s %7.2fx %12d %12.3g\n', routine_names{r}, 1e3 / results(r,1), ...
+        1e3 / results(r,2), results(r,1) / results(r,2), results(r,3), results(r,4));
+end
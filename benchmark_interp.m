@@ -0,0 +1,56 @@
+% benchmark_interp.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script times the interpolation kernels that AGTF30_model_init
+% chooses for every table of the model (engine_model/interpAt_TMATS.c)
+% against the generic routines interp1Ac, interp2Ac and interp3Ac, on
+% sweeps over each table that run 5% past its bounds. It lists the kernel
+% of each table (constant, or the cell search of each axis), the lookup
+% times and the lookups whose value or interpErr differ; there should be
+% none. Building the MEX files with -DTMATS_PROPERTIES_REFERENCE leaves
+% the model without kernels, so both columns time the generic routines.
+% It then times the Wc, PR and Eff maps of each compressor (Wc and Eff of
+% each turbine) read one by one with the kernels against the same maps
+% read together with interp2Am (one cell search for all of them).
+
+clear; clc;
+
+%% Definition of constants
+NUM_REPEATS = 1000; % passes over the sweep of each table
+
+table_names = {'ambient Ts', 'ambient Ps', 'ambient Rt', 'ambient gamma', 'inlet eRam', ...
+    'fan Wc', 'fan PR', 'fan Eff', 'fan PR surge', 'lpc Wc', 'lpc PR', 'lpc Eff', 'lpc PR surge', ...
+    'vbv Wc', 'NozByp Rt', 'NozByp gamma', 'NozByp CdTh', 'NozByp Cv', 'NozByp Cfg', 'NozByp TG', ...
+    'hpc Wc', 'hpc PR', 'hpc Eff', 'hpc PR surge', 'hpcstatic Rt', 'hpcstatic gamma', ...
+    'hpt Wc', 'hpt Eff', 'lpt Wc', 'lpt Eff', 'NozCor Rt', 'NozCor gamma', 'NozCor CdTh', ...
+    'NozCor Cv', 'NozCor Cfg', 'NozCor TG'};
+search_names = {'scan', 'uniform', 'binary', 'cursor'}; % INTERP_SCAN, ... + 1
+map_names = {'fan', 'lpc', 'hpc', 'hpt', 'lpt'};
+
+%% Setup
+addpath('engine_model');
+
+%% Time the lookups
+[results, maps] = MEX_interp_benchmark(NUM_REPEATS);
+
+fprintf('%-16s %-26s %12s %12s %8s %12s\n', 'table', 'kernel', 'interp*Ac', 'interp*At', 'speedup', 'differences');
+for t = 1:numel(table_names)
+    if results(t,1)
+        kernel = 'constant';
+    elseif results(t,2) < 0
+        kernel = 'generic';
+    else
+        kinds = results(t,2:4);
+        kernel = strjoin(search_names(kinds(kinds >= 0) + 1), ' x ');
+    end
+    fprintf('%-16s %-26s %9.2f ns %9.2f ns %7.2fx %12d\n', table_names{t}, kernel, results(t,5), ...
+        results(t,6), results(t,5) / results(t,6), results(t,7));
+end
+fprintf('%-16s %-26s %9.2f ns %9.2f ns %7.2fx %12d\n', 'all tables', '', sum(results(:,5)), ...
+    sum(results(:,6)), sum(results(:,5)) / sum(results(:,6)), sum(results(:,7)));
+
+fprintf('\n%-16s %-26s %12s %12s %8s %12s\n', 'map', 'tables', 'one by one', 'together', 'speedup', 'differences');
+for t = 1:numel(map_names)
+    fprintf('%-16s %-26d %9.2f ns %9.2f ns %7.2fx %12d\n', map_names{t}, maps(t,1), maps(t,2), maps(t,3), ...
+        maps(t,2) / maps(t,3), maps(t,4));
+end
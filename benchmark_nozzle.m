@@ -0,0 +1,64 @@
+% benchmark_nozzle.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script counts the work of the nozzle throat searches
+% (engine_model/Nozzle_TMATS_body.c) while MEX_nr_solver trims the cases
+% in inputs.csv, starting from the same initial guesses as
+% solve_at_points.m, with each Jacobian method. For the bypass and core
+% nozzles it reports the runs per trim, the share of runs whose MN = 1
+% search started from the throat of an earlier run (the cached base point
+% of the solver), and the MN = 1 search iterations per run. Iterations
+% are static evaluations after the first; 0 means the starting pressure
+% was already at MN = 1 or one Newton step taken to first order got
+% there. The Newton searches are built with -DTMATS_PROPERTIES_CONVERGED;
+% the default MEX files run the original secant searches, for
+% comparison. Sensor biases are not applied.
+
+clear; clc;
+
+%% Definition of constants
+ENABLE_DEBUG = false;
+STANDARD_DAY_TEMPERATURE_R = 518.67;
+GEAR_RATIO = 3.1;
+
+Ivec = logical([1 1 1 1 1 1 1 1 0 0 0 1 0 0]'); % same selections as solve_at_points.m
+Dvec = logical([1 1 1 1 1 1 1 1 1 0 0 0]');
+targets = [NaN; NaN; NaN];
+bleeds = [0; 0.02; 0.0693; 0.0625];
+
+%% Setup
+addpath('engine_model');
+load("AGTF30_simulink_data.mat");
+construct_gridded_interpolants;
+[inputs_array, num_inputs] = load_inputs_from_csv();
+
+%% Trim every case with each Jacobian method
+nozzle_names = {'bypass', 'core'};
+for method = 0:2
+    nozzle_stats = zeros(4, 2);
+    converged = 0;
+    tic;
+    for point = 1:num_inputs
+        inputs = inputs_array(point);
+        environmental_conditions = [inputs.altitude; inputs.mach_number; inputs.dTamb];
+        ambient_conditions = Ambient_C(environmental_conditions);
+
+        guess = get_initial_guess(inputs.altitude, inputs.mach_number, inputs.N1c, inputs.dTamb, IC_interpolants);
+        guess(9) = min(8000, max(0, VAFN_interpolant(inputs.mach_number, inputs.N1c)));
+        guess(10) = min(1, max(0, VBV_interpolant(inputs.mach_number, inputs.N1c)));
+        guess(11) = inputs.N1c * sqrt(ambient_conditions(1)/STANDARD_DAY_TEMPERATURE_R) * GEAR_RATIO;
+
+        [~,~,~,~,~,~,convergence_reached,~,~,stats] = MEX_nr_solver(environmental_conditions, guess, targets, ...
+            inputs.health_params(:), bleeds, Ivec, Dvec, ENABLE_DEBUG, method);
+        converged = converged + convergence_reached;
+        nozzle_stats = nozzle_stats + stats;
+    end
+    sec_per_trim = toc / num_inputs;
+
+    fprintf('method %d: %d of %d converged, %8.4f s/trim\n', method, converged, num_inputs, sec_per_trim);
+    for n = 1:2
+        fprintf('  %-6s nozzle: %7.1f runs/trim, %5.1f%% seeded, %5.3f MN = 1 iterations/run, %5.3f exit iterations/run\n', ...
+            nozzle_names{n}, nozzle_stats(1,n) / num_inputs, 100 * nozzle_stats(2,n) / nozzle_stats(1,n), ...
+            nozzle_stats(3,n) / nozzle_stats(1,n), nozzle_stats(4,n) / nozzle_stats(1,n));
+    end
+end
@@ -0,0 +1,81 @@
+% compare_jacobian_methods.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script compares the Jacobian strategies of MEX_nr_solver by the
+% number of engine model evaluations per converged operating point. Method
+% 0 rebuilds the finite-difference Jacobian every NRASS iterations like
+% nr_solver.m, method 1 uses Broyden updates and rebuilds only when
+% progress stalls, method 2 takes the exact Jacobian from the forward mode
+% derivatives of every model evaluation. All are run on the cases in inputs.csv and on a dense
+% grid over the flight envelope (standard day and dTamb = 20), starting
+% from the same initial guesses as solve_at_points.m. Sensor biases are
+% not applied.
+
+clear; clc;
+
+%% Definition of constants
+ENABLE_DEBUG = false;
+GRID_ALTITUDES = linspace(0, 40000, 17);
+GRID_MACH_NUMBERS = linspace(0, 0.8, 17);
+GRID_N1CS = linspace(1000, 2400, 8);
+GRID_DTAMBS = [0 20];
+
+STANDARD_DAY_TEMPERATURE_R = 518.67;
+GEAR_RATIO = 3.1;
+
+Ivec = logical([1 1 1 1 1 1 1 1 0 0 0 1 0 0]'); % same selections as solve_at_points.m
+Dvec = logical([1 1 1 1 1 1 1 1 1 0 0 0]');
+targets = [NaN; NaN; NaN];
+bleeds = [0; 0.02; 0.0693; 0.0625];
+
+%% Setup
+addpath('engine_model');
+load("AGTF30_simulink_data.mat");
+construct_gridded_interpolants;
+
+% Operating points as rows of [altitude, mach_number, N1c, dTamb]
+[inputs_array, num_inputs] = load_inputs_from_csv();
+csv_points = [[inputs_array.altitude]', [inputs_array.mach_number]', [inputs_array.N1c]', [inputs_array.dTamb]'];
+csv_health = reshape([inputs_array.health_params], 13, num_inputs);
+
+[alt, mach, N1c, dTamb] = ndgrid(GRID_ALTITUDES, GRID_MACH_NUMBERS, GRID_N1CS, GRID_DTAMBS);
+grid_points = [alt(:), mach(:), N1c(:), dTamb(:)];
+inside = false(size(grid_points, 1), 1);
+for point = 1:size(grid_points, 1)
+    inside(point) = in_envelope(grid_points(point,1), grid_points(point,2), grid_points(point,4));
+end
+grid_points = grid_points(inside, :);
+grid_health = zeros(13, size(grid_points, 1));
+
+cases = {csv_points, csv_health, 'inputs.csv'; grid_points, grid_health, 'envelope grid'};
+
+%% Solve every point with each Jacobian method
+for c = 1:size(cases, 1)
+    points = cases{c, 1};
+    num_points = size(points, 1);
+    converged = false(num_points, 3);
+    model_evals = NaN(num_points, 3);
+
+    for point = 1:num_points
+        environmental_conditions = [points(point,1); points(point,2); points(point,4)];
+        ambient_conditions = Ambient_C(environmental_conditions);
+
+        guess = get_initial_guess(points(point,1), points(point,2), points(point,3), points(point,4), IC_interpolants);
+        guess(9) = min(8000, max(0, VAFN_interpolant(points(point,2), points(point,3))));
+        guess(10) = min(1, max(0, VBV_interpolant(points(point,2), points(point,3))));
+        guess(11) = points(point,3) * sqrt(ambient_conditions(1)/STANDARD_DAY_TEMPERATURE_R) * GEAR_RATIO;
+
+        for method = 0:2
+            [~,~,~,~,Y,E,convergence_reached,~,model_evals(point, method+1)] = MEX_nr_solver( ...
+                environmental_conditions, guess, targets, cases{c, 2}(:, point), bleeds, Ivec, Dvec, ...
+                ENABLE_DEBUG, method);
+            converged(point, method+1) = convergence_reached && ~(Y(55) < E(13));
+        end
+    end
+
+    fprintf('%s (%d points)\n', cases{c, 3}, num_points);
+    for method = 0:2
+        fprintf('  method %d: %4d converged, %6.1f model evaluations per converged point\n', method, ...
+            sum(converged(:, method+1)), sum(model_evals(converged(:, method+1), method+1)) / sum(converged(:, method+1)));
+    end
+end
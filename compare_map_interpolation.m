@@ -0,0 +1,94 @@
+% compare_map_interpolation.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script compares the interpolation of the compressor and turbine
+% maps by the convergence of MEX_nr_solver. With the linear maps (0) the
+% dependents have kinks at every map grid line, which the finite-difference
+% Jacobian of nr_solver.m straddles; the C1 monotone cubic (1) and Akima
+% (2) maps have none. Every mode solves the cases in inputs.csv and a
+% dense grid over the flight envelope (standard day and dTamb = 20) from
+% the initial guesses of solve_at_points.m, with the finite-difference
+% Jacobian of nr_solver.m (JACOBIAN_METHOD 0). Reported per mode are the
+% failure rate, the iterations of the parameter set that converged, the
+% trims that needed the second parameter set and the model evaluations.
+% Sensor biases are not applied.
+
+clear; clc;
+
+%% Definition of constants
+ENABLE_DEBUG = false;
+JACOBIAN_METHOD = 0; % finite differences as nr_solver.m
+MAP_INTERP_NAMES = {'linear', 'monotone cubic', 'Akima'};
+GRID_ALTITUDES = linspace(0, 40000, 17);
+GRID_MACH_NUMBERS = linspace(0, 0.8, 17);
+GRID_N1CS = linspace(1000, 2400, 8);
+GRID_DTAMBS = [0 20];
+
+STANDARD_DAY_TEMPERATURE_R = 518.67;
+GEAR_RATIO = 3.1;
+
+Ivec = logical([1 1 1 1 1 1 1 1 0 0 0 1 0 0]'); % same selections as solve_at_points.m
+Dvec = logical([1 1 1 1 1 1 1 1 1 0 0 0]');
+targets = [NaN; NaN; NaN];
+bleeds = [0; 0.02; 0.0693; 0.0625];
+
+%% Setup
+addpath('engine_model');
+load("AGTF30_simulink_data.mat");
+construct_gridded_interpolants;
+
+% Operating points as rows of [altitude, mach_number, N1c, dTamb]
+[inputs_array, num_inputs] = load_inputs_from_csv();
+csv_points = [[inputs_array.altitude]', [inputs_array.mach_number]', [inputs_array.N1c]', [inputs_array.dTamb]'];
+csv_health = reshape([inputs_array.health_params], 13, num_inputs);
+
+[alt, mach, N1c, dTamb] = ndgrid(GRID_ALTITUDES, GRID_MACH_NUMBERS, GRID_N1CS, GRID_DTAMBS);
+grid_points = [alt(:), mach(:), N1c(:), dTamb(:)];
+inside = false(size(grid_points, 1), 1);
+for point = 1:size(grid_points, 1)
+    inside(point) = in_envelope(grid_points(point,1), grid_points(point,2), grid_points(point,4));
+end
+grid_points = grid_points(inside, :);
+grid_health = zeros(13, size(grid_points, 1));
+
+cases = {csv_points, csv_health, 'inputs.csv'; grid_points, grid_health, 'envelope grid'};
+num_modes = numel(MAP_INTERP_NAMES);
+
+%% Solve every point with each map interpolation
+for c = 1:size(cases, 1)
+    points = cases{c, 1};
+    num_points = size(points, 1);
+    converged = false(num_points, num_modes);
+    iterations = NaN(num_points, num_modes);
+    parameter_set = NaN(num_points, num_modes);
+    model_evals = NaN(num_points, num_modes);
+
+    for point = 1:num_points
+        environmental_conditions = [points(point,1); points(point,2); points(point,4)];
+        ambient_conditions = Ambient_C(environmental_conditions);
+
+        guess = get_initial_guess(points(point,1), points(point,2), points(point,3), points(point,4), IC_interpolants);
+        guess(9) = min(8000, max(0, VAFN_interpolant(points(point,2), points(point,3))));
+        guess(10) = min(1, max(0, VBV_interpolant(points(point,2), points(point,3))));
+        guess(11) = points(point,3) * sqrt(ambient_conditions(1)/STANDARD_DAY_TEMPERATURE_R) * GEAR_RATIO;
+
+        for mode = 1:num_modes
+            [~,~,~,~,Y,E,convergence_reached,iterations(point, mode),model_evals(point, mode),~, ...
+                parameter_set(point, mode)] = MEX_nr_solver(environmental_conditions, guess, targets, ...
+                cases{c, 2}(:, point), bleeds, Ivec, Dvec, ENABLE_DEBUG, JACOBIAN_METHOD, mode-1);
+            converged(point, mode) = convergence_reached && ~(Y(55) < E(13));
+        end
+    end
+
+    fprintf('%s (%d points)\n', cases{c, 3}, num_points);
+    for mode = 1:num_modes
+        ok = converged(:, mode);
+        fprintf(['  %-15s %4d converged (%5.1f%% failed), %5.2f iterations and %5.1f model evaluations per ' ...
+            'converged point, second parameter set on %d points (%d converged)\n'], MAP_INTERP_NAMES{mode}, ...
+            sum(ok), 100 * (num_points - sum(ok)) / num_points, mean(iterations(ok, mode)), ...
+            mean(model_evals(ok, mode)), sum(parameter_set(:, mode) > 1), sum(ok & parameter_set(:, mode) > 1));
+    end
+    all_ok = all(converged, 2);
+    fprintf('  points converged in every mode: %d, mean iterations %s\n', sum(all_ok), ...
+        sprintf('%.2f ', mean(iterations(all_ok, :), 1)));
+end
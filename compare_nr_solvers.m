@@ -0,0 +1,88 @@
+% compare_nr_solvers.m
+% NASA Glenn Research Center, Cleveland, OH
+
+% This script checks that MEX_nr_solver returns what nr_solver.m returns.
+% Both solvers are run on the cases in inputs.csv, starting from the same
+% initial guesses as solve_at_points.m (sensor biases are not applied),
+% and from the stored solutions in outputs.mat with the solver
+% independents offset by 3%. For every point the convergence flags and
+% iteration counts of the two solvers must be identical. MEX_nr_solver
+% inverts the Jacobian by LU with partial pivoting instead of inv, so the
+% solutions may differ in the last digits; the largest relative
+% differences are printed and must stay well below the solver tolerance
+% of 1e-5.
+
+clear; clc;
+
+%% Definition of constants
+ENABLE_DEBUG = false;
+OFFSET_FRACTION = 0.03; % offset of the stored solutions used as initial guesses
+
+STANDARD_DAY_TEMPERATURE_R = 518.67;
+GEAR_RATIO = 3.1;
+
+Ivec = logical([1 1 1 1 1 1 1 1 0 0 0 1 0 0]'); % same selections as solve_at_points.m
+Dvec = logical([1 1 1 1 1 1 1 1 1 0 0 0]');
+targets = [NaN; NaN; NaN];
+bleeds = [0; 0.02; 0.0693; 0.0625];
+
+%% Setup
+addpath('engine_model');
+load("AGTF30_simulink_data.mat");
+construct_gridded_interpolants;
+
+[inputs_array, num_inputs] = load_inputs_from_csv();
+load('outputs.mat', 'outputs');
+
+% Initial guesses as columns, with the flight conditions and health parameters they belong to
+environments = NaN(3, 2*num_inputs);
+health = NaN(13, 2*num_inputs);
+guesses = NaN(14, 2*num_inputs);
+for point = 1:num_inputs
+    environmental_conditions = [inputs_array(point).altitude; inputs_array(point).mach_number; inputs_array(point).dTamb];
+    ambient_conditions = Ambient_C(environmental_conditions);
+    N1c = inputs_array(point).N1c;
+
+    guess = get_initial_guess(environmental_conditions(1), environmental_conditions(2), N1c, ...
+        environmental_conditions(3), IC_interpolants);
+    guess(9) = min(8000, max(0, VAFN_interpolant(environmental_conditions(2), N1c)));
+    guess(10) = min(1, max(0, VBV_interpolant(environmental_conditions(2), N1c)));
+    guess(11) = N1c * sqrt(ambient_conditions(1)/STANDARD_DAY_TEMPERATURE_R) * GEAR_RATIO;
+    environments(:, point) = environmental_conditions;
+    health(:, point) = inputs_array(point).health_params(:);
+    guesses(:, point) = guess;
+
+    guess = outputs(point).solver_independents_solution(:);
+    guess(Ivec) = guess(Ivec) * (1 + OFFSET_FRACTION);
+    environments(:, num_inputs + point) = [outputs(point).altitude; outputs(point).mach_number; outputs(point).dTamb];
+    health(:, num_inputs + point) = outputs(point).health_params(:);
+    guesses(:, num_inputs + point) = guess;
+end
+
+%% Solve every point with both solvers
+num_points = size(guesses, 2);
+converged = false(num_points, 2);
+iterations = NaN(num_points, 2);
+solutions = cell(num_points, 2);
+Ys = cell(num_points, 2);
+solvers = {@nr_solver, @MEX_nr_solver};
+for point = 1:num_points
+    for s = 1:2
+        [~, solutions{point, s}, ~, ~, Ys{point, s}, ~, converged(point, s), iterations(point, s)] = ...
+            solvers{s}(environments(:, point), guesses(:, point), targets, health(:, point), bleeds, ...
+            Ivec, Dvec, ENABLE_DEBUG);
+    end
+end
+
+%% Report
+both = find(converged(:,1) & converged(:,2))';
+max_rel_solution = 0;
+max_rel_Y = 0;
+for point = both
+    max_rel_solution = max(max_rel_solution, max(abs(solutions{point,2} - solutions{point,1}) ./ ...
+        max(abs(solutions{point,1}), eps)));
+    max_rel_Y = max(max_rel_Y, max(abs(Ys{point,2} - Ys{point,1}) ./ max(abs(Ys{point,1}), 1)));
+end
+fprintf('%d points: convergence flags identical at %d, iteration counts identical at %d\n', num_points, ...
+    sum(converged(:,1) == converged(:,2)), sum(iterations(:,1) == iterations(:,2)));
+fprintf('Max relative difference MEX_nr_solver vs nr_solver: solution %g, Y %g\n', max_rel_solution, max_rel_Y);
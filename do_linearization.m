@@ -6,11 +6,12 @@
 % This function perturbs each state and input to generate linear 
 % state-space matrices (A, B, C, D). Partial derivative are computed 
 % by taking the average derivatives resulting from perturbations in the 
-% positive and negative direction.
+% positive and negative direction. solver is the steady-state solver to
+% use, either @nr_solver or @MEX_nr_solver.
 
 function [A, B, C, D, failure_mode] = do_linearization(solver_independents_solution_trim, ...
     X_trim, Y_trim, altitude, mach_number, N1c, VAFN_interpolant, VBV_interpolant, ...
-    environmental_conditions, health_params, bleeds, DO_ELECTRIC_MOTORS, ENABLE_DEBUG)
+    environmental_conditions, health_params, bleeds, DO_ELECTRIC_MOTORS, ENABLE_DEBUG, solver)
 
 PERTURBATION_FRACTION = 0.0003;  % 0.0003 = 0.03%
 PWR_TRQ_FORMULA_CONSTANT = 5252.113; % Conversion factor to maintain units of lb-ft on torque perturbations
@@ -70,7 +71,7 @@ solver_initial_guess(10) = VBV_interpolant(mach_number, N1c + N1c_perturbation);
 solver_initial_guess(11) = X_trim(1) + N2_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -103,7 +104,7 @@ solver_initial_guess(10) = VBV_interpolant(mach_number, N1c - N1c_perturbation);
 solver_initial_guess(11) = X_trim(1) - N2_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -142,7 +143,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(12) = X_trim(2) + N3_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -173,7 +174,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(12) = X_trim(2) - N3_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -212,7 +213,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(8) = solver_independents_solution_trim(8) + fuel_flow_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -243,7 +244,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(8) = solver_independents_solution_trim(8) - fuel_flow_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -289,7 +290,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(13) = solver_independents_solution_trim(13) + HP_pwr_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -321,7 +322,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(13) = solver_independents_solution_trim(13) - HP_pwr_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -365,7 +366,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(14) = solver_initial_guess(14) + LP_pwr_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -397,7 +398,7 @@ solver_initial_guess = solver_independents_solution_trim;
 solver_initial_guess(14) = solver_initial_guess(14) - LP_pwr_perturbation;
 
 [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, ...
+        solver_iterations] = solver(environmental_conditions, ...
         solver_initial_guess, solver_targets, health_params, bleeds, ...
         solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
 
@@ -0,0 +1,61 @@
+/*		AGTF30_diagnostics.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Collection of the component error flags into the workspace diagnostics.
+%
+%  The component bodies latch their warnings in IWork (1 = e.g. a map
+%  input outside the table, see the body files for each code), and print
+%  them only when enable_debug is set. After an evaluation with
+%  ws->diag.point_flags set, AGTF30_diag_collect stores the flags of each
+%  component as a bit mask in point_flags and appends one event record
+%  per raised flag to the ring buffer of the workspace. An evaluation
+%  without warnings costs one test per IWork entry; nothing is printed
+%  and nothing is locked, as each thread evaluates with its own workspace.
+% *************************************************************************/
+
+#include "AGTF30_model.h"
+
+void AGTF30_diag_reset(AGTF30Diag *d)
+{
+    d->num_events = 0;
+}
+
+void AGTF30_diag_collect(AGTF30Workspace *ws)
+{
+    /* IWork of each component, in the order of the AGTF30DiagEvent component ids */
+    const int *IWork[AGTF30_DIAG_NUM_COMPONENTS];
+    int len[AGTF30_DIAG_NUM_COMPONENTS];
+    AGTF30Diag *d = &ws->diag;
+    AGTF30DiagEvent *ev;
+    unsigned int flags;
+    int c, k;
+
+    IWork[0] = ws->ambient_IWork;   len[0] = sizeof(ws->ambient_IWork) / sizeof(int);
+    IWork[1] = ws->inlet_IWork;     len[1] = sizeof(ws->inlet_IWork) / sizeof(int);
+    IWork[2] = ws->fan_IWork;       len[2] = sizeof(ws->fan_IWork) / sizeof(int);
+    IWork[3] = ws->lpc_IWork;       len[3] = sizeof(ws->lpc_IWork) / sizeof(int);
+    IWork[4] = ws->vbv_IWork;       len[4] = sizeof(ws->vbv_IWork) / sizeof(int);
+    IWork[5] = ws->nozbyp_IWork;    len[5] = sizeof(ws->nozbyp_IWork) / sizeof(int);
+    IWork[6] = ws->hpc_IWork;       len[6] = sizeof(ws->hpc_IWork) / sizeof(int);
+    IWork[7] = ws->hpcstatic_IWork; len[7] = sizeof(ws->hpcstatic_IWork) / sizeof(int);
+    IWork[8] = ws->hpt_IWork;       len[8] = sizeof(ws->hpt_IWork) / sizeof(int);
+    IWork[9] = ws->lpt_IWork;       len[9] = sizeof(ws->lpt_IWork) / sizeof(int);
+    IWork[10] = ws->nozcor_IWork;   len[10] = sizeof(ws->nozcor_IWork) / sizeof(int);
+
+    for (c = 0; c < AGTF30_DIAG_NUM_COMPONENTS; c++) {
+        flags = 0;
+        for (k = 0; k < len[c]; k++) {
+            if (IWork[c][k] != 0) {
+                flags |= 1u << k;
+                ev = &d->ring[d->num_events & (AGTF30_DIAG_RING - 1)];
+                ev->eval_id = d->eval_id;
+                ev->component = (unsigned short)c;
+                ev->code = (unsigned short)k;
+                ev->value = IWork[c][k];
+                d->num_events++;
+            }
+        }
+        d->point_flags[c] = flags;
+    }
+}
@@ -0,0 +1,1110 @@
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+#include "constants_TMATS.h"
+#include "AGTF30_model.h"
+#include "AGTF30_lanes.h"
+#include "AGTF30_tangent.h"
+
+extern void Ambient_TMATS_body(double *y, const double *u, const AmbientStruct* prm);
+extern void Inlet_TMATS_body(double *y, const double *u, const InletStruct* prm, const double enable_debug);
+extern void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, const double* Wcust, const double* FracWbld, const CompressorStruct* prm, const double enable_debug);
+extern void Splitter_TMATS(double* y, double* y1, const double* u, const double* u1);
+extern void Duct_TMATS_body(double *y, const double *u, const DuctStruct* prm, const double enable_debug);
+extern void Valve_TMATS_body(double* y, const double* u, const ValveStruct* prm);
+extern void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, const double enable_debug);
+extern void StaticCalc_TMATS_body(double *y1, const double *u1, const StaticCalcStruct* prm, const double enable_debug);
+extern void Burner_TMATS_body(double* y, const double* u, const BurnStruct* prm);
+extern void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, const TurbineStruct* prm, const double enable_debug);
+extern void Shaft_TMATS_body(double *y, const double *u, const ShaftStruct* prm);
+extern void SFCCalc_TMATS(double* y, const double* u);
+
+
+/*--- Incremental evaluation ---*/
+
+/* Returns 1 and the cached outputs and error flags of a component when
+ * incremental evaluation is on and key, the component inputs, equals the
+ * key of its cached run. IWork may be NULL. */
+static int cache_get(const AGTF30Workspace *ws, int slot, const double *key, int nkey,
+                     double *y, int ny, int *IWork, int nIWork)
+{
+    const AGTF30CacheEntry *c = &ws->cache[slot];
+
+    if (ws->cache_mode == AGTF30_CACHE_OFF || !c->valid || memcmp(c->key, key, nkey*sizeof(double)) != 0)
+        return 0;
+    memcpy(y, c->y, ny*sizeof(double));
+    if (IWork)
+        memcpy(IWork, c->IWork, nIWork*sizeof(int));
+    return 1;
+}
+
+/* Caches a component run when the cache is being updated */
+static void cache_put(AGTF30Workspace *ws, int slot, const double *key, int nkey,
+                      const double *y, int ny, const int *IWork, int nIWork)
+{
+    AGTF30CacheEntry *c = &ws->cache[slot];
+
+    if (ws->cache_mode != AGTF30_CACHE_UPDATE)
+        return;
+    memcpy(c->key, key, nkey*sizeof(double));
+    memcpy(c->y, y, ny*sizeof(double));
+    if (IWork)
+        memcpy(c->IWork, IWork, nIWork*sizeof(int));
+    c->valid = 1;
+}
+
+/* Compressor_TMATS_body through the cache. The key is u followed by the
+ * customer and fractional bleeds and SMSkip, the outputs y, y1 and y2 are
+ * cached back to back. */
+static void Compressor_cached(AGTF30Workspace *ws, int slot, double* y, double* y1, double* y2, const double* u,
+                              const double* Wcust, const double* FracWbld, const CompressorStruct* prm,
+                              const double enable_debug)
+{
+    double key[AGTF30_CACHE_KEY], out[AGTF30_CACHE_Y];
+    int n1 = (int)prm->CustBldNm, n2 = (int)prm->FracBldNm;
+    int nkey = 13 + n1 + n2, ny = 27 + 5*n1 + 5*n2;
+
+    if (ws->cache_mode == AGTF30_CACHE_OFF || nkey > AGTF30_CACHE_KEY || ny > AGTF30_CACHE_Y) {
+        Compressor_TMATS_body(y, y1, y2, u, Wcust, FracWbld, prm, enable_debug);
+        return;
+    }
+
+    memcpy(&key[0], u, 12*sizeof(double));
+    memcpy(&key[12], Wcust, n1*sizeof(double));
+    memcpy(&key[12 + n1], FracWbld, n2*sizeof(double));
+    key[12 + n1 + n2] = prm->SMSkip;
+
+    if (!cache_get(ws, slot, key, nkey, out, ny, prm->IWork, 5)) {
+        Compressor_TMATS_body(y, y1, y2, u, Wcust, FracWbld, prm, enable_debug);
+        memcpy(&out[0], y, 27*sizeof(double));
+        memcpy(&out[27], y1, 5*n1*sizeof(double));
+        memcpy(&out[27 + 5*n1], y2, 5*n2*sizeof(double));
+        cache_put(ws, slot, key, nkey, out, ny, prm->IWork, 5);
+        return;
+    }
+    memcpy(y, &out[0], 27*sizeof(double));
+    memcpy(y1, &out[27], 5*n1*sizeof(double));
+    memcpy(y2, &out[27 + 5*n1], 5*n2*sizeof(double));
+}
+
+/* Turbine_TMATS_body through the cache. The key is u followed by the
+ * cfWidth cooling flow entries. */
+static void Turbine_cached(AGTF30Workspace *ws, int slot, double* y, const double* u, const double* CoolFlow,
+                           const TurbineStruct* prm, const double enable_debug)
+{
+    double key[AGTF30_CACHE_KEY];
+    int cfWidth = (int)u[11];
+
+    if (ws->cache_mode == AGTF30_CACHE_OFF || cfWidth < 0 || 12 + cfWidth > AGTF30_CACHE_KEY) {
+        Turbine_TMATS_body(y, u, CoolFlow, prm, enable_debug);
+        return;
+    }
+
+    memcpy(&key[0], u, 12*sizeof(double));
+    memcpy(&key[12], CoolFlow, cfWidth*sizeof(double));
+
+    if (!cache_get(ws, slot, key, 12 + cfWidth, y, 20, prm->IWork, 5)) {
+        Turbine_TMATS_body(y, u, CoolFlow, prm, enable_debug);
+        cache_put(ws, slot, key, 12 + cfWidth, y, 20, prm->IWork, 5);
+    }
+}
+
+/* Nozzle_TMATS_body through the cache. The throat of a run that is
+ * cached becomes the seed of the MN = 1 search of later runs of the
+ * nozzle (the body takes it only when Tt and FAR are close, and only in
+ * TMATS_PROPERTIES_CONVERGED builds), also those with the cache off, such
+ * as the perturbations of a Jacobian. Only AGTF30_CACHE_UPDATE seeds, and
+ * AGTF30_nr_solver clears the seeds before and after a solve
+ * (AGTF30_nozzle_seeds_clear), so only the runs of one solve are seeded,
+ * from the runs of that solve. */
+static void Nozzle_cached(AGTF30Workspace *ws, int slot, double* y, const double* u, NozzleStruct* prm,
+                          const double enable_debug)
+{
+    if (cache_get(ws, slot, u, 8, y, 17, prm->IWork, 16))
+        return;
+    Nozzle_TMATS_body(y, u, prm, enable_debug);
+    if (ws->cache_mode == AGTF30_CACHE_UPDATE) {
+        prm->Search->seed = prm->Search->last;
+        prm->Search->seeded = 1;
+    }
+    cache_put(ws, slot, u, 8, y, 17, prm->IWork, 16);
+}
+
+/* Structural dependence of DEP on CMD: entry [i][j] is 1 when dependent i
+ * can change with command j. It follows the order of the gas path: a
+ * command only reaches the components downstream of where it enters. */
+const unsigned char AGTF30_dep_pattern[AGTF30_NUM_DEP][AGTF30_NUM_CMD] = {
+  /* W  FRL LRL HRL BPR HPR LPR Wf VAFN VBV N2  N3 HPp LPp */
+    {1,  1,  0,  0,  0,  0,  0,  0,  0,  0,  1,  0,  0,  0},  /* Nerr21 */
+    {1,  1,  1,  0,  1,  0,  0,  0,  0,  0,  1,  0,  0,  0},  /* Nerr24a */
+    {1,  1,  1,  1,  1,  0,  0,  0,  0,  1,  1,  1,  0,  0},  /* Nerr36 */
+    {1,  1,  1,  1,  1,  1,  0,  1,  0,  1,  1,  1,  0,  0},  /* Nerr45 */
+    {1,  1,  1,  1,  1,  1,  1,  1,  0,  1,  1,  1,  0,  0},  /* Nerr5 */
+    {1,  1,  1,  1,  1,  1,  1,  1,  0,  1,  1,  1,  0,  0},  /* NErr8 */
+    {1,  1,  1,  0,  1,  0,  0,  0,  1,  1,  1,  0,  0,  0},  /* NErr18 */
+    {1,  1,  1,  1,  1,  1,  1,  1,  0,  1,  1,  1,  0,  1},  /* N2dot */
+    {1,  1,  1,  1,  1,  1,  0,  1,  0,  1,  1,  1,  1,  0},  /* N3dot */
+    {0,  1,  1,  0,  0,  0,  0,  0,  0,  0,  1,  0,  0,  0},  /* LPC SM error */
+    {1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  0,  0},  /* Fnet error */
+    {1,  1,  1,  1,  1,  1,  0,  1,  0,  1,  1,  1,  0,  0}   /* T45 error */
+};
+
+/* Commands that enter the gas path at or after the HPC, or only at the
+ * bypass nozzle. After a change to one of them alone, an incremental
+ * evaluation (cache_mode) re-runs less than a third of the model. */
+const unsigned char AGTF30_cmd_downstream[AGTF30_NUM_CMD] = {
+  /* W  FRL LRL HRL BPR HPR LPR Wf VAFN VBV N2  N3 HPp LPp */
+     0,  0,  0,  1,  0,  1,  1,  1,  1,  0,  0,  1,  1,  1
+};
+
+void AGTF30_workspace_init(AGTF30Workspace *ws, const AGTF30Model *mdl)
+{
+    int i;
+
+    ws->mdl = mdl;
+
+    /*--- Copy the component structures that write error flags and point them at this workspace ---*/
+    ws->ambient   = mdl->ambient;   ws->ambient.IWork   = &ws->ambient_IWork[0];
+    ws->inlet     = mdl->inlet;     ws->inlet.IWork     = &ws->inlet_IWork[0];
+    ws->fan       = mdl->fan;       ws->fan.IWork       = &ws->fan_IWork[0];
+    ws->lpc       = mdl->lpc;       ws->lpc.IWork       = &ws->lpc_IWork[0];
+    ws->vbv       = mdl->vbv;       ws->vbv.IWork       = &ws->vbv_IWork[0];
+    ws->nozbyp    = mdl->nozbyp;    ws->nozbyp.IWork    = &ws->nozbyp_IWork[0];
+    ws->hpc       = mdl->hpc;       ws->hpc.IWork       = &ws->hpc_IWork[0];
+    ws->hpcstatic = mdl->hpcstatic; ws->hpcstatic.IWork = &ws->hpcstatic_IWork[0];
+    ws->hpt       = mdl->hpt;       ws->hpt.IWork       = &ws->hpt_IWork[0];
+    ws->lpt       = mdl->lpt;       ws->lpt.IWork       = &ws->lpt_IWork[0];
+    ws->nozcor    = mdl->nozcor;    ws->nozcor.IWork    = &ws->nozcor_IWork[0];
+
+    memset(&ws->nozbyp_search, 0, sizeof(ws->nozbyp_search));
+    memset(&ws->nozcor_search, 0, sizeof(ws->nozcor_search));
+    ws->nozbyp.Search = &ws->nozbyp_search;
+    ws->nozcor.Search = &ws->nozcor_search;
+
+    memset(ws->fan_MapCell, 0, sizeof(ws->fan_MapCell));
+    memset(ws->lpc_MapCell, 0, sizeof(ws->lpc_MapCell));
+    memset(ws->hpc_MapCell, 0, sizeof(ws->hpc_MapCell));
+    ws->fan.MapCell = ws->fan_MapCell;
+    ws->lpc.MapCell = ws->lpc_MapCell;
+    ws->hpc.MapCell = ws->hpc_MapCell;
+
+    ws->hpc_Wcust[0] = 0;
+    ws->hpc_FracWbld[0] = 0;
+    ws->hpc_FracWbld[1] = 0;
+    ws->hpc_FracWbld[2] = 0;
+
+    ws->eval_level = AGTF30_EVAL_FULL;
+    ws->diag.point_flags = NULL;
+    ws->diag.eval_id = 0;
+    AGTF30_diag_reset(&ws->diag);
+    ws->cache_mode = AGTF30_CACHE_OFF;
+    for (i = 0; i < AGTF30_NUM_CACHED; i++)
+        ws->cache[i].valid = 0;
+}
+
+void AGTF30_nozzle_seeds_clear(AGTF30Workspace *ws)
+{
+    ws->nozbyp_search.seeded = 0;
+    ws->nozcor_search.seeded = 0;
+}
+
+void AGTF30_engine_eval(AGTF30Workspace *ws, const double *env, const double *cmd, const double *tar,
+                        const double *health_params, const double *blds, const double enable_debug,
+                        double *DEP, double *X, double *U, double *Y, double *E)
+{
+    const AGTF30Model *mdl = ws->mdl;
+
+    /*--------Define Inputs----------*/
+    double AltIn, MNIn, dTambIn;
+    
+    double WIn, FAN_RLIn, LPC_RLIn, HPC_RLIn, BPRIn, HPT_PRIn, LPT_PRIn;
+    double WfIn, VAFNIn, VBVIn, N2In, N3In, HPpwrIn, LPpwrIn;
+
+    double LPC_SM_target, Fnet_target, T45_target;
+
+    double GTF_fan_WcMod, GTF_fan_PRMod, GTF_fan_EffMod, GTF_fan_hp_En;
+    double GTF_lpc_WcMod, GTF_lpc_PRMod, GTF_lpc_EffMod, GTF_lpc_hp_En;
+    double GTF_hpc_WcMod, GTF_hpc_PRMod, GTF_hpc_EffMod, GTF_hpc_hp_En;
+    double GTF_hpt_WcMod, GTF_hpt_EffMod, GTF_hpt_hp_En;
+    double GTF_lpt_WcMod, GTF_lpt_EffMod, GTF_lpt_hp_En;
+
+    /*--- Define Block Inputs/Outputs ---*/
+    /*--- Ambient ---*/
+    double amb_u[3]; /*--- Inputs:  Alt, dTamb, MN ---*/
+    double amb_y[8]; /*--- Outputs: W, ht, Tt, Pt, FAR, Ps, Ts, Veng ---*/
+
+    /*--- Inlet ---*/
+    double inlet_u[6]; /*--- Inputs:  W, ht, Tt, Pt, FAR, Ps ---*/
+    double inlet_y[5]; /*--- Outputs: W, ht, Tt, Pt, FAR ---*/
+
+    /*--- Compressor Blocks (Fan, LPC, and HPC) ---*/
+    double compressor_u[12]; /*--- Inputs:  W, ht, Tt, Pt, FAR, Nmech, Rline, Alpha, s_C_Nc, s_C_Wc, s_C_PR, s_C_Eff ---*/
+    double compressor_y[27]; /*--- Outputs: W, ht, Tt, Pt, FAR, Trq, Werr, SMavail, C_Nc, C_Wc, C_PR, C_Eff, Wcin, Nc, PR, NcMap, WcMap, PRMap, EffMap, SPR, Wbleeds, Pwrb4bleed, PwrBld, Pwrout, SMMap, SPRMap, Test ---*/
+    double compressor_y1[5]; /*--- Outputs: Customer bleeds (W, ht, Tt, Pt, FAR per bleed). The HPC has one customer bleed ---*/
+    double compressor_y2[15]; /*--- Outputs: Fractional bleeds. In AGTF30 fractional bleeds used in HPC to extract 3 bleed flows (LPT exit, HPT exit, HPT in) but no bleeds off FAN or LPC ---*/
+
+    /*--- Splitter ---*/
+    double splitter_u[5];  /*--- Inputs:  W, ht, Tt, Pt, FAR ---*/
+    double splitter_u1[1]; /*--- Inputs:  BPR ---*/
+    double splitter_y[5];  /*--- Outputs: W, ht, Tt, Pt, FAR (Bypass) ---*/
+    double splitter_y1[5]; /*--- Outputs: W, ht, Tt, Pt, FAR (Core) ---*/
+
+    /*--- Ducts --- */
+    double duct_u[5]; /*--- Inputs:  W, ht, Tt, Pt, FAR ---*/
+    double duct_y[5]; /*--- Outputs: W, ht, Tt, Pt, FAR ---*/
+
+    /*--- VBV Valve ---*/
+    double vbv_u[5]; /*--- Inputs:  Pt, VBVIn, WIn, TtIn, PtIn ---*/
+    double vbv_y[2]; /*--- Outputs: WthOut (valve throat flow), Test ---*/
+
+    /*--- Nozzles ---*/
+    double nozzle_u[8]; /*---  Inputs:  W, ht, Tt, Pt, FAR, Pamb, AthroatIn, AexitIn ---*/
+    double nozzle_y[17]; /*--- Outputs: W, Fg, Werr, Ath, Ax, Psth, Tsth, MNth, Vth, Psx, Tsx, MNx, Vx, Woutcalc, choked, V_s, Test ---*/
+
+    /*--- StaticCalc ---*/
+    double static_u[5]; /*--- Inputs:  W, ht, Tt, Pt, FAR ---*/
+    double static_y[5]; /*--- Outputs: Ts, Ps, rhos, MN, Ath ---*/
+
+    /*--- Burner ---*/
+    double burner_u[6]; /*--- Inputs:  Wf, W, ht, Tt, Pt, FAR ---*/
+    double burner_y[6]; /*--- Outputs: W, ht, Tt, Pt, FAR, Test ---*/
+
+    /*--- Turbines (HPT and LPT) ---*/
+    double turbine_u[12];    /*--- Inputs:  Wf, W, ht, Tt, Pt, FAR, Nmech, PR, s_T_Nc, s_T_Wc, s_T_PR, s_T_Eff, cfWidth (cooling Flow vector length) ---*/
+    double turbinecool_u[10]; /*--- Inputs:  2 incoming bleed streams x (Wcool, htcool, Ttcool, Ptcool, FARcool) ---*/
+    double turbine_y[20];    /*--- Outputs: W, ht, Tt, Pt, FAR, Trq, Werr, C_Nc, C_Wc, C_PR, C_Eff, Wcin, Wcs1in, Nc, NcMap, WcMap, PRmapRead, EffMap, Pwrout, Test ---*/
+
+    /*--- Shafts ---*/
+    double shaft_u[3]; /*--- Inputs:  Trq, Pwr (extraction), Nmech ---*/
+    double shaft_y[2]; /*--- Outputs: Nmech, Ndot ---*/
+
+    /*--- TSFC Calcuation ---*/
+    double SFCCalc_u[3]; /*--- Inputs:  Wf, Fg, Fdrag ---*/
+    double SFCCalc_y[2]; /*--- Outputs: SFC, Fnet ---*/
+
+    /*===================================================================*/
+    /*--- Define parameters ---*/
+    /*===================================================================*/
+    /*--- Ambient outputs ---*/
+    double W0, ht0, Tt0, Pt0, FAR0, Ps0, Ts0, Veng, Fdrag;
+
+    /*--- Inlet outputs ---*/
+    double W2, ht2, Tt2, Pt2, FAR2;
+
+    /*--- Fan outputs ---*/
+    double W21, ht21, Tt21, Pt21, FAR21;
+    double Trq21, Nerr21, SMavail21, C_Nc21, C_Wc21, C_PR21, C_Eff21, Wcin21, Nc21, PR21, NcMap21, WcMap21, PRMap21, EffMap21, SPR21, Wbleeds21, Pwrb4bleed21, PwrBld21, Pwrout21, SMMap21, SPRMap21;
+
+    /*--- Splitter outputs ---*/
+    double W13, ht13, Tt13, Pt13, FAR13; /*--- bypass ---*/
+    double W22, ht22, Tt22, Pt22, FAR22; /*--- core ---*/
+
+    /*--- Duct2 outputs ---*/
+    double W23, ht23, Tt23, Pt23, FAR23;
+
+    /*--- LPC outputs ---*/
+    double W24a, ht24a, Tt24a, Pt24a, FAR24a;
+    double Trq24a, Nerr24a, SMavail24a, C_Nc24a, C_Wc24a, C_PR24a, C_Eff24a, Wcin24a, Nc24a, PR24a, NcMap24a, WcMap24a, PRMap24a, EffMap24a, SPR24a, Wbleeds24a, Pwrb4bleed24a, PwrBld24a, Pwrout24a, SMMap24a, SPRMap24a;
+
+    /*--- VBV outputs ---*/
+    double W24, ht24, Tt24, Pt24, FAR24; /*--- core ---*/
+    double W15, ht15, Tt15, Pt15, FAR15; /*--- bypass ---*/
+    double vbv_Wth, vbv_Test;
+
+    /*--- Duct25 outputs ---*/
+    double W25, ht25, Tt25, Pt25, FAR25;
+
+    /*--- Duct17 outputs ---*/
+    double W17, ht17, Tt17, Pt17, FAR17;
+
+    /*--- Bypass Nozzle outputs ---*/
+    double W18, Fg18, NErr18, Ath18, Ax18, Psth18, Tsth18, MNth18, Vth18, Psx18, Tsx18, MNx18, Vx18, Woutcalc18, choked18, Vs18, Nozzle_Test18;
+
+    /*--- HPC outputs ---*/
+    double W36, ht36, Tt36, Pt36, FAR36;
+    double Trq36, Nerr36, SMavail36, C_Nc36, C_Wc36, C_PR36, C_Eff36, Wcin36, Nc36, PR36, NcMap36, WcMap36, PRMap36, EffMap36, SPR36, Wbleeds36, Pwrb4bleed36, PwrBld36, Pwrout36, SMMap36, SPRMap36;
+
+    /*--- HPC StaticCalc outputs ---*/
+    double Ps36, Ts36;
+    double inf = HUGE_VAL;
+
+    /*--- Burner outputs ---*/
+    double W4, ht4, Tt4, Pt4, FAR4, Test4;
+
+    /*--- HPT outputs ---*/
+    double W45, ht45, Tt45, Pt45, FAR45;
+    double Trq45, Nerr45, s_T_Nc45, s_T_Wc45, s_T_PR45, s_T_Eff45, Wcin45, Wcs1in45, Nc45, NcMap45, WcMap45, PRMap45, EffMap45, Pwrout45, Test45;
+
+    /*--- Duct45 outputs ---*/
+    double W48, ht48, Tt48, Pt48, FAR48;
+
+    /*--- LPT outputs ---*/
+    double W5, ht5, Tt5, Pt5, FAR5;
+    double Trq5, Nerr5, s_T_Nc5, s_T_Wc5, s_T_PR5, s_T_Eff5, Wcin5, Wcs1in5, Nc5, NcMap5, WcMap5, PRMap5, EffMap5, Pwrout5, Test5;
+
+    /*--- Duct7 outputs ---*/
+    double W7, ht7, Tt7, Pt7, FAR7;
+
+    /*--- Core Nozzle outputs ---*/
+    double W8, Fg8, NErr8, Ath8, Ax8, Psth8, Tsth8, MNth8, Vth8, Psx8, Tsx8, MNx8, Vx8, Woutcalc8, choked8, Vs8, Nozzle_Test8;
+
+    /*--- LP Shaft outputs ---*/
+    double N2dot, N2mechOut;
+
+    /*--- HP Shaft outputs ---*/
+    double N3dot, N3mechOut;
+
+    /*--- SFCCalc outputs ---*/
+    double Fnet, TSFC;
+
+    /*--- Error flags are cleared on every evaluation, as each call used to start from fresh structures ---*/
+    memset(ws->ambient_IWork, 0, sizeof(ws->ambient_IWork));
+    memset(ws->inlet_IWork, 0, sizeof(ws->inlet_IWork));
+    memset(ws->fan_IWork, 0, sizeof(ws->fan_IWork));
+    memset(ws->lpc_IWork, 0, sizeof(ws->lpc_IWork));
+    memset(ws->vbv_IWork, 0, sizeof(ws->vbv_IWork));
+    memset(ws->nozbyp_IWork, 0, sizeof(ws->nozbyp_IWork));
+    memset(ws->hpc_IWork, 0, sizeof(ws->hpc_IWork));
+    memset(ws->hpcstatic_IWork, 0, sizeof(ws->hpcstatic_IWork));
+    memset(ws->hpt_IWork, 0, sizeof(ws->hpt_IWork));
+    memset(ws->lpt_IWork, 0, sizeof(ws->lpt_IWork));
+    memset(ws->nozcor_IWork, 0, sizeof(ws->nozcor_IWork));
+
+    /*--- The fan and HPC stall margins are only evaluated for the map diagnostics ---*/
+    ws->fan.SMSkip = (ws->eval_level < AGTF30_EVAL_DIAGNOSTICS);
+    ws->hpc.SMSkip = (ws->eval_level < AGTF30_EVAL_DIAGNOSTICS);
+
+    /*--- HPC bleeds ---*/
+    ws->hpc_Wcust[0] = blds[0];
+    ws->hpc_FracWbld[0] = blds[1];
+    ws->hpc_FracWbld[1] = blds[2];
+    ws->hpc_FracWbld[2] = blds[3];
+
+    /*--- Environmental inputs ---*/
+    AltIn    = env[0]; /* Altitude */
+    MNIn     = env[1]; /* Mach */
+    dTambIn  = env[2]; /* dTamb */
+
+    /*--- Independent and command inputs ---*/
+    WIn      = cmd[0]; /* Mass flow */
+    FAN_RLIn = cmd[1]; /* Fan Rline */
+    LPC_RLIn = cmd[2]; /* LPC Rline */
+    HPC_RLIn = cmd[3]; /* HPC Rline */
+    BPRIn    = cmd[4]; /* Bypass Ratio */
+    HPT_PRIn = cmd[5]; /* HPT PRIn */
+    LPT_PRIn = cmd[6]; /* LPT PRIn */
+    WfIn     = cmd[7]; /* Fuel flow */
+    VAFNIn   = cmd[8]; /* VAFN position */
+    VBVIn    = cmd[9]; /* VBV position */
+    N2In     = cmd[10]; /* LP shaft speed */
+    N3In     = cmd[11]; /* HP shaft speed */
+    HPpwrIn  = cmd[12]; /* HP shaft power extraction */
+    LPpwrIn  = cmd[13]; /* LP shaft power extraction */
+
+    /*--- Target outputs ---*/
+    LPC_SM_target  = tar[0];
+    Fnet_target  = tar[1];
+    T45_target = tar[2];
+
+    /*--- Health Parameters ---*/
+    // Fan
+    GTF_fan_WcMod  = health_params[0];  
+    GTF_fan_PRMod  = health_params[1];
+    GTF_fan_EffMod = health_params[2];
+    GTF_fan_hp_En  = 1;
+    // LPC
+    GTF_lpc_WcMod  = health_params[3];  
+    GTF_lpc_PRMod  = health_params[4];
+    GTF_lpc_EffMod = health_params[5];
+    GTF_lpc_hp_En  = 1;
+    // HPC
+    GTF_hpc_WcMod  = health_params[6];  
+    GTF_hpc_PRMod  = health_params[7];
+    GTF_hpc_EffMod = health_params[8];
+    GTF_hpc_hp_En  = 1;
+    // HPT
+    GTF_hpt_WcMod  = health_params[9]; 
+    GTF_hpt_EffMod = health_params[10];
+    GTF_hpt_hp_En  = 1;
+    // LPT
+    GTF_lpt_WcMod  = health_params[11]; 
+    GTF_lpt_EffMod = health_params[12];
+    GTF_lpt_hp_En  = 1;
+
+    /*--- Ambient ---*/
+    amb_u[0] = AltIn;
+    amb_u[1] = dTambIn;
+    amb_u[2] = MNIn;
+
+    if (!cache_get(ws, AGTF30_CACHED_AMBIENT, amb_u, 3, amb_y, 8, ws->ambient.IWork, 5)) {
+        Ambient_TMATS_body(&amb_y[0], &amb_u[0], &ws->ambient);
+        cache_put(ws, AGTF30_CACHED_AMBIENT, amb_u, 3, amb_y, 8, ws->ambient.IWork, 5);
+    }
+    W0 = WIn;
+    ht0 = amb_y[0];
+    Tt0 = amb_y[1];
+    Pt0 = amb_y[2];
+    FAR0 = amb_y[3];
+    Ps0 = amb_y[4];
+    Ts0 = amb_y[5];
+    Veng = amb_y[6];
+
+    // For this calculation only, the old Simulink model used value of gravity with fewer signficiant digits, 
+    // leading to minor disagreement at Fdrag calculation. After rectifying the issue the two models agree.
+    Fdrag = WIn * Veng / C_GRAVITY;
+
+    /*--- Inlet ---*/
+    inlet_u[0] = W0;
+    inlet_u[1] = ht0;
+    inlet_u[2] = Tt0;
+    inlet_u[3] = Pt0;
+    inlet_u[4] = FAR0;
+    inlet_u[5] = Ps0;
+
+    if (!cache_get(ws, AGTF30_CACHED_INLET, inlet_u, 6, inlet_y, 5, ws->inlet.IWork, 1)) {
+        Inlet_TMATS_body(&inlet_y[0], &inlet_u[0], &ws->inlet, enable_debug);
+        cache_put(ws, AGTF30_CACHED_INLET, inlet_u, 6, inlet_y, 5, ws->inlet.IWork, 1);
+    }
+    W2 = inlet_y[0];
+    ht2 = inlet_y[1];
+    Tt2 = inlet_y[2];
+    Pt2 = inlet_y[3];
+    FAR2 = inlet_y[4];
+
+    /*--- Fan --- */
+    compressor_u[0] = W2;
+    compressor_u[1] = ht2;
+    compressor_u[2] = Tt2;
+    compressor_u[3] = Pt2;
+    compressor_u[4] = FAR2;
+    compressor_u[5] = N2In / mdl->gearbox_GearRatio; /* Nmech */
+    compressor_u[6] = FAN_RLIn; /*Rline; */
+
+    compressor_u[7] = mdl->fan_Alpha;
+    compressor_u[8] = mdl->fan_s_C_Nc;
+    compressor_u[9] = mdl->fan_s_C_Wc * (1 + GTF_fan_WcMod * GTF_fan_hp_En);
+    compressor_u[10] = mdl->fan_s_C_PR * (1 + GTF_fan_PRMod * GTF_fan_hp_En);
+    compressor_u[11] = mdl->fan_s_C_Eff * (1 + GTF_fan_EffMod * GTF_fan_hp_En);
+
+    Compressor_cached(ws, AGTF30_CACHED_FAN, &compressor_y[0], &compressor_y1[0], &compressor_y2[0], &compressor_u[0], mdl->fan_Wcust, mdl->fan_FracWbld, &ws->fan, enable_debug);
+    W21 = compressor_y[0];
+    ht21 = compressor_y[1];
+    Tt21 = compressor_y[2];
+    Pt21 = compressor_y[3];
+    FAR21 = compressor_y[4];
+    Trq21 = compressor_y[5];
+    Nerr21 = compressor_y[6];
+    SMavail21 = compressor_y[7];
+    C_Nc21 = compressor_y[8];            /* Corrected shaft speed scalar */
+    C_Wc21 = compressor_y[9];             /* Corrected flow scalar */
+    C_PR21 = compressor_y[10];            /* Pressure Ratio scalar */
+    C_Eff21 = compressor_y[11];          /* Efficiency scalar */
+    Wcin21 = compressor_y[12];           /* Corrected input flow [pps] */
+    Nc21 = compressor_y[13];             /* Corrected speed [rpm]*/
+    PR21 = compressor_y[14];             /* Pressure ratio */
+    NcMap21 = compressor_y[15];          /* Map corrected speed */
+    WcMap21 = compressor_y[16];          /* Map corrected flow */
+    PRMap21 = compressor_y[17];          /* Map pressure ratio */
+    EffMap21 = compressor_y[18];         /* Map efficiency */
+    SPR21 = compressor_y[19];            /* Surge pressure ratio */
+    Wbleeds21 = compressor_y[20];        /* Bleed flow [pps]*/
+    Pwrb4bleed21 = compressor_y[21];     /* Power if there was no bleed [hp]*/
+    PwrBld21 = compressor_y[22];         /* Power loss due to bleed [hp] */
+    Pwrout21 = compressor_y[23];         /* Output power [hp]*/
+    SMMap21 = compressor_y[24];          /* Stall margin calculated from map values [%]*/
+    SPRMap21 = compressor_y[25];         /* Map stall pressure ratio*/    
+
+    /*--- Splitter --- */
+    splitter_u[0] = W21;
+    splitter_u[1] = ht21;
+    splitter_u[2] = Tt21;
+    splitter_u[3] = Pt21;
+    splitter_u[4] = FAR21;
+
+    splitter_u1[0] = BPRIn;
+
+    Splitter_TMATS(&splitter_y[0], &splitter_y1[0], &splitter_u[0], &splitter_u1[0]);
+    W13 = splitter_y[0];
+    ht13 = splitter_y[1];
+    Tt13 = splitter_y[2];
+    Pt13 = splitter_y[3];
+    FAR13 = splitter_y[4];
+
+    W22 = splitter_y1[0];
+    ht22 = splitter_y1[1];
+    Tt22 = splitter_y1[2];
+    Pt22 = splitter_y1[3];
+    FAR22 = splitter_y1[4];
+
+    /*--- Duct 2 (between splitter and LPC)---*/
+    duct_u[0] = W22;
+    duct_u[1] = ht22;
+    duct_u[2] = Tt22;
+    duct_u[3] = Pt22;
+    duct_u[4] = FAR22;
+    if (!cache_get(ws, AGTF30_CACHED_DUCT2, duct_u, 5, duct_y, 5, NULL, 0)) {
+        Duct_TMATS_body(&duct_y[0],&duct_u[0],&mdl->duct2, enable_debug);
+        cache_put(ws, AGTF30_CACHED_DUCT2, duct_u, 5, duct_y, 5, NULL, 0);
+    }
+    W23 = duct_y[0];
+    ht23 = duct_y[1];
+    Tt23 = duct_y[2];
+    Pt23 = duct_y[3];
+    FAR23 = duct_y[4];
+
+    /*--- LPC --- */
+    compressor_u[0] = W23;
+    compressor_u[1] = ht23;
+    compressor_u[2] = Tt23;
+    compressor_u[3] = Pt23;
+    compressor_u[4] = FAR23;
+    compressor_u[5] = N2In; /* Nmech */
+    compressor_u[6] = LPC_RLIn; /*Rline; */
+
+    compressor_u[7] = mdl->lpc_Alpha;
+    compressor_u[8] = mdl->lpc_s_C_Nc;
+    compressor_u[9] = mdl->lpc_s_C_Wc * (1 + GTF_lpc_WcMod * GTF_lpc_hp_En);
+    compressor_u[10] = mdl->lpc_s_C_PR * (1 + GTF_lpc_PRMod * GTF_lpc_hp_En);
+    compressor_u[11] = mdl->lpc_s_C_Eff * (1 + GTF_lpc_EffMod * GTF_lpc_hp_En);
+
+    Compressor_cached(ws, AGTF30_CACHED_LPC, &compressor_y[0], &compressor_y1[0], &compressor_y2[0], &compressor_u[0], mdl->lpc_Wcust, mdl->lpc_FracWbld, &ws->lpc, enable_debug);
+    W24a = compressor_y[0];
+    ht24a = compressor_y[1];
+    Tt24a = compressor_y[2];
+    Pt24a = compressor_y[3];
+    FAR24a = compressor_y[4];
+    Trq24a = compressor_y[5];
+    Nerr24a = compressor_y[6];
+    SMavail24a = compressor_y[7];
+    C_Nc24a = compressor_y[8];            /* Corrected shaft speed scalar */
+    C_Wc24a = compressor_y[9];             /* Corrected flow scalar */
+    C_PR24a = compressor_y[10];            /* Pressure Ratio scalar */
+    C_Eff24a = compressor_y[11];          /* Efficiency scalar */
+    Wcin24a = compressor_y[12];           /* Corrected input flow [pps] */
+    Nc24a = compressor_y[13];             /* Corrected speed [rpm]*/
+    PR24a = compressor_y[14];             /* Pressure ratio */
+    NcMap24a = compressor_y[15];          /* Map corrected speed */
+    WcMap24a = compressor_y[16];          /* Map corrected flow */
+    PRMap24a = compressor_y[17];          /* Map pressure ratio */
+    EffMap24a = compressor_y[18];         /* Map efficiency */
+    SPR24a = compressor_y[19];            /* Surge pressure ratio */
+    Wbleeds24a = compressor_y[20];        /* Bleed flow [pps]*/
+    Pwrb4bleed24a = compressor_y[21];     /* Power if there was no bleed [hp]*/
+    PwrBld24a = compressor_y[22];         /* Power loss due to bleed [hp] */
+    Pwrout24a = compressor_y[23];         /* Output power [hp]*/
+    SMMap24a = compressor_y[24];          /* Stall margin calculated from map values [%]*/
+    SPRMap24a = compressor_y[25];         /* Map stall pressure ratio*/ 
+
+    /*--- VBV ---*/
+    vbv_u[0] = Pt13;
+    vbv_u[1] = VBVIn;
+    vbv_u[2] = W24a;
+    vbv_u[3] = Tt24a;
+    vbv_u[4] = Pt24a;
+
+    Valve_TMATS_body(&vbv_y[0], &vbv_u[0], &ws->vbv);
+    vbv_Wth = vbv_y[0];
+    vbv_Test = vbv_y[1];
+
+    W24 = W24a - vbv_Wth; /*--- core flow aft of VBV ---*/
+    ht24 = ht24a;
+    Tt24 = Tt24a;
+    Pt24 = Pt24a;
+    FAR24 = FAR24a;
+
+    W15 = W13 + vbv_Wth; /*--- bypass flow aft of VBV ---*/
+    ht15 = ht13;
+    Tt15 = Tt13;
+    Pt15 = Pt13;
+    FAR15 = FAR13;
+
+    /*--- Duct 25 (aft of LPC and VBV) ---*/
+    duct_u[0] = W24;
+    duct_u[1] = ht24;
+    duct_u[2] = Tt24;
+    duct_u[3] = Pt24;
+    duct_u[4] = FAR24;
+    if (!cache_get(ws, AGTF30_CACHED_DUCT25, duct_u, 5, duct_y, 5, NULL, 0)) {
+        Duct_TMATS_body(&duct_y[0],&duct_u[0],&mdl->duct25, enable_debug);
+        cache_put(ws, AGTF30_CACHED_DUCT25, duct_u, 5, duct_y, 5, NULL, 0);
+    }
+    W25 = duct_y[0];
+    ht25 = duct_y[1];
+    Tt25 = duct_y[2];
+    Pt25 = duct_y[3];
+    FAR25 = duct_y[4];
+
+    /*--- Duct 17 (in bypass) ---*/
+    duct_u[0] = W15;
+    duct_u[1] = ht15;
+    duct_u[2] = Tt15;
+    duct_u[3] = Pt15;
+    duct_u[4] = FAR15;
+    if (!cache_get(ws, AGTF30_CACHED_DUCT17, duct_u, 5, duct_y, 5, NULL, 0)) {
+        Duct_TMATS_body(&duct_y[0],&duct_u[0],&mdl->duct17, enable_debug);
+        cache_put(ws, AGTF30_CACHED_DUCT17, duct_u, 5, duct_y, 5, NULL, 0);
+    }
+    W17 = duct_y[0];
+    ht17 = duct_y[1];
+    Tt17 = duct_y[2];
+    Pt17 = duct_y[3];
+    FAR17 = duct_y[4];
+
+    /*--- Bypass Nozzle ---*/
+    nozzle_u[0] = W17;
+    nozzle_u[1] = ht17;
+    nozzle_u[2] = Tt17;
+    nozzle_u[3] = Pt17;
+    nozzle_u[4] = FAR17;
+    nozzle_u[5] = Ps0;
+
+    if (mdl->nozbyp.IDes < 1.5)
+    {
+        nozzle_u[6] = mdl->NozByp_N_TArea_M;
+        nozzle_u[7] = mdl->NozByp_N_EArea_M;
+    }
+    else
+    {
+        nozzle_u[6] = VAFNIn;
+        nozzle_u[7] = VAFNIn;
+    }
+
+    Nozzle_cached(ws, AGTF30_CACHED_NOZBYP, &nozzle_y[0], &nozzle_u[0], &ws->nozbyp, enable_debug);
+    W18 = nozzle_y[0];
+    Fg18 = nozzle_y[1];
+    NErr18 = nozzle_y[2];
+    Ath18 = nozzle_y[3];
+    Ax18 = nozzle_y[4];
+    Psth18 = nozzle_y[5];
+    Tsth18 = nozzle_y[6];
+    MNth18 = nozzle_y[7];
+    Vth18 = nozzle_y[8];
+    Psx18 = nozzle_y[9];
+    Tsx18 = nozzle_y[10];
+    MNx18 = nozzle_y[11];
+    Vx18 = nozzle_y[12];
+    Woutcalc18 = nozzle_y[13];
+    choked18 = nozzle_y[14];
+    Vs18 = nozzle_y[15];
+    Nozzle_Test18 = nozzle_y[16];
+
+    /*--- HPC --- */
+    compressor_u[0] = W25;
+    compressor_u[1] = ht25;
+    compressor_u[2] = Tt25;
+    compressor_u[3] = Pt25;
+    compressor_u[4] = FAR25;
+    compressor_u[5] = N3In; /* Nmech */
+    compressor_u[6] = HPC_RLIn; /*Rline; */
+
+    compressor_u[7] = mdl->hpc_Alpha;
+    compressor_u[8] = mdl->hpc_s_C_Nc;
+    compressor_u[9] = mdl->hpc_s_C_Wc * (1 + GTF_hpc_WcMod * GTF_hpc_hp_En);
+    compressor_u[10] = mdl->hpc_s_C_PR * (1 + GTF_hpc_PRMod * GTF_hpc_hp_En);
+    compressor_u[11] = mdl->hpc_s_C_Eff * (1 + GTF_hpc_EffMod * GTF_hpc_hp_En);
+
+    Compressor_cached(ws, AGTF30_CACHED_HPC, &compressor_y[0], &compressor_y1[0], &compressor_y2[0], &compressor_u[0], &ws->hpc_Wcust[0], &ws->hpc_FracWbld[0], &ws->hpc, enable_debug);
+    W36 = compressor_y[0];
+    ht36 = compressor_y[1];
+    Tt36 = compressor_y[2];
+    Pt36 = compressor_y[3];
+    FAR36 = compressor_y[4];
+    Trq36 = compressor_y[5];
+    Nerr36 = compressor_y[6];
+    SMavail36 = compressor_y[7];
+    C_Nc36 = compressor_y[8];            /* Corrected shaft speed scalar */
+    C_Wc36 = compressor_y[9];             /* Corrected flow scalar */
+    C_PR36 = compressor_y[10];            /* Pressure Ratio scalar */
+    C_Eff36 = compressor_y[11];          /* Efficiency scalar */
+    Wcin36 = compressor_y[12];           /* Corrected input flow [pps] */
+    Nc36 = compressor_y[13];             /* Corrected speed [rpm]*/
+    PR36 = compressor_y[14];             /* Pressure ratio */
+    NcMap36 = compressor_y[15];          /* Map corrected speed */
+    WcMap36 = compressor_y[16];          /* Map corrected flow */
+    PRMap36 = compressor_y[17];          /* Map pressure ratio */
+    EffMap36 = compressor_y[18];         /* Map efficiency */
+    SPR36 = compressor_y[19];            /* Surge pressure ratio */
+    Wbleeds36 = compressor_y[20];        /* Bleed flow [pps]*/
+    Pwrb4bleed36 = compressor_y[21];     /* Power if there was no bleed [hp]*/
+    PwrBld36 = compressor_y[22];         /* Power loss due to bleed [hp] */
+    Pwrout36 = compressor_y[23];         /* Output power [hp]*/
+    SMMap36 = compressor_y[24];          /* Stall margin calculated from map values [%]*/
+    SPRMap36 = compressor_y[25];         /* Map stall pressure ratio*/ 
+
+    /*---- call StaticCalc to Station 36 Ps and Ts, for the full outputs only --- */
+    if (ws->eval_level >= AGTF30_EVAL_FULL) {
+        static_u[0] = W36;
+        static_u[1] = ht36;
+        static_u[2] = Tt36;
+        static_u[3] = Pt36;
+        static_u[4] = FAR36;
+        if (!cache_get(ws, AGTF30_CACHED_HPCSTATIC, static_u, 5, static_y, 5, ws->hpcstatic.IWork, 5)) {
+            StaticCalc_TMATS_body(&static_y[0], &compressor_y[0], &ws->hpcstatic, enable_debug);
+            cache_put(ws, AGTF30_CACHED_HPCSTATIC, static_u, 5, static_y, 5, ws->hpcstatic.IWork, 5);
+        }
+        Ts36 = static_y[0];
+        Ps36 = static_y[1];
+    }
+    else {
+        Ts36 = inf - inf;
+        Ps36 = inf - inf;
+    }
+
+    /*--- Burner ---*/
+    burner_u[0] = WfIn;
+    burner_u[1] = W36;
+    burner_u[2] = ht36;
+    burner_u[3] = Tt36;
+    burner_u[4] = Pt36;
+    burner_u[5] = FAR36;
+    if (!cache_get(ws, AGTF30_CACHED_BURNER, burner_u, 6, burner_y, 6, NULL, 0)) {
+        Burner_TMATS_body(&burner_y[0],&burner_u[0],&mdl->burner);
+        cache_put(ws, AGTF30_CACHED_BURNER, burner_u, 6, burner_y, 6, NULL, 0);
+    }
+    W4 = burner_y[0];
+    ht4 = burner_y[1];
+    Tt4 = burner_y[2];
+    Pt4 = burner_y[3];
+    FAR4 = burner_y[4];
+    Test4 = burner_y[5];
+
+    /*--- HPT ---*/
+    turbine_u[0] = W4;
+    turbine_u[1] = ht4;
+    turbine_u[2] = Tt4;
+    turbine_u[3] = Pt4;
+    turbine_u[4] = FAR4;
+    turbine_u[5] = N3In;
+    turbine_u[6] = HPT_PRIn;
+    turbine_u[7] = mdl->hpt.s_T_Nc;
+    turbine_u[8] = mdl->hpt.s_T_Wc * (1 + GTF_hpt_WcMod * GTF_hpt_hp_En);
+    turbine_u[9] = mdl->hpt.s_T_PR;
+    turbine_u[10] = mdl->hpt.s_T_Eff * (1 + GTF_hpt_EffMod * GTF_hpt_hp_En);
+    turbine_u[11] = mdl->hpt_cfWidth;
+    
+    turbinecool_u[0] = compressor_y2[5];
+    turbinecool_u[1] = compressor_y2[6];
+    turbinecool_u[2] = compressor_y2[7];
+    turbinecool_u[3] = compressor_y2[8];
+    turbinecool_u[4] = compressor_y2[9];
+    turbinecool_u[5] = compressor_y2[10];
+    turbinecool_u[6] = compressor_y2[11];
+    turbinecool_u[7] = compressor_y2[12];
+    turbinecool_u[8] = compressor_y2[13];
+    turbinecool_u[9] = compressor_y2[14];
+    
+    Turbine_cached(ws, AGTF30_CACHED_HPT, &turbine_y[0], &turbine_u[0], &turbinecool_u[0], &ws->hpt, enable_debug);
+
+    W45 = turbine_y[0];
+    ht45 = turbine_y[1];
+    Tt45 = turbine_y[2];
+    Pt45 = turbine_y[3];
+    FAR45 = turbine_y[4];
+    Trq45 = turbine_y[5];
+    Nerr45 = turbine_y[6];
+    s_T_Nc45 = turbine_y[7];
+    s_T_Wc45 = turbine_y[8];
+    s_T_PR45 = turbine_y[9];
+    s_T_Eff45 = turbine_y[10];
+    Wcin45 = turbine_y[11];
+    Wcs1in45 = turbine_y[12];
+    Nc45 = turbine_y[13];
+    NcMap45 = turbine_y[14];
+    WcMap45 = turbine_y[15];
+    PRMap45 = turbine_y[16];
+    EffMap45 = turbine_y[17];
+    Pwrout45 = turbine_y[18];
+    Test45 = turbine_y[19];
+
+    /*--- Duct 48 (between HPT and LPT) ---*/
+    duct_u[0] = W45;
+    duct_u[1] = ht45;
+    duct_u[2] = Tt45;
+    duct_u[3] = Pt45;
+    duct_u[4] = FAR45;
+    if (!cache_get(ws, AGTF30_CACHED_DUCT45, duct_u, 5, duct_y, 5, NULL, 0)) {
+        Duct_TMATS_body(&duct_y[0],&duct_u[0],&mdl->duct45, enable_debug);
+        cache_put(ws, AGTF30_CACHED_DUCT45, duct_u, 5, duct_y, 5, NULL, 0);
+    }
+    W48 = duct_y[0];
+    ht48 = duct_y[1];
+    Tt48 = duct_y[2];
+    Pt48 = duct_y[3];
+    FAR48 = duct_y[4];
+
+    /*--- LPT ---*/
+    turbine_u[0] = W48;
+    turbine_u[1] = ht48;
+    turbine_u[2] = Tt48;
+    turbine_u[3] = Pt48;
+    turbine_u[4] = FAR48;
+    turbine_u[5] = N2In;
+    turbine_u[6] = LPT_PRIn;
+    turbine_u[7] = mdl->lpt.s_T_Nc;
+    turbine_u[8] = mdl->lpt.s_T_Wc * (1 + GTF_lpt_WcMod * GTF_lpt_hp_En);
+    turbine_u[9] = mdl->lpt.s_T_PR;
+    turbine_u[10] = mdl->lpt.s_T_Eff * (1 + GTF_lpt_EffMod * GTF_lpt_hp_En);
+    turbine_u[11] = mdl->lpt_cfWidth;
+    
+    turbinecool_u[0] = compressor_y2[0];
+    turbinecool_u[1] = compressor_y2[1];
+    turbinecool_u[2] = compressor_y2[2];
+    turbinecool_u[3] = compressor_y2[3];
+    turbinecool_u[4] = compressor_y2[4];
+    
+    Turbine_cached(ws, AGTF30_CACHED_LPT, &turbine_y[0], &turbine_u[0], &turbinecool_u[0], &ws->lpt, enable_debug);
+
+    W5 = turbine_y[0];
+    ht5 = turbine_y[1];
+    Tt5 = turbine_y[2];
+    Pt5 = turbine_y[3];
+    FAR5 = turbine_y[4];
+    Trq5 = turbine_y[5];
+    Nerr5 = turbine_y[6];
+    s_T_Nc5 = turbine_y[7];
+    s_T_Wc5 = turbine_y[8];
+    s_T_PR5 = turbine_y[9];
+    s_T_Eff5 = turbine_y[10];
+    Wcin5 = turbine_y[11];
+    Wcs1in5 = turbine_y[12];
+    Nc5 = turbine_y[13];
+    NcMap5 = turbine_y[14];
+    WcMap5 = turbine_y[15];
+    PRMap5 = turbine_y[16];
+    EffMap5 = turbine_y[17];
+    Pwrout5 = turbine_y[18];
+    Test5 = turbine_y[19];
+
+    /*--- Duct 5 (between HPT and LPT)---*/
+    duct_u[0] = W5;
+    duct_u[1] = ht5;
+    duct_u[2] = Tt5;
+    duct_u[3] = Pt5;
+    duct_u[4] = FAR5;
+    if (!cache_get(ws, AGTF30_CACHED_DUCT5, duct_u, 5, duct_y, 5, NULL, 0)) {
+        Duct_TMATS_body(&duct_y[0],&duct_u[0],&mdl->duct5, enable_debug);
+        cache_put(ws, AGTF30_CACHED_DUCT5, duct_u, 5, duct_y, 5, NULL, 0);
+    }
+    W7 = duct_y[0];
+    ht7 = duct_y[1];
+    Tt7 = duct_y[2];
+    Pt7 = duct_y[3];
+    FAR7 = duct_y[4];
+    
+    /*--- Core Nozzle ---*/
+    nozzle_u[0] = W7;
+    nozzle_u[1] = ht7;
+    nozzle_u[2] = Tt7;
+    nozzle_u[3] = Pt7;
+    nozzle_u[4] = FAR7;
+    nozzle_u[5] = Ps0;
+    nozzle_u[6] = mdl->NozCor_N_TArea_M;
+    nozzle_u[7] = mdl->NozCor_N_EArea_M;
+    Nozzle_cached(ws, AGTF30_CACHED_NOZCOR, &nozzle_y[0], &nozzle_u[0], &ws->nozcor, enable_debug);
+    W8 = nozzle_y[0];
+    Fg8 = nozzle_y[1];
+    NErr8 = nozzle_y[2];
+    Ath8 = nozzle_y[3];
+    Ax8 = nozzle_y[4];
+    Psth8 = nozzle_y[5];
+    Tsth8 = nozzle_y[6];
+    MNth8 = nozzle_y[7];
+    Vth8 = nozzle_y[8];
+    Psx8 = nozzle_y[9];
+    Tsx8 = nozzle_y[10];
+    MNx8 = nozzle_y[11];
+    Vx8 = nozzle_y[12];
+    Woutcalc8 = nozzle_y[13];
+    choked8 = nozzle_y[14];
+    Vs8 = nozzle_y[15];
+    Nozzle_Test8 = nozzle_y[16];
+
+    /*--- LP Shaft ----*/
+    shaft_u[0] = (Trq21 / mdl->gearbox_GearRatio) + Trq24a + (Trq5 * mdl->lpshaft_Eff); /*--- Fan, LPC, LPt ---*/
+    shaft_u[1] = LPpwrIn;
+    shaft_u[2] = N2In;
+    Shaft_TMATS_body(&shaft_y[0],&shaft_u[0],&mdl->lpshaft);
+    N2mechOut = shaft_y[0];
+    N2dot = shaft_y[1];
+
+    /*--- HP Shaft ----*/
+    shaft_u[0] = Trq36 + Trq45; /*--- HPC, HPT ---*/
+    shaft_u[1] = HPpwrIn;
+    shaft_u[2] = N3In;
+    Shaft_TMATS_body(&shaft_y[0],&shaft_u[0],&mdl->hpshaft);
+    N3mechOut = shaft_y[0];
+    N3dot = shaft_y[1];
+
+    /*--- SFCCalc ---*/
+    SFCCalc_u[0] = WfIn; /*--- Wf fuel flow ---*/
+    SFCCalc_u[1] = Fg18 + Fg8; /*--- bypass and core gross thrust ---*/
+    SFCCalc_u[2] = Fdrag;
+    SFCCalc_TMATS(&SFCCalc_y[0], &SFCCalc_u[0]);
+    TSFC = SFCCalc_y[0];
+    Fnet = SFCCalc_y[1];
+
+    /* ================================================================= */
+    /*--- Assign Outputs ---*/
+    /* ================================================================= */
+    // Dependent variables
+    DEP[0] = Nerr21;
+    DEP[1] = Nerr24a;
+    DEP[2] = Nerr36;
+    DEP[3] = Nerr45;
+    DEP[4] = Nerr5;
+    DEP[5] = NErr8;
+    DEP[6] = NErr18;
+    DEP[7] = N2dot;
+    DEP[8] = N3dot;
+    DEP[9] = SMMap24a - LPC_SM_target;
+    DEP[10] = Fnet - Fnet_target;
+    DEP[11] = Tt45 - T45_target;
+
+    // States
+    X[0] = N2mechOut;
+    X[1] = N3mechOut;
+
+    // Inputs
+    U[0] = WfIn;
+    U[1] = HPpwrIn;
+    U[2] = LPpwrIn;
+
+    // Outputs
+    Y[0] = N2mechOut/mdl->gearbox_GearRatio;
+    Y[1] = N2mechOut;
+    Y[2] = N3mechOut;
+    Y[3] = W0;
+    Y[4] = Tt0;
+    Y[5] = Pt0;
+    Y[6] = W2;
+    Y[7] = Tt2;
+    Y[8] = Pt2;
+    Y[9] = W21;
+    Y[10] = Tt21;
+    Y[11] = Pt21;
+    Y[12] = W13;
+    Y[13] = Tt13;
+    Y[14] = Pt13;
+    Y[15] = W15;
+    Y[16] = Tt15;
+    Y[17] = Pt15;
+    Y[18] = W17;
+    Y[19] = Tt17;
+    Y[20] = Pt17;
+    Y[21] = W22;
+    Y[22] = Tt22;
+    Y[23] = Pt22;
+    Y[24] = W23;
+    Y[25] = Tt23;
+    Y[26] = Pt23;
+    Y[27] = W24a;
+    Y[28] = Tt24a;
+    Y[29] = Pt24a;
+    Y[30] = W24;
+    Y[31] = Tt24;
+    Y[32] = Pt24;
+    Y[33] = W25;
+    Y[34] = Tt25;
+    Y[35] = Pt25;
+    Y[36] = W36;
+    Y[37] = Tt36;
+    Y[38] = Pt36;
+    Y[39] = Ps36;
+    Y[40] = W4;
+    Y[41] = Tt4;
+    Y[42] = Pt4;
+    Y[43] = W45;
+    Y[44] = Tt45;
+    Y[45] = Pt45;
+    Y[46] = W48;
+    Y[47] = Tt48;
+    Y[48] = Pt48;
+    Y[49] = W5;
+    Y[50] = Tt5;
+    Y[51] = Pt5;
+    Y[52] = W7;
+    Y[53] = Tt7;
+    Y[54] = Pt7;
+    Y[55] = Fdrag;
+    Y[56] = Fg18 + Fg8;
+    Y[57] = Fnet;
+    Y[58] = Fg18;
+    Y[59] = Fg8;
+    Y[60] = TSFC;
+    Y[61] = SMMap21;
+    Y[62] = SMMap24a;
+    Y[63] = SMMap36;
+
+    // Diagnostic output
+    E[0] = Nc24a;
+    E[1] = Nc36;
+    E[2] = NcMap21; /*--- Fan NcMap ---*/
+    E[3] = NcMap24a; /*--- LPC NcMap ---*/
+    E[4] = NcMap36; /*--- HPC NcMap ---*/
+    E[5] = NcMap45; /*--- HPT NcMap ---*/
+    E[6] = NcMap5; /*--- LPT NcMap ---*/
+    E[7] = Trq21; /*--- Fan Torque ---*/
+    E[8] = Trq24a; /*--- LPC Torque ---*/
+    E[9] = Trq36; /*--- HPC Torque ---*/
+    E[10] = Trq45; /*--- HPT Torque ---*/
+    E[11] = Trq5; /*--- LPT Torque ---*/
+    E[12] = Ps0;
+
+    if (ws->diag.point_flags)
+        AGTF30_diag_collect(ws);
+}
+
+/* Evaluates points first..last-1 of a batch with the given workspace */
+void AGTF30_engine_eval_batch(AGTF30Workspace *ws, const AGTF30Batch *b, unsigned int first, unsigned int last)
+{
+    unsigned int j;
+
+    ws->eval_level = b->eval_level;
+
+    /*--- Derivatives requested: forward mode evaluation of each point ---*/
+    if (b->dDEP) {
+        for (j = first; j < last; j++) {
+            if (b->diag_flags) {
+                ws->diag.point_flags = &b->diag_flags[j * AGTF30_DIAG_NUM_COMPONENTS];
+                ws->diag.eval_id = j;
+            }
+            AGTF30_engine_eval_tangent(ws,
+                                       &b->env[j * b->env_stride],
+                                       &b->cmd[j * AGTF30_NUM_CMD],
+                                       &b->tar[j * b->tar_stride],
+                                       &b->health_params[j * b->health_stride],
+                                       b->blds, b->enable_debug,
+                                       &b->DEP[j * AGTF30_NUM_DEP], &b->X[j * AGTF30_NUM_X], &b->U[j * AGTF30_NUM_U],
+                                       &b->Y[j * AGTF30_NUM_Y], &b->E[j * AGTF30_NUM_E],
+                                       &b->dDEP[j * AGTF30_NUM_DEP * AGTF30_NUM_CMD],
+                                       b->dY ? &b->dY[j * AGTF30_NUM_Y * AGTF30_NUM_CMD] : NULL);
+        }
+        ws->diag.point_flags = NULL;
+        return;
+    }
+
+    /*--- The lane kernels do not report warnings, so debug runs and
+     *    diagnostics use the scalar bodies ---*/
+    if (b->use_lanes && b->enable_debug == 0 && b->diag_flags == NULL) {
+        AGTF30_engine_eval_lanes(ws, b, first, last);
+        return;
+    }
+
+    for (j = first; j < last; j++) {
+        if (b->diag_flags) {
+            ws->diag.point_flags = &b->diag_flags[j * AGTF30_DIAG_NUM_COMPONENTS];
+            ws->diag.eval_id = j;
+        }
+        AGTF30_engine_eval(ws,
+                           &b->env[j * b->env_stride],
+                           &b->cmd[j * AGTF30_NUM_CMD],
+                           &b->tar[j * b->tar_stride],
+                           &b->health_params[j * b->health_stride],
+                           b->blds, b->enable_debug,
+                           &b->DEP[j * AGTF30_NUM_DEP], &b->X[j * AGTF30_NUM_X], &b->U[j * AGTF30_NUM_U],
+                           &b->Y[j * AGTF30_NUM_Y], &b->E[j * AGTF30_NUM_E]);
+    }
+    ws->diag.point_flags = NULL;
+}
@@ -0,0 +1,428 @@
+/*		AGTF30_engine_eval_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane-parallel evaluation of a batch of AGTF30 operating points.
+%
+%  The points are taken AGTF30_LANES at a time. Flow stations are kept as
+%  structure-of-arrays (one double[AGTF30_LANES] per station quantity) and
+%  the gas path components with gas property iterations (compressors,
+%  ducts, burner, turbines, HPC static conditions) run over all lanes at
+%  once. Ambient, inlet, VBV, nozzles, shafts and the SFC calculation are
+%  evaluated lane by lane with the scalar bodies. A partly filled group
+%  repeats its last point in the unused lanes and discards their results.
+%
+%  The station chain and output assignments follow AGTF30_engine_eval.
+% *************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "constants_TMATS.h"
+#include "AGTF30_lanes.h"
+
+extern void Ambient_TMATS_body(double *y, const double *u, const AmbientStruct* prm);
+extern void Inlet_TMATS_body(double *y, const double *u, const InletStruct* prm, const double enable_debug);
+extern void Valve_TMATS_body(double* y, const double* u, const ValveStruct* prm);
+extern void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, const double enable_debug);
+extern void Shaft_TMATS_body(double *y, const double *u, const ShaftStruct* prm);
+extern void SFCCalc_TMATS(double* y, const double* u);
+
+/* Runs a scalar nozzle body on every lane of the SoA nozzle inputs */
+static void Nozzle_lanes(lane_t *y, lane_t *u, const NozzleStruct* prm)
+{
+    double nozzle_u[8];
+    double nozzle_y[17];
+    int k, l;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        for (k = 0; k < 8; k++)
+            nozzle_u[k] = u[k][l];
+        Nozzle_TMATS_body(&nozzle_y[0], &nozzle_u[0], prm, 0);
+        for (k = 0; k < 17; k++)
+            y[k][l] = nozzle_y[k];
+    }
+}
+
+/* Copies the W, ht, Tt, Pt, FAR station from the first five entries of src */
+static void copy_station(lane_t *dst, const lane_t *src)
+{
+    memcpy(dst, src, 5*sizeof(lane_t));
+}
+
+/* Evaluates the n points first..first+n-1 (1 <= n <= AGTF30_LANES) */
+static void eval_group(AGTF30Workspace *ws, const AGTF30Batch *b, unsigned int first, unsigned int n)
+{
+    const AGTF30Model *mdl = ws->mdl;
+
+    /*--- Inputs, one column per lane ---*/
+    lane_t env[AGTF30_NUM_ENV], cmd[AGTF30_NUM_CMD], tar[AGTF30_NUM_TAR], hp[AGTF30_NUM_HEALTH];
+
+    /*--- Scalar component I/O ---*/
+    double amb_u[3], amb_y[8], inlet_u[6], inlet_y[5], vbv_u[5], vbv_y[2];
+    double shaft_u[3], shaft_y[2], SFCCalc_u[3], SFCCalc_y[2];
+
+    /*--- Lane component I/O ---*/
+    lane_t compressor_u[12], fan_y[27], lpc_y[27], hpc_y[27], compressor_y1[5], compressor_y2[15];
+    lane_t splitter_u1[1], bypass_y[5], core_y[5];
+    lane_t st2[5], st23[5], st24[5], st15[5], st25[5], st17[5], st4[6], st48[5], st7[5];
+    lane_t nozzle_u[8], nozbyp_y[17], nozcor_y[17];
+    lane_t static_y[5], burner_u[6];
+    lane_t turbine_u[12], turbinecool_u[10], hpt_y[20], lpt_y[20];
+
+    /*--- Per lane values used further down the chain ---*/
+    lane_t Tt0, Pt0, Ps0, Veng, vbv_Wth;
+
+    unsigned int j;
+    double *Y, *E, *DEP;
+    double Fnet, TSFC, N2dot, N2mechOut, N3dot, N3mechOut;
+    double inf = HUGE_VAL;
+    int k, l;
+
+    /*--- Gather the inputs of each lane ---*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        j = first + (((unsigned int)l < n) ? (unsigned int)l : n - 1);
+        for (k = 0; k < AGTF30_NUM_ENV; k++)
+            env[k][l] = b->env[j * b->env_stride + k];
+        for (k = 0; k < AGTF30_NUM_CMD; k++)
+            cmd[k][l] = b->cmd[j * AGTF30_NUM_CMD + k];
+        for (k = 0; k < AGTF30_NUM_TAR; k++)
+            tar[k][l] = b->tar[j * b->tar_stride + k];
+        for (k = 0; k < AGTF30_NUM_HEALTH; k++)
+            hp[k][l] = b->health_params[j * b->health_stride + k];
+    }
+
+    /*--- The fan and HPC stall margins are only evaluated for the map diagnostics ---*/
+    ws->fan.SMSkip = (ws->eval_level < AGTF30_EVAL_DIAGNOSTICS);
+    ws->hpc.SMSkip = (ws->eval_level < AGTF30_EVAL_DIAGNOSTICS);
+
+    /*--- HPC bleeds ---*/
+    ws->hpc_Wcust[0] = b->blds[0];
+    ws->hpc_FracWbld[0] = b->blds[1];
+    ws->hpc_FracWbld[1] = b->blds[2];
+    ws->hpc_FracWbld[2] = b->blds[3];
+
+    /*--- Ambient and Inlet (scalar) ---*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        amb_u[0] = env[0][l]; /* Alt */
+        amb_u[1] = env[2][l]; /* dTamb */
+        amb_u[2] = env[1][l]; /* MN */
+        Ambient_TMATS_body(&amb_y[0], &amb_u[0], &ws->ambient);
+        Tt0[l] = amb_y[1];
+        Pt0[l] = amb_y[2];
+        Ps0[l] = amb_y[4];
+        Veng[l] = amb_y[6];
+
+        inlet_u[0] = cmd[0][l];
+        inlet_u[1] = amb_y[0];
+        inlet_u[2] = amb_y[1];
+        inlet_u[3] = amb_y[2];
+        inlet_u[4] = amb_y[3];
+        inlet_u[5] = amb_y[4];
+        Inlet_TMATS_body(&inlet_y[0], &inlet_u[0], &ws->inlet, 0);
+        for (k = 0; k < 5; k++)
+            st2[k][l] = inlet_y[k];
+    }
+
+    /*--- Fan ---*/
+    copy_station(compressor_u, st2);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        compressor_u[5][l] = cmd[10][l] / mdl->gearbox_GearRatio; /* Nmech */
+        compressor_u[6][l] = cmd[1][l]; /* Rline */
+        compressor_u[7][l] = mdl->fan_Alpha;
+        compressor_u[8][l] = mdl->fan_s_C_Nc;
+        compressor_u[9][l] = mdl->fan_s_C_Wc * (1 + hp[0][l]);
+        compressor_u[10][l] = mdl->fan_s_C_PR * (1 + hp[1][l]);
+        compressor_u[11][l] = mdl->fan_s_C_Eff * (1 + hp[2][l]);
+    }
+    Compressor_TMATS_lanes(fan_y, compressor_y1, compressor_y2, compressor_u, mdl->fan_Wcust, mdl->fan_FracWbld, &ws->fan);
+
+    /*--- Splitter ---*/
+    for (l = 0; l < AGTF30_LANES; l++)
+        splitter_u1[0][l] = cmd[4][l]; /* BPR */
+    Splitter_TMATS_lanes(bypass_y, core_y, fan_y, splitter_u1);
+
+    /*--- Duct 2 (between splitter and LPC)---*/
+    Duct_TMATS_lanes(st23, core_y, &mdl->duct2);
+
+    /*--- LPC --- */
+    copy_station(compressor_u, st23);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        compressor_u[5][l] = cmd[10][l]; /* Nmech */
+        compressor_u[6][l] = cmd[2][l];  /* Rline */
+        compressor_u[7][l] = mdl->lpc_Alpha;
+        compressor_u[8][l] = mdl->lpc_s_C_Nc;
+        compressor_u[9][l] = mdl->lpc_s_C_Wc * (1 + hp[3][l]);
+        compressor_u[10][l] = mdl->lpc_s_C_PR * (1 + hp[4][l]);
+        compressor_u[11][l] = mdl->lpc_s_C_Eff * (1 + hp[5][l]);
+    }
+    Compressor_TMATS_lanes(lpc_y, compressor_y1, compressor_y2, compressor_u, mdl->lpc_Wcust, mdl->lpc_FracWbld, &ws->lpc);
+
+    /*--- VBV (scalar) ---*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        vbv_u[0] = bypass_y[3][l];
+        vbv_u[1] = cmd[9][l];
+        vbv_u[2] = lpc_y[0][l];
+        vbv_u[3] = lpc_y[2][l];
+        vbv_u[4] = lpc_y[3][l];
+        Valve_TMATS_body(&vbv_y[0], &vbv_u[0], &ws->vbv);
+        vbv_Wth[l] = vbv_y[0];
+    }
+    copy_station(st24, lpc_y);
+    copy_station(st15, bypass_y);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        st24[0][l] = lpc_y[0][l] - vbv_Wth[l];      /*--- core flow aft of VBV ---*/
+        st15[0][l] = bypass_y[0][l] + vbv_Wth[l];   /*--- bypass flow aft of VBV ---*/
+    }
+
+    /*--- Duct 25 (aft of LPC and VBV) and Duct 17 (in bypass) ---*/
+    Duct_TMATS_lanes(st25, st24, &mdl->duct25);
+    Duct_TMATS_lanes(st17, st15, &mdl->duct17);
+
+    /*--- Bypass Nozzle ---*/
+    copy_station(nozzle_u, st17);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        nozzle_u[5][l] = Ps0[l];
+        if (mdl->nozbyp.IDes < 1.5) {
+            nozzle_u[6][l] = mdl->NozByp_N_TArea_M;
+            nozzle_u[7][l] = mdl->NozByp_N_EArea_M;
+        }
+        else {
+            nozzle_u[6][l] = cmd[8][l];
+            nozzle_u[7][l] = cmd[8][l];
+        }
+    }
+    Nozzle_lanes(nozbyp_y, nozzle_u, &ws->nozbyp);
+
+    /*--- HPC --- */
+    copy_station(compressor_u, st25);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        compressor_u[5][l] = cmd[11][l]; /* Nmech */
+        compressor_u[6][l] = cmd[3][l];  /* Rline */
+        compressor_u[7][l] = mdl->hpc_Alpha;
+        compressor_u[8][l] = mdl->hpc_s_C_Nc;
+        compressor_u[9][l] = mdl->hpc_s_C_Wc * (1 + hp[6][l]);
+        compressor_u[10][l] = mdl->hpc_s_C_PR * (1 + hp[7][l]);
+        compressor_u[11][l] = mdl->hpc_s_C_Eff * (1 + hp[8][l]);
+    }
+    Compressor_TMATS_lanes(hpc_y, compressor_y1, compressor_y2, compressor_u, &ws->hpc_Wcust[0], &ws->hpc_FracWbld[0], &ws->hpc);
+
+    /*---- call StaticCalc to Station 36 Ps and Ts, for the full outputs only --- */
+    if (ws->eval_level >= AGTF30_EVAL_FULL) {
+        StaticCalc_TMATS_lanes(static_y, hpc_y, &ws->hpcstatic);
+    }
+    else {
+        for (l = 0; l < AGTF30_LANES; l++)
+            static_y[1][l] = inf - inf;
+    }
+
+    /*--- Burner ---*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        burner_u[0][l] = cmd[7][l];
+        for (k = 0; k < 5; k++)
+            burner_u[k+1][l] = hpc_y[k][l];
+    }
+    Burner_TMATS_lanes(st4, burner_u, &mdl->burner);
+
+    /*--- HPT ---*/
+    copy_station(turbine_u, st4);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        turbine_u[5][l] = cmd[11][l];
+        turbine_u[6][l] = cmd[5][l];
+        turbine_u[7][l] = mdl->hpt.s_T_Nc;
+        turbine_u[8][l] = mdl->hpt.s_T_Wc * (1 + hp[9][l]);
+        turbine_u[9][l] = mdl->hpt.s_T_PR;
+        turbine_u[10][l] = mdl->hpt.s_T_Eff * (1 + hp[10][l]);
+        turbine_u[11][l] = mdl->hpt_cfWidth;
+    }
+    memcpy(turbinecool_u, &compressor_y2[5], 10*sizeof(lane_t));
+    Turbine_TMATS_lanes(hpt_y, turbine_u, turbinecool_u, &ws->hpt);
+
+    /*--- Duct 48 (between HPT and LPT) ---*/
+    Duct_TMATS_lanes(st48, hpt_y, &mdl->duct45);
+
+    /*--- LPT ---*/
+    copy_station(turbine_u, st48);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        turbine_u[5][l] = cmd[10][l];
+        turbine_u[6][l] = cmd[6][l];
+        turbine_u[7][l] = mdl->lpt.s_T_Nc;
+        turbine_u[8][l] = mdl->lpt.s_T_Wc * (1 + hp[11][l]);
+        turbine_u[9][l] = mdl->lpt.s_T_PR;
+        turbine_u[10][l] = mdl->lpt.s_T_Eff * (1 + hp[12][l]);
+        turbine_u[11][l] = mdl->lpt_cfWidth;
+    }
+    memcpy(turbinecool_u, &compressor_y2[0], 5*sizeof(lane_t));
+    Turbine_TMATS_lanes(lpt_y, turbine_u, turbinecool_u, &ws->lpt);
+
+    /*--- Duct 5 (between HPT and LPT)---*/
+    Duct_TMATS_lanes(st7, lpt_y, &mdl->duct5);
+
+    /*--- Core Nozzle ---*/
+    copy_station(nozzle_u, st7);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        nozzle_u[5][l] = Ps0[l];
+        nozzle_u[6][l] = mdl->NozCor_N_TArea_M;
+        nozzle_u[7][l] = mdl->NozCor_N_EArea_M;
+    }
+    Nozzle_lanes(nozcor_y, nozzle_u, &ws->nozcor);
+
+    /*--- Shafts, SFC and outputs of each used lane ---*/
+    for (l = 0; l < (int)n; l++) {
+        j = first + (unsigned int)l;
+
+        /*--- LP Shaft ----*/
+        shaft_u[0] = (fan_y[5][l] / mdl->gearbox_GearRatio) + lpc_y[5][l] + (lpt_y[5][l] * mdl->lpshaft_Eff); /*--- Fan, LPC, LPt ---*/
+        shaft_u[1] = cmd[13][l];
+        shaft_u[2] = cmd[10][l];
+        Shaft_TMATS_body(&shaft_y[0],&shaft_u[0],&mdl->lpshaft);
+        N2mechOut = shaft_y[0];
+        N2dot = shaft_y[1];
+
+        /*--- HP Shaft ----*/
+        shaft_u[0] = hpc_y[5][l] + hpt_y[5][l]; /*--- HPC, HPT ---*/
+        shaft_u[1] = cmd[12][l];
+        shaft_u[2] = cmd[11][l];
+        Shaft_TMATS_body(&shaft_y[0],&shaft_u[0],&mdl->hpshaft);
+        N3mechOut = shaft_y[0];
+        N3dot = shaft_y[1];
+
+        /*--- SFCCalc ---*/
+        SFCCalc_u[0] = cmd[7][l]; /*--- Wf fuel flow ---*/
+        SFCCalc_u[1] = nozbyp_y[1][l] + nozcor_y[1][l]; /*--- bypass and core gross thrust ---*/
+        SFCCalc_u[2] = cmd[0][l] * Veng[l] / C_GRAVITY; /*--- Fdrag ---*/
+        SFCCalc_TMATS(&SFCCalc_y[0], &SFCCalc_u[0]);
+        TSFC = SFCCalc_y[0];
+        Fnet = SFCCalc_y[1];
+
+        /*--- Dependent variables ---*/
+        DEP = &b->DEP[j * AGTF30_NUM_DEP];
+        DEP[0] = fan_y[6][l];
+        DEP[1] = lpc_y[6][l];
+        DEP[2] = hpc_y[6][l];
+        DEP[3] = hpt_y[6][l];
+        DEP[4] = lpt_y[6][l];
+        DEP[5] = nozcor_y[2][l];
+        DEP[6] = nozbyp_y[2][l];
+        DEP[7] = N2dot;
+        DEP[8] = N3dot;
+        DEP[9] = lpc_y[24][l] - tar[0][l];
+        DEP[10] = Fnet - tar[1][l];
+        DEP[11] = hpt_y[2][l] - tar[2][l];
+
+        /*--- States ---*/
+        b->X[j * AGTF30_NUM_X + 0] = N2mechOut;
+        b->X[j * AGTF30_NUM_X + 1] = N3mechOut;
+
+        /*--- Inputs ---*/
+        b->U[j * AGTF30_NUM_U + 0] = cmd[7][l];
+        b->U[j * AGTF30_NUM_U + 1] = cmd[12][l];
+        b->U[j * AGTF30_NUM_U + 2] = cmd[13][l];
+
+        /*--- Outputs ---*/
+        Y = &b->Y[j * AGTF30_NUM_Y];
+        Y[0] = N2mechOut/mdl->gearbox_GearRatio;
+        Y[1] = N2mechOut;
+        Y[2] = N3mechOut;
+        Y[3] = cmd[0][l];
+        Y[4] = Tt0[l];
+        Y[5] = Pt0[l];
+        Y[6] = st2[0][l];
+        Y[7] = st2[2][l];
+        Y[8] = st2[3][l];
+        Y[9] = fan_y[0][l];
+        Y[10] = fan_y[2][l];
+        Y[11] = fan_y[3][l];
+        Y[12] = bypass_y[0][l];
+        Y[13] = bypass_y[2][l];
+        Y[14] = bypass_y[3][l];
+        Y[15] = st15[0][l];
+        Y[16] = st15[2][l];
+        Y[17] = st15[3][l];
+        Y[18] = st17[0][l];
+        Y[19] = st17[2][l];
+        Y[20] = st17[3][l];
+        Y[21] = core_y[0][l];
+        Y[22] = core_y[2][l];
+        Y[23] = core_y[3][l];
+        Y[24] = st23[0][l];
+        Y[25] = st23[2][l];
+        Y[26] = st23[3][l];
+        Y[27] = lpc_y[0][l];
+        Y[28] = lpc_y[2][l];
+        Y[29] = lpc_y[3][l];
+        Y[30] = st24[0][l];
+        Y[31] = st24[2][l];
+        Y[32] = st24[3][l];
+        Y[33] = st25[0][l];
+        Y[34] = st25[2][l];
+        Y[35] = st25[3][l];
+        Y[36] = hpc_y[0][l];
+        Y[37] = hpc_y[2][l];
+        Y[38] = hpc_y[3][l];
+        Y[39] = static_y[1][l];
+        Y[40] = st4[0][l];
+        Y[41] = st4[2][l];
+        Y[42] = st4[3][l];
+        Y[43] = hpt_y[0][l];
+        Y[44] = hpt_y[2][l];
+        Y[45] = hpt_y[3][l];
+        Y[46] = st48[0][l];
+        Y[47] = st48[2][l];
+        Y[48] = st48[3][l];
+        Y[49] = lpt_y[0][l];
+        Y[50] = lpt_y[2][l];
+        Y[51] = lpt_y[3][l];
+        Y[52] = st7[0][l];
+        Y[53] = st7[2][l];
+        Y[54] = st7[3][l];
+        Y[55] = SFCCalc_u[2];
+        Y[56] = SFCCalc_u[1];
+        Y[57] = Fnet;
+        Y[58] = nozbyp_y[1][l];
+        Y[59] = nozcor_y[1][l];
+        Y[60] = TSFC;
+        Y[61] = fan_y[24][l];
+        Y[62] = lpc_y[24][l];
+        Y[63] = hpc_y[24][l];
+
+        /*--- Diagnostic output ---*/
+        E = &b->E[j * AGTF30_NUM_E];
+        E[0] = lpc_y[13][l];
+        E[1] = hpc_y[13][l];
+        E[2] = fan_y[15][l];
+        E[3] = lpc_y[15][l];
+        E[4] = hpc_y[15][l];
+        E[5] = hpt_y[14][l];
+        E[6] = lpt_y[14][l];
+        E[7] = fan_y[5][l];
+        E[8] = lpc_y[5][l];
+        E[9] = hpc_y[5][l];
+        E[10] = hpt_y[5][l];
+        E[11] = lpt_y[5][l];
+        E[12] = Ps0[l];
+    }
+}
+
+/* Evaluates points first..last-1 of a batch with the lane kernels, using the
+ * workspace for the components that are evaluated lane by lane */
+void AGTF30_engine_eval_lanes(AGTF30Workspace *ws, const AGTF30Batch *b, unsigned int first, unsigned int last)
+{
+    unsigned int j, n;
+
+    for (j = first; j < last; j += n) {
+        n = last - j;
+        if (n > AGTF30_LANES)
+            n = AGTF30_LANES;
+        if (n > 1) {
+            eval_group(ws, b, j, n);
+        }
+        else {
+            /*--- A single point gains nothing from the lanes ---*/
+            AGTF30_engine_eval(ws, &b->env[j * b->env_stride], &b->cmd[j * AGTF30_NUM_CMD],
+                               &b->tar[j * b->tar_stride], &b->health_params[j * b->health_stride],
+                               b->blds, b->enable_debug,
+                               &b->DEP[j * AGTF30_NUM_DEP], &b->X[j * AGTF30_NUM_X], &b->U[j * AGTF30_NUM_U],
+                               &b->Y[j * AGTF30_NUM_Y], &b->E[j * AGTF30_NUM_E]);
+        }
+    }
+}
@@ -0,0 +1,479 @@
+#include <math.h>
+#include <string.h>
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_model.h"
+#include "AGTF30_tangent.h"
+
+/*		AGTF30_engine_eval_tangent.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  AGTF30_engine_eval with forward mode derivatives. The components are
+%  called in the same order and with the same inputs as in
+%  AGTF30_engine_eval, so DEP, X, U, Y and E are bit for bit those of
+%  AGTF30_engine_eval. Each component body is followed by its tangent
+%  routine, seeded with one direction per command.
+%
+%  dDEP (AGTF30_NUM_DEP x AGTF30_NUM_CMD, column major) receives dDEP/dCMD
+%  and dY (AGTF30_NUM_Y x AGTF30_NUM_CMD, column major) dY/dCMD; dY may be
+%  NULL. The outputs are always evaluated in full, whatever eval_level.
+% *************************************************************************/
+
+extern void Ambient_TMATS_body(double *y, const double *u, const AmbientStruct* prm);
+extern void Inlet_TMATS_body(double *y, const double *u, const InletStruct* prm, const double enable_debug);
+extern void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, const double* Wcust, const double* FracWbld, const CompressorStruct* prm, const double enable_debug);
+extern void Splitter_TMATS(double* y, double* y1, const double* u, const double* u1);
+extern void Valve_TMATS_body(double* y, const double* u, const ValveStruct* prm);
+extern void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, const double enable_debug);
+extern void StaticCalc_TMATS_body(double *y1, const double *u1, const StaticCalcStruct* prm, const double enable_debug);
+extern void Burner_TMATS_body(double* y, const double* u, const BurnStruct* prm);
+extern void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, const TurbineStruct* prm, const double enable_debug);
+extern void Shaft_TMATS_body(double *y, const double *u, const ShaftStruct* prm);
+extern void SFCCalc_TMATS(double* y, const double* u);
+
+/* Stores value v and its tangent dv as entry i of an output vector with n entries */
+static void set_out(double *v_out, double *dv_out, int n, int i, double v, const double *dv)
+{
+    int k;
+
+    v_out[i] = v;
+    if (dv_out != NULL) {
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dv_out[i + n*k] = dv[k];
+    }
+}
+
+/* Shaft_TMATS_body tangent: Ndot = (Trq + C*Pwr*divby(N))*60*divby(2*pi*Inertia) */
+static void shaft_tangent(double *dNdot, const double *u, const double *dTrq, const double *dPwr,
+                          const double *dN, const ShaftStruct* prm)
+{
+    double c = 60 * divby(2 * 3.14159265358979 * prm->Inertia_M);
+    int k;
+
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dNdot[k] = (dTrq[k] + C_HP_PER_RPMtoFT_LBF*(dPwr[k]*divby(u[2]) + u[1]*divby_d(u[2])*dN[k])) * c;
+}
+
+void AGTF30_engine_eval_tangent(AGTF30Workspace *ws, const double *env, const double *cmd, const double *tar,
+                                const double *health_params, const double *blds, const double enable_debug,
+                                double *DEP, double *X, double *U, double *Y, double *E,
+                                double *dDEP, double *dY)
+{
+    const AGTF30Model *mdl = ws->mdl;
+
+    /*--- Block inputs and outputs, as in AGTF30_engine_eval ---*/
+    double amb_u[3], amb_y[8];
+    double inlet_u[6], inlet_y[5];
+    double compressor_u[12], fan_y[27], lpc_y[27], hpc_y[27], compressor_y1[5], compressor_y2[15], hpc_y2[15];
+    double splitter_u1[1], byp_y[5], core_y[5];
+    double duct2_y[5], duct25_y[5], duct17_y[5], duct45_y[5], duct5_y[5];
+    double vbv_u[5], vbv_y[2];
+    double st24[5], st15[5];
+    double nozzle_u[8], nozbyp_y[17], nozcor_y[17];
+    double static_y[5];
+    double burner_u[6], burner_y[6];
+    double turbine_u[12], turbinecool_u[10], hpt_y[20], lpt_y[20];
+    double shaft_u[3], lpshaft_y[2], hpshaft_y[2];
+    double SFCCalc_u[3], SFCCalc_y[2];
+    double Veng, Fdrag, Fnet, TSFC;
+
+    /*--- Tangents ---*/
+    tan_t dcmd[AGTF30_NUM_CMD], zero;
+    tan_t dinlet_y[5], dcompressor_u[7], dfan_y[27], dlpc_y[27], dhpc_y[27];
+    tan_t dcompressor_y1[5], dcompressor_y2[15], dhpc_y2[15];
+    tan_t dsplitter_u1[1], dbyp_y[5], dcore_y[5];
+    tan_t dduct2_y[5], dduct25_y[5], dduct17_y[5], dduct45_y[5], dduct5_y[5];
+    tan_t dvbv_u[5], dvbv_y[2], dst24[5], dst15[5];
+    tan_t dnozzle_u[8], dnozbyp_y[17], dnozcor_y[17];
+    tan_t dstatic_y[5], dburner_u[6], dburner_y[6];
+    tan_t dturbine_u[7], dturbinecool_u[10], dhpt_y[20], dlpt_y[20];
+    tan_t dTrq, dN2dot, dN3dot, dFdrag, dFg, dFnet, dTSFC, dtmp;
+    int i, k;
+
+    /*--- Error flags are cleared on every evaluation, as in AGTF30_engine_eval ---*/
+    memset(ws->ambient_IWork, 0, sizeof(ws->ambient_IWork));
+    memset(ws->inlet_IWork, 0, sizeof(ws->inlet_IWork));
+    memset(ws->fan_IWork, 0, sizeof(ws->fan_IWork));
+    memset(ws->lpc_IWork, 0, sizeof(ws->lpc_IWork));
+    memset(ws->vbv_IWork, 0, sizeof(ws->vbv_IWork));
+    memset(ws->nozbyp_IWork, 0, sizeof(ws->nozbyp_IWork));
+    memset(ws->hpc_IWork, 0, sizeof(ws->hpc_IWork));
+    memset(ws->hpcstatic_IWork, 0, sizeof(ws->hpcstatic_IWork));
+    memset(ws->hpt_IWork, 0, sizeof(ws->hpt_IWork));
+    memset(ws->lpt_IWork, 0, sizeof(ws->lpt_IWork));
+    memset(ws->nozcor_IWork, 0, sizeof(ws->nozcor_IWork));
+
+    /*--- Full outputs, with the stall margins ---*/
+    ws->fan.SMSkip = 0;
+    ws->hpc.SMSkip = 0;
+
+    /*--- HPC bleeds ---*/
+    ws->hpc_Wcust[0] = blds[0];
+    ws->hpc_FracWbld[0] = blds[1];
+    ws->hpc_FracWbld[1] = blds[2];
+    ws->hpc_FracWbld[2] = blds[3];
+
+    /*--- Seed one direction per command ---*/
+    tan_zero(zero);
+    for (i = 0; i < AGTF30_NUM_CMD; i++) {
+        tan_zero(dcmd[i]);
+        dcmd[i][i] = 1;
+    }
+
+    /*--- Ambient (no command dependence) ---*/
+    amb_u[0] = env[0];
+    amb_u[1] = env[2];
+    amb_u[2] = env[1];
+    Ambient_TMATS_body(&amb_y[0], &amb_u[0], &ws->ambient);
+    Veng = amb_y[6];
+    Fdrag = cmd[0] * Veng / C_GRAVITY;
+    tan_scale(dFdrag, Veng / C_GRAVITY, dcmd[0]);
+
+    /*--- Inlet: only the flow carries a tangent ---*/
+    inlet_u[0] = cmd[0];
+    inlet_u[1] = amb_y[0];
+    inlet_u[2] = amb_y[1];
+    inlet_u[3] = amb_y[2];
+    inlet_u[4] = amb_y[3];
+    inlet_u[5] = amb_y[4];
+    Inlet_TMATS_body(&inlet_y[0], &inlet_u[0], &ws->inlet, enable_debug);
+    tan_copy(dinlet_y[0], dcmd[0]);
+    for (i = 1; i < 5; i++)
+        tan_zero(dinlet_y[i]);
+
+    /*--- Fan ---*/
+    for (i = 0; i < 5; i++) {
+        compressor_u[i] = inlet_y[i];
+        tan_copy(dcompressor_u[i], dinlet_y[i]);
+    }
+    compressor_u[5] = cmd[10] / mdl->gearbox_GearRatio;
+    tan_scale(dcompressor_u[5], 1 / mdl->gearbox_GearRatio, dcmd[10]);
+    compressor_u[6] = cmd[1];
+    tan_copy(dcompressor_u[6], dcmd[1]);
+    compressor_u[7] = mdl->fan_Alpha;
+    compressor_u[8] = mdl->fan_s_C_Nc;
+    compressor_u[9] = mdl->fan_s_C_Wc * (1 + health_params[0]);
+    compressor_u[10] = mdl->fan_s_C_PR * (1 + health_params[1]);
+    compressor_u[11] = mdl->fan_s_C_Eff * (1 + health_params[2]);
+    Compressor_TMATS_body(&fan_y[0], &compressor_y1[0], &compressor_y2[0], &compressor_u[0], mdl->fan_Wcust, mdl->fan_FracWbld, &ws->fan, enable_debug);
+    Compressor_TMATS_tangent(dfan_y, dcompressor_y1, dcompressor_y2, fan_y, compressor_y1, compressor_y2, compressor_u,
+                             dcompressor_u, mdl->fan_Wcust, mdl->fan_FracWbld, &ws->fan);
+
+    /*--- Splitter ---*/
+    splitter_u1[0] = cmd[4];
+    tan_copy(dsplitter_u1[0], dcmd[4]);
+    Splitter_TMATS(&byp_y[0], &core_y[0], &fan_y[0], &splitter_u1[0]);
+    Splitter_TMATS_tangent(dbyp_y, dcore_y, fan_y, dfan_y, splitter_u1, dsplitter_u1);
+
+    /*--- Duct 2 (between splitter and LPC) ---*/
+    Duct_TMATS_tangent(&duct2_y[0], dduct2_y, core_y, dcore_y, &mdl->duct2, enable_debug);
+
+    /*--- LPC ---*/
+    for (i = 0; i < 5; i++) {
+        compressor_u[i] = duct2_y[i];
+        tan_copy(dcompressor_u[i], dduct2_y[i]);
+    }
+    compressor_u[5] = cmd[10];
+    tan_copy(dcompressor_u[5], dcmd[10]);
+    compressor_u[6] = cmd[2];
+    tan_copy(dcompressor_u[6], dcmd[2]);
+    compressor_u[7] = mdl->lpc_Alpha;
+    compressor_u[8] = mdl->lpc_s_C_Nc;
+    compressor_u[9] = mdl->lpc_s_C_Wc * (1 + health_params[3]);
+    compressor_u[10] = mdl->lpc_s_C_PR * (1 + health_params[4]);
+    compressor_u[11] = mdl->lpc_s_C_Eff * (1 + health_params[5]);
+    Compressor_TMATS_body(&lpc_y[0], &compressor_y1[0], &compressor_y2[0], &compressor_u[0], mdl->lpc_Wcust, mdl->lpc_FracWbld, &ws->lpc, enable_debug);
+    Compressor_TMATS_tangent(dlpc_y, dcompressor_y1, dcompressor_y2, lpc_y, compressor_y1, compressor_y2, compressor_u,
+                             dcompressor_u, mdl->lpc_Wcust, mdl->lpc_FracWbld, &ws->lpc);
+
+    /*--- VBV ---*/
+    vbv_u[0] = byp_y[3];
+    vbv_u[1] = cmd[9];
+    vbv_u[2] = lpc_y[0];
+    vbv_u[3] = lpc_y[2];
+    vbv_u[4] = lpc_y[3];
+    tan_copy(dvbv_u[0], dbyp_y[3]);
+    tan_copy(dvbv_u[1], dcmd[9]);
+    tan_copy(dvbv_u[2], dlpc_y[0]);
+    tan_copy(dvbv_u[3], dlpc_y[2]);
+    tan_copy(dvbv_u[4], dlpc_y[3]);
+    Valve_TMATS_body(&vbv_y[0], &vbv_u[0], &ws->vbv);
+    Valve_TMATS_tangent(dvbv_y, vbv_y, vbv_u, dvbv_u, &ws->vbv);
+
+    for (i = 0; i < 5; i++) {
+        st24[i] = lpc_y[i];
+        st15[i] = byp_y[i];
+        tan_copy(dst24[i], dlpc_y[i]);
+        tan_copy(dst15[i], dbyp_y[i]);
+    }
+    st24[0] = lpc_y[0] - vbv_y[0]; /*--- core flow aft of VBV ---*/
+    st15[0] = byp_y[0] + vbv_y[0]; /*--- bypass flow aft of VBV ---*/
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dst24[0][k] = dlpc_y[0][k] - dvbv_y[0][k];
+        dst15[0][k] = dbyp_y[0][k] + dvbv_y[0][k];
+    }
+
+    /*--- Duct 25 (aft of LPC and VBV) and Duct 17 (in bypass) ---*/
+    Duct_TMATS_tangent(&duct25_y[0], dduct25_y, st24, dst24, &mdl->duct25, enable_debug);
+    Duct_TMATS_tangent(&duct17_y[0], dduct17_y, st15, dst15, &mdl->duct17, enable_debug);
+
+    /*--- Bypass Nozzle ---*/
+    for (i = 0; i < 5; i++) {
+        nozzle_u[i] = duct17_y[i];
+        tan_copy(dnozzle_u[i], dduct17_y[i]);
+    }
+    nozzle_u[5] = amb_y[4];
+    tan_zero(dnozzle_u[5]);
+    if (mdl->nozbyp.IDes < 1.5)
+    {
+        nozzle_u[6] = mdl->NozByp_N_TArea_M;
+        nozzle_u[7] = mdl->NozByp_N_EArea_M;
+        tan_zero(dnozzle_u[6]);
+        tan_zero(dnozzle_u[7]);
+    }
+    else
+    {
+        nozzle_u[6] = cmd[8];
+        nozzle_u[7] = cmd[8];
+        tan_copy(dnozzle_u[6], dcmd[8]);
+        tan_copy(dnozzle_u[7], dcmd[8]);
+    }
+    Nozzle_TMATS_body(&nozbyp_y[0], &nozzle_u[0], &ws->nozbyp, enable_debug);
+    Nozzle_TMATS_tangent(dnozbyp_y, nozbyp_y, nozzle_u, dnozzle_u, &ws->nozbyp);
+
+    /*--- HPC ---*/
+    for (i = 0; i < 5; i++) {
+        compressor_u[i] = duct25_y[i];
+        tan_copy(dcompressor_u[i], dduct25_y[i]);
+    }
+    compressor_u[5] = cmd[11];
+    tan_copy(dcompressor_u[5], dcmd[11]);
+    compressor_u[6] = cmd[3];
+    tan_copy(dcompressor_u[6], dcmd[3]);
+    compressor_u[7] = mdl->hpc_Alpha;
+    compressor_u[8] = mdl->hpc_s_C_Nc;
+    compressor_u[9] = mdl->hpc_s_C_Wc * (1 + health_params[6]);
+    compressor_u[10] = mdl->hpc_s_C_PR * (1 + health_params[7]);
+    compressor_u[11] = mdl->hpc_s_C_Eff * (1 + health_params[8]);
+    Compressor_TMATS_body(&hpc_y[0], &compressor_y1[0], &hpc_y2[0], &compressor_u[0], &ws->hpc_Wcust[0], &ws->hpc_FracWbld[0], &ws->hpc, enable_debug);
+    Compressor_TMATS_tangent(dhpc_y, dcompressor_y1, dhpc_y2, hpc_y, compressor_y1, hpc_y2, compressor_u,
+                             dcompressor_u, &ws->hpc_Wcust[0], &ws->hpc_FracWbld[0], &ws->hpc);
+
+    /*---- StaticCalc for Station 36 Ps and Ts --- */
+    StaticCalc_TMATS_body(&static_y[0], &hpc_y[0], &ws->hpcstatic, enable_debug);
+    StaticCalc_TMATS_tangent(dstatic_y, static_y, hpc_y, dhpc_y, &ws->hpcstatic);
+
+    /*--- Burner ---*/
+    burner_u[0] = cmd[7];
+    tan_copy(dburner_u[0], dcmd[7]);
+    for (i = 0; i < 5; i++) {
+        burner_u[i+1] = hpc_y[i];
+        tan_copy(dburner_u[i+1], dhpc_y[i]);
+    }
+    Burner_TMATS_body(&burner_y[0],&burner_u[0],&mdl->burner);
+    Burner_TMATS_tangent(dburner_y, burner_y, burner_u, dburner_u, &mdl->burner);
+
+    /*--- HPT ---*/
+    for (i = 0; i < 5; i++) {
+        turbine_u[i] = burner_y[i];
+        tan_copy(dturbine_u[i], dburner_y[i]);
+    }
+    turbine_u[5] = cmd[11];
+    tan_copy(dturbine_u[5], dcmd[11]);
+    turbine_u[6] = cmd[5];
+    tan_copy(dturbine_u[6], dcmd[5]);
+    turbine_u[7] = mdl->hpt.s_T_Nc;
+    turbine_u[8] = mdl->hpt.s_T_Wc * (1 + health_params[9]);
+    turbine_u[9] = mdl->hpt.s_T_PR;
+    turbine_u[10] = mdl->hpt.s_T_Eff * (1 + health_params[10]);
+    turbine_u[11] = mdl->hpt_cfWidth;
+    for (i = 0; i < 10; i++) {
+        turbinecool_u[i] = hpc_y2[5 + i];
+        tan_copy(dturbinecool_u[i], dhpc_y2[5 + i]);
+    }
+    Turbine_TMATS_body(&hpt_y[0], &turbine_u[0], &turbinecool_u[0], &ws->hpt, enable_debug);
+    Turbine_TMATS_tangent(dhpt_y, hpt_y, turbine_u, dturbine_u, turbinecool_u, dturbinecool_u, &ws->hpt);
+
+    /*--- Duct 48 (between HPT and LPT) ---*/
+    Duct_TMATS_tangent(&duct45_y[0], dduct45_y, hpt_y, dhpt_y, &mdl->duct45, enable_debug);
+
+    /*--- LPT ---*/
+    for (i = 0; i < 5; i++) {
+        turbine_u[i] = duct45_y[i];
+        tan_copy(dturbine_u[i], dduct45_y[i]);
+    }
+    turbine_u[5] = cmd[10];
+    tan_copy(dturbine_u[5], dcmd[10]);
+    turbine_u[6] = cmd[6];
+    tan_copy(dturbine_u[6], dcmd[6]);
+    turbine_u[7] = mdl->lpt.s_T_Nc;
+    turbine_u[8] = mdl->lpt.s_T_Wc * (1 + health_params[11]);
+    turbine_u[9] = mdl->lpt.s_T_PR;
+    turbine_u[10] = mdl->lpt.s_T_Eff * (1 + health_params[12]);
+    turbine_u[11] = mdl->lpt_cfWidth;
+    for (i = 0; i < 5; i++) {
+        turbinecool_u[i] = hpc_y2[i];
+        tan_copy(dturbinecool_u[i], dhpc_y2[i]);
+    }
+    Turbine_TMATS_body(&lpt_y[0], &turbine_u[0], &turbinecool_u[0], &ws->lpt, enable_debug);
+    Turbine_TMATS_tangent(dlpt_y, lpt_y, turbine_u, dturbine_u, turbinecool_u, dturbinecool_u, &ws->lpt);
+
+    /*--- Duct 5 ---*/
+    Duct_TMATS_tangent(&duct5_y[0], dduct5_y, lpt_y, dlpt_y, &mdl->duct5, enable_debug);
+
+    /*--- Core Nozzle ---*/
+    for (i = 0; i < 5; i++) {
+        nozzle_u[i] = duct5_y[i];
+        tan_copy(dnozzle_u[i], dduct5_y[i]);
+    }
+    nozzle_u[5] = amb_y[4];
+    nozzle_u[6] = mdl->NozCor_N_TArea_M;
+    nozzle_u[7] = mdl->NozCor_N_EArea_M;
+    tan_zero(dnozzle_u[5]);
+    tan_zero(dnozzle_u[6]);
+    tan_zero(dnozzle_u[7]);
+    Nozzle_TMATS_body(&nozcor_y[0], &nozzle_u[0], &ws->nozcor, enable_debug);
+    Nozzle_TMATS_tangent(dnozcor_y, nozcor_y, nozzle_u, dnozzle_u, &ws->nozcor);
+
+    /*--- LP Shaft ----*/
+    shaft_u[0] = (fan_y[5] / mdl->gearbox_GearRatio) + lpc_y[5] + (lpt_y[5] * mdl->lpshaft_Eff); /*--- Fan, LPC, LPt ---*/
+    shaft_u[1] = cmd[13];
+    shaft_u[2] = cmd[10];
+    tan_lin3(dTrq, 1 / mdl->gearbox_GearRatio, dfan_y[5], 1, dlpc_y[5], mdl->lpshaft_Eff, dlpt_y[5]);
+    Shaft_TMATS_body(&lpshaft_y[0],&shaft_u[0],&mdl->lpshaft);
+    shaft_tangent(dN2dot, shaft_u, dTrq, dcmd[13], dcmd[10], &mdl->lpshaft);
+
+    /*--- HP Shaft ----*/
+    shaft_u[0] = hpc_y[5] + hpt_y[5]; /*--- HPC, HPT ---*/
+    shaft_u[1] = cmd[12];
+    shaft_u[2] = cmd[11];
+    tan_lin2(dTrq, 1, dhpc_y[5], 1, dhpt_y[5]);
+    Shaft_TMATS_body(&hpshaft_y[0],&shaft_u[0],&mdl->hpshaft);
+    shaft_tangent(dN3dot, shaft_u, dTrq, dcmd[12], dcmd[11], &mdl->hpshaft);
+
+    /*--- SFCCalc ---*/
+    SFCCalc_u[0] = cmd[7];
+    SFCCalc_u[1] = nozbyp_y[1] + nozcor_y[1];
+    SFCCalc_u[2] = Fdrag;
+    SFCCalc_TMATS(&SFCCalc_y[0], &SFCCalc_u[0]);
+    TSFC = SFCCalc_y[0];
+    Fnet = SFCCalc_y[1];
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dFg[k] = dnozbyp_y[1][k] + dnozcor_y[1][k];
+        dFnet[k] = dFg[k] - dFdrag[k];
+    }
+    tan_lin2(dTSFC, 3600.0*divby(Fnet), dcmd[7], cmd[7]*3600.0*divby_d(Fnet), dFnet);
+
+    /* ================================================================= */
+    /*--- Assign Outputs ---*/
+    /* ================================================================= */
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 0, fan_y[6], dfan_y[6]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 1, lpc_y[6], dlpc_y[6]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 2, hpc_y[6], dhpc_y[6]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 3, hpt_y[6], dhpt_y[6]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 4, lpt_y[6], dlpt_y[6]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 5, nozcor_y[2], dnozcor_y[2]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 6, nozbyp_y[2], dnozbyp_y[2]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 7, lpshaft_y[1], dN2dot);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 8, hpshaft_y[1], dN3dot);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 9, lpc_y[24] - tar[0], dlpc_y[24]);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 10, Fnet - tar[1], dFnet);
+    set_out(DEP, dDEP, AGTF30_NUM_DEP, 11, hpt_y[2] - tar[2], dhpt_y[2]);
+
+    // States
+    X[0] = lpshaft_y[0];
+    X[1] = hpshaft_y[0];
+
+    // Inputs
+    U[0] = cmd[7];
+    U[1] = cmd[12];
+    U[2] = cmd[13];
+
+    // Outputs
+    tan_scale(dtmp, 1/mdl->gearbox_GearRatio, dcmd[10]);
+    set_out(Y, dY, AGTF30_NUM_Y, 0, lpshaft_y[0]/mdl->gearbox_GearRatio, dtmp);
+    set_out(Y, dY, AGTF30_NUM_Y, 1, lpshaft_y[0], dcmd[10]);
+    set_out(Y, dY, AGTF30_NUM_Y, 2, hpshaft_y[0], dcmd[11]);
+    set_out(Y, dY, AGTF30_NUM_Y, 3, cmd[0], dcmd[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 4, amb_y[1], zero);
+    set_out(Y, dY, AGTF30_NUM_Y, 5, amb_y[2], zero);
+    set_out(Y, dY, AGTF30_NUM_Y, 6, inlet_y[0], dinlet_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 7, inlet_y[2], dinlet_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 8, inlet_y[3], dinlet_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 9, fan_y[0], dfan_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 10, fan_y[2], dfan_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 11, fan_y[3], dfan_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 12, byp_y[0], dbyp_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 13, byp_y[2], dbyp_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 14, byp_y[3], dbyp_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 15, st15[0], dst15[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 16, st15[2], dst15[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 17, st15[3], dst15[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 18, duct17_y[0], dduct17_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 19, duct17_y[2], dduct17_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 20, duct17_y[3], dduct17_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 21, core_y[0], dcore_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 22, core_y[2], dcore_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 23, core_y[3], dcore_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 24, duct2_y[0], dduct2_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 25, duct2_y[2], dduct2_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 26, duct2_y[3], dduct2_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 27, lpc_y[0], dlpc_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 28, lpc_y[2], dlpc_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 29, lpc_y[3], dlpc_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 30, st24[0], dst24[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 31, st24[2], dst24[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 32, st24[3], dst24[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 33, duct25_y[0], dduct25_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 34, duct25_y[2], dduct25_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 35, duct25_y[3], dduct25_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 36, hpc_y[0], dhpc_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 37, hpc_y[2], dhpc_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 38, hpc_y[3], dhpc_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 39, static_y[1], dstatic_y[1]);
+    set_out(Y, dY, AGTF30_NUM_Y, 40, burner_y[0], dburner_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 41, burner_y[2], dburner_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 42, burner_y[3], dburner_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 43, hpt_y[0], dhpt_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 44, hpt_y[2], dhpt_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 45, hpt_y[3], dhpt_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 46, duct45_y[0], dduct45_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 47, duct45_y[2], dduct45_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 48, duct45_y[3], dduct45_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 49, lpt_y[0], dlpt_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 50, lpt_y[2], dlpt_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 51, lpt_y[3], dlpt_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 52, duct5_y[0], dduct5_y[0]);
+    set_out(Y, dY, AGTF30_NUM_Y, 53, duct5_y[2], dduct5_y[2]);
+    set_out(Y, dY, AGTF30_NUM_Y, 54, duct5_y[3], dduct5_y[3]);
+    set_out(Y, dY, AGTF30_NUM_Y, 55, Fdrag, dFdrag);
+    set_out(Y, dY, AGTF30_NUM_Y, 56, nozbyp_y[1] + nozcor_y[1], dFg);
+    set_out(Y, dY, AGTF30_NUM_Y, 57, Fnet, dFnet);
+    set_out(Y, dY, AGTF30_NUM_Y, 58, nozbyp_y[1], dnozbyp_y[1]);
+    set_out(Y, dY, AGTF30_NUM_Y, 59, nozcor_y[1], dnozcor_y[1]);
+    set_out(Y, dY, AGTF30_NUM_Y, 60, TSFC, dTSFC);
+    set_out(Y, dY, AGTF30_NUM_Y, 61, fan_y[24], dfan_y[24]);
+    set_out(Y, dY, AGTF30_NUM_Y, 62, lpc_y[24], dlpc_y[24]);
+    set_out(Y, dY, AGTF30_NUM_Y, 63, hpc_y[24], dhpc_y[24]);
+
+    // Diagnostic output
+    E[0] = lpc_y[13];
+    E[1] = hpc_y[13];
+    E[2] = fan_y[15]; /*--- Fan NcMap ---*/
+    E[3] = lpc_y[15]; /*--- LPC NcMap ---*/
+    E[4] = hpc_y[15]; /*--- HPC NcMap ---*/
+    E[5] = hpt_y[14]; /*--- HPT NcMap ---*/
+    E[6] = lpt_y[14]; /*--- LPT NcMap ---*/
+    E[7] = fan_y[5]; /*--- Fan Torque ---*/
+    E[8] = lpc_y[5]; /*--- LPC Torque ---*/
+    E[9] = hpc_y[5]; /*--- HPC Torque ---*/
+    E[10] = hpt_y[5]; /*--- HPT Torque ---*/
+    E[11] = lpt_y[5]; /*--- LPT Torque ---*/
+    E[12] = amb_y[4];
+
+    if (ws->diag.point_flags)
+        AGTF30_diag_collect(ws);
+}
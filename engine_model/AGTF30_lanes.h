@@ -0,0 +1,109 @@
+#ifndef AGTF30_LANES_H
+#define AGTF30_LANES_H
+
+/*		AGTF30_lanes.h
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane-parallel (structure-of-arrays) versions of the gas path routines.
+%
+%  A lane group holds AGTF30_LANES operating points. Every quantity that
+%  the scalar bodies keep in a double is kept here in a double[AGTF30_LANES]
+%  and every operation is written as a loop over the lanes, so that the
+%  compiler maps one loop onto one AVX2 (4 lanes) or AVX-512 (8 lanes)
+%  instruction sequence. Without those instruction sets the same loops run
+%  on SSE2 or plain scalar code.
+%
+%  Iterative searches (sp2tc, h2tc, StaticCalc, ...) run in lock step: all
+%  lanes share one iteration counter, each lane keeps its own "active" flag
+%  and stops updating its state once its own convergence test is met. The
+%  operations each lane performs are the same as in the scalar bodies, so a
+%  lane reproduces the scalar result for its point.
+%
+%  Component inputs and outputs keep the index layout of the scalar bodies,
+%  e.g. y[2][l] of Compressor_TMATS_lanes is TtOut (y[2]) of lane l.
+%
+%  The lane kernels do not write IWork error flags or print warnings; the
+%  MEX gateway only uses them when ENABLE_DEBUG is 0.
+% *************************************************************************/
+
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+#include "AGTF30_model.h"
+
+/*--- Number of points per lane group ---*/
+#ifndef AGTF30_LANES
+#if defined(__AVX512F__)
+#define AGTF30_LANES 8
+#else
+#define AGTF30_LANES 4
+#endif
+#endif
+
+/*--- Lane versions of divby and sqrtT (functions_TMATS.c) ---*/
+#define DIVBY_L(X)  (((X) < 1e-10 && (X) > -1e-10) ? (((X) >= 0) - ((X) < 0))*1e10 : 1/(X))
+#define SQRTT_L(X)  (((X) < 0) ? 0 : sqrt(X))
+
+typedef double lane_t[AGTF30_LANES];
+
+/* properties_TMATS_lanes.c */
+extern void t2hc_lanes(double *H, const double *T, const double *fa);
+extern void h2tc_lanes(double *T, const double *H, const double *fa);
+extern void pt2sc_lanes(double *S, const double *P, const double *T, const double *fa);
+extern void sp2tc_lanes(double *T, const double *S, const double *P, const double *fa, const int *active);
+extern void h2tc_from_lanes(double *T, const double *H, const double *fa, const double *T1);
+extern void sp2tc_from_lanes(double *T, const double *S, const double *P, const double *fa,
+                             const double *T1, const double *P1);
+extern void isentropic_lanes(const double *Tt, const double *Pt, const double *PtOut, const double *fa,
+                             const double *eff, int expansion, double *ht, double *S, double *TtIdeal,
+                             double *htIdeal, double *TtOut, double *htOut);
+
+/* Total states of a static pressure search (StaticState in functions_TMATS.h) */
+struct StaticStateLanes{
+    lane_t fa, zmea, zmsp, tmlsr, zz, rcas;     /* gas composition */
+    int row[AGTF30_LANES];                      /* inverse table rows, as GasMix */
+    lane_t w, philo, phiscale;
+    lane_t Tt, ht, Rt, S, phiS;                 /* total state */
+    int warm[AGTF30_LANES];                     /* last static temperature */
+    lane_t Ts, phi, dphi;
+};
+typedef struct StaticStateLanes StaticStateLanes;
+
+extern void static_state_lanes(StaticStateLanes *ss, const double *Pt, const double *Tt, const double *ht,
+                               const double *FAR, const double *Rt);
+extern void PcalcStat_state_lanes(StaticStateLanes *ss, const double *Ps, double *Ts, double *hs,
+                                  double *rhos, double *V, const int *active);
+extern void static_state_slope_lanes(const StaticStateLanes *ss, const double *Ps, double *dTs, double *dhs,
+                                     int *ok);
+
+/* Array versions over n points; an increment of 0 uses one value for all points */
+extern void t2hc_array(double *H, const double *T, int incT, const double *fa, int incfa, unsigned int n);
+extern void h2tc_array(double *T, const double *H, int incH, const double *fa, int incfa, unsigned int n);
+extern void pt2sc_array(double *S, const double *P, int incP, const double *T, int incT,
+                        const double *fa, int incfa, unsigned int n);
+extern void sp2tc_array(double *T, const double *S, int incS, const double *P, int incP,
+                        const double *fa, int incfa, unsigned int n);
+
+/* StaticCalc_TMATS_lanes.c */
+extern void StaticCalc_TMATS_lanes(lane_t *y, const lane_t *u, const StaticCalcStruct* prm);
+
+/* Duct_TMATS_lanes.c */
+extern void Duct_TMATS_lanes(lane_t *y, const lane_t *u, const DuctStruct* prm);
+
+/* Compressor_TMATS_lanes.c */
+extern void Compressor_TMATS_lanes(lane_t *y, lane_t *y1, lane_t *y2, const lane_t *u, const double* Wcust,
+                                   const double* FracWbld, const CompressorStruct* prm);
+
+/* Splitter_TMATS_lanes.c */
+extern void Splitter_TMATS_lanes(lane_t *y, lane_t *y1, const lane_t *u, const lane_t *u1);
+
+/* Burner_TMATS_lanes.c */
+extern void Burner_TMATS_lanes(lane_t *y, const lane_t *u, const BurnStruct* prm);
+
+/* Turbine_TMATS_lanes.c */
+extern void Turbine_TMATS_lanes(lane_t *y, const lane_t *u, const lane_t *CoolFlow, const TurbineStruct* prm);
+
+/* AGTF30_engine_eval_lanes.c */
+extern void AGTF30_engine_eval_lanes(AGTF30Workspace *ws, const AGTF30Batch *b, unsigned int first, unsigned int last);
+
+#endif /* AGTF30_LANES_H */
@@ -0,0 +1,280 @@
+#ifndef AGTF30_MODEL_H
+#define AGTF30_MODEL_H
+
+/*		AGTF30_model.h
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Model context and per-call workspace for the AGTF30 engine model.
+%
+%  AGTF30Model holds every map table and component parameter structure. It
+%  is built once (AGTF30_model_init) and is never written afterwards, so a
+%  single instance is shared by all evaluations.
+%
+%  AGTF30Workspace is the small per-call overlay: copies of the component
+%  structures whose IWork pointers refer to arrays owned by the workspace,
+%  plus the bleed vectors passed to the HPC. Health parameter scalars are
+%  applied to the map scalars inside AGTF30_engine_eval.
+%
+%  The workspace also caches the inputs and outputs of the last run of each
+%  gas path component. With cache_mode set, AGTF30_engine_eval reuses a
+%  component whose inputs are bit for bit those cached instead of running
+%  it, so after a change to one command only the components downstream of
+%  where it enters are evaluated again. Results are unchanged.
+%
+%  eval_level lets a caller that only needs the dependents, such as the
+%  iterations of a solver, skip the outputs that do not feed them: the
+%  HPC exit static pressure (Y(40)) below AGTF30_EVAL_FULL, and the fan
+%  and HPC stall margins (Y(62) and Y(64)) below AGTF30_EVAL_DIAGNOSTICS.
+%  Skipped outputs are NaN; DEP, X, U and E are the same at every level.
+%
+%  The error flags the components latch in their IWork vectors during an
+%  evaluation can be collected into the workspace diagnostics (diag, see
+%  AGTF30_diagnostics.c): one event record per raised flag in a ring
+%  buffer, and the flags of each component as a bit mask per point. As
+%  every thread evaluates with its own workspace, no record is shared.
+%
+%  AGTF30_model_init_maps gives the same model with the compressor and
+%  turbine maps interpolated by C1 cubic splines instead of linearly
+%  (interp_map_init), for solvers that suffer from the kinks of the
+%  linear maps. Each variant is built once on first use and shared as
+%  the linear one is.
+% *************************************************************************/
+
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+
+/*--- Vector lengths of the model inputs and outputs ---*/
+#define AGTF30_NUM_ENV      3   /* Alt, MN, dTamb */
+#define AGTF30_NUM_CMD      14  /* Independents and commands */
+#define AGTF30_NUM_TAR      3   /* LPC_SM, Fnet, T45 targets */
+#define AGTF30_NUM_HEALTH   13  /* Component health parameters */
+#define AGTF30_NUM_BLDS     4   /* HPC customer bleed + 3 fractional bleeds */
+#define AGTF30_NUM_DEP      12  /* Dependents */
+#define AGTF30_NUM_X        2   /* States */
+#define AGTF30_NUM_U        3   /* Inputs */
+#define AGTF30_NUM_Y        64  /* Outputs */
+#define AGTF30_NUM_E        13  /* Miscellaneous outputs */
+
+struct AGTF30Model {
+    /*--- Component parameter structures (IWork pointers are NULL here) ---*/
+    AmbientStruct    ambient;
+    InletStruct      inlet;
+    CompressorStruct fan;
+    DuctStruct       duct2;
+    CompressorStruct lpc;
+    ValveStruct      vbv;
+    DuctStruct       duct25;
+    DuctStruct       duct17;
+    NozzleStruct     nozbyp;
+    CompressorStruct hpc;
+    StaticCalcStruct hpcstatic;
+    BurnStruct       burner;
+    TurbineStruct    hpt;
+    DuctStruct       duct45;
+    TurbineStruct    lpt;
+    DuctStruct       duct5;
+    NozzleStruct     nozcor;
+    ShaftStruct      lpshaft;
+    ShaftStruct      hpshaft;
+
+    /*--- Compressor inputs that are not part of the compressor structures ---*/
+    double fan_Alpha, fan_s_C_Nc, fan_s_C_Wc, fan_s_C_PR, fan_s_C_Eff;
+    double lpc_Alpha, lpc_s_C_Nc, lpc_s_C_Wc, lpc_s_C_PR, lpc_s_C_Eff;
+    double hpc_Alpha, hpc_s_C_Nc, hpc_s_C_Wc, hpc_s_C_PR, hpc_s_C_Eff;
+    const double *fan_Wcust, *fan_FracWbld;
+    const double *lpc_Wcust, *lpc_FracWbld;
+
+    /*--- Turbine inputs that are not part of the turbine structures ---*/
+    double hpt_cfWidth;
+    double lpt_cfWidth;
+
+    /*--- Nozzle areas used when IDes < 1.5 ---*/
+    double NozByp_N_TArea_M, NozByp_N_EArea_M;
+    double NozCor_N_TArea_M, NozCor_N_EArea_M;
+
+    /*--- Gearbox and LP shaft ---*/
+    double gearbox_GearRatio;
+    double gearbox_Eff;
+    double lpshaft_Eff;
+};
+typedef struct AGTF30Model AGTF30Model;
+
+/*--- Components whose last run is cached for incremental evaluation, in evaluation order ---*/
+enum {
+    AGTF30_CACHED_AMBIENT, AGTF30_CACHED_INLET, AGTF30_CACHED_FAN, AGTF30_CACHED_DUCT2,
+    AGTF30_CACHED_LPC, AGTF30_CACHED_DUCT25, AGTF30_CACHED_DUCT17, AGTF30_CACHED_NOZBYP,
+    AGTF30_CACHED_HPC, AGTF30_CACHED_HPCSTATIC, AGTF30_CACHED_BURNER, AGTF30_CACHED_HPT,
+    AGTF30_CACHED_DUCT45, AGTF30_CACHED_LPT, AGTF30_CACHED_DUCT5, AGTF30_CACHED_NOZCOR,
+    AGTF30_NUM_CACHED
+};
+
+#define AGTF30_CACHE_KEY    22  /* longest component input: turbine u and two cooling flows */
+#define AGTF30_CACHE_Y      47  /* longest component output: HPC y, y1 and y2 */
+#define AGTF30_CACHE_IWORK  16  /* longest IWork (nozzles) */
+
+/*--- Incremental evaluation modes (AGTF30Workspace.cache_mode) ---*/
+#define AGTF30_CACHE_OFF     0  /* every component runs */
+#define AGTF30_CACHE_UPDATE  1  /* components with cached inputs are reused, the others run and are cached */
+#define AGTF30_CACHE_KEEP    2  /* components with cached inputs are reused, the cache is left unchanged */
+
+/*--- Evaluation levels (AGTF30Workspace.eval_level, AGTF30Batch.eval_level) ---*/
+#define AGTF30_EVAL_RESIDUALS    0  /* DEP, X, U and E */
+#define AGTF30_EVAL_DIAGNOSTICS  1  /* and the compressor stall margins */
+#define AGTF30_EVAL_FULL         2  /* every output */
+
+/*--- Diagnostics (AGTF30Workspace.diag) ---*/
+#define AGTF30_DIAG_NUM_COMPONENTS  11   /* components with IWork flags, in the order of AGTF30Workspace */
+#define AGTF30_DIAG_RING            1024 /* events kept per workspace, a power of 2 */
+
+/* One raised IWork flag */
+struct AGTF30DiagEvent {
+    unsigned int eval_id;       /* AGTF30Diag.eval_id of the evaluation, the point of a batch */
+    unsigned short component;   /* 0 ambient, 1 inlet, 2 fan, 3 lpc, 4 vbv, 5 bypass nozzle, 6 hpc,
+                                   7 hpc static, 8 hpt, 9 lpt, 10 core nozzle */
+    unsigned short code;        /* IWork entry, 0 for Er1 */
+    int value;                  /* flag value */
+};
+typedef struct AGTF30DiagEvent AGTF30DiagEvent;
+
+struct AGTF30Diag {
+    /* Off when NULL. Otherwise AGTF30_DIAG_NUM_COMPONENTS words receiving
+     * the flags raised by the evaluation, bit k for Er(k+1) */
+    unsigned int *point_flags;
+    unsigned int eval_id;
+    unsigned int num_events;    /* since AGTF30_diag_reset; the ring keeps the last AGTF30_DIAG_RING */
+    AGTF30DiagEvent ring[AGTF30_DIAG_RING];
+};
+typedef struct AGTF30Diag AGTF30Diag;
+
+/* Inputs (key), outputs and error flags of the last cached run of a component */
+struct AGTF30CacheEntry {
+    int valid;
+    double key[AGTF30_CACHE_KEY];
+    double y[AGTF30_CACHE_Y];
+    int IWork[AGTF30_CACHE_IWORK];
+};
+typedef struct AGTF30CacheEntry AGTF30CacheEntry;
+
+struct AGTF30Workspace {
+    const AGTF30Model *mdl;
+
+    /*--- Component structures that carry IWork error flags ---*/
+    AmbientStruct    ambient;
+    InletStruct      inlet;
+    CompressorStruct fan;
+    CompressorStruct lpc;
+    ValveStruct      vbv;
+    NozzleStruct     nozbyp;
+    CompressorStruct hpc;
+    StaticCalcStruct hpcstatic;
+    TurbineStruct    hpt;
+    TurbineStruct    lpt;
+    NozzleStruct     nozcor;
+
+    /*--- IWork error flags ---*/
+    int ambient_IWork[5];
+    int inlet_IWork[1];
+    int fan_IWork[5];
+    int lpc_IWork[5];
+    int vbv_IWork[1];
+    int nozbyp_IWork[16];
+    int hpc_IWork[5];
+    int hpcstatic_IWork[5];
+    int hpt_IWork[5];
+    int lpt_IWork[5];
+    int nozcor_IWork[16];
+
+    /*--- Nozzle throat searches: the seeds, taken from the cached nozzle
+     *    runs of the current solve (AGTF30_nozzle_seeds_clear), and
+     *    iteration counts since AGTF30_workspace_init ---*/
+    NozzleSearch nozbyp_search;
+    NozzleSearch nozcor_search;
+
+    /*--- Rline, Nc and Alpha cells of the last compressor map lookups,
+     *    where the searches of the irregular map axes start ---*/
+    int fan_MapCell[3];
+    int lpc_MapCell[3];
+    int hpc_MapCell[3];
+
+    /*--- HPC bleeds (from BLDS_IN) ---*/
+    double hpc_Wcust[1];
+    double hpc_FracWbld[3];
+
+    /*--- Incremental evaluation, off after AGTF30_workspace_init. Used by
+     *    AGTF30_engine_eval only; leave it off when enable_debug is set, as
+     *    reused components print no warnings. ---*/
+    int cache_mode;
+    AGTF30CacheEntry cache[AGTF30_NUM_CACHED];
+
+    /*--- Outputs evaluated by AGTF30_engine_eval, AGTF30_EVAL_FULL after
+     *    AGTF30_workspace_init. AGTF30_engine_eval_batch sets it from the
+     *    batch. ---*/
+    int eval_level;
+
+    /*--- Diagnostics, off after AGTF30_workspace_init ---*/
+    AGTF30Diag diag;
+};
+typedef struct AGTF30Workspace AGTF30Workspace;
+
+/* A batch of N points stored column by column. Inputs with a stride of 0
+ * hold a single column that is shared by every point. */
+struct AGTF30Batch {
+    unsigned int N;
+    const double *env;            unsigned int env_stride;
+    const double *cmd;
+    const double *tar;            unsigned int tar_stride;
+    const double *health_params;  unsigned int health_stride;
+    const double *blds;
+    double enable_debug;
+    int use_lanes;                /* evaluate with the lane kernels (enable_debug must be 0) */
+    int eval_level;               /* AGTF30_EVAL_ level of the outputs, ignored with derivatives */
+
+    /* AGTF30_DIAG_NUM_COMPONENTS flag words per point (AGTF30Diag.point_flags),
+     * NULL for no diagnostics. The lane kernels raise no flags, so points
+     * with diagnostics are evaluated with the scalar bodies. */
+    unsigned int *diag_flags;
+
+    double *DEP, *X, *U, *Y, *E;
+
+    /* Derivatives with respect to the commands (AGTF30_engine_eval_tangent),
+     * NULL for none: dDEP holds 12 x 14 and dY 64 x 14 values per point,
+     * column-major. dY may be NULL when dDEP is not. Points with
+     * derivatives are evaluated with the scalar bodies. */
+    double *dDEP, *dY;
+};
+typedef struct AGTF30Batch AGTF30Batch;
+
+/*--- Interpolation of the compressor and turbine maps (AGTF30_model_init_maps) ---*/
+#define AGTF30_MAPS_LINEAR  0   /* piecewise linear, the model of AGTF30_model_init */
+#define AGTF30_MAPS_PCHIP   1   /* C1, monotone cubic */
+#define AGTF30_MAPS_AKIMA   2   /* C1, Akima */
+#define AGTF30_NUM_MAPS     3
+
+/* AGTF30_model_data.c */
+extern const AGTF30Model* AGTF30_model_init(void);
+extern const AGTF30Model* AGTF30_model_init_maps(int maps);
+
+/* AGTF30_engine_eval.c */
+extern const unsigned char AGTF30_dep_pattern[AGTF30_NUM_DEP][AGTF30_NUM_CMD];
+extern const unsigned char AGTF30_cmd_downstream[AGTF30_NUM_CMD];
+extern void AGTF30_workspace_init(AGTF30Workspace *ws, const AGTF30Model *mdl);
+extern void AGTF30_nozzle_seeds_clear(AGTF30Workspace *ws);
+extern void AGTF30_engine_eval(AGTF30Workspace *ws, const double *env, const double *cmd, const double *tar,
+                               const double *health_params, const double *blds, const double enable_debug,
+                               double *DEP, double *X, double *U, double *Y, double *E);
+extern void AGTF30_engine_eval_batch(AGTF30Workspace *ws, const AGTF30Batch *b, unsigned int first, unsigned int last);
+
+/* AGTF30_diagnostics.c */
+extern void AGTF30_diag_reset(AGTF30Diag *d);
+extern void AGTF30_diag_collect(AGTF30Workspace *ws);
+
+/* AGTF30_thread_pool.c */
+extern int  AGTF30_num_cores(void);
+extern int  AGTF30_pool_start(const AGTF30Model *mdl, int num_threads);
+extern int  AGTF30_pool_eval(AGTF30Workspace *caller_ws, const AGTF30Batch *b, int num_threads);
+extern void AGTF30_pool_shutdown(void);
+extern int  AGTF30_pool_num_workers(void);
+extern const AGTF30Diag* AGTF30_pool_diag(int worker);
+
+#endif /* AGTF30_MODEL_H */
@@ -0,0 +1,822 @@
+/*		AGTF30_nr_solver.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Newton-Raphson solver for the AGTF30 engine model, written to follow
+%  nr_solver.m step for step:
+%   - the parameter sets (MaxIter, NRASS, JPerSS) are tried in order,
+%   - commands are clamped to IMinMax before every model call,
+%   - the Jacobian is formed from positive and negative one-sided
+%     perturbations (central difference, or the one finite side),
+%   - a VBV independent is kept above zero,
+%   - an iterate with an NcMap outside MapRange is not accepted.
+%  Reductions over dependents and NcMaps skip NaN values like MATLAB's
+%  max and min. Jinv = inv(J) is computed by LU factorization with
+%  partial pivoting.
+%
+%  Independents that reach disjoint sets of the selected dependents
+%  (AGTF30_dep_pattern) are perturbed together, so a one-sided Jacobian
+%  takes one model call per group of columns rather than per column. The
+%  groups are formed once per solve. With the selections of
+%  solve_at_points.m and do_linearization.m every column reaches the
+%  turbine and nozzle flow errors, each group holds one column and the
+%  perturbations are those of nr_solver.m.
+%
+%  With AGTF30_JACOBIAN_BROYDEN the finite-difference Jacobian is only
+%  built at the start of a parameter set, from positive perturbations
+%  alone where they are in range. After each accepted step Jinv is given a
+%  Broyden rank-one update (Sherman-Morrison form), and the Jacobian is
+%  rebuilt only when the step did not reduce the largest scaled dependent
+%  enough or the update is ill-conditioned.
+%
+%  With AGTF30_JACOBIAN_EXACT every model call is a forward mode (tangent)
+%  evaluation, AGTF30_engine_eval_tangent, which returns dDEP/dCMD along
+%  with the outputs. The Jacobian of every accepted iterate is therefore
+%  exact and costs no extra model calls. Finite differences are only used
+%  when the tangents are not finite.
+%
+%  Without debug output the iterations evaluate the model at
+%  AGTF30_EVAL_RESIDUALS, which skips the outputs that do not feed the
+%  dependents. The outputs of the returned point are evaluated in full
+%  once, at the end, from the cached components where they are unchanged.
+% *************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include "AGTF30_nr_solver.h"
+#include "AGTF30_tangent.h"
+
+#ifdef MATLAB_MEX_FILE
+#include "simstruc.h"
+#endif
+
+#define NR_NUM_PARAM_SETS 2
+#define NR_NUM_NCMAPS     5
+
+/* finite test that is false for NaN and +-Inf */
+#define NR_ISFINITE(X)  ((X) - (X) == 0)
+
+/*--- Parameter sets, used in turn until one gives convergence ---*/
+static const int    MaxIter_array[NR_NUM_PARAM_SETS] = {20, 100};       /* Maximum iterations before giving up */
+static const int    NRASS_array[NR_NUM_PARAM_SETS]   = {10, 5};         /* Number of iterations before recalculating Jacobian */
+static const double JPerSS_array[NR_NUM_PARAM_SETS]  = {0.001, 0.001};  /* Jacobian perturbation size */
+/* NumJPerSS (iterations before the perturbation size is adjusted) equals MaxIter */
+
+/*--- Broyden update settings ---*/
+#define BROYDEN_STALL_RATIO 0.8     /* rebuild unless max|DEP/Dtol| drops below this fraction of its last value */
+#define BROYDEN_MIN_COSINE  1e-6    /* rebuild when the update denominator is this close to zero */
+
+/*--- Independent vector min/max range. nr_solver.m uses the same range,
+ *    dependent tolerances and map range for every parameter set. ---*/
+static const double IMinMax[AGTF30_NUM_CMD][2] = {
+    {0,       HUGE_VAL},    /* 1) WIn */
+    {1,       3.5},         /* 2) FAN_RLIn */
+    {1,       3.2},         /* 3) LPC_RLIn */
+    {1,       3.0},         /* 4) HPC_RLIn */
+    {1,       HUGE_VAL},    /* 5) BPR */
+    {2.5478,  6.417},       /* 6) HPT_PR */
+    {1,       11.785},      /* 7) LPT_PR */
+    {0,       HUGE_VAL},    /* 8) WfIn */
+    {0,       HUGE_VAL},    /* 9) VAFNIn */
+    {0,       HUGE_VAL},    /* 10) VBVIn */
+    {0,       HUGE_VAL},    /* 11) N2In */
+    {0,       HUGE_VAL},    /* 12) N3In */
+    {-HUGE_VAL, HUGE_VAL},  /* 13) HPpwrIn */
+    {-HUGE_VAL, HUGE_VAL}   /* 14) LPpwrIn */
+};
+
+/*--- Dependent vector tolerances ---*/
+static const double Dtol[AGTF30_NUM_DEP] = {
+    1e-5, 1e-5, 1e-5, 1e-5, 1e-5, 1e-5,   /* W21err, W24aerr, W36err, W45err, W5err, W8err */
+    1e-5, 1e-5, 1e-5,                     /* W18err, N2dot, N3dot */
+    1e-5, 1e-5, 1e-5                      /* LPC SM error, Fnet error, T45 error */
+};
+
+/*--- Component map range of E(3:7) ---*/
+static const double MapRange[NR_NUM_NCMAPS][2] = {
+    {0.3, 1.10},    /* FAN NcMap */
+    {0.3, 1.25},    /* LPC NcMap */
+    {0.5, 1.05},    /* HPC NcMap */
+    {60,  130},     /* HPT NcMap */
+    {20,  120}      /* LPT NcMap */
+};
+
+struct NRProblem {
+    AGTF30Workspace *ws;
+    const double *env, *tar, *health_params, *blds;
+    double enable_debug;
+
+    int n;                                  /* number of independents (= dependents) */
+    int Ivec_range[AGTF30_NUM_CMD];         /* find(Ivec) */
+    int Dvec_range[AGTF30_NUM_DEP];         /* find(Dvec) */
+    int num_groups;                         /* number of column groups for the perturbation Jacobian */
+    int group[AGTF30_NUM_CMD];              /* group of each independent (group_columns) */
+    int eval_level;                         /* outputs evaluated by the iterations (AGTF30_EVAL_) */
+    int full_outputs;                       /* res holds every output of its point */
+
+    AGTF30SolverResult *res;
+};
+
+static double nr_nan(void)
+{
+    double inf = HUGE_VAL;
+    return inf - inf;
+}
+
+/* Sets command values outside IMinMax to the violated limit */
+static void clamp_cmd(double *CMD)
+{
+    int i;
+
+    for (i = 0; i < AGTF30_NUM_CMD; i++) {
+        if (CMD[i] > IMinMax[i][1])
+            CMD[i] = IMinMax[i][1]; /* Set any max violations to maximum */
+        if (CMD[i] < IMinMax[i][0])
+            CMD[i] = IMinMax[i][0]; /* Set any min violations to minimum */
+    }
+}
+
+/* max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0 */
+static int dep_converged(const struct NRProblem *p, const double *DEP)
+{
+    double v, vmax = 0;
+    int k, found = 0;
+
+    for (k = 0; k < p->n; k++) {
+        v = fabs(DEP[p->Dvec_range[k]] / Dtol[p->Dvec_range[k]]);
+        if (v == v && (!found || v > vmax)) {
+            vmax = v;
+            found = 1;
+        }
+    }
+    return found && vmax < 1.0;
+}
+
+/* (max(E(3:7) ./ MapRange(:,2)) > 1.0) || (min(E(3:7) ./ MapRange(:,1)) < 1.0) */
+static int map_violation(const double *E)
+{
+    double v, vmax = 0, vmin = 0;
+    int i, found_max = 0, found_min = 0;
+
+    for (i = 0; i < NR_NUM_NCMAPS; i++) {
+        v = E[2+i] / MapRange[i][1];
+        if (v == v && (!found_max || v > vmax)) {
+            vmax = v;
+            found_max = 1;
+        }
+        v = E[2+i] / MapRange[i][0];
+        if (v == v && (!found_min || v < vmin)) {
+            vmin = v;
+            found_min = 1;
+        }
+    }
+    return (found_max && vmax > 1.0) || (found_min && vmin < 1.0);
+}
+
+/* Evaluates the engine model at res->CMD. Without debug output the
+ * components are cached, so that the perturbations of a Jacobian about
+ * this point can be evaluated incrementally. */
+static void model_eval(struct NRProblem *p)
+{
+    AGTF30SolverResult *res = p->res;
+
+    p->ws->cache_mode = (p->enable_debug == 0) ? AGTF30_CACHE_UPDATE : AGTF30_CACHE_OFF;
+    p->ws->eval_level = p->eval_level;
+    AGTF30_engine_eval(p->ws, p->env, res->CMD, p->tar, p->health_params, p->blds, p->enable_debug,
+                       res->DEP, res->X, res->U, res->Y, res->E);
+    res->model_evals++;
+    p->full_outputs = (p->eval_level == AGTF30_EVAL_FULL);
+}
+
+/* Evaluates the engine model and its derivatives at res->CMD. J receives
+ * dDEP(Dvec)/dCMD(Ivec), n x n column-major. Returns 1 when every entry of
+ * J is finite. */
+static int model_eval_exact(struct NRProblem *p, double *J)
+{
+    AGTF30SolverResult *res = p->res;
+    double dDEP[AGTF30_NUM_DEP * AGTF30_NUM_CMD];
+    int n = p->n;
+    int c, r, finite = 1;
+
+    AGTF30_engine_eval_tangent(p->ws, p->env, res->CMD, p->tar, p->health_params, p->blds, p->enable_debug,
+                               res->DEP, res->X, res->U, res->Y, res->E, dDEP, NULL);
+    res->model_evals++;
+    p->full_outputs = 1;
+
+    for (c = 0; c < n; c++) {
+        for (r = 0; r < n; r++) {
+            J[r + c*n] = dDEP[p->Dvec_range[r] + AGTF30_NUM_DEP*p->Ivec_range[c]];
+            if (!NR_ISFINITE(J[r + c*n]))
+                finite = 0;
+        }
+    }
+    return finite;
+}
+
+/* Groups the independents into sets of structurally orthogonal columns
+ * (Curtis-Powell-Reid): no two columns of a group reach the same selected
+ * dependent in AGTF30_dep_pattern, so one model call perturbing a whole
+ * group gives every column of it. Columns are assigned greedily in order
+ * to the first group they fit in. */
+static void group_columns(struct NRProblem *p)
+{
+    int n = p->n;
+    int c, k, g, r, clash;
+
+    p->num_groups = 0;
+    for (c = 0; c < n; c++) {
+        for (g = 0; g < p->num_groups; g++) {
+            clash = 0;
+            for (k = 0; k < c && !clash; k++) {
+                if (p->group[k] != g)
+                    continue;
+                for (r = 0; r < n; r++) {
+                    if (AGTF30_dep_pattern[p->Dvec_range[r]][p->Ivec_range[c]]
+                        && AGTF30_dep_pattern[p->Dvec_range[r]][p->Ivec_range[k]]) {
+                        clash = 1;
+                        break;
+                    }
+                }
+            }
+            if (!clash)
+                break;
+        }
+        p->group[c] = g;
+        if (g == p->num_groups)
+            p->num_groups++;
+    }
+}
+
+/* One side of the perturbation Jacobian (perturbation_jacobian in
+ * nr_solver.m). Each group of independents (group_columns) is perturbed
+ * in one command vector, leaving out perturbations outside IMinMax. The
+ * groups are evaluated and then checked for convergence in order.
+ * Returns 1 with the converged point in res, otherwise res holds the last
+ * evaluated point. Jside is n x n, column-major.
+ *
+ * A group that only perturbs AGTF30_cmd_downstream commands is evaluated
+ * incrementally from the components cached by model_eval (the baseline,
+ * when it was the last point evaluated), which is cheaper than a point of
+ * the lane kernels. The other groups are evaluated as one batch. */
+static int perturbation_jacobian(struct NRProblem *p, double direction, const double *CMD0, const double *DEP0,
+                                 double JPerSS, double *Jside)
+{
+    AGTF30SolverResult *res = p->res;
+    double CMD_eval[AGTF30_NUM_CMD * AGTF30_NUM_CMD];
+    double DEP_batch[AGTF30_NUM_DEP * AGTF30_NUM_CMD];
+    double X_batch[AGTF30_NUM_X * AGTF30_NUM_CMD];
+    double U_batch[AGTF30_NUM_U * AGTF30_NUM_CMD];
+    double Y_batch[AGTF30_NUM_Y * AGTF30_NUM_CMD];
+    double E_batch[AGTF30_NUM_E * AGTF30_NUM_CMD];
+    double cmd_pert[AGTF30_NUM_CMD];
+    int in_range[AGTF30_NUM_CMD], group_size[AGTF30_NUM_CMD];
+    int group_pos[AGTF30_NUM_CMD], incremental[AGTF30_NUM_CMD];
+    int n = p->n;
+    int g, i1, ii, k, r, dd, pass, num_eval = 0, num_batch = 0;
+    double *cmd_col, diff;
+    AGTF30Batch b;
+
+    for (k = 0; k < n*n; k++)
+        Jside[k] = nr_nan();
+
+    /*--- Perturbed value of each independent ---*/
+    for (i1 = 0; i1 < n; i1++) {
+        ii = p->Ivec_range[i1];
+        cmd_pert[i1] = CMD0[ii] * (1 + direction*JPerSS);
+        in_range[i1] = (direction > 0) ? (cmd_pert[i1] <= IMinMax[ii][1]) : (cmd_pert[i1] >= IMinMax[ii][0]);
+    }
+
+    /*--- Groups with a perturbation in range that can be evaluated incrementally ---*/
+    for (g = 0; g < p->num_groups; g++) {
+        group_pos[g] = -1;
+        group_size[g] = 0;
+        incremental[g] = (p->enable_debug == 0);
+        for (i1 = 0; i1 < n; i1++) {
+            if (p->group[i1] == g && in_range[i1]) {
+                group_size[g]++;
+                if (!AGTF30_cmd_downstream[p->Ivec_range[i1]])
+                    incremental[g] = 0;
+            }
+        }
+    }
+
+    /*--- One command vector per group, the batch groups first ---*/
+    for (pass = 0; pass < 2; pass++) {
+        if (pass == 1)
+            num_batch = num_eval;
+        for (g = 0; g < p->num_groups; g++) {
+            if (group_size[g] == 0 || incremental[g] != pass)
+                continue;
+            cmd_col = &CMD_eval[num_eval * AGTF30_NUM_CMD];
+            memcpy(cmd_col, CMD0, AGTF30_NUM_CMD*sizeof(double));
+            for (i1 = 0; i1 < n; i1++) {
+                if (p->group[i1] == g && in_range[i1])
+                    cmd_col[p->Ivec_range[i1]] = cmd_pert[i1];
+            }
+            group_pos[g] = num_eval++;
+        }
+    }
+
+    /* the batch must leave the cached baseline alone */
+    p->ws->cache_mode = AGTF30_CACHE_OFF;
+    if (num_batch > 0) {
+        b.N = (unsigned int)num_batch;
+        b.env = p->env;                     b.env_stride = 0;
+        b.cmd = CMD_eval;
+        b.tar = p->tar;                     b.tar_stride = 0;
+        b.health_params = p->health_params; b.health_stride = 0;
+        b.blds = p->blds;
+        b.enable_debug = p->enable_debug;
+        b.use_lanes = (p->enable_debug == 0);
+        b.eval_level = p->eval_level;
+        b.diag_flags = NULL;
+        b.DEP = DEP_batch;
+        b.X = X_batch;
+        b.U = U_batch;
+        b.Y = Y_batch;
+        b.E = E_batch;
+        b.dDEP = NULL;
+        b.dY = NULL;
+        AGTF30_engine_eval_batch(p->ws, &b, 0, b.N);
+    }
+
+    p->ws->cache_mode = AGTF30_CACHE_KEEP;
+    p->ws->eval_level = p->eval_level;
+    for (k = num_batch; k < num_eval; k++) {
+        AGTF30_engine_eval(p->ws, p->env, &CMD_eval[k * AGTF30_NUM_CMD], p->tar, p->health_params, p->blds,
+                           p->enable_debug, &DEP_batch[k * AGTF30_NUM_DEP], &X_batch[k * AGTF30_NUM_X],
+                           &U_batch[k * AGTF30_NUM_U], &Y_batch[k * AGTF30_NUM_Y], &E_batch[k * AGTF30_NUM_E]);
+    }
+    p->ws->cache_mode = AGTF30_CACHE_OFF;
+    res->model_evals += num_eval;
+
+    /*--- Check the groups for convergence and fill the Jacobian in group order ---*/
+    for (g = 0; g < p->num_groups; g++) {
+        k = group_pos[g];
+        if (k < 0)
+            continue;
+        memcpy(res->CMD, &CMD_eval[k * AGTF30_NUM_CMD], AGTF30_NUM_CMD*sizeof(double));
+        memcpy(res->DEP, &DEP_batch[k * AGTF30_NUM_DEP], AGTF30_NUM_DEP*sizeof(double));
+        memcpy(res->X, &X_batch[k * AGTF30_NUM_X], AGTF30_NUM_X*sizeof(double));
+        memcpy(res->U, &U_batch[k * AGTF30_NUM_U], AGTF30_NUM_U*sizeof(double));
+        memcpy(res->Y, &Y_batch[k * AGTF30_NUM_Y], AGTF30_NUM_Y*sizeof(double));
+        memcpy(res->E, &E_batch[k * AGTF30_NUM_E], AGTF30_NUM_E*sizeof(double));
+        p->full_outputs = (p->eval_level == AGTF30_EVAL_FULL);
+
+        /* check for convergence */
+        if (dep_converged(p, res->DEP))
+            return 1;
+
+        /* A group of one column takes every row, as nr_solver.m does. In a
+         * larger group each row belongs to the one column that reaches it. */
+        for (i1 = 0; i1 < n; i1++) {
+            if (p->group[i1] != g || !in_range[i1])
+                continue;
+            ii = p->Ivec_range[i1];
+            for (r = 0; r < n; r++) {
+                dd = p->Dvec_range[r];
+                diff = res->DEP[dd] - DEP0[dd];
+                if (group_size[g] == 1 || AGTF30_dep_pattern[dd][ii])
+                    Jside[r + i1*n] = diff / (direction*cmd_pert[i1]*JPerSS);
+                else
+                    Jside[r + i1*n] = 0;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int column_finite(const double *A, int n, int col)
+{
+    int r;
+
+    for (r = 0; r < n; r++) {
+        if (!NR_ISFINITE(A[r + col*n]))
+            return 0;
+    }
+    return 1;
+}
+
+/* Forms J from the one-sided Jacobians. Columns with no finite side keep
+ * their previous values. */
+static void form_jacobian(const struct NRProblem *p, const double *Jpos, const double *Jneg, double *J)
+{
+    int n = p->n;
+    int c, r, pos_ok, neg_ok;
+
+    for (c = 0; c < n; c++) {
+        pos_ok = column_finite(Jpos, n, c);
+        neg_ok = column_finite(Jneg, n, c);
+        if (pos_ok && neg_ok) {
+            for (r = 0; r < n; r++)
+                J[r + c*n] = (Jpos[r + c*n] + Jneg[r + c*n])/2;
+        }
+        else if (pos_ok) {
+            for (r = 0; r < n; r++)
+                J[r + c*n] = Jpos[r + c*n];
+        }
+        else if (neg_ok) {
+            for (r = 0; r < n; r++)
+                J[r + c*n] = Jneg[r + c*n];
+        }
+        else {
+            #ifdef MATLAB_MEX_FILE
+            if (p->enable_debug) {
+            printf("Cannot form invertible Jacobian matrix.\n");
+            }
+            #endif
+        }
+    }
+}
+
+/* Ainv = inv(A) for an n x n column-major matrix. As with MATLAB's inv, a
+ * matrix with NaN or Inf entries gives NaN entries and an exactly
+ * singular matrix gives Inf entries. */
+static void invert_matrix(double *Ainv, const double *A, int n)
+{
+    double LU[AGTF30_NUM_CMD * AGTF30_NUM_CMD];
+    int piv[AGTF30_NUM_CMD];
+    double t, amax;
+    int i, j, k, pk;
+
+    for (k = 0; k < n*n; k++) {
+        if (!NR_ISFINITE(A[k])) {
+            for (j = 0; j < n*n; j++)
+                Ainv[j] = nr_nan();
+            return;
+        }
+        LU[k] = A[k];
+    }
+
+    /*--- LU factorization with partial pivoting ---*/
+    for (k = 0; k < n; k++) {
+        pk = k;
+        amax = fabs(LU[k + k*n]);
+        for (i = k+1; i < n; i++) {
+            if (fabs(LU[i + k*n]) > amax) {
+                amax = fabs(LU[i + k*n]);
+                pk = i;
+            }
+        }
+        piv[k] = pk;
+        if (amax == 0) {
+            for (j = 0; j < n*n; j++)
+                Ainv[j] = HUGE_VAL;
+            return;
+        }
+        if (pk != k) {
+            for (j = 0; j < n; j++) {
+                t = LU[k + j*n];
+                LU[k + j*n] = LU[pk + j*n];
+                LU[pk + j*n] = t;
+            }
+        }
+        for (i = k+1; i < n; i++) {
+            LU[i + k*n] /= LU[k + k*n];
+            for (j = k+1; j < n; j++)
+                LU[i + j*n] -= LU[i + k*n]*LU[k + j*n];
+        }
+    }
+
+    /*--- Solve LU * Ainv(:,j) = P * I(:,j) ---*/
+    for (j = 0; j < n; j++) {
+        double *x = &Ainv[j*n];
+
+        for (i = 0; i < n; i++)
+            x[i] = (i == j) ? 1 : 0;
+        for (k = 0; k < n; k++) {
+            if (piv[k] != k) {
+                t = x[k];
+                x[k] = x[piv[k]];
+                x[piv[k]] = t;
+            }
+        }
+        for (i = 1; i < n; i++) {
+            for (k = 0; k < i; k++)
+                x[i] -= LU[i + k*n]*x[k];
+        }
+        for (i = n-1; i >= 0; i--) {
+            for (k = i+1; k < n; k++)
+                x[i] -= LU[i + k*n]*x[k];
+            x[i] /= LU[i + i*n];
+        }
+    }
+}
+
+/* max(abs(DEP(Dvec) ./ Dtol(Dvec))), or NaN when every entry is NaN */
+static double dep_scaled_max(const struct NRProblem *p, const double *DEP)
+{
+    double v, vmax = nr_nan();
+    int k;
+
+    for (k = 0; k < p->n; k++) {
+        v = fabs(DEP[p->Dvec_range[k]] / Dtol[p->Dvec_range[k]]);
+        if (v == v && !(v <= vmax))
+            vmax = v;
+    }
+    return vmax;
+}
+
+/* Finite-difference Jacobian at (CMD0, DEP0) and its inverse. With
+ * one_sided the negative perturbations are only evaluated when a positive
+ * one is out of range or not finite. Returns 1 when one of the perturbed
+ * points is converged. */
+static int jacobian_refresh(struct NRProblem *p, const double *CMD0, const double *DEP0, double JPerSS,
+                            int one_sided, double *Jpos, double *Jneg, double *J, double *Jinv)
+{
+    int c, need_neg = !one_sided;
+
+    if (perturbation_jacobian(p, 1, CMD0, DEP0, JPerSS, Jpos))
+        return 1;
+    for (c = 0; c < p->n && !need_neg; c++)
+        need_neg = !column_finite(Jpos, p->n, c);
+    if (!need_neg) {
+        for (c = 0; c < p->n*p->n; c++)
+            Jneg[c] = nr_nan();
+    }
+    else if (perturbation_jacobian(p, -1, CMD0, DEP0, JPerSS, Jneg))
+        return 1;
+    form_jacobian(p, Jpos, Jneg, J);
+    invert_matrix(Jinv, J, p->n);
+    return 0;
+}
+
+/* Broyden rank-one update of Jinv for the step s = CMD - CMD0 and the
+ * change y = DEP - DEP0 (Sherman-Morrison form of the "good" update):
+ *     Jinv = Jinv + (s - Jinv*y) * (w'*Jinv) / (w'*Jinv*y)
+ * with w = s ./ CMD0.^2, i.e. the update is taken in relative command
+ * units like the perturbation sizes. Returns 0 and leaves Jinv unchanged
+ * when the denominator is ill-conditioned. */
+static int broyden_update(const struct NRProblem *p, const double *CMD, const double *CMD0,
+                          const double *DEP, const double *DEP0, double *Jinv)
+{
+    double s[AGTF30_NUM_CMD], w[AGTF30_NUM_CMD], y[AGTF30_NUM_CMD];
+    double Jy[AGTF30_NUM_CMD], wJ[AGTF30_NUM_CMD];
+    double den = 0, wnorm = 0, Jynorm = 0, scale;
+    int n = p->n;
+    int i, k;
+
+    for (i = 0; i < n; i++) {
+        s[i] = CMD[p->Ivec_range[i]] - CMD0[p->Ivec_range[i]];
+        scale = fabs(CMD0[p->Ivec_range[i]]);
+        if (scale == 0)
+            scale = 1;
+        w[i] = s[i] / (scale*scale);
+        y[i] = DEP[p->Dvec_range[i]] - DEP0[p->Dvec_range[i]];
+    }
+
+    for (i = 0; i < n; i++) {
+        Jy[i] = 0;
+        wJ[i] = 0;
+        for (k = 0; k < n; k++) {
+            Jy[i] += Jinv[i + k*n]*y[k];
+            wJ[i] += w[k]*Jinv[k + i*n];
+        }
+        den += w[i]*Jy[i];
+        wnorm += w[i]*w[i];
+        Jynorm += Jy[i]*Jy[i];
+    }
+
+    if (!NR_ISFINITE(den) || !(fabs(den) > BROYDEN_MIN_COSINE*sqrt(wnorm*Jynorm)))
+        return 0;
+
+    for (k = 0; k < n; k++) {
+        for (i = 0; i < n; i++)
+            Jinv[i + k*n] += (s[i] - Jy[i])*wJ[k]/den;
+    }
+    return 1;
+}
+
+/* The parameter sets of the solver in turn, from cmd_in. Returns with the
+ * converged point, or the last point evaluated, in p->res. */
+static void nr_iterate(struct NRProblem *p, const double *cmd_in, const int *Ivec, int jacobian_method)
+{
+    AGTF30SolverResult *res = p->res;
+    double CMD0[AGTF30_NUM_CMD], DEP0[AGTF30_NUM_DEP];
+    double Jpos[AGTF30_NUM_CMD * AGTF30_NUM_CMD], Jneg[AGTF30_NUM_CMD * AGTF30_NUM_CMD];
+    double J[AGTF30_NUM_CMD * AGTF30_NUM_CMD], Jinv[AGTF30_NUM_CMD * AGTF30_NUM_CMD];
+    double JPerSS, step, resid0, resid;
+    int MaxIter, NRASS, NumJPerSS, jacobian_fresh, rebuild = 0, exact_ok = 0;
+    int set, i, k;
+
+    /*--- Run solver with each set of parameters specified ---*/
+    for (set = 0; set < NR_NUM_PARAM_SETS; set++) {
+        res->solver_iterations = 0;
+        res->parameter_set = set + 1;
+
+        MaxIter = MaxIter_array[set];
+        NRASS = NRASS_array[set];
+        JPerSS = JPerSS_array[set];
+        NumJPerSS = MaxIter;
+
+        /*--- Initial call to the engine model ---*/
+        memcpy(res->CMD, cmd_in, AGTF30_NUM_CMD*sizeof(double));
+        clamp_cmd(res->CMD);
+        if (jacobian_method == AGTF30_JACOBIAN_EXACT)
+            exact_ok = model_eval_exact(p, Jpos);
+        else
+            model_eval(p);
+
+        if (dep_converged(p, res->DEP)) {
+            res->converged = 1;
+            return;
+        }
+
+        /*--- Initial Jacobian calculation ---*/
+        for (k = 0; k < p->n*p->n; k++)
+            J[k] = nr_nan();
+
+        /* DEP0 and CMD0 represent the unperturbed dependents and independents */
+        memcpy(DEP0, res->DEP, AGTF30_NUM_DEP*sizeof(double));
+        memcpy(CMD0, cmd_in, AGTF30_NUM_CMD*sizeof(double));
+
+        if (exact_ok) {
+            memcpy(J, Jpos, p->n*p->n*sizeof(double));
+            invert_matrix(Jinv, J, p->n);
+        }
+        else {
+            if (jacobian_refresh(p, CMD0, DEP0, JPerSS, jacobian_method == AGTF30_JACOBIAN_BROYDEN, Jpos, Jneg, J, Jinv)) {
+                res->converged = 1;
+                return;
+            }
+        }
+        jacobian_fresh = 1;
+
+        /*--- Iterate until convergence reached or MaxIter reached ---*/
+        while (res->solver_iterations < MaxIter) {
+            res->solver_iterations++;
+
+            for (i = 0; i < p->n; i++) {
+                step = 0;
+                for (k = 0; k < p->n; k++)
+                    step += Jinv[i + k*p->n]*DEP0[p->Dvec_range[k]];
+                res->CMD[p->Ivec_range[i]] = CMD0[p->Ivec_range[i]] - step;
+            }
+
+            /* If VBV independent active, make sure VBV is > 0. Otherwise convergence issues will arise */
+            if (Ivec[9] && res->CMD[9] <= 0)
+                res->CMD[9] = 0.0001;
+
+            clamp_cmd(res->CMD);
+            if (jacobian_method == AGTF30_JACOBIAN_EXACT)
+                exact_ok = model_eval_exact(p, Jpos);
+            else
+                model_eval(p);
+
+            if (dep_converged(p, res->DEP)) {
+                res->converged = 1;
+                return;
+            }
+
+            /* Check for component map violation. Such an iterate is not used as a new baseline */
+            if (map_violation(res->E)) {
+                #ifdef MATLAB_MEX_FILE
+                if (p->enable_debug) {
+                printf("Component map violation with parameter index %d NcMaps: %g %g %g %g %g\n",
+                       set + 1, res->E[2], res->E[3], res->E[4], res->E[5], res->E[6]);
+                }
+                #endif
+                if (jacobian_method == AGTF30_JACOBIAN_BROYDEN) {
+                    /* The step from a fresh Jacobian would only be repeated; try the next parameter set */
+                    if (jacobian_fresh)
+                        break;
+                    if (jacobian_refresh(p, CMD0, DEP0, JPerSS, jacobian_method == AGTF30_JACOBIAN_BROYDEN, Jpos, Jneg, J, Jinv)) {
+                        res->converged = 1;
+                        return;
+                    }
+                    jacobian_fresh = 1;
+                }
+                /* The exact Jacobian at the baseline would only repeat the step; try the next parameter set */
+                else if (jacobian_method == AGTF30_JACOBIAN_EXACT)
+                    break;
+                continue;
+            }
+
+            if (jacobian_method == AGTF30_JACOBIAN_BROYDEN) {
+                resid0 = dep_scaled_max(p, DEP0);
+                resid = dep_scaled_max(p, res->DEP);
+                rebuild = !(resid <= BROYDEN_STALL_RATIO*resid0)
+                          || !broyden_update(p, res->CMD, CMD0, res->DEP, DEP0, Jinv);
+            }
+
+            /* Update baselines for command and dependent vectors */
+            memcpy(CMD0, res->CMD, AGTF30_NUM_CMD*sizeof(double));
+            memcpy(DEP0, res->DEP, AGTF30_NUM_DEP*sizeof(double));
+
+            /* check if Jacobian perturbation size should be adjusted */
+            if (res->solver_iterations % NumJPerSS == 0)
+                JPerSS = JPerSS/10;
+
+            if (jacobian_method == AGTF30_JACOBIAN_EXACT) {
+                /* Jacobian of the new baseline from its tangent evaluation */
+                if (exact_ok) {
+                    memcpy(J, Jpos, p->n*p->n*sizeof(double));
+                    invert_matrix(Jinv, J, p->n);
+                }
+                else if (jacobian_refresh(p, CMD0, DEP0, JPerSS, 0, Jpos, Jneg, J, Jinv)) {
+                    res->converged = 1;
+                    return;
+                }
+            }
+            else if (jacobian_method == AGTF30_JACOBIAN_BROYDEN) {
+                /* Rebuild the Jacobian when progress stalls or the update was rejected */
+                jacobian_fresh = rebuild;
+                if (rebuild) {
+                    #ifdef MATLAB_MEX_FILE
+                    if (p->enable_debug) {
+                    printf("Broyden update rejected at iteration %d, rebuilding Jacobian\n", res->solver_iterations);
+                    }
+                    #endif
+                    if (jacobian_refresh(p, CMD0, DEP0, JPerSS, jacobian_method == AGTF30_JACOBIAN_BROYDEN, Jpos, Jneg, J, Jinv)) {
+                        res->converged = 1;
+                        return;
+                    }
+                }
+            }
+            /* Update Jacobian every NRASS iterations */
+            else if (res->solver_iterations % NRASS == 0) {
+                if (jacobian_refresh(p, CMD0, DEP0, JPerSS, jacobian_method == AGTF30_JACOBIAN_BROYDEN, Jpos, Jneg, J, Jinv)) {
+                    res->converged = 1;
+                    return;
+                }
+            }
+        }
+    }
+
+    /*--- Reaching this point means convergence not achieved ---*/
+    res->converged = 0;
+}
+
+/* Evaluates every output at the point in p->res when the last evaluation
+ * skipped some. Only Y is replaced: DEP, X, U and E are kept as the
+ * convergence check saw them. Components that are unchanged since the
+ * last cached evaluation are reused. */
+static void full_outputs(struct NRProblem *p)
+{
+    AGTF30SolverResult *res = p->res;
+    double DEP[AGTF30_NUM_DEP], X[AGTF30_NUM_X], U[AGTF30_NUM_U], E[AGTF30_NUM_E];
+
+    if (p->full_outputs)
+        return;
+    p->ws->cache_mode = AGTF30_CACHE_KEEP;
+    p->ws->eval_level = AGTF30_EVAL_FULL;
+    AGTF30_engine_eval(p->ws, p->env, res->CMD, p->tar, p->health_params, p->blds, p->enable_debug,
+                       DEP, X, U, res->Y, E);
+    p->ws->cache_mode = AGTF30_CACHE_OFF;
+    res->model_evals++;
+    p->full_outputs = 1;
+}
+
+int AGTF30_nr_solver(AGTF30Workspace *ws, const double *env, const double *cmd_in, const double *tar,
+                     const double *health_params, const double *blds, const int *Ivec, const int *Dvec,
+                     const double enable_debug, int jacobian_method, AGTF30SolverResult *res)
+{
+    struct NRProblem p;
+    int i, k, nD = 0;
+
+    p.ws = ws;
+    p.env = env;
+    p.tar = tar;
+    p.health_params = health_params;
+    p.blds = blds;
+    p.enable_debug = enable_debug;
+    p.res = res;
+
+    /* Debug runs evaluate everything, their warnings cover every component */
+    p.eval_level = (enable_debug == 0) ? AGTF30_EVAL_RESIDUALS : AGTF30_EVAL_FULL;
+    p.full_outputs = 0;
+
+    p.n = 0;
+    for (i = 0; i < AGTF30_NUM_CMD; i++) {
+        if (Ivec[i])
+            p.Ivec_range[p.n++] = i;
+    }
+    for (k = 0; k < AGTF30_NUM_DEP; k++) {
+        if (Dvec[k])
+            p.Dvec_range[nD++] = k;
+    }
+
+    /*--- Make sure number of independents equals number of dependents ---*/
+    if (p.n != nD) {
+        #ifdef MATLAB_MEX_FILE
+        if (enable_debug) {
+        printf("Must have same number of Independents and Dependents!\n");
+        }
+        #endif
+        return -1;
+    }
+    group_columns(&p);
+
+    /* The nozzle throat seeds are taken from the runs of this solve only,
+     * so a solve does not depend on the calls made on the workspace before
+     * it, nor the calls after it on the solve. */
+    AGTF30_nozzle_seeds_clear(ws);
+    res->model_evals = 0;
+    nr_iterate(&p, cmd_in, Ivec, jacobian_method);
+    full_outputs(&p);
+    ws->eval_level = AGTF30_EVAL_FULL;
+    AGTF30_nozzle_seeds_clear(ws);
+    return 0;
+}
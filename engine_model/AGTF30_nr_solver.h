@@ -0,0 +1,49 @@
+#ifndef AGTF30_NR_SOLVER_H
+#define AGTF30_NR_SOLVER_H
+
+/*		AGTF30_nr_solver.h
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Native version of nr_solver.m. The engine model is called directly
+%  (AGTF30_engine_eval, AGTF30_engine_eval_batch and
+%  AGTF30_engine_eval_tangent) instead of through MEX_engine_model, and
+%  the steps, clamping, Jacobian formation and convergence checks of
+%  nr_solver.m are followed one for one.
+% *************************************************************************/
+
+#include "AGTF30_model.h"
+
+/*--- Jacobian strategies ---*/
+#define AGTF30_JACOBIAN_NEWTON   0  /* finite differences every NRASS iterations, as nr_solver.m */
+#define AGTF30_JACOBIAN_BROYDEN  1  /* Broyden updates, finite differences when progress stalls */
+#define AGTF30_JACOBIAN_EXACT    2  /* forward mode derivatives from every model call */
+
+/* Solution of one solver call. CMD, DEP, X, U, Y and E hold the values of
+ * the last model evaluation, as nr_solver.m returns them, with every
+ * output of Y evaluated. */
+struct AGTF30SolverResult {
+    double DEP[AGTF30_NUM_DEP];
+    double CMD[AGTF30_NUM_CMD];
+    double X[AGTF30_NUM_X];
+    double U[AGTF30_NUM_U];
+    double Y[AGTF30_NUM_Y];
+    double E[AGTF30_NUM_E];
+    int converged;
+    int solver_iterations;      /* iterations of the last parameter set tried */
+    int parameter_set;          /* last parameter set tried, 1 for the first */
+    int model_evals;            /* engine model evaluations over all parameter sets */
+};
+typedef struct AGTF30SolverResult AGTF30SolverResult;
+
+/* AGTF30_nr_solver.c
+ * Ivec (AGTF30_NUM_CMD entries) and Dvec (AGTF30_NUM_DEP entries) select the
+ * independents and dependents with nonzero entries. jacobian_method is one
+ * of the AGTF30_JACOBIAN_ strategies. Returns 0, or -1 when
+ * they select a different number of independents and dependents (the
+ * result is then left untouched). */
+extern int AGTF30_nr_solver(AGTF30Workspace *ws, const double *env, const double *cmd_in, const double *tar,
+                            const double *health_params, const double *blds, const int *Ivec, const int *Dvec,
+                            const double enable_debug, int jacobian_method, AGTF30SolverResult *res);
+
+#endif /* AGTF30_NR_SOLVER_H */
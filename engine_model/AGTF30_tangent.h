@@ -0,0 +1,127 @@
+#ifndef AGTF30_TANGENT_H
+#define AGTF30_TANGENT_H
+
+/*		AGTF30_tangent.h
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Forward mode (tangent) derivatives of the gas path routines.
+%
+%  Every quantity q of the model carries a tangent dq[AGTF30_NUM_DIR],
+%  the derivatives of q with respect to the AGTF30_NUM_CMD commands
+%  (independents). One pass through the model therefore gives the values
+%  and the full Jacobian dDEP/dCMD.
+%
+%  The tangent routines do not compute the model outputs themselves: they
+%  take the inputs, the input tangents and the outputs of the scalar body
+%  (the converged results of its iterations) and return the output
+%  tangents. Values therefore stay bit for bit those of the scalar bodies.
+%  Duct_TMATS_tangent is the exception: the duct body does not return the
+%  static pressure its tangent needs, so it computes the duct outputs with
+%  the operations of Duct_TMATS_body.
+%
+%  Iterative searches are differentiated through the equation they solve
+%  (implicit function theorem) instead of through their iterations:
+%   - h2tc:    t2hc(T, fa) = H             dT  = (dH - H_fa*dfa)/H_T
+%   - sp2tc:   pt2sc(P, T, fa) = S         dT  = (dS - S_P*dP - S_fa*dfa)/S_T
+%   - nozzle throat and StaticCalc Mach number searches:
+%              MN(Ps, ...) = MN target     dPs = -dMN/MN_Ps
+%   - StaticCalc area search:
+%              A(Ps, ...) = Athroat        dPs = -dA/A_Ps
+%  The derivatives are those of the exactly converged model, which the
+%  searches of TMATS_PROPERTIES_CONVERGED builds approach to 1e-9. The
+%  secant searches of the default build stop at MN within 0.001, so finite
+%  differences of that build scatter by a few percent about them. Table
+%  lookups are differentiated within the current cell, the C1 compressor
+%  and turbine maps (AGTF30_model_init_maps) through their splines
+%  (interp2Amd, interp3Amd); along an axis that is clamped to the table
+%  range the derivative is zero.
+%
+%  The SMN stall margins (SMNEn) are differentiated through the stall
+%  line tabulated at model init (stallline_TMATS.c), which depends on
+%  NcMap only.
+%
+%  Not differentiated (tangents set to NaN): design point calculations
+%  (IDes < 0.5), the SMN stall margin search of a compressor without a
+%  stall line, the divergent section of a choked CD nozzle and StaticCalc
+%  points with no flow. None of these is used by the AGTF30 off-design
+%  model.
+% *************************************************************************/
+
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+#include "AGTF30_model.h"
+
+/*--- Number of tangent directions: one per command ---*/
+#define AGTF30_NUM_DIR  AGTF30_NUM_CMD
+
+typedef double tan_t[AGTF30_NUM_DIR];
+
+/* properties_TMATS_tangent.c */
+extern void tan_zero(double *d);
+extern void tan_fill(double *d, double v);
+extern void tan_nan(double *d);
+extern void tan_copy(double *d, const double *a);
+extern void tan_scale(double *d, double ca, const double *a);
+extern void tan_lin2(double *d, double ca, const double *a, double cb, const double *b);
+extern void tan_lin3(double *d, double ca, const double *a, double cb, const double *b, double cc, const double *c);
+extern double divby_d(double X);
+extern double sqrtT_d(double X);
+
+extern void t2hc_tangent(double *dH, double T, const double *dT, double fa, const double *dfa);
+extern void h2tc_tangent(double *dT, double T, const double *dH, double fa, const double *dfa);
+extern void pt2sc_tangent(double *dS, double P, double T, double fa, const double *dP, const double *dT, const double *dfa);
+extern void sp2tc_tangent(double *dT, double T, double P, const double *dS, const double *dP, double fa, const double *dfa);
+
+extern double interp1Ac_tangent(double *dyi, double *X, double *Y, double xi, const double *dxi, int A);
+extern double interp2Ac_tangent(double *dzi, double *X, double *Y, double *Z, double xi, const double *dxi,
+                                double yi, const double *dyi, int A, int B);
+extern double interp3Ac_tangent(double *dvi, double *X, double *Y, double *Z, double *V, double xi, const double *dxi,
+                                double yi, const double *dyi, double zi, const double *dzi, int A, int B, int C);
+
+extern void PcalcStat_tangent(double Pt, double Ps, double Tt, double ht, double FAR, double Rt,
+                              const double *dPt, const double *dPs, const double *dTt, const double *dht,
+                              const double *dFAR, const double *dRt,
+                              double *Ts, double *rhos, double *V, double *dTs, double *drhos, double *dV);
+extern void PcalcStatMN_tangent(double Pt, double Ps, double Tt, double ht, double FAR, double Rt,
+                                const double *dPt, const double *dPs, const double *dTt, const double *dht,
+                                const double *dFAR, const double *dRt,
+                                double *X_FARVec, double *Y_TtVec, double *T_gammaArray, int A, int B,
+                                double *Ts, double *rhos, double *V, double *MN,
+                                double *dTs, double *drhos, double *dV, double *dgammas, double *dMN);
+
+/* StaticCalc_TMATS_tangent.c */
+extern void StaticCalc_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du,
+                                     const StaticCalcStruct* prm);
+extern void Duct_TMATS_tangent(double *y, tan_t *dy, const double *u, tan_t *du, const DuctStruct* prm,
+                               const double enable_debug);
+
+/* Compressor_TMATS_tangent.c */
+extern void Compressor_TMATS_tangent(tan_t *dy, tan_t *dy1, tan_t *dy2, const double *y, const double *y1,
+                                     const double *y2, const double *u, tan_t *du, const double* Wcust,
+                                     const double* FracWbld, const CompressorStruct* prm);
+
+/* Turbine_TMATS_tangent.c */
+extern void Turbine_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du,
+                                  const double *CoolFlow, tan_t *dCoolFlow, const TurbineStruct* prm);
+
+/* Nozzle_TMATS_tangent.c */
+extern void Nozzle_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du, const NozzleStruct* prm);
+
+/* Burner_TMATS_tangent.c */
+extern void Burner_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du, const BurnStruct* prm);
+
+/* Splitter_TMATS_tangent.c */
+extern void Splitter_TMATS_tangent(tan_t *dy, tan_t *dy1, const double *u, tan_t *du,
+                                   const double *u1, tan_t *du1);
+
+/* Valve_TMATS_tangent.c */
+extern void Valve_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du, const ValveStruct* prm);
+
+/* AGTF30_engine_eval_tangent.c */
+extern void AGTF30_engine_eval_tangent(AGTF30Workspace *ws, const double *env, const double *cmd, const double *tar,
+                                       const double *health_params, const double *blds, const double enable_debug,
+                                       double *DEP, double *X, double *U, double *Y, double *E,
+                                       double *dDEP, double *dY);
+
+#endif /* AGTF30_TANGENT_H */
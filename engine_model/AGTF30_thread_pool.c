@@ -0,0 +1,300 @@
+/*		AGTF30_thread_pool.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Persistent pool of worker threads for batched AGTF30 evaluation.
+%
+%  The workers are created by AGTF30_pool_start and stay alive between MEX
+%  calls until AGTF30_pool_shutdown. Each worker owns an AGTF30Workspace,
+%  so IWork error flags and HPC bleed vectors are never shared between
+%  threads. The caller thread takes part in every batch with its own
+%  workspace. Points are handed out one at a time from a shared counter,
+%  so the outputs do not depend on the number of threads.
+%
+%  The pool only grows: a batch that asks for fewer threads than there
+%  are workers, e.g. one with fewer points than cores, is run by the
+%  first workers only and the others keep waiting, so the threads are
+%  not recreated from one call to the next. The diagnostics of every
+%  workspace taking part are reset for each batch; afterwards the
+%  caller's and AGTF30_pool_diag(0..n-2), with n the number of threads
+%  returned by AGTF30_pool_eval, together hold the events of the batch.
+%
+%  The component bodies keep their scratch arrays (e.g. the ten 500-element
+%  bleed arrays in Compressor_TMATS_body) on the stack, which is private to
+%  each thread. Workers are created with AGTF30_THREAD_STACK_SIZE bytes of
+%  stack so these fit regardless of the platform default.
+% *************************************************************************/
+
+#include <stdlib.h>
+#include "AGTF30_model.h"
+#include "AGTF30_lanes.h"
+
+#define AGTF30_MAX_THREADS        256
+#define AGTF30_THREAD_STACK_SIZE  (4 * 1024 * 1024)
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE             pool_thread_t;
+typedef CRITICAL_SECTION   pool_mutex_t;
+typedef CONDITION_VARIABLE pool_cond_t;
+#define pool_mutex_init(m)   InitializeCriticalSection(m)
+#define pool_mutex_destroy(m) DeleteCriticalSection(m)
+#define pool_lock(m)         EnterCriticalSection(m)
+#define pool_unlock(m)       LeaveCriticalSection(m)
+#define pool_cond_init(c)    InitializeConditionVariable(c)
+#define pool_cond_destroy(c)
+#define pool_cond_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define pool_cond_broadcast(c) WakeAllConditionVariable(c)
+#define pool_cond_signal(c)  WakeConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t          pool_thread_t;
+typedef pthread_mutex_t    pool_mutex_t;
+typedef pthread_cond_t     pool_cond_t;
+#define pool_mutex_init(m)   pthread_mutex_init(m, NULL)
+#define pool_mutex_destroy(m) pthread_mutex_destroy(m)
+#define pool_lock(m)         pthread_mutex_lock(m)
+#define pool_unlock(m)       pthread_mutex_unlock(m)
+#define pool_cond_init(c)    pthread_cond_init(c, NULL)
+#define pool_cond_destroy(c) pthread_cond_destroy(c)
+#define pool_cond_wait(c, m) pthread_cond_wait(c, m)
+#define pool_cond_broadcast(c) pthread_cond_broadcast(c)
+#define pool_cond_signal(c)  pthread_cond_signal(c)
+#endif
+
+struct PoolWorker {
+    pool_thread_t   thread;
+    AGTF30Workspace ws;
+};
+
+struct Pool {
+    int num_workers;                /* worker threads, not counting the caller */
+    struct PoolWorker *workers;
+
+    pool_mutex_t lock;
+    pool_cond_t  work_cv;           /* signalled when a new batch is posted */
+    pool_cond_t  done_cv;           /* signalled when the last worker finishes */
+
+    const AGTF30Batch *batch;
+    int participants;               /* workers taking part in the batch, the first ones */
+    unsigned int next;              /* next point to hand out */
+    unsigned int generation;        /* incremented for every batch */
+    int active;                     /* workers still busy with the current batch */
+    int stop;
+};
+
+static struct Pool pool;
+static int pool_running = 0;
+
+/* Hands out the next unclaimed points first..*last-1, or returns batch->N
+ * when none are left. The lane kernels take a full lane group at a time. */
+static unsigned int pool_claim(unsigned int *last)
+{
+    unsigned int j, n;
+
+    n = pool.batch->use_lanes ? AGTF30_LANES : 1;
+    pool_lock(&pool.lock);
+    j = pool.next;
+    if (j < pool.batch->N)
+        pool.next = (pool.batch->N - j > n) ? j + n : pool.batch->N;
+    *last = pool.next;
+    pool_unlock(&pool.lock);
+    return j;
+}
+
+static void pool_run_batch(AGTF30Workspace *ws)
+{
+    unsigned int j, last;
+
+    while ((j = pool_claim(&last)) < pool.batch->N)
+        AGTF30_engine_eval_batch(ws, pool.batch, j, last);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI pool_worker_main(LPVOID arg)
+#else
+static void* pool_worker_main(void *arg)
+#endif
+{
+    struct PoolWorker *w = (struct PoolWorker*)arg;
+    int index = (int)(w - pool.workers);
+    unsigned int seen = 0;
+
+    for (;;) {
+        pool_lock(&pool.lock);
+        while ((pool.generation == seen || index >= pool.participants) && !pool.stop) {
+            seen = pool.generation;
+            pool_cond_wait(&pool.work_cv, &pool.lock);
+        }
+        if (pool.stop) {
+            pool_unlock(&pool.lock);
+            break;
+        }
+        seen = pool.generation;
+        pool_unlock(&pool.lock);
+
+        AGTF30_diag_reset(&w->ws.diag);
+        pool_run_batch(&w->ws);
+
+        pool_lock(&pool.lock);
+        if (--pool.active == 0)
+            pool_cond_signal(&pool.done_cv);
+        pool_unlock(&pool.lock);
+    }
+    return 0;
+}
+
+/* Number of processors available to this process */
+int AGTF30_num_cores(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return (int)si.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+#endif
+}
+
+/* Makes sure num_threads threads (the caller plus num_threads-1 workers)
+ * are available. A running pool with fewer workers is restarted, a larger
+ * one is kept. Returns the number of threads actually available. */
+int AGTF30_pool_start(const AGTF30Model *mdl, int num_threads)
+{
+    int i;
+#ifndef _WIN32
+    pthread_attr_t attr;
+#endif
+
+    if (num_threads < 1)
+        num_threads = 1;
+    if (num_threads > AGTF30_MAX_THREADS)
+        num_threads = AGTF30_MAX_THREADS;
+
+    if (pool_running && pool.num_workers >= num_threads - 1)
+        return pool.num_workers + 1;
+    AGTF30_pool_shutdown();
+
+    pool.workers = (struct PoolWorker*)calloc((size_t)(num_threads - 1) + 1, sizeof(struct PoolWorker));
+    if (pool.workers == NULL)
+        return 1;
+
+    pool_mutex_init(&pool.lock);
+    pool_cond_init(&pool.work_cv);
+    pool_cond_init(&pool.done_cv);
+    pool.batch = NULL;
+    pool.participants = 0;
+    pool.next = 0;
+    pool.generation = 0;
+    pool.active = 0;
+    pool.stop = 0;
+    pool.num_workers = 0;
+
+#ifndef _WIN32
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, AGTF30_THREAD_STACK_SIZE);
+#endif
+    for (i = 0; i < num_threads - 1; i++) {
+        AGTF30_workspace_init(&pool.workers[i].ws, mdl);
+#ifdef _WIN32
+        pool.workers[i].thread = CreateThread(NULL, AGTF30_THREAD_STACK_SIZE, pool_worker_main,
+                                              &pool.workers[i], STACK_SIZE_PARAM_IS_A_RESERVATION, NULL);
+        if (pool.workers[i].thread == NULL)
+            break;
+#else
+        if (pthread_create(&pool.workers[i].thread, &attr, pool_worker_main, &pool.workers[i]) != 0)
+            break;
+#endif
+        pool.num_workers++;
+    }
+#ifndef _WIN32
+    pthread_attr_destroy(&attr);
+#endif
+
+    pool_running = 1;
+    return pool.num_workers + 1;
+}
+
+/* Evaluates every point of the batch using the caller thread and at most
+ * num_threads-1 workers, no more than there are points. Returns the number
+ * of threads used, the caller included. */
+int AGTF30_pool_eval(AGTF30Workspace *caller_ws, const AGTF30Batch *b, int num_threads)
+{
+    int participants;
+
+    AGTF30_diag_reset(&caller_ws->diag);
+    participants = pool_running ? pool.num_workers : 0;
+    if (participants > num_threads - 1)
+        participants = num_threads - 1;
+    if ((unsigned int)participants > b->N - 1)
+        participants = (int)(b->N - 1);
+    if (participants <= 0) {
+        AGTF30_engine_eval_batch(caller_ws, b, 0, b->N);
+        return 1;
+    }
+
+    pool_lock(&pool.lock);
+    pool.batch = b;
+    pool.participants = participants;
+    pool.next = 0;
+    pool.active = participants;
+    pool.generation++;
+    pool_cond_broadcast(&pool.work_cv);
+    pool_unlock(&pool.lock);
+
+    pool_run_batch(caller_ws);
+
+    pool_lock(&pool.lock);
+    while (pool.active > 0)
+        pool_cond_wait(&pool.done_cv, &pool.lock);
+    pool.batch = NULL;
+    pool_unlock(&pool.lock);
+    return participants + 1;
+}
+
+/* Number of worker threads, not counting the caller */
+int AGTF30_pool_num_workers(void)
+{
+    return pool_running ? pool.num_workers : 0;
+}
+
+/* Diagnostics of a worker from the last batch, NULL for no such worker */
+const AGTF30Diag* AGTF30_pool_diag(int worker)
+{
+    if (!pool_running || worker < 0 || worker >= pool.num_workers)
+        return NULL;
+    return &pool.workers[worker].ws.diag;
+}
+
+/* Stops and joins all workers. Safe to call when the pool is not running. */
+void AGTF30_pool_shutdown(void)
+{
+    int i;
+
+    if (!pool_running)
+        return;
+
+    pool_lock(&pool.lock);
+    pool.stop = 1;
+    pool_cond_broadcast(&pool.work_cv);
+    pool_unlock(&pool.lock);
+
+    for (i = 0; i < pool.num_workers; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(pool.workers[i].thread, INFINITE);
+        CloseHandle(pool.workers[i].thread);
+#else
+        pthread_join(pool.workers[i].thread, NULL);
+#endif
+    }
+
+    pool_cond_destroy(&pool.work_cv);
+    pool_cond_destroy(&pool.done_cv);
+    pool_mutex_destroy(&pool.lock);
+    free(pool.workers);
+    pool.workers = NULL;
+    pool.num_workers = 0;
+    pool_running = 0;
+}
@@ -1,8 +1,10 @@
 #include "mex.h"
 #include <math.h>
 #include <stdio.h>
+#include <stddef.h>
 #include "types_TMATS.h"
 #include "constants_TMATS.h"
+#include "functions_TMATS.h"
 
 
 /* Input Arguments */
@@ -21,6 +23,44 @@
 
 extern void Ambient_TMATS_body(double *y, const double *u, const AmbientStruct* prm);
 
+/*--- Ambient tables, the same as those of the engine model (AGTF30_model_data.c) ---*/
+static double GTF_ambient_X_A_AltVec[15] = {-5000, 0, 5000, 10000, 15000, 20000, 25000, 30000, 35000, 40000, 45000, 50000, 60000, 70000, 80000};
+static double GTF_ambient_T_A_TsVec[15] = {536.51, 518.67, 500.84, 483.03, 465.22, 447.41, 429.62, 411.84, 394.06, 389.97, 389.97, 389.97, 389.97, 392.25, 397.69};
+static double GTF_ambient_T_A_PsVec[15] = {17.554, 14.696, 12.228, 10.108, 8.297, 6.759, 5.461, 4.373, 3.468, 2.73, 2.149, 1.692, 1.049, 0.651, 0.406};
+static double GTF_ambient_X_A_FARVec[7] = {0, 0.0050, 0.0100, 0.0150, 0.0200, 0.0250, 0.0300};
+static double GTF_ambient_T_A_RtArray[7] = {0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686};
+static double GTF_ambient_Y_A_TVec[2] = {300, 10000};
+static double GTF_ambient_T_A_gammaArray[14] = {1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4};
+static int GTF_ambient_A = 15;
+static int GTF_ambient_B = 7;
+static int GTF_ambient_C = 2;
+
+/*--- Interpolation kernels and flow functions of the tables, set up on the
+ * first call as AGTF30_model_init sets them up for the engine model, so
+ * that both compute the same Pt ---*/
+#ifndef TMATS_PROPERTIES_REFERENCE
+static InterpTable GTF_ambient_K[4];
+#ifdef TMATS_PROPERTIES_CONVERGED
+static FlowTable GTF_ambient_flow;
+#endif
+static int GTF_ambient_initialized = 0;
+
+static void ambient_init(void)
+{
+    gas_tables_init();
+#ifdef TMATS_PROPERTIES_CONVERGED
+    flow_table_init(&GTF_ambient_flow, GTF_ambient_X_A_FARVec, GTF_ambient_T_A_RtArray, GTF_ambient_Y_A_TVec,
+                    GTF_ambient_T_A_gammaArray, GTF_ambient_B, GTF_ambient_C);
+#endif
+    interp_table_init(&GTF_ambient_K[0], GTF_ambient_X_A_AltVec, NULL, NULL, GTF_ambient_T_A_TsVec, GTF_ambient_A, 0, 0, 0);
+    interp_table_init(&GTF_ambient_K[1], GTF_ambient_X_A_AltVec, NULL, NULL, GTF_ambient_T_A_PsVec, GTF_ambient_A, 0, 0, 0);
+    interp_table_init(&GTF_ambient_K[2], GTF_ambient_X_A_FARVec, NULL, NULL, GTF_ambient_T_A_RtArray, GTF_ambient_B, 0, 0, 0);
+    interp_table_init(&GTF_ambient_K[3], GTF_ambient_X_A_FARVec, GTF_ambient_Y_A_TVec, NULL, GTF_ambient_T_A_gammaArray,
+                      GTF_ambient_B, GTF_ambient_C, 0, 0);
+    GTF_ambient_initialized = 1;
+}
+#endif
+
 void mexFunction(int nlhs, mxArray *plhs[],
                  int nrhs, const mxArray *prhs[])
 {
@@ -32,7 +72,7 @@ void mexFunction(int nlhs, mxArray *plhs[],
     /*--- Define Block Inputs/Outputs ---*/
     /*--- Ambient ---*/
     double amb_u[3]; /*--- Inputs:  Alt, dTamb, MN ---*/
-    double amb_y[4]; /*--- Outputs: Tt, Pt, Ps, Ts ---*/
+    double amb_y[8]; /*--- Outputs: ht, Tt, Pt, FAR, Ps, Ts, Veng, Test ---*/
 
     /*--- Define Output Vector Pointers ---*/
     double *AMB; /*--- Outputs ---*/
@@ -48,18 +88,8 @@ void mexFunction(int nlhs, mxArray *plhs[],
     /*===================================================================*/
     /*--- Define GTF ambient structure ---*/
     double GTF_ambient_AFARc = 0;
-    double GTF_ambient_X_A_AltVec[15] = {-5000, 0, 5000, 10000, 15000, 20000, 25000, 30000, 35000, 40000, 45000, 50000, 60000, 70000, 80000};
-    double GTF_ambient_T_A_TsVec[15] = {536.51, 518.67, 500.84, 483.03, 465.22, 447.41, 429.62, 411.84, 394.06, 389.97, 389.97, 389.97, 389.97, 392.25, 397.69};
-    double GTF_ambient_T_A_PsVec[15] = {17.554, 14.696, 12.228, 10.108, 8.297, 6.759, 5.461, 4.373, 3.468, 2.73, 2.149, 1.692, 1.049, 0.651, 0.406};
-    double GTF_ambient_X_A_FARVec[7] = {0, 0.0050, 0.0100, 0.0150, 0.0200, 0.0250, 0.0300};
-    double GTF_ambient_T_A_RtArray[7] = {0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686};
-    double GTF_ambient_Y_A_TVec[2] = {300, 10000};
-    double GTF_ambient_T_A_gammaArray[14] = {1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4};
     char GTF_ambient_BlkNm[13] = "GTF_ambient\0";
     int GTF_ambient_IWork[5] = {0, 0, 0, 0, 0};
-    int GTF_ambient_A = 15;
-    int GTF_ambient_B = 7;
-    int GTF_ambient_C = 2;
     
     struct AmbientStruct GTF_ambient = {
         GTF_ambient_AFARc,
@@ -75,8 +105,26 @@ void mexFunction(int nlhs, mxArray *plhs[],
         GTF_ambient_A,
         GTF_ambient_B,
         GTF_ambient_C,
+        /* Flow functions and interpolation kernels (set below) */
+        NULL,
+        NULL,
+        NULL,
+        NULL,
+        NULL,
     };
 
+#ifndef TMATS_PROPERTIES_REFERENCE
+    if (!GTF_ambient_initialized)
+        ambient_init();
+#ifdef TMATS_PROPERTIES_CONVERGED
+    GTF_ambient.Flow = &GTF_ambient_flow;
+#endif
+    GTF_ambient.K_A_Ts = &GTF_ambient_K[0];
+    GTF_ambient.K_A_Ps = &GTF_ambient_K[1];
+    GTF_ambient.K_A_Rt = &GTF_ambient_K[2];
+    GTF_ambient.K_A_gamma = &GTF_ambient_K[3];
+#endif
+
     /*===================================================================*/
     /*===================================================================*/
     /* Check for proper number of arguments. */
@@ -22,10 +22,15 @@ void Burner_TMATS_body(double* y, const double* u, const BurnStruct* prm)
     double htin;
     double htOut, TtOut, PtOut, FARcOut, WOut;
     double Test;
+    GasMix mix;
     
-     /*-- Compute Input enthalpy (empirical) --------*/
+     /*-- Compute Input enthalpy, or take it from the incoming station --------*/
     
+#ifndef TMATS_PROPERTIES_CONVERGED
     htin = t2hc(TtIn,FARcIn);
+#else
+    htin = htIn;
+#endif
     
     /*-- Compute Flow output  --------*/
     
@@ -43,7 +48,8 @@ void Burner_TMATS_body(double* y, const double* u, const BurnStruct* prm)
     
     /*------ Compute Temperature output ---------*/
     
-    TtOut = h2tc(htOut,FARcOut);
+    gasmix(&mix, FARcOut);
+    TtOut = h2tc_mix(&mix, htOut);
     
     /*------ Compute pressure output ---------*/
     PtOut = (1- prm->dPnormBurner) * PtIn;
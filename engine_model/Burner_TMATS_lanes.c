@@ -0,0 +1,51 @@
+/*		T-MATS -- Burner_TMATS_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane version of Burner_TMATS_body.
+% *************************************************************************/
+
+#include "AGTF30_lanes.h"
+
+void Burner_TMATS_lanes(lane_t *y, const lane_t *u, const BurnStruct* prm)
+{
+    const double *WfIn   = u[0];     /* Input Fuel Flow[pps] */
+    const double *WIn    = u[1];     /* Input Flow [pps] */
+    const double *PtIn   = u[4];     /* Pressure Input [psia] */
+    const double *FARcIn = u[5];     /* Combusted Fuel to Air Ratio [frac] */
+
+    lane_t htin, htOut, FARcOut;
+    double WOut;
+    int l;
+
+    /*-- Compute Input enthalpy, or take it from the incoming station --------*/
+#ifndef TMATS_PROPERTIES_CONVERGED
+    t2hc_lanes(htin, u[3], FARcIn);
+#else
+    for (l = 0; l < AGTF30_LANES; l++)
+        htin[l] = u[2][l];
+#endif
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        /*-- Compute Flow output  --------*/
+        WOut = WIn[l] + WfIn[l];     /*Perfect combustion*/
+
+        /*-- Compute Input fuel to air ratio --*/
+        FARcOut[l] = (WIn[l]* FARcIn[l] + WfIn[l])*DIVBY_L(WIn[l]*(1-FARcIn[l]));
+
+        /*------ Compute enthalpy output ---------*/
+        if (prm->LHVEn < 0.5)
+            htOut[l] = (WIn[l]*htin[l] + WfIn[l]*prm->hFuel)*DIVBY_L(WOut);
+        else
+            htOut[l] = (WIn[l]*htin[l] + WfIn[l]*prm->LHV*prm->Eff)*DIVBY_L(WOut);
+
+        y[0][l] = WOut;                             /* Output Air Flow [pps]	*/
+        y[1][l] = htOut[l];                         /* Output Enthalpy [BTU/lbm] */
+        y[3][l] = (1- prm->dPnormBurner) * PtIn[l]; /* Output Pressure [psia]	*/
+        y[4][l] = FARcOut[l];                       /* Output Combusted Fuel to Air Ratio [frac] */
+        y[5][l] = htin[l];                          /* Output Test Point */
+    }
+
+    /*------ Compute Temperature output ---------*/
+    h2tc_lanes(y[2], htOut, FARcOut);
+}
@@ -0,0 +1,54 @@
+/*
+ * Tangent version of Burner_TMATS_body. du holds the tangents of the
+ * inputs u[0..5] (Wf, W, ht, Tt, Pt, FAR) and y the outputs of the body.
+ */
+
+#include "types_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+void Burner_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du, const BurnStruct* prm)
+{
+    double WfIn   = u[0];     /* Input Fuel Flow[pps] */
+    double WIn    = u[1];     /* Input Flow [pps] */
+    double FARcIn = u[5];     /* Combusted Fuel to Air Ratio [frac] */
+
+    double WOut = y[0], TtOut = y[2], FARcOut = y[4];
+    double htin, hf, num, den;
+    tan_t dhtin, dnum, dden;
+    int k;
+
+    /*-- Input enthalpy --------*/
+#ifndef TMATS_PROPERTIES_CONVERGED
+    htin = t2hc(u[3],FARcIn);
+    t2hc_tangent(dhtin, u[3], du[3], FARcIn, du[5]);
+#else
+    htin = u[2];
+    tan_copy(dhtin, du[2]);
+#endif
+
+    /*-- Flow output: WOut = WIn + WfIn --------*/
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dy[0][k] = du[1][k] + du[0][k];
+
+    /*-- Fuel to air ratio: (WIn*FARcIn + WfIn)*divby(WIn*(1-FARcIn)) --*/
+    num = WIn*FARcIn + WfIn;
+    den = WIn*(1-FARcIn);
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dnum[k] = du[1][k]*FARcIn + WIn*du[5][k] + du[0][k];
+        dden[k] = du[1][k]*(1-FARcIn) - WIn*du[5][k];
+    }
+    tan_lin2(dy[4], divby(den), dnum, num*divby_d(den), dden);
+
+    /*------ enthalpy output: (WIn*htin + WfIn*hf)*divby(WOut) ---------*/
+    hf = prm->LHVEn < 0.5 ? prm->hFuel : prm->LHV*prm->Eff;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dnum[k] = du[1][k]*htin + WIn*dhtin[k] + du[0][k]*hf;
+    num = WIn*htin + WfIn*hf;
+    tan_lin2(dy[1], divby(WOut), dnum, num*divby_d(WOut), dy[0]);
+
+    /*------ Temperature and pressure outputs ---------*/
+    h2tc_tangent(dy[2], TtOut, dy[1], FARcOut, dy[4]);
+    tan_scale(dy[3], 1 - prm->dPnormBurner, du[4]);
+    tan_copy(dy[5], dhtin);
+}
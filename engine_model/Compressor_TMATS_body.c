@@ -29,9 +29,10 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
     double WOut, htOut, TtOut, PtOut, FARcOut, TorqueOut, NErrorOut;
     double C_Nc, C_Wc, C_PR, C_Eff;
     double htin, Sin, Wcin, WcCalcin, WcMap, theta,delta, Pwrout, Wbleeds;
-    double TtIdealout, htIdealout, Test, Sout, NcMap, Nc, PRMap, PR, EffMap, Eff;
+    double TtIdealout, htIdealout, Test, NcMap, Nc, PRMap, PR, EffMap, Eff;
     double Wb4bleed, Pwrb4bleed, PwrBld;
     double SPR, SPRMap, SMavail, SMMap;
+    double inf = HUGE_VAL;
 
     /* Define Arrays for bleed calcs */
     int MaxNumberBleeds = 100;
@@ -53,21 +54,18 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
     
     // Variables for iterative search to find Rline stall
     int interpErr = 0;
+    GasMix mix;
     int iterations;
     double RlineErr, RlineErrOld, RlineGuess;
     double RlineGuessBounds[2];
     double WcMapTemp, PRMapTemp, SPRMapTemp;
 
+    /* Wc, PR and Eff maps, read together */
+    double *MapTbl[3], MapVal[3];
+
     /*-- Compute output Fuel to Air Ratio ---*/
     FARcOut = FARcIn;
-
-    /*-- Compute Input enthalpy --------*/
-
-    htin = t2hc(TtIn,FARcIn);
-
-    /*-- Compute Input entropy  --------*/
-
-    Sin = pt2sc(PtIn,TtIn,FARcIn);
+    gasmix(&mix, FARcIn);
 
     /*---- calculate misc. fluid condition related variables and corrected Flow --*/
     delta = PtIn / C_PSTD;
@@ -83,11 +81,17 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
 
     NcMap = Nc *divby(C_Nc);
 
-    /*-- Compute Total Flow input (from Compressor map)  --------*/
+    /*-- Look up Wc, PR and Eff at the map point in one search  --------*/
+    MapTbl[0] = prm->T_C_Map_WcArray;
+    MapTbl[1] = prm->T_C_Map_PRArray;
+    MapTbl[2] = prm->T_C_Map_EffArray;
     if(prm->C > 1)
-        WcMap = interp3Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,prm->T_C_Map_WcArray,Rline,NcMap,Alpha,prm->B,prm->A,prm->C,&interpErr);
+        interp3Am(prm->M_C_Map,prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,MapTbl,3,Rline,NcMap,Alpha,prm->B,prm->A,prm->C,prm->MapCell,MapVal,&interpErr);
     else
-        WcMap = interp2Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->T_C_Map_WcArray,Rline,NcMap,prm->B,prm->A,&interpErr);
+        interp2Am(prm->M_C_Map,prm->X_C_RlineVec,prm->Y_C_Map_NcVec,MapTbl,3,Rline,NcMap,prm->B,prm->A,prm->MapCell,MapVal,&interpErr);
+
+    /*-- Compute Total Flow input (from Compressor map)  --------*/
+    WcMap = MapVal[0];
 
     if ((prm->WcMapCol != prm->B || prm->WcMapRw != prm->A || prm->WcMapLay !=prm->C) && *(prm->IWork+Er1)==0){
         #ifdef MATLAB_MEX_FILE
@@ -114,10 +118,7 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
     WcCalcin = WcMap * C_Wc;
 
     /*-- Compute Pressure Ratio (from Compressor map)  --------*/
-    if(prm->C > 1)
-        PRMap = interp3Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,prm->T_C_Map_PRArray,Rline,NcMap,Alpha,prm->B,prm->A,prm->C,&interpErr);
-    else
-        PRMap = interp2Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->T_C_Map_PRArray,Rline,NcMap,prm->B,prm->A,&interpErr);
+    PRMap = MapVal[1];
 
     if ((prm->PRMapCol != prm->B || prm->PRMapRw != prm->A || prm->PRMapLay !=prm->C) && *(prm->IWork+Er2)==0){
         #ifdef MATLAB_MEX_FILE
@@ -144,10 +145,7 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
     PR = C_PR*(PRMap - 1) + 1 ;
 
     /*-- Compute Efficiency (from Compressor map) ---*/
-    if(prm->C > 1)
-        EffMap = interp3Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,prm->T_C_Map_EffArray,Rline,NcMap,Alpha,prm->B,prm->A,prm->C,&interpErr);
-    else
-        EffMap = interp2Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->T_C_Map_EffArray,Rline,NcMap,prm->B,prm->A,&interpErr);
+    EffMap = MapVal[2];
 
     if ((prm->EffMapCol != prm->B || prm->EffMapRw != prm->A || prm->EffMapLay !=prm->C) && *(prm->IWork+Er3)==0){
         #ifdef MATLAB_MEX_FILE
@@ -180,19 +178,10 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
 
     /*------ enthalpy calculations ---------*/
 
-    /* ---- Ideal enthalpy ----*/
-    Sout = Sin;
-    TtIdealout = sp2tc(Sout,PtOut,FARcIn);
-    htIdealout = t2hc(TtIdealout,FARcIn);
-
-
-    /* ---- Final enthalpy output ----*/
-
-    htOut = ((htIdealout - htin)*divby(Eff)) + htin;
-
-    /*------ Compute Temperature output ---------*/
-
-    TtOut = h2tc(htOut,FARcIn);
+    /* ---- Input enthalpy and entropy, ideal and final enthalpy and  ----*/
+    /* ---- temperature output, each search started from the last     ----*/
+    isentropic_mix(&mix, TtIn, PtIn, PtOut, Eff, 0, &htin, &Sin,
+                   &TtIdealout, &htIdealout, &TtOut, &htOut);
 
 
     /* initalize Bleed sums components */
@@ -217,7 +206,7 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
             FARcustOut[i] = FARcIn;
             htcustOut[i] = htin + prm->FracCusBldht[i]*(htOut - htin); /* calculate customer bleed enthalpy */
             PtcustOut[i] = PtIn + prm->FracCusBldPt[i]*(PtOut -PtIn); /* calculate customer bleed Total Pressure */
-            TtcustOut[i] = h2tc(htcustOut[i],FARcustOut[i]); /* calculate customer bleed Total Temp */
+            TtcustOut[i] = h2tc_from(&mix, htcustOut[i], TtIn); /* calculate customer bleed Total Temp */
             PwrBld = PwrBld + WcustOut[i]*(htcustOut[i]-htOut)*C_BTU_PER_SECtoHP;  /* calculate customer bleed power */
         }
         if (i > 4*MaxNumberBleeds && *(prm->IWork+Er4)==0){
@@ -249,7 +238,7 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
             FARbldOut[i] = FARcIn;
             PtbldOut[i] = PtIn + prm->FracBldPt[i]*(PtOut -PtIn); /* calculate  bleed Total Pressure */
             htbldOut[i] = htin + prm->FracBldht[i]*(htOut - htin); /* calculate  bleed enthalpy */
-            TtbldOut[i] = h2tc(htbldOut[i],FARbldOut[i]); /* calculate  bleed Total Temp */
+            TtbldOut[i] = h2tc_from(&mix, htbldOut[i], TtIn); /* calculate  bleed Total Temp */
             PwrBld = PwrBld + WbldOut[i]*(htbldOut[i]-htOut)*C_BTU_PER_SECtoHP;  /* calculate bleed power */
         }
         if (i > 4*MaxNumberBleeds && *(prm->IWork+Er4)==0){
@@ -285,7 +274,12 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
         NErrorOut = (Wcin - WcCalcin)*divby(Wcin);
 
     /* Compute Stall Margin */
-    if (prm->C > 1){
+    if (prm->SMSkip){
+        /* Not wanted by the caller: NaN, carried by the SMW expressions below */
+        SPRMap = inf - inf;
+        interpErr = 0;
+    }
+    else if (prm->C > 1){
         /* Define 1-prm->D surge margin vectors based on alpha */
         for (i = 0; i < prm->D/prm->C; i++){
             SMWcVec[i] = interp1Ac(prm->Z_C_AlphaVec, prm->X_C_Map_WcSurgeVec + prm->C*i, Alpha,prm->C, &interpErr);
@@ -318,7 +312,7 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
         }
     }
     else
-        SPRMap = interp1Ac(prm->X_C_Map_WcSurgeVec,prm->T_C_Map_PRSurgeVec,WcMap,prm->D,&interpErr);
+        SPRMap = interp1At(prm->K_C_PRSurge,prm->X_C_Map_WcSurgeVec,prm->T_C_Map_PRSurgeVec,WcMap,prm->D,NULL,&interpErr);
         
     if (interpErr == 1 && *(prm->IWork+Er5)==0){
         #ifdef MATLAB_MEX_FILE
@@ -331,78 +325,89 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
     SPR = C_PR*(SPRMap - 1) + 1;
     
     // If SMN calculation desired instead of SMW (via checkbox in mask)...
-    if (prm->SMNEn > 0.5)
+    if (prm->SMNEn > 0.5 && !prm->SMSkip)
     {
-        // Iterative stall r-line finder, via binary search.
-        // Should not take many iterations since this is an easy search.
-        // Assumes RlineVec is monotonically increasing and that the stall
-        // line is a function with an inverse.
         iterations = 20;
-        RlineErr = 1000;
-        RlineGuessBounds[0] = prm->X_C_RlineVec[0];
-        RlineGuessBounds[1] = prm->X_C_RlineVec[prm->B - 1];
-        while ( ((iterations--) > 0) && abs(RlineErr) > 0.01)
+        if (prm->StallLine != NULL)
         {
-            // Take a guess at the stall R-line for current speed, use the
-            // middle of our current search range (which narrows as we go)
-            RlineGuess = (RlineGuessBounds[0] + RlineGuessBounds[1]) / 2;
-            // Look up the Wc and PR at current Nc, and guessed R-line.
-            if(prm->C > 1)
-                WcMapTemp = interp3Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,prm->T_C_Map_WcArray,RlineGuess,NcMap,Alpha,prm->B,prm->A,prm->C,&interpErr);
-            else
-                WcMapTemp = interp2Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->T_C_Map_WcArray,RlineGuess,NcMap,prm->B,prm->A,&interpErr);
-            if(prm->C > 1)
-                PRMapTemp = interp3Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,prm->T_C_Map_PRArray,RlineGuess,NcMap,Alpha,prm->B,prm->A,prm->C,&interpErr);
-            else
-                PRMapTemp = interp2Ac(prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->T_C_Map_PRArray,RlineGuess,NcMap,prm->B,prm->A,&interpErr);
-            
-            // Compute the stall pressure ratio of the guess point.
-            // Take the difference between that stall PR and the PR of the
-            // guess point. As the guess point gets closer to the stall
-            // line, this difference will get closer to zero. Once we're
-            // there, the guess value for Rline will be the stall Rline.
-            if (prm->C > 1)
+            // Stall Wc and PR at the current speed, from the stall line
+            // found per speed line of the map at model init
+            // (stallline_TMATS.c) by the search below.
+            if (stall_line(prm->StallLine, NcMap, Alpha, &WcMapTemp, &PRMapTemp))
+                iterations = 0;
+        }
+        else
+        {
+            // Iterative stall r-line finder, via binary search.
+            // Should not take many iterations since this is an easy search.
+            // Assumes RlineVec is monotonically increasing and that the stall
+            // line is a function with an inverse.
+            RlineErr = 1000;
+            RlineGuessBounds[0] = prm->X_C_RlineVec[0];
+            RlineGuessBounds[1] = prm->X_C_RlineVec[prm->B - 1];
+            while ( ((iterations--) > 0) && fabs(RlineErr) > 0.01)
             {
-                SPRMapTemp = interp1Ac(SMWcVec, SMPRVec,WcMapTemp,prm->D/prm->C,&interpErr);
-                if (interpErr == 1 && *(prm->IWork+Er5)==0){
-                    #ifdef MATLAB_MEX_FILE
-                    if (enable_debug) {
-                    printf("Warning in %s, Error calculating 2D SPR for SMN solver. Vector definitions may need to be expanded.\n", prm->BlkNm);
-                    #endif
-                    *(prm->IWork+Er5) = 1;
+                // Take a guess at the stall R-line for current speed, use the
+                // middle of our current search range (which narrows as we go)
+                RlineGuess = (RlineGuessBounds[0] + RlineGuessBounds[1]) / 2;
+                // Look up the Wc and PR at current Nc, and guessed R-line.
+                if(prm->C > 1)
+                    interp3Am(prm->M_C_Map,prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,MapTbl,2,RlineGuess,NcMap,Alpha,prm->B,prm->A,prm->C,prm->MapCell,MapVal,&interpErr);
+                else
+                    interp2Am(prm->M_C_Map,prm->X_C_RlineVec,prm->Y_C_Map_NcVec,MapTbl,2,RlineGuess,NcMap,prm->B,prm->A,prm->MapCell,MapVal,&interpErr);
+                WcMapTemp = MapVal[0];
+                PRMapTemp = MapVal[1];
+            
+                // Compute the stall pressure ratio of the guess point.
+                // Take the difference between that stall PR and the PR of the
+                // guess point. As the guess point gets closer to the stall
+                // line, this difference will get closer to zero. Once we're
+                // there, the guess value for Rline will be the stall Rline.
+                if (prm->C > 1)
+                {
+                    SPRMapTemp = interp1Ac(SMWcVec, SMPRVec,WcMapTemp,prm->D/prm->C,&interpErr);
+                    if (interpErr == 1 && *(prm->IWork+Er5)==0){
+                        #ifdef MATLAB_MEX_FILE
+                        if (enable_debug) {
+                        printf("Warning in %s, Error calculating 2D SPR for SMN solver. Vector definitions may need to be expanded.\n", prm->BlkNm);
+                        }
+                        #endif
+                        *(prm->IWork+Er5) = 1;
+                    }
                 }
-            }
-            else
-            {
-                SPRMapTemp = interp1Ac(prm->X_C_Map_WcSurgeVec,prm->T_C_Map_PRSurgeVec,WcMapTemp,prm->D,&interpErr);
-                if (interpErr == 1 && *(prm->IWork+Er5)==0){
-                    #ifdef MATLAB_MEX_FILE
-                    if (enable_debug) {
-                    printf("Warning in %s, Error calculating SPR for SMN solver. Vector definitions may need to be expanded.\n", prm->BlkNm);
+                else
+                {
+                    SPRMapTemp = interp1At(prm->K_C_PRSurge,prm->X_C_Map_WcSurgeVec,prm->T_C_Map_PRSurgeVec,WcMapTemp,prm->D,NULL,&interpErr);
+                    if (interpErr == 1 && *(prm->IWork+Er5)==0){
+                        #ifdef MATLAB_MEX_FILE
+                        if (enable_debug) {
+                        printf("Warning in %s, Error calculating SPR for SMN solver. Vector definitions may need to be expanded.\n", prm->BlkNm);
+                        }
+                        #endif
+                        *(prm->IWork+Er5) = 1;
                     }
-                    #endif
-                    *(prm->IWork+Er5) = 1;
                 }
-            }
-            RlineErr = (SPRMapTemp-PRMapTemp) / SPRMapTemp;
+                RlineErr = (SPRMapTemp-PRMapTemp) / SPRMapTemp;
             
-            // If this error is greater than zero, we are below stall.
-            // So we'll want to decrease Rline (to get closer to stall)
-            // Therefore, we'll want to shrink upper search bounds.
-            if (RlineErr > 0)
-            {
-                // Search between current guess Rline and lower bound.
-                RlineGuessBounds[1] = RlineGuess;
-            }
-            // Otherwise, error is positive, so we are past stall.
-            // So we'll want to increase Rline (to move away from stall)
-            // Therefore, we'll want to shrink lower search bounds.
-            else
-            {
-                // Search between current guess Rline and upper bound.
-                RlineGuessBounds[0] = RlineGuess;
+                // If this error is greater than zero, we are below stall.
+                // So we'll want to decrease Rline (to get closer to stall)
+                // Therefore, we'll want to shrink upper search bounds.
+                if (RlineErr > 0)
+                {
+                    // Search between current guess Rline and lower bound.
+                    RlineGuessBounds[1] = RlineGuess;
+                }
+                // Otherwise, error is positive, so we are past stall.
+                // So we'll want to increase Rline (to move away from stall)
+                // Therefore, we'll want to shrink lower search bounds.
+                else
+                {
+                    // Search between current guess Rline and upper bound.
+                    RlineGuessBounds[0] = RlineGuess;
+                }
             }
         }
+
         if (iterations <= 0)
         {
             #ifdef MATLAB_MEX_FILE
@@ -424,7 +429,7 @@ void Compressor_TMATS_body(double* y, double* y1, double* y2, const double* u, c
         SMavail = ((WcCalcin/WcMapTemp) / (PR/PRMapTemp) - 1.0) * 100.;
     }
     // Else, we're calculating normal SMW.
-    } else
+    else
     {
         SMavail = (SPR - PR)*divby(PR) * 100;
         SMMap = (SPRMap - PRMap)*divby(PRMap) * 100;
@@ -0,0 +1,280 @@
+/*		T-MATS -- Compressor_TMATS_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane version of Compressor_TMATS_body. Map lookups and the stall margin
+%  search are done lane by lane with the scalar interpolation routines; the
+%  gas property evaluations run over all lanes at once. Customer and
+%  fractional bleed vectors are shared by all lanes.
+% *************************************************************************/
+
+#include <math.h>
+#include <stdlib.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_lanes.h"
+
+#define MAX_BLEEDS 20
+
+/* Map lookup of the first num of the Wc, PR and Eff tables, in one search */
+static void map_lookup(const CompressorStruct* prm, int num, double Rline, double NcMap, double Alpha,
+                       double *MapVal)
+{
+    double *MapTbl[3];
+    int interpErr = 0;
+
+    MapTbl[0] = prm->T_C_Map_WcArray;
+    MapTbl[1] = prm->T_C_Map_PRArray;
+    MapTbl[2] = prm->T_C_Map_EffArray;
+    if (prm->C > 1)
+        interp3Am(prm->M_C_Map,prm->X_C_RlineVec,prm->Y_C_Map_NcVec,prm->Z_C_AlphaVec,MapTbl,num,Rline,NcMap,Alpha,prm->B,prm->A,prm->C,prm->MapCell,MapVal,&interpErr);
+    else
+        interp2Am(prm->M_C_Map,prm->X_C_RlineVec,prm->Y_C_Map_NcVec,MapTbl,num,Rline,NcMap,prm->B,prm->A,prm->MapCell,MapVal,&interpErr);
+}
+
+/* Stall margins SMavail and SMMap of one lane, as computed by Compressor_TMATS_body */
+static void stall_margin(const CompressorStruct* prm, double Alpha, double NcMap, double WcMap, double PRMap,
+                         double WcCalcin, double PR, double C_Wc, double C_PR,
+                         double *SPRMap_out, double *SMavail, double *SMMap)
+{
+    double SMWcVec[500];
+    double SMPRVec[500];
+    double SPRMap, SPR, RlineErr, RlineGuess, RlineGuessBounds[2];
+    double WcMapTemp, PRMapTemp, SPRMapTemp, MapVal[2];
+    int interpErr = 0;
+    int i, iterations;
+    double inf = HUGE_VAL;
+
+    if (prm->SMSkip) {
+        /* Not wanted by the caller, as in Compressor_TMATS_body */
+        *SPRMap_out = *SMavail = *SMMap = inf - inf;
+        return;
+    }
+
+    if (prm->C > 1) {
+        /* Define 1-prm->D surge margin vectors based on alpha */
+        for (i = 0; i < prm->D/prm->C; i++) {
+            SMWcVec[i] = interp1Ac(prm->Z_C_AlphaVec, prm->X_C_Map_WcSurgeVec + prm->C*i, Alpha,prm->C, &interpErr);
+            SMPRVec[i] = interp1Ac(prm->Z_C_AlphaVec, prm->T_C_Map_PRSurgeVec + prm->C*i, Alpha,prm->C, &interpErr);
+        }
+        SPRMap = interp1Ac(SMWcVec, SMPRVec,WcMap,prm->D/prm->C,&interpErr);
+    }
+    else
+        SPRMap = interp1At(prm->K_C_PRSurge,prm->X_C_Map_WcSurgeVec,prm->T_C_Map_PRSurgeVec,WcMap,prm->D,NULL,&interpErr);
+    SPR = C_PR*(SPRMap - 1) + 1;
+
+    if (prm->SMNEn > 0.5) {
+        if (prm->StallLine != NULL) {
+            /* Stall point from the stall line (see Compressor_TMATS_body) */
+            stall_line(prm->StallLine, NcMap, Alpha, &WcMapTemp, &PRMapTemp);
+        }
+        else {
+            /* Iterative stall r-line finder, via binary search (see Compressor_TMATS_body) */
+            iterations = 20;
+            RlineErr = 1000;
+            RlineGuessBounds[0] = prm->X_C_RlineVec[0];
+            RlineGuessBounds[1] = prm->X_C_RlineVec[prm->B - 1];
+            WcMapTemp = WcMap;
+            PRMapTemp = PRMap;
+            while ( ((iterations--) > 0) && fabs(RlineErr) > 0.01)
+            {
+                RlineGuess = (RlineGuessBounds[0] + RlineGuessBounds[1]) / 2;
+                map_lookup(prm, 2, RlineGuess, NcMap, Alpha, MapVal);
+                WcMapTemp = MapVal[0];
+                PRMapTemp = MapVal[1];
+                if (prm->C > 1)
+                    SPRMapTemp = interp1Ac(SMWcVec, SMPRVec,WcMapTemp,prm->D/prm->C,&interpErr);
+                else
+                    SPRMapTemp = interp1At(prm->K_C_PRSurge,prm->X_C_Map_WcSurgeVec,prm->T_C_Map_PRSurgeVec,WcMapTemp,prm->D,NULL,&interpErr);
+                RlineErr = (SPRMapTemp-PRMapTemp) / SPRMapTemp;
+                if (RlineErr > 0)
+                    RlineGuessBounds[1] = RlineGuess;
+                else
+                    RlineGuessBounds[0] = RlineGuess;
+            }
+        }
+        *SMMap = ((WcMap/WcMapTemp) / (PRMap/PRMapTemp) - 1.0) * 100.;
+        WcMapTemp = C_Wc*WcMapTemp;
+        PRMapTemp = C_PR*(PRMapTemp - 1) + 1;
+        *SMavail = ((WcCalcin/WcMapTemp) / (PR/PRMapTemp) - 1.0) * 100.;
+    }
+    else {
+        *SMavail = (SPR - PR)*DIVBY_L(PR) * 100;
+        *SMMap = (SPRMap - PRMap)*DIVBY_L(PRMap) * 100;
+    }
+    *SPRMap_out = SPRMap;
+}
+
+void Compressor_TMATS_lanes(lane_t *y, lane_t *y1, lane_t *y2, const lane_t *u, const double* Wcust,
+                            const double* FracWbld, const CompressorStruct* prm)
+{
+    const double *WIn     = u[0];     /* Input Flow [pps] 	*/
+    const double *TtIn    = u[2];     /* Temperature Input [degR] 	*/
+    const double *PtIn    = u[3];     /* Pressure Input [psia] 	*/
+    const double *FARcIn  = u[4];     /* Combusted Fuel to Air Ratio [frac] 	*/
+    const double *Nmech   = u[5];     /* Mechancial Shaft Speed [rpm] 	*/
+    const double *Rline   = u[6];     /* Rline [NA]  */
+    const double *Alpha   = u[7];     /* Alpha [NA]  */
+    const double *s_C_Nc  = u[8];     /* Nc map scalar [NA]  */
+    const double *s_C_Wc  = u[9];     /* Wc map scalar [NA] */
+    const double *s_C_PR  = u[10];    /* PR map scalar [NA]  */
+    const double *s_C_Eff = u[11];    /* Eff map scalar [NA]  */
+
+    int uWidth1 = prm->CustBldNm;
+    int uWidth2 = prm->FracBldNm;
+
+    /*--------Define Constants-------*/
+    lane_t htin, Sin, PtOut, Eff, TtIdealout, htIdealout, htOut, hbld, Wbleeds, PwrBld;
+    double C_Nc, C_Wc, C_PR, C_Eff, Wcin, WcCalcin, WcMap, theta, delta, Pwrout;
+    double NcMap, Nc, PRMap, PR, EffMap, Pwrb4bleed, NErrorOut;
+    double SPRMap, SMavail, SMMap, MapVal[3];
+    int i, k, l;
+
+    if (uWidth1 > MAX_BLEEDS)
+        uWidth1 = MAX_BLEEDS;
+    if (uWidth2 > MAX_BLEEDS)
+        uWidth2 = MAX_BLEEDS;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        /*---- calculate misc. fluid condition related variables and corrected Flow --*/
+        delta = PtIn[l] / C_PSTD;
+        theta = TtIn[l] / C_TSTD;
+        Wcin = WIn[l]*SQRTT_L(theta)*DIVBY_L(delta);
+
+        /*------ Calculate corrected speed ---------*/
+        Nc = Nmech[l]*DIVBY_L(SQRTT_L(theta));
+        if (prm->IDes < 0.5)
+            C_Nc = Nc *DIVBY_L(prm->NcDes) ;
+        else
+            C_Nc = s_C_Nc[l];
+
+        NcMap = Nc *DIVBY_L(C_Nc);
+
+        /*-- Compute Total Flow input (from Compressor map)  --------*/
+        map_lookup(prm, 3, Rline[l], NcMap, Alpha[l], MapVal);
+        WcMap = MapVal[0];
+        if (prm->IDes < 0.5)
+            C_Wc = Wcin*DIVBY_L(WcMap);
+        else
+            C_Wc = s_C_Wc[l];
+
+        WcCalcin = WcMap * C_Wc;
+
+        /*-- Compute Pressure Ratio (from Compressor map)  --------*/
+        PRMap = MapVal[1];
+        if (prm->IDes < 0.5)
+            C_PR = (prm->PRDes -1)*DIVBY_L(PRMap-1);
+        else
+            C_PR = s_C_PR[l];
+
+        PR = C_PR*(PRMap - 1) + 1 ;
+
+        /*-- Compute Efficiency (from Compressor map) ---*/
+        EffMap = MapVal[2];
+        if (prm->IDes < 0.5)
+            C_Eff = prm->EffDes*DIVBY_L(EffMap);
+        else
+            C_Eff = s_C_Eff[l];
+
+        Eff[l] = EffMap * C_Eff;
+
+        /*------ Compute pressure output --------*/
+        PtOut[l] = PtIn[l]*PR;
+
+        /* ----- Compute Normalized Flow Error ----- */
+        if (prm->IDes < 0.5 && Rline[l] == 0)
+            NErrorOut = 100;
+        else if (prm->IDes < 0.5)
+            NErrorOut = (Rline[l] - prm->RlineDes)*DIVBY_L(Rline[l]);
+        else if (WIn[l] == 0)
+            NErrorOut = 100;
+        else
+            NErrorOut = (Wcin - WcCalcin)*DIVBY_L(Wcin);
+
+        /* Compute Stall Margin */
+        stall_margin(prm, Alpha[l], NcMap, WcMap, PRMap, WcCalcin, PR, C_Wc, C_PR, &SPRMap, &SMavail, &SMMap);
+
+        y[3][l] = PtOut[l];       /* Outlet Pressure [psia] 	*/
+        y[4][l] = FARcIn[l];      /* Exit Combusted Fuel Flow [frac] */
+        y[6][l] = NErrorOut;      /* Normalized compressor Error [frac]*/
+        y[7][l] = SMavail;        /* Available Stall Margin [%] */
+        y[8][l] = C_Nc;           /* Corrected shaft speed scalar */
+        y[9][l] = C_Wc;           /* Corrected flow scalar */
+        y[10][l] = C_PR;          /* Pressure Ratio scalar */
+        y[11][l] = C_Eff;         /* Efficiency scalar */
+        y[12][l] = Wcin;          /* Corrected input flow [pps] */
+        y[13][l] = Nc;            /* Corrected speed [rpm]*/
+        y[14][l] = PR;            /* Pressure ratio */
+        y[15][l] = NcMap;         /* Map corrected speed */
+        y[16][l] = WcMap;         /* Map corrected flow */
+        y[17][l] = PRMap;         /* Map pressure ratio */
+        y[18][l] = EffMap;        /* Map efficiency */
+        y[19][l] = C_PR*(SPRMap - 1) + 1;   /* Surge pressure ratio */
+        y[24][l] = SMMap;         /* Stall margin calculated from map values [%]*/
+        y[25][l] = SPRMap;        /* Map stall pressure ratio*/
+        y[26][l] = SPRMap;        /* test signal */
+    }
+
+    /*------ enthalpy calculations ---------*/
+    /* ---- Input, ideal and final enthalpy and temperature output ----*/
+    isentropic_lanes(TtIn, PtIn, PtOut, FARcIn, Eff, 0, htin, Sin, TtIdealout, htIdealout, y[2], htOut);
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        Wbleeds[l] = 0;
+        PwrBld[l] = 0;
+    }
+
+    /* compute customer Bleed components */
+    for (i = 0; i < uWidth1; i++) {
+        if (Wcust[i] == 0 || prm->CustBldEn < 0.5) {
+            for (k = 0; k < 5; k++)
+                for (l = 0; l < AGTF30_LANES; l++)
+                    y1[5*i+k][l] = 0;
+            continue;
+        }
+        for (l = 0; l < AGTF30_LANES; l++) {
+            Wbleeds[l] = Wbleeds[l] + Wcust[i]; /* add to total bleed value */
+            hbld[l] = htin[l] + prm->FracCusBldht[i]*(htOut[l] - htin[l]); /* customer bleed enthalpy */
+            y1[5*i][l] = Wcust[i];
+            y1[5*i+1][l] = hbld[l];
+            y1[5*i+3][l] = PtIn[l] + prm->FracCusBldPt[i]*(PtOut[l] -PtIn[l]); /* customer bleed Total Pressure */
+            y1[5*i+4][l] = FARcIn[l];
+            PwrBld[l] = PwrBld[l] + Wcust[i]*(hbld[l]-htOut[l])*C_BTU_PER_SECtoHP;  /* customer bleed power */
+        }
+        h2tc_from_lanes(y1[5*i+2], hbld, FARcIn, TtIn); /* customer bleed Total Temp */
+    }
+
+    /* compute fractional Bleed components */
+    for (i = 0; i < uWidth2; i++) {
+        if (FracWbld[i] <= 0 || prm->FBldEn < 0.5) {
+            for (k = 0; k < 5; k++)
+                for (l = 0; l < AGTF30_LANES; l++)
+                    y2[5*i+k][l] = 0;
+            continue;
+        }
+        for (l = 0; l < AGTF30_LANES; l++) {
+            Wbleeds[l] = Wbleeds[l] + FracWbld[i]*WIn[l]; /* add to total bleed value */
+            hbld[l] = htin[l] + prm->FracBldht[i]*(htOut[l] - htin[l]); /* bleed enthalpy */
+            y2[5*i][l] = FracWbld[i]*WIn[l];
+            y2[5*i+1][l] = hbld[l];
+            y2[5*i+3][l] = PtIn[l] + prm->FracBldPt[i]*(PtOut[l] -PtIn[l]); /* bleed Total Pressure */
+            y2[5*i+4][l] = FARcIn[l];
+            PwrBld[l] = PwrBld[l] + y2[5*i][l]*(hbld[l]-htOut[l])*C_BTU_PER_SECtoHP;  /* bleed power */
+        }
+        h2tc_from_lanes(y2[5*i+2], hbld, FARcIn, TtIn); /* bleed Total Temp */
+    }
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        /*------ Compute Powers ---------*/
+        Pwrb4bleed = WIn[l] * (htin[l] - htOut[l]) * C_BTU_PER_SECtoHP;
+        Pwrout = Pwrb4bleed - PwrBld[l];
+
+        y[0][l] = WIn[l] - Wbleeds[l];  /* Outlet Total Flow [pps]	*/
+        y[1][l] = htOut[l];             /* Output Enthalpy [BTU/lbm]	*/
+        y[5][l] = C_HP_PER_RPMtoFT_LBF * Pwrout*DIVBY_L(Nmech[l]);   /* Outlet Torque [lbf*ft]	*/
+        y[20][l] = Wbleeds[l];          /* Bleed flow [pps]*/
+        y[21][l] = Pwrb4bleed;          /* Power if there was no bleed [hp]*/
+        y[22][l] = PwrBld[l];           /* Power loss due to bleed [hp] */
+        y[23][l] = Pwrout;              /* Output power [hp]*/
+    }
+}
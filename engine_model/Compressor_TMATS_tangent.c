@@ -0,0 +1,252 @@
+/*		T-MATS -- Compressor_TMATS_tangent.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Tangent version of Compressor_TMATS_body for off-design operation
+%  (IDes >= 0.5). du holds the tangents of the gas path inputs u[0..6]
+%  (W, ht, Tt, Pt, FAR, Nmech, Rline); Alpha and the map scalars are
+%  constants of the model. y, y1 and y2 are the outputs of the body.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+/* Map lookup at (Rline, NcMap) with its tangent */
+static double map_tangent(double *dz, double *T_Array, double Rline, const double *dRline,
+                          double NcMap, const double *dNcMap, double Alpha, const CompressorStruct* prm)
+{
+    tan_t zero;
+    double z, zx, zy, zz;
+
+    /* C1 maps (interp_map_init with INTERP_PCHIP or INTERP_AKIMA); Alpha is constant */
+    if (prm->C > 1 ? interp3Amd(prm->M_C_Map, prm->X_C_RlineVec, prm->Y_C_Map_NcVec, prm->Z_C_AlphaVec, T_Array,
+                                Rline, NcMap, Alpha, prm->B, prm->A, prm->C, &z, &zx, &zy, &zz)
+                   : interp2Amd(prm->M_C_Map, prm->X_C_RlineVec, prm->Y_C_Map_NcVec, T_Array, Rline, NcMap,
+                                prm->B, prm->A, &z, &zx, &zy)) {
+        tan_lin2(dz, zx, dRline, zy, dNcMap);
+        return z;
+    }
+
+    if (prm->C > 1) {
+        tan_zero(zero);
+        return interp3Ac_tangent(dz, prm->X_C_RlineVec, prm->Y_C_Map_NcVec, prm->Z_C_AlphaVec, T_Array,
+                                 Rline, dRline, NcMap, dNcMap, Alpha, zero, prm->B, prm->A, prm->C);
+    }
+    return interp2Ac_tangent(dz, prm->X_C_RlineVec, prm->Y_C_Map_NcVec, T_Array,
+                             Rline, dRline, NcMap, dNcMap, prm->B, prm->A);
+}
+
+void Compressor_TMATS_tangent(tan_t *dy, tan_t *dy1, tan_t *dy2, const double *y, const double *y1,
+                              const double *y2, const double *u, tan_t *du, const double* Wcust,
+                              const double* FracWbld, const CompressorStruct* prm)
+{
+    double WIn      = u[0];     /* Input Flow [pps] 	*/
+    double TtIn     = u[2];     /* Temperature Input [degR] 	*/
+    double PtIn     = u[3];     /* Pressure Input [psia] 	*/
+    double FARcIn   = u[4];     /* Combusted Fuel to Air Ratio [frac] 	*/
+    double Nmech    = u[5];     /* Mechancial Shaft Speed [rpm] 	*/
+    double Rline    = u[6];     /* Rline [NA]  */
+    double Alpha    = u[7];     /* Alpha [NA]  */
+
+    const double *dWIn = du[0], *dTtIn = du[2], *dPtIn = du[3], *dFARcIn = du[4], *dNmech = du[5], *dRline = du[6];
+
+    /*--- Outputs of the body ---*/
+    double htOut = y[1], TtOut = y[2], PtOut = y[3];
+    double C_Nc = y[8], C_PR = y[10], C_Eff = y[11];
+    double Wcin = y[12], PR = y[14], NcMap = y[15], WcMap = y[16], PRMap = y[17], EffMap = y[18];
+    double SPR = y[19], Pwrout = y[23], SPRMap = y[25];
+    double WcCalcin = WcMap * y[9];
+
+    /*--------Define Constants-------*/
+    double htin, theta, delta, sth, Eff, TtIdealout, htIdealout, hbld, Wbld;
+    double SMWcVec[500];
+    double SMPRVec[500];
+    tan_t dhtin, dSin, dtheta, ddelta, dsth, dWcin, dNc, dNcMap, dWcMap, dPRMap, dEffMap, dPR, dEff;
+    tan_t dPtOut, dTtIdealout, dhtIdealout, dhtOut, dhbld, dWbleeds, dPwrBld, dPwrb4bleed, dPwrout;
+    tan_t dSPRMap, dtmp, dWcS, dPRS, zero;
+    double WcS, PRS, PRT;
+    const StallLine *sl;
+    int interpErr = 0;
+    GasMix mix;
+    int i, k;
+
+    /*--- Design point scalars are not differentiated ---*/
+    if (prm->IDes < 0.5) {
+        for (i = 0; i < 27; i++)
+            tan_nan(dy[i]);
+        for (i = 0; i < 5*prm->CustBldNm; i++)
+            tan_nan(dy1[i]);
+        for (i = 0; i < 5*prm->FracBldNm; i++)
+            tan_nan(dy2[i]);
+        return;
+    }
+
+    /*-- Input enthalpy and entropy --------*/
+    htin = t2hc(TtIn,FARcIn);
+    t2hc_tangent(dhtin, TtIn, dTtIn, FARcIn, dFARcIn);
+    pt2sc_tangent(dSin, PtIn, TtIn, FARcIn, dPtIn, dTtIn, dFARcIn);
+
+    /*---- corrected flow Wcin = W*sqrtT(theta)*divby(delta) --*/
+    delta = PtIn / C_PSTD;
+    theta = TtIn / C_TSTD;
+    tan_scale(ddelta, 1/C_PSTD, dPtIn);
+    tan_scale(dtheta, 1/C_TSTD, dTtIn);
+    sth = sqrtT(theta);
+    tan_scale(dsth, sqrtT_d(theta), dtheta);
+    tan_lin3(dWcin, sth*divby(delta), dWIn, WIn*divby(delta), dsth, WIn*sth*divby_d(delta), ddelta);
+
+    /*------ corrected speed Nc = Nmech*divby(sqrtT(theta)) ---------*/
+    tan_lin2(dNc, divby(sth), dNmech, Nmech*divby_d(sth), dsth);
+    tan_scale(dNcMap, divby(C_Nc), dNc);
+
+    /*-- Map lookups --------*/
+    map_tangent(dWcMap, prm->T_C_Map_WcArray, Rline, dRline, NcMap, dNcMap, Alpha, prm);
+    map_tangent(dPRMap, prm->T_C_Map_PRArray, Rline, dRline, NcMap, dNcMap, Alpha, prm);
+    map_tangent(dEffMap, prm->T_C_Map_EffArray, Rline, dRline, NcMap, dNcMap, Alpha, prm);
+    tan_scale(dPR, C_PR, dPRMap);
+    Eff = EffMap * C_Eff;
+    tan_scale(dEff, C_Eff, dEffMap);
+
+    /*------ pressure and enthalpy outputs --------*/
+    tan_lin2(dPtOut, PR, dPtIn, PtIn, dPR);
+    gasmix(&mix, FARcIn);
+    TtIdealout = sp2tc_from(&mix, pt2sc_mix(&mix, PtIn, TtIn), PtOut, TtIn, PtIn);
+    sp2tc_tangent(dTtIdealout, TtIdealout, PtOut, dSin, dPtOut, FARcIn, dFARcIn);
+    htIdealout = t2hc(TtIdealout,FARcIn);
+    t2hc_tangent(dhtIdealout, TtIdealout, dTtIdealout, FARcIn, dFARcIn);
+
+    /* htOut = ((htIdealout - htin)*divby(Eff)) + htin */
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dhtOut[k] = (dhtIdealout[k] - dhtin[k])*divby(Eff) + (htIdealout - htin)*divby_d(Eff)*dEff[k] + dhtin[k];
+    h2tc_tangent(dy[2], TtOut, dhtOut, FARcIn, dFARcIn);
+
+    /*--- Bleeds ---*/
+    tan_zero(dWbleeds);
+    tan_zero(dPwrBld);
+    for (i = 0; i < prm->CustBldNm; i++)
+    {
+        if (Wcust[i] == 0 || prm->CustBldEn < 0.5){
+            for (k = 0; k < 5; k++)
+                tan_zero(dy1[5*i+k]);
+        }
+        else {
+            tan_zero(dy1[5*i]);
+            tan_lin2(dy1[5*i+1], 1 - prm->FracCusBldht[i], dhtin, prm->FracCusBldht[i], dhtOut);
+            h2tc_tangent(dy1[5*i+2], y1[5*i+2], dy1[5*i+1], FARcIn, dFARcIn);
+            tan_lin2(dy1[5*i+3], 1 - prm->FracCusBldPt[i], dPtIn, prm->FracCusBldPt[i], dPtOut);
+            tan_copy(dy1[5*i+4], dFARcIn);
+            /* PwrBld += Wcust*(htcust - htOut)*C */
+            for (k = 0; k < AGTF30_NUM_DIR; k++)
+                dPwrBld[k] += Wcust[i]*(dy1[5*i+1][k] - dhtOut[k])*C_BTU_PER_SECtoHP;
+        }
+    }
+    for (i = 0; i < prm->FracBldNm; i++)
+    {
+        if (FracWbld[i] <= 0 || prm->FBldEn < 0.5 ){
+            for (k = 0; k < 5; k++)
+                tan_zero(dy2[5*i+k]);
+        }
+        else {
+            Wbld = y2[5*i];
+            hbld = y2[5*i+1];
+            tan_scale(dy2[5*i], FracWbld[i], dWIn);
+            for (k = 0; k < AGTF30_NUM_DIR; k++)
+                dWbleeds[k] += dy2[5*i][k];
+            tan_lin2(dhbld, 1 - prm->FracBldht[i], dhtin, prm->FracBldht[i], dhtOut);
+            tan_copy(dy2[5*i+1], dhbld);
+            h2tc_tangent(dy2[5*i+2], y2[5*i+2], dhbld, FARcIn, dFARcIn);
+            tan_lin2(dy2[5*i+3], 1 - prm->FracBldPt[i], dPtIn, prm->FracBldPt[i], dPtOut);
+            tan_copy(dy2[5*i+4], dFARcIn);
+            /* PwrBld += Wbld*(hbld - htOut)*C */
+            for (k = 0; k < AGTF30_NUM_DIR; k++)
+                dPwrBld[k] += (dy2[5*i][k]*(hbld - htOut) + Wbld*(dhbld[k] - dhtOut[k]))*C_BTU_PER_SECtoHP;
+        }
+    }
+
+    /*------ Powers and torque ---------*/
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dPwrb4bleed[k] = (dWIn[k]*(htin - htOut) + WIn*(dhtin[k] - dhtOut[k]))*C_BTU_PER_SECtoHP;
+        dPwrout[k] = dPwrb4bleed[k] - dPwrBld[k];
+    }
+    tan_lin2(dy[5], C_HP_PER_RPMtoFT_LBF*divby(Nmech), dPwrout, C_HP_PER_RPMtoFT_LBF*Pwrout*divby_d(Nmech), dNmech);
+
+    /* ----- Normalized Flow Error (Wcin - WcCalcin)*divby(Wcin) ----- */
+    if (WIn == 0)
+        tan_zero(dy[6]);
+    else {
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dtmp[k] = dWcin[k] - y[9]*dWcMap[k];
+        tan_lin2(dy[6], divby(Wcin), dtmp, (Wcin - WcCalcin)*divby_d(Wcin), dWcin);
+    }
+
+    /*--- Stall line pressure ratio ---*/
+    if (prm->C > 1){
+        for (i = 0; i < prm->D/prm->C; i++){
+            SMWcVec[i] = interp1Ac(prm->Z_C_AlphaVec, prm->X_C_Map_WcSurgeVec + prm->C*i, Alpha,prm->C, &interpErr);
+            SMPRVec[i] = interp1Ac(prm->Z_C_AlphaVec, prm->T_C_Map_PRSurgeVec + prm->C*i, Alpha,prm->C, &interpErr);
+        }
+        interp1Ac_tangent(dSPRMap, SMWcVec, SMPRVec, WcMap, dWcMap, prm->D/prm->C);
+    }
+    else
+        interp1Ac_tangent(dSPRMap, prm->X_C_Map_WcSurgeVec, prm->T_C_Map_PRSurgeVec, WcMap, dWcMap, prm->D);
+
+    /*--- Stall margins ---*/
+    if (prm->SMNEn > 0.5 && prm->StallLine != NULL) {
+        /* SMMap = ((WcMap/WcS)*(PRS/PRMap) - 1)*100 at the stall point (WcS, PRS) of the
+         * stall line at NcMap, SMavail the same with PRS scaled by C_PR */
+        sl = prm->StallLine;
+        if (sl->C > 1) {
+            tan_zero(zero);
+            WcS = interp2Ac_tangent(dWcS, sl->NcVec, sl->AlphaVec, sl->V[STALL_WC], NcMap, dNcMap, Alpha, zero, sl->A, sl->C);
+            PRS = interp2Ac_tangent(dPRS, sl->NcVec, sl->AlphaVec, sl->V[STALL_PR], NcMap, dNcMap, Alpha, zero, sl->A, sl->C);
+        }
+        else {
+            WcS = interp1Ac_tangent(dWcS, sl->NcVec, sl->V[STALL_WC], NcMap, dNcMap, sl->A);
+            PRS = interp1Ac_tangent(dPRS, sl->NcVec, sl->V[STALL_PR], NcMap, dNcMap, sl->A);
+        }
+        PRT = C_PR*(PRS - 1) + 1;
+        for (k = 0; k < AGTF30_NUM_DIR; k++) {
+            dy[7][k] = (y[7] + 100) * (dWcMap[k]/WcMap - dWcS[k]/WcS + C_PR*dPRS[k]/PRT - dPR[k]/PR);
+            dy[24][k] = (y[24] + 100) * (dWcMap[k]/WcMap - dWcS[k]/WcS + dPRS[k]/PRS - dPRMap[k]/PRMap);
+        }
+    }
+    else if (prm->SMNEn > 0.5) {
+        tan_nan(dy[7]);
+        tan_nan(dy[24]);
+    }
+    else {
+        for (k = 0; k < AGTF30_NUM_DIR; k++) {
+            dy[7][k] = ((C_PR*dSPRMap[k] - dPR[k])*divby(PR) + (SPR - PR)*divby_d(PR)*dPR[k]) * 100;
+            dy[24][k] = ((dSPRMap[k] - dPRMap[k])*divby(PRMap) + (SPRMap - PRMap)*divby_d(PRMap)*dPRMap[k]) * 100;
+        }
+    }
+
+    /*------Assign output tangents------------*/
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dy[0][k] = dWIn[k] - dWbleeds[k];   /* WOut */
+        dy[1][k] = dhtOut[k];
+        dy[3][k] = dPtOut[k];
+        dy[4][k] = dFARcIn[k];
+        dy[8][k] = 0;                       /* map scalars */
+        dy[9][k] = 0;
+        dy[10][k] = 0;
+        dy[11][k] = 0;
+        dy[12][k] = dWcin[k];
+        dy[13][k] = dNc[k];
+        dy[14][k] = dPR[k];
+        dy[15][k] = dNcMap[k];
+        dy[16][k] = dWcMap[k];
+        dy[17][k] = dPRMap[k];
+        dy[18][k] = dEffMap[k];
+        dy[19][k] = C_PR*dSPRMap[k];        /* SPR */
+        dy[20][k] = dWbleeds[k];
+        dy[21][k] = dPwrb4bleed[k];
+        dy[22][k] = dPwrBld[k];
+        dy[23][k] = dPwrout[k];
+        dy[25][k] = dSPRMap[k];
+        dy[26][k] = dSPRMap[k];             /* Test */
+    }
+}
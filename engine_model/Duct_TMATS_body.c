@@ -1,5 +1,6 @@
 #include "types_TMATS_additions.h"
 #include <math.h>
+#include <stddef.h>
 #include "types_TMATS.h"
 
 #ifdef MATLAB_MEX_FILE
@@ -27,11 +28,11 @@ void Duct_TMATS_body(double *y, const double *u, const DuctStruct* prm, const do
     double AthroatIn = prm->Ath;
     double MNIn = 0.45;
     int SolveType = 0;
-    double X_FARVec[7] = {0, 0.0050, 0.0100, 0.0150, 0.0200, 0.0250, 0.0300};
-    double T_RtArray[7] = {0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686};
-    double Y_TtVec[7] = {300, 10000};
-    double T_gammaArray[14] = {1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4};
-    int IWork[1] = {0};
+    static double X_FARVec[7] = {0, 0.0050, 0.0100, 0.0150, 0.0200, 0.0250, 0.0300};
+    static double T_RtArray[7] = {0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686};
+    static double Y_TtVec[7] = {300, 10000};
+    static double T_gammaArray[14] = {1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4};
+    int IWork[5] = {0, 0, 0, 0, 0};
     int  A = 7;
     int  B = 2;
     struct StaticCalcStruct duct = {
@@ -46,6 +47,10 @@ void Duct_TMATS_body(double *y, const double *u, const DuctStruct* prm, const do
         &IWork[0],
         A,
         B,
+        NULL,
+        /* Interpolation kernels: none, the generic interp*Ac routines are used */
+        .K_Rt = NULL,
+        .K_gamma = NULL,
     };
 
     /*---- call StaticCalc to retrieve Mach number --- */
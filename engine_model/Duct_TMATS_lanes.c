@@ -0,0 +1,63 @@
+/*		T-MATS -- Duct_TMATS_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane version of Duct_TMATS_body.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "AGTF30_lanes.h"
+
+void Duct_TMATS_lanes(lane_t *y, const lane_t *u, const DuctStruct* prm)
+{
+    /*--- Define StaticCalc I/O ---*/
+    lane_t staticcalc_y[5];
+
+    /*--------Define Constants-------*/
+    double MN;
+    int l;
+
+    /*--- Define StaticCalc structure (same as Duct_TMATS_body) ---*/
+    double AthroatIn = prm->Ath;
+    double MNIn = 0.45;
+    int SolveType = 0;
+    static double X_FARVec[7] = {0, 0.0050, 0.0100, 0.0150, 0.0200, 0.0250, 0.0300};
+    static double T_RtArray[7] = {0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686};
+    static double Y_TtVec[7] = {300, 10000};
+    static double T_gammaArray[14] = {1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4};
+    int IWork[5] = {0, 0, 0, 0, 0};
+    int  A = 7;
+    int  B = 2;
+    struct StaticCalcStruct duct = {
+        AthroatIn,
+        MNIn,
+        SolveType,
+        &X_FARVec[0],
+        &T_RtArray[0],
+        &Y_TtVec[0],
+        &T_gammaArray[0],
+        &prm->BlkNm[0],
+        &IWork[0],
+        A,
+        B,
+        NULL,
+        /* Interpolation kernels: none, the generic interp*Ac routines are used */
+        .K_Rt = NULL,
+        .K_gamma = NULL,
+    };
+
+    /*---- call StaticCalc to retrieve Mach number --- */
+    StaticCalc_TMATS_lanes(staticcalc_y, u, &duct);
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        MN = staticcalc_y[3][l];
+
+        /*------Assign output values------------*/
+        y[0][l] = u[0][l];      /* Mass flow */
+        y[1][l] = u[1][l];      /* Total enthalpy */
+        y[2][l] = u[2][l];      /* Total Temperature [degR] */
+        y[3][l] = (1 - (MN/prm->MNdes) * (MN/prm->MNdes) * prm->dP_M) * u[3][l];  /* Total Pressure [psia] */
+        y[4][l] = u[4][l];      /* Fuel to Air Ratio */
+    }
+}
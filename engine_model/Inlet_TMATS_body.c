@@ -23,7 +23,7 @@ void Inlet_TMATS_body(double *y, const double *u, const InletStruct* prm, const
     
     int interpErr = 0;
 
-    eRam_sf = interp1Ac(prm->X_eRamVec_M,prm->T_eRamtbl_M,PtIn/PambIn,prm->A,&interpErr);
+    eRam_sf = interp1At(prm->K_eRam_M,prm->X_eRamVec_M,prm->T_eRamtbl_M,PtIn/PambIn,prm->A,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er1) == 0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
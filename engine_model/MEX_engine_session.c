@@ -0,0 +1,454 @@
+#include "mex.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+#include "constants_TMATS.h"
+#include "AGTF30_model.h"
+
+/*		MEX_engine_session.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Engine model sessions for repeated calls to the model:
+%
+%  H = MEX_engine_session('open', CAPACITY, SETTINGS_IN)
+%      Opens a session with output buffers for CAPACITY points (optional,
+%      default 1). SETTINGS_IN is optional and read as in MEX_engine_model
+%      ([ENABLE_DEBUG threads lanes eval_level diagnostics]). With
+%      SETTINGS_IN(5) = 1 the session collects the component error flags
+%      of every point (AGTF30_diagnostics.c) without printing them.
+%  [DEP,X,U,Y,E] = MEX_engine_session('eval', H, ENV_IN, CMD_IN, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN)
+%      Evaluates the points of CMD_IN as MEX_engine_model does and keeps
+%      the outputs in the session. Only the outputs asked for are
+%      returned; with none, the call allocates nothing.
+%  [DEP,X,U,Y,E] = MEX_engine_session('get', H)
+%      Outputs of the last evaluation.
+%  STATS = MEX_engine_session('stats', H)
+%      [evaluations; points evaluated; allocations; bytes allocated] of
+%      the session, counting the output buffers and the returned arrays.
+%  [FLAGS,EVENTS,COUNTS,LOST] = MEX_engine_session('diag', H)
+%      Diagnostics of a session opened with SETTINGS_IN(5) = 1. FLAGS
+%      (11 x N) holds, for each point of the last evaluation, the error
+%      flags raised by each component as a bit mask, bit k-1 for IWork
+%      entry k. The components are ambient, inlet, fan, LPC, VBV, bypass
+%      nozzle, HPC, HPC static, HPT, LPT and core nozzle. EVENTS (4 x K)
+%      lists the flags of the last evaluation as [point; component; entry;
+%      value] ordered by point; LOST events did not fit the ring buffers.
+%      COUNTS (11 x 16) is the number of points that raised each flag
+%      since the session was opened.
+%  MEX_engine_session('close', H)
+%
+%  Each session owns its workspace, so the components cached by one
+%  session (AGTF30Workspace) are not disturbed by calls to another, and
+%  its output buffers, which only grow when a call has more points than
+%  any before. A call with the outputs left in the session therefore
+%  makes no allocation once the buffers are large enough.
+% *************************************************************************/
+
+/* Input Arguments */
+#define COMMAND_IN  prhs[0]
+#define HANDLE_IN   prhs[1]
+#define	ENV_IN	prhs[2]
+#define	CMD_IN	prhs[3]
+#define TAR_OUT  prhs[4]
+#define HEALTH_PARAMS_IN prhs[5]
+#define BLDS_IN prhs[6]
+#define CAPACITY_IN prhs[1]
+#define SETTINGS_IN prhs[2]
+
+#define MAX_SESSIONS    64
+#define NUM_OUTPUTS     5
+#define MAX_EVENTS      1024    /* events of an evaluation kept by 'diag' */
+#define MAX_CODES       16      /* longest IWork of the components */
+
+/* Rows of DEP, X, U, Y and E */
+static const unsigned int output_rows[NUM_OUTPUTS] = {
+    AGTF30_NUM_DEP, AGTF30_NUM_X, AGTF30_NUM_U, AGTF30_NUM_Y, AGTF30_NUM_E
+};
+#define ROWS_PER_POINT  (AGTF30_NUM_DEP + AGTF30_NUM_X + AGTF30_NUM_U + AGTF30_NUM_Y + AGTF30_NUM_E)
+
+struct EngineSession {
+    int open;
+    AGTF30Workspace ws;
+    AGTF30Batch batch;              /* settings of the session; DEP..E point into buffer */
+    int num_threads;                /* 0 = all cores */
+
+    unsigned int capacity;          /* points the buffer holds */
+    double *buffer;                 /* DEP, X, U, Y and E of capacity points, one after the other */
+    double *output[NUM_OUTPUTS];
+
+    /*--- Diagnostics returned by 'diag' ---*/
+    int diagnostics;
+    unsigned int *flags;            /* AGTF30_DIAG_NUM_COMPONENTS words for each of capacity points */
+    AGTF30DiagEvent events[MAX_EVENTS];
+    unsigned int num_events;
+    double events_lost;
+    double counts[AGTF30_DIAG_NUM_COMPONENTS][MAX_CODES];
+
+    /*--- Counters returned by 'stats' ---*/
+    double num_evals;
+    double num_points;
+    double num_allocs;
+    double bytes_allocated;
+};
+
+static struct EngineSession sessions[MAX_SESSIONS];
+
+/* Returns the number of points (columns) held in a real double input with
+ * the given number of rows, or 0 if the input has the wrong shape. A row
+ * vector of length rows is accepted as a single point. */
+static unsigned int num_points(const mxArray *arg, unsigned int rows)
+{
+    unsigned int m = (unsigned int)mxGetM(arg);
+    unsigned int n = (unsigned int)mxGetN(arg);
+
+    if (!mxIsDouble(arg) || mxIsComplex(arg))
+        return 0;
+    if (m == rows && n >= 1)
+        return n;
+    if (m == 1 && n == rows)
+        return 1;
+    return 0;
+}
+
+/* Makes the output buffer of a session hold at least N points */
+static void reserve(struct EngineSession *s, unsigned int N)
+{
+    double *buffer;
+    size_t bytes;
+    int k;
+
+    if (N <= s->capacity)
+        return;
+    bytes = (size_t)N * ROWS_PER_POINT * sizeof(double);
+    buffer = (double*)calloc((size_t)N * ROWS_PER_POINT, sizeof(double));
+    if (buffer == NULL)
+        mexErrMsgTxt("Cannot allocate the session outputs.");
+    if (s->diagnostics) {
+        free(s->flags);
+        s->flags = (unsigned int*)calloc((size_t)N * AGTF30_DIAG_NUM_COMPONENTS, sizeof(unsigned int));
+        if (s->flags == NULL) {
+            free(buffer);
+            mexErrMsgTxt("Cannot allocate the session diagnostics.");
+        }
+        s->batch.diag_flags = s->flags;
+        s->num_allocs++;
+        s->bytes_allocated += (double)N * AGTF30_DIAG_NUM_COMPONENTS * sizeof(unsigned int);
+    }
+    free(s->buffer);
+    s->buffer = buffer;
+    s->capacity = N;
+    s->num_allocs++;
+    s->bytes_allocated += (double)bytes;
+
+    s->output[0] = buffer;
+    for (k = 1; k < NUM_OUTPUTS; k++)
+        s->output[k] = s->output[k-1] + (size_t)N * output_rows[k-1];
+    s->batch.DEP = s->output[0];
+    s->batch.X = s->output[1];
+    s->batch.U = s->output[2];
+    s->batch.Y = s->output[3];
+    s->batch.E = s->output[4];
+}
+
+static void close_session(struct EngineSession *s)
+{
+    free(s->buffer);
+    free(s->flags);
+    memset(s, 0, sizeof(*s));
+}
+
+static void close_all(void)
+{
+    int i;
+
+    for (i = 0; i < MAX_SESSIONS; i++) {
+        if (sessions[i].open)
+            close_session(&sessions[i]);
+    }
+    AGTF30_pool_shutdown();
+}
+
+/* Returns the open session of a handle */
+static struct EngineSession* get_session(const mxArray *arg)
+{
+    double h;
+
+    if (!mxIsDouble(arg) || mxIsComplex(arg) || mxGetNumberOfElements(arg) != 1)
+        mexErrMsgTxt("The session handle must be a scalar.");
+    h = mxGetScalar(arg);
+    if (!(h >= 1 && h <= MAX_SESSIONS) || h != floor(h) || !sessions[(int)h - 1].open)
+        mexErrMsgTxt("Not an open session handle.");
+    return &sessions[(int)h - 1];
+}
+
+/* Copies the first nlhs outputs of the last evaluation to new arrays */
+static void return_outputs(struct EngineSession *s, int nlhs, mxArray *plhs[])
+{
+    unsigned int N = s->batch.N;
+    int k;
+
+    if (nlhs > NUM_OUTPUTS)
+        mexErrMsgTxt("At most 5 outputs (DEP, X, U, Y, E).");
+    for (k = 0; k < nlhs; k++) {
+        plhs[k] = mxCreateDoubleMatrix(output_rows[k], N, mxREAL);
+        memcpy(mxGetPr(plhs[k]), s->output[k], (size_t)N * output_rows[k] * sizeof(double));
+        s->num_allocs++;
+        s->bytes_allocated += (double)N * output_rows[k] * sizeof(double);
+    }
+}
+
+/* Orders events by point, then component and entry, so that they do not
+ * depend on which thread evaluated a point */
+static int compare_events(const void *a, const void *b)
+{
+    const AGTF30DiagEvent *ea = (const AGTF30DiagEvent*)a;
+    const AGTF30DiagEvent *eb = (const AGTF30DiagEvent*)b;
+
+    if (ea->eval_id != eb->eval_id)
+        return (ea->eval_id < eb->eval_id) ? -1 : 1;
+    if (ea->component != eb->component)
+        return (ea->component < eb->component) ? -1 : 1;
+    return (int)ea->code - (int)eb->code;
+}
+
+/* Appends the events kept in the ring buffer of a workspace */
+static void gather_events(struct EngineSession *s, const AGTF30Diag *d)
+{
+    unsigned int kept, i;
+
+    kept = (d->num_events < AGTF30_DIAG_RING) ? d->num_events : AGTF30_DIAG_RING;
+    s->events_lost += d->num_events - kept;
+    for (i = d->num_events - kept; i < d->num_events; i++) {
+        if (s->num_events < MAX_EVENTS)
+            s->events[s->num_events++] = d->ring[i & (AGTF30_DIAG_RING - 1)];
+        else
+            s->events_lost++;
+    }
+}
+
+/* Counts the flags of the last evaluation and gathers its events from the
+ * workspaces of the threads that took part */
+static void collect_diagnostics(struct EngineSession *s, int threads_used)
+{
+    unsigned int j, f;
+    int k, i;
+
+    for (j = 0; j < s->batch.N * AGTF30_DIAG_NUM_COMPONENTS; j++) {
+        for (f = s->flags[j], k = 0; f != 0; f >>= 1, k++) {
+            if (f & 1u)
+                s->counts[j % AGTF30_DIAG_NUM_COMPONENTS][k]++;
+        }
+    }
+
+    s->num_events = 0;
+    s->events_lost = 0;
+    gather_events(s, &s->ws.diag);
+    for (i = 0; i < threads_used - 1; i++) {
+        if (AGTF30_pool_diag(i) != NULL)
+            gather_events(s, AGTF30_pool_diag(i));
+    }
+    if (s->num_events > 1)
+        qsort(s->events, s->num_events, sizeof(AGTF30DiagEvent), compare_events);
+}
+
+static void return_diagnostics(struct EngineSession *s, int nlhs, mxArray *plhs[])
+{
+    unsigned int N = s->batch.N;
+    unsigned int j;
+    double *out;
+    int c, k;
+
+    if (!s->diagnostics)
+        mexErrMsgTxt("The session was opened without diagnostics (SETTINGS_IN(5)).");
+    if (nlhs > 4)
+        mexErrMsgTxt("At most 4 outputs (FLAGS, EVENTS, COUNTS, LOST).");
+
+    plhs[0] = mxCreateDoubleMatrix(AGTF30_DIAG_NUM_COMPONENTS, N, mxREAL);
+    out = mxGetPr(plhs[0]);
+    for (j = 0; j < N * AGTF30_DIAG_NUM_COMPONENTS; j++)
+        out[j] = (double)s->flags[j];
+    if (nlhs >= 2) {
+        plhs[1] = mxCreateDoubleMatrix(4, s->num_events, mxREAL);
+        out = mxGetPr(plhs[1]);
+        for (j = 0; j < s->num_events; j++) {
+            out[4*j] = (double)s->events[j].eval_id + 1;
+            out[4*j+1] = (double)s->events[j].component + 1;
+            out[4*j+2] = (double)s->events[j].code + 1;
+            out[4*j+3] = (double)s->events[j].value;
+        }
+    }
+    if (nlhs >= 3) {
+        plhs[2] = mxCreateDoubleMatrix(AGTF30_DIAG_NUM_COMPONENTS, MAX_CODES, mxREAL);
+        out = mxGetPr(plhs[2]);
+        for (c = 0; c < AGTF30_DIAG_NUM_COMPONENTS; c++) {
+            for (k = 0; k < MAX_CODES; k++)
+                out[c + k * AGTF30_DIAG_NUM_COMPONENTS] = s->counts[c][k];
+        }
+    }
+    if (nlhs >= 4)
+        plhs[3] = mxCreateDoubleScalar(s->events_lost);
+}
+
+static void session_open(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    struct EngineSession *s = NULL;
+    const double *settings_in;
+    size_t num_settings = 0;
+    double capacity = 1;
+    int i;
+
+    for (i = 0; i < MAX_SESSIONS && s == NULL; i++) {
+        if (!sessions[i].open)
+            s = &sessions[i];
+    }
+    if (s == NULL)
+        mexErrMsgTxt("Too many open sessions.");
+
+    if (nrhs >= 2) {
+        if (!mxIsDouble(CAPACITY_IN) || mxGetNumberOfElements(CAPACITY_IN) != 1)
+            mexErrMsgTxt("CAPACITY must be a scalar.");
+        capacity = mxGetScalar(CAPACITY_IN);
+        if (!(capacity >= 1 && capacity <= 1e8))
+            mexErrMsgTxt("CAPACITY must be between 1 and 1e8.");
+    }
+    if (nrhs >= 3) {
+        if (!mxIsDouble(SETTINGS_IN) || mxIsComplex(SETTINGS_IN))
+            mexErrMsgTxt("SETTINGS_IN must be a real double vector.");
+        num_settings = mxGetNumberOfElements(SETTINGS_IN);
+    }
+
+    memset(s, 0, sizeof(*s));
+    AGTF30_workspace_init(&s->ws, AGTF30_model_init());
+
+    /*--- Settings, read as SETTINGS_IN of MEX_engine_model ---*/
+    s->batch.enable_debug = 0;
+    s->batch.use_lanes = 1;
+    s->batch.eval_level = AGTF30_EVAL_FULL;
+    if (num_settings >= 1) {
+        settings_in = mxGetPr(SETTINGS_IN);
+        s->batch.enable_debug = settings_in[0];
+        if (num_settings >= 2)
+            s->num_threads = (int)settings_in[1];
+        if (num_settings >= 3)
+            s->batch.use_lanes = (settings_in[2] != 0);
+        if (num_settings >= 4 && settings_in[3] >= AGTF30_EVAL_RESIDUALS && settings_in[3] < AGTF30_EVAL_FULL)
+            s->batch.eval_level = (int)settings_in[3];
+        if (num_settings >= 5)
+            s->diagnostics = (settings_in[4] != 0);
+    }
+    s->batch.use_lanes = s->batch.use_lanes && (s->batch.enable_debug == 0);
+    if (s->num_threads <= 0)
+        s->num_threads = AGTF30_num_cores();
+
+    reserve(s, (unsigned int)capacity);
+    s->open = 1;
+
+    mexAtExit(close_all);
+    if (nlhs >= 1)
+        plhs[0] = mxCreateDoubleScalar((double)(s - sessions) + 1);
+}
+
+static void session_eval(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+    struct EngineSession *s = get_session(HANDLE_IN);
+    AGTF30Batch *b = &s->batch;
+    unsigned int N, N_env, N_tar, N_health;
+    int threads_used;
+
+    if (nrhs != 7)
+        mexErrMsgTxt("'eval' requires H, ENV_IN, CMD_IN, TAR_OUT, HEALTH_PARAMS_IN and BLDS_IN.");
+
+    /* CMD_IN sets the number of points N, the other inputs are shared or per point as in MEX_engine_model */
+    N = num_points(CMD_IN, AGTF30_NUM_CMD);
+    if (N == 0)
+        mexErrMsgTxt("Requires that CMD_IN be a 14 x N matrix.");
+    N_env = num_points(ENV_IN, AGTF30_NUM_ENV);
+    if (N_env != 1 && N_env != N)
+        mexErrMsgTxt("Requires that ENV_IN be a 3 x 1 vector or a 3 x N matrix.");
+    N_tar = num_points(TAR_OUT, AGTF30_NUM_TAR);
+    if (N_tar != 1 && N_tar != N)
+        mexErrMsgTxt("Requires that TAR_OUT be a 3 x 1 vector or a 3 x N matrix.");
+    N_health = num_points(HEALTH_PARAMS_IN, AGTF30_NUM_HEALTH);
+    if (N_health != 1 && N_health != N)
+        mexErrMsgTxt("Requires that HEALTH_PARAMS_IN be a 13 x 1 vector or a 13 x N matrix.");
+    if (num_points(BLDS_IN, AGTF30_NUM_BLDS) != 1)
+        mexErrMsgTxt("Requires that BLDS_IN be a 4 x 1 vector.");
+
+    reserve(s, N);
+
+    b->N = N;
+    b->env = mxGetPr(ENV_IN);
+    b->env_stride = (N_env == 1) ? 0 : AGTF30_NUM_ENV;
+    b->cmd = mxGetPr(CMD_IN);
+    b->tar = mxGetPr(TAR_OUT);
+    b->tar_stride = (N_tar == 1) ? 0 : AGTF30_NUM_TAR;
+    b->health_params = mxGetPr(HEALTH_PARAMS_IN);
+    b->health_stride = (N_health == 1) ? 0 : AGTF30_NUM_HEALTH;
+    b->blds = mxGetPr(BLDS_IN);
+
+    /*--- Debug runs stay serial, see MEX_engine_model ---*/
+    if (s->num_threads > 1 && N > 1 && b->enable_debug == 0) {
+        AGTF30_pool_start(s->ws.mdl, s->num_threads);
+        threads_used = AGTF30_pool_eval(&s->ws, b, s->num_threads);
+    }
+    else {
+        AGTF30_diag_reset(&s->ws.diag);
+        AGTF30_engine_eval_batch(&s->ws, b, 0, N);
+        threads_used = 1;
+    }
+    s->num_evals++;
+    s->num_points += N;
+    if (s->diagnostics)
+        collect_diagnostics(s, threads_used);
+
+    return_outputs(s, nlhs, plhs);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],
+                 int nrhs, const mxArray *prhs[])
+{
+    struct EngineSession *s;
+    char command[8];
+    double *stats;
+
+    if (nrhs < 1 || !mxIsChar(COMMAND_IN) || mxGetString(COMMAND_IN, command, sizeof(command)) != 0)
+        mexErrMsgTxt("The first input must be 'open', 'eval', 'get', 'stats', 'diag' or 'close'.");
+
+    if (strcmp(command, "eval") == 0) {
+        session_eval(nlhs, plhs, nrhs, prhs);
+        return;
+    }
+    if (strcmp(command, "open") == 0) {
+        session_open(nlhs, plhs, nrhs, prhs);
+        return;
+    }
+
+    if (nrhs != 2)
+        mexErrMsgTxt("'get', 'stats', 'diag' and 'close' take the session handle only.");
+    s = get_session(HANDLE_IN);
+
+    if (strcmp(command, "get") == 0) {
+        return_outputs(s, nlhs, plhs);
+    }
+    else if (strcmp(command, "stats") == 0) {
+        plhs[0] = mxCreateDoubleMatrix(4, 1, mxREAL);
+        stats = mxGetPr(plhs[0]);
+        stats[0] = s->num_evals;
+        stats[1] = s->num_points;
+        stats[2] = s->num_allocs;
+        stats[3] = s->bytes_allocated;
+    }
+    else if (strcmp(command, "diag") == 0) {
+        return_diagnostics(s, nlhs, plhs);
+    }
+    else if (strcmp(command, "close") == 0) {
+        close_session(s);
+    }
+    else {
+        mexErrMsgTxt("The first input must be 'open', 'eval', 'get', 'stats', 'diag' or 'close'.");
+    }
+}
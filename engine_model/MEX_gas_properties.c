@@ -0,0 +1,104 @@
+#include "mex.h"
+#include <string.h>
+#include "functions_TMATS.h"
+#include "AGTF30_lanes.h"
+
+/*		MEX_gas_properties.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Gas property routines over arrays:
+%   H = MEX_gas_properties('t2hc', T, FAR)
+%   T = MEX_gas_properties('h2tc', H, FAR)
+%   S = MEX_gas_properties('pt2sc', P, T, FAR)
+%   T = MEX_gas_properties('sp2tc', S, P, FAR)
+%
+%  The arguments are those of t2hc, h2tc, pt2sc and sp2tc. Each is either
+%  a scalar or an array; all arrays must have the same number of elements
+%  and scalars are used for every element. The result has the shape of
+%  the first array argument. The points are evaluated in lane groups
+%  (t2hc_array, ..., properties_TMATS_lanes.c), with the results of
+%  t2hc_mix, h2tc_mix, pt2sc_mix and sp2tc_mix.
+%
+%  Example, enthalpy and entropy of the burner exit for every point of
+%  outputs.mat:
+%   S4 = MEX_gas_properties('pt2sc', Pt4, Tt4, FAR4);
+% *************************************************************************/
+
+#define NAME_IN prhs[0]
+#define RESULT_OUT plhs[0]
+
+void mexFunction(int nlhs, mxArray *plhs[],
+                 int nrhs, const mxArray *prhs[])
+{
+    char name[8];
+    const mxArray *shape = 0;
+    const double *x[3];
+    int inc[3];
+    int num_args, i;
+    size_t n = 1, numel;
+    double *out;
+
+    if (nrhs < 1 || !mxIsChar(NAME_IN) || mxGetString(NAME_IN, name, sizeof(name)) != 0) {
+    mexErrMsgTxt("First input to MEX gas properties must be 't2hc', 'h2tc', 'pt2sc' or 'sp2tc'");
+    }
+    if (strcmp(name, "t2hc") == 0 || strcmp(name, "h2tc") == 0)
+        num_args = 2;
+    else if (strcmp(name, "pt2sc") == 0 || strcmp(name, "sp2tc") == 0)
+        num_args = 3;
+    else {
+        mexErrMsgTxt("First input to MEX gas properties must be 't2hc', 'h2tc', 'pt2sc' or 'sp2tc'");
+        return;
+    }
+    if (nrhs != num_args + 1) {
+    mexErrMsgTxt(num_args == 2 ? "3 inputs to MEX gas properties required for t2hc and h2tc"
+                               : "4 inputs to MEX gas properties required for pt2sc and sp2tc");
+    } else if (nlhs > 1) {
+    mexErrMsgTxt("At most 1 output argument from MEX gas properties");
+    }
+
+    /*--- Scalars are used for every point, arrays must agree in size ---*/
+    for (i = 0; i < num_args; i++) {
+        const mxArray *arg = prhs[i + 1];
+
+        if (!mxIsDouble(arg) || mxIsComplex(arg) || mxIsSparse(arg)) {
+        mexErrMsgTxt("Inputs to MEX gas properties must be real double arrays.");
+        }
+        numel = mxGetNumberOfElements(arg);
+        x[i] = mxGetPr(arg);
+        inc[i] = (numel != 1);
+        if (numel == 1)
+            continue;
+        if (shape == 0) {
+            shape = arg;
+            n = numel;
+        }
+        else if (numel != n) {
+        mexErrMsgTxt("Array inputs to MEX gas properties must have the same number of elements.");
+        }
+    }
+    if (n > 0xFFFFFFFFu) {
+    mexErrMsgTxt("Too many points for MEX gas properties.");
+    }
+
+    if (shape == 0)
+        RESULT_OUT = mxCreateDoubleMatrix(1, 1, mxREAL);
+    else
+        RESULT_OUT = mxCreateNumericArray(mxGetNumberOfDimensions(shape), mxGetDimensions(shape),
+                                          mxDOUBLE_CLASS, mxREAL);
+    out = mxGetPr(RESULT_OUT);
+    if (n == 0)
+        return;
+
+    /*--- Tables of h2tc_mix and sp2tc_mix ---*/
+    gas_tables_init();
+
+    if (strcmp(name, "t2hc") == 0)
+        t2hc_array(out, x[0], inc[0], x[1], inc[1], (unsigned int)n);
+    else if (strcmp(name, "h2tc") == 0)
+        h2tc_array(out, x[0], inc[0], x[1], inc[1], (unsigned int)n);
+    else if (strcmp(name, "pt2sc") == 0)
+        pt2sc_array(out, x[0], inc[0], x[1], inc[1], x[2], inc[2], (unsigned int)n);
+    else
+        sp2tc_array(out, x[0], inc[0], x[1], inc[1], x[2], inc[2], (unsigned int)n);
+}
@@ -0,0 +1,156 @@
+#include "mex.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+
+/*		MEX_gas_properties_benchmark.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  RESULTS = MEX_gas_properties_benchmark(NUM_REPEATS)
+%
+%  Microbenchmark of the gas property routines. t2hc, h2tc, pt2sc, sp2tc
+%  and PcalcStat are timed against their GasMix versions (t2hc_mix, ...,
+%  properties_TMATS.c) on a grid of temperatures, pressures and fuel-air
+%  ratios covering the engine model, NUM_REPEATS times (default 200).
+%
+%  RESULTS is 5 x 4, one row per routine in the order above:
+%   [ns per call original, ns per call GasMix, results not bit identical,
+%    largest absolute difference]
+%  The GasMix times include one gasmix per fuel-air ratio, as a component
+%  would compute it. Built with TMATS_PROPERTIES_CONVERGED, h2tc_mix and
+%  sp2tc_mix invert t2hc and pt2sc from tables with one Newton step, so
+%  their results differ from the secant iterations of h2tc and sp2tc by
+%  the iteration error of those; built with TMATS_PROPERTIES_REFERENCE
+%  all routines match bit for bit.
+% *************************************************************************/
+
+/* Input Arguments */
+#define NUM_REPEATS_IN prhs[0]
+
+/* Output Arguments */
+#define RESULTS_OUT plhs[0]
+
+#define NUM_FAR 3
+#define NUM_T   35
+#define NUM_P   8
+#define NUM_PTS (NUM_FAR*NUM_T*NUM_P)
+#define NUM_ROUTINES 5
+
+/* Sink for the results, so the timed loops are not optimized away */
+static volatile double sink;
+
+static double FARgrid[NUM_FAR] = {0, 0.015, 0.03};
+
+/* Compares two results bit for bit */
+static int differ(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(double)) != 0;
+}
+
+static double ns_per_call(clock_t start, unsigned int calls)
+{
+    return 1e9 * (double)(clock() - start) / CLOCKS_PER_SEC / calls;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],
+                 int nrhs, const mxArray *prhs[])
+{
+    static double T[NUM_PTS], P[NUM_PTS], fa[NUM_PTS], H[NUM_PTS], S[NUM_PTS], Ps[NUM_PTS];
+    static double ref[NUM_ROUTINES][NUM_PTS], mixed[NUM_ROUTINES][NUM_PTS];
+    double Sx, Ts, hs, rhos, V, acc, *results;
+    unsigned int num_repeats = 200, rep, calls;
+    int f, i, j, k, n, r;
+    GasMix mix;
+    clock_t start;
+
+    if (nrhs > 1) {
+    mexErrMsgTxt("At most 1 input to MEX gas properties benchmark");
+    } else if (nlhs > 1) {
+    mexErrMsgTxt("At most 1 output argument from MEX gas properties benchmark");
+    }
+    if (nrhs == 1) {
+        if (mxGetScalar(NUM_REPEATS_IN) < 1) {
+        mexErrMsgTxt("NUM_REPEATS must be at least 1.");
+        }
+        num_repeats = (unsigned int)mxGetScalar(NUM_REPEATS_IN);
+    }
+
+    /*--- Test points, ordered by fuel-air ratio ---*/
+    n = 0;
+    for (f = 0; f < NUM_FAR; f++) {
+        for (i = 0; i < NUM_T; i++) {
+            for (j = 0; j < NUM_P; j++) {
+                fa[n] = FARgrid[f];
+                T[n] = 400 + 100.0*i + 7.3*j;
+                P[n] = 5 * pow(2.0, j);
+                H[n] = t2hc(T[n], fa[n]);
+                S[n] = pt2sc(P[n], T[n], fa[n]);
+                Ps[n] = 0.6*P[n];
+                n++;
+            }
+        }
+    }
+    calls = num_repeats * NUM_PTS;
+    results = mxGetPr(RESULTS_OUT = mxCreateDoubleMatrix(NUM_ROUTINES, 4, mxREAL));
+
+    /*--- Original routines ---*/
+    for (r = 0; r < NUM_ROUTINES; r++) {
+        acc = 0;
+        start = clock();
+        for (rep = 0; rep < num_repeats; rep++) {
+            for (k = 0; k < NUM_PTS; k++) {
+                switch (r) {
+                    case 0: ref[r][k] = t2hc(T[k], fa[k]); break;
+                    case 1: ref[r][k] = h2tc(H[k], fa[k]); break;
+                    case 2: ref[r][k] = pt2sc(P[k], T[k], fa[k]); break;
+                    case 3: ref[r][k] = sp2tc(S[k], Ps[k], fa[k]); break;
+                    default:
+                        PcalcStat(P[k], Ps[k], T[k], H[k], fa[k], 0.0686, &Sx, &Ts, &hs, &rhos, &V);
+                        ref[r][k] = V;
+                }
+                acc += ref[r][k];
+            }
+        }
+        results[r] = ns_per_call(start, calls);
+        sink = acc;
+    }
+
+    /*--- GasMix routines, one gasmix per fuel-air ratio ---*/
+    for (r = 0; r < NUM_ROUTINES; r++) {
+        acc = 0;
+        start = clock();
+        for (rep = 0; rep < num_repeats; rep++) {
+            for (k = 0; k < NUM_PTS; k++) {
+                if (k % (NUM_T*NUM_P) == 0)
+                    gasmix(&mix, fa[k]);
+                switch (r) {
+                    case 0: mixed[r][k] = t2hc_mix(&mix, T[k]); break;
+                    case 1: mixed[r][k] = h2tc_mix(&mix, H[k]); break;
+                    case 2: mixed[r][k] = pt2sc_mix(&mix, P[k], T[k]); break;
+                    case 3: mixed[r][k] = sp2tc_mix(&mix, S[k], Ps[k]); break;
+                    default:
+                        PcalcStat_mix(&mix, P[k], Ps[k], T[k], H[k], 0.0686, &Sx, &Ts, &hs, &rhos, &V);
+                        mixed[r][k] = V;
+                }
+                acc += mixed[r][k];
+            }
+        }
+        results[r + NUM_ROUTINES] = ns_per_call(start, calls);
+        sink = acc;
+    }
+
+    /*--- Bit for bit comparison and largest difference ---*/
+    for (r = 0; r < NUM_ROUTINES; r++) {
+        results[r + 2*NUM_ROUTINES] = 0;
+        results[r + 3*NUM_ROUTINES] = 0;
+        for (k = 0; k < NUM_PTS; k++) {
+            results[r + 2*NUM_ROUTINES] += differ(ref[r][k], mixed[r][k]);
+            if (fabs(ref[r][k] - mixed[r][k]) > results[r + 3*NUM_ROUTINES])
+                results[r + 3*NUM_ROUTINES] = fabs(ref[r][k] - mixed[r][k]);
+        }
+    }
+}
@@ -0,0 +1,318 @@
+#include "mex.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+#include "AGTF30_model.h"
+#include "functions_TMATS.h"
+
+/*		MEX_interp_benchmark.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  [RESULTS, MAPS] = MEX_interp_benchmark(NUM_REPEATS)
+%
+%  Microbenchmark of the interpolation kernels chosen per table by
+%  AGTF30_model_init (interpAt_TMATS.c). Every table of the model is read
+%  with interp1Ac/2Ac/3Ac and with interp1At/2At/3At at the same points,
+%  NUM_REPEATS times (default 200). The points sweep each axis from 5%
+%  below its range to 5% above it, so the bounds are checked too, plus
+%  one NaN point; consecutive points are close, as in the component
+%  searches, and the compressor maps keep their cells between lookups.
+%
+%  RESULTS is NUM_TABLES x 7, one row per table in the order listed in
+%  benchmark_interp.m:
+%   [constant table, search of axis 1, 2 and 3 (INTERP_SCAN = 0, ...,
+%    -1 for no axis), ns per lookup interp*Ac, ns per lookup interp*At,
+%    lookups whose value or interpErr is not bit identical]
+%  MAPS is 5 x 4, one row per turbomachinery map (fan, lpc, hpc, hpt,
+%  lpt), read on the same sweep:
+%   [tables of the map, ns per point reading them one by one with
+%    interp*At, ns per point reading them together with interp2Am/3Am,
+%    values whose bits differ]
+%  Built with TMATS_PROPERTIES_REFERENCE the model has no kernels and
+%  interp*At falls back to interp*Ac; the kinds are then -1. It has no
+%  maps either and interp2Am/3Am read the tables one by one.
+% *************************************************************************/
+
+/* Input Arguments */
+#define NUM_REPEATS_IN prhs[0]
+
+/* Output Arguments */
+#define RESULTS_OUT plhs[0]
+#define MAPS_OUT    plhs[1]
+
+#define NUM_TABLES  36
+#define NUM_MAPS    5
+#define NUM_SWEEP   24      /* points per axis */
+#define MAX_PTS     (NUM_SWEEP*NUM_SWEEP*NUM_SWEEP + 1)
+
+/* One table as its component reads it */
+struct BenchTable {
+    const InterpTable *K;
+    double *X, *Y, *Z, *V;
+    int A, B, C;
+    int compressor;         /* keeps the cells of its last lookup */
+};
+
+/* Sink for the results, so the timed loops are not optimized away */
+static volatile double sink;
+
+static struct BenchTable bench[NUM_TABLES];
+static int num_bench;
+
+/* One turbomachinery map: its first table in bench and the map */
+struct BenchMap {
+    int first;
+    int num;
+    const InterpMap *M;
+};
+static struct BenchMap bench_maps[NUM_MAPS];
+static int num_maps;
+
+static void add1(const InterpTable *K, double *X, double *V, int A)
+{
+    struct BenchTable *b = &bench[num_bench++];
+    b->K = K; b->X = X; b->Y = NULL; b->Z = NULL; b->V = V;
+    b->A = A; b->B = 0; b->C = 0; b->compressor = 0;
+}
+
+static void add2(const InterpTable *K, double *X, double *Y, double *V, int A, int B, int compressor)
+{
+    struct BenchTable *b = &bench[num_bench++];
+    b->K = K; b->X = X; b->Y = Y; b->Z = NULL; b->V = V;
+    b->A = A; b->B = B; b->C = 0; b->compressor = compressor;
+}
+
+static void add_compressor(const CompressorStruct *c)
+{
+    double *maps[3];
+    const InterpTable *K[3];
+    int m;
+
+    maps[0] = c->T_C_Map_WcArray; maps[1] = c->T_C_Map_PRArray; maps[2] = c->T_C_Map_EffArray;
+    K[0] = c->K_C_Wc; K[1] = c->K_C_PR; K[2] = c->K_C_Eff;
+    bench_maps[num_maps].first = num_bench;
+    bench_maps[num_maps].num = 3;
+    bench_maps[num_maps++].M = c->M_C_Map;
+    for (m = 0; m < 3; m++) {
+        add2(K[m], c->X_C_RlineVec, c->Y_C_Map_NcVec, maps[m], c->B, c->A, 1);
+        if (c->C > 1) {
+            bench[num_bench-1].Z = c->Z_C_AlphaVec;
+            bench[num_bench-1].C = c->C;
+        }
+    }
+    add1(c->K_C_PRSurge, c->X_C_Map_WcSurgeVec, c->T_C_Map_PRSurgeVec, c->D);
+}
+
+static void add_turbine(const TurbineStruct *t)
+{
+    bench_maps[num_maps].first = num_bench;
+    bench_maps[num_maps].num = 2;
+    bench_maps[num_maps++].M = t->M_T_Map;
+    add2(t->K_T_Wc, t->X_T_PRVec, t->Y_T_NcVec, t->T_T_Map_WcArray, t->B, t->A, 0);
+    add2(t->K_T_Eff, t->X_T_PRVec, t->Y_T_NcVec, t->T_T_Map_EffArray, t->B, t->A, 0);
+}
+
+static void add_nozzle(const NozzleStruct *n)
+{
+    add1(n->K_N_Rt, n->Y_N_FARVec, n->T_N_RtArray, n->A);
+    add2(n->K_N_gamma, n->Y_N_FARVec, n->X_N_TtVec, n->T_N_MAP_gammaArray, n->A, n->B, 0);
+    add1(n->K_N_CdTh, n->X_N_PEQPaVec, n->T_N_CdThArray, n->B1);
+    add1(n->K_N_Cv, n->X_N_PEQPaVec, n->T_N_CvArray, n->B1);
+    add1(n->K_N_Cfg, n->X_N_PEQPaVec, n->T_N_CfgArray, n->B1);
+    add1(n->K_N_TG, n->X_N_TtVecTG, n->T_N_TGArray, n->C);
+}
+
+/* Value k of NUM_SWEEP from 5% below to 5% above the axis range */
+static double sweep(const double *X, int n, int k)
+{
+    double span = X[n-1] - X[0];
+    return X[0] - 0.05*span + 1.1*span*k/(NUM_SWEEP - 1);
+}
+
+/* Compares two results bit for bit */
+static int differ(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(double)) != 0;
+}
+
+/* Points of a table: a raster sweep over the axes, then NaN */
+static int sweep_points(const struct BenchTable *b, double *xs, double *ys, double *zs)
+{
+    int i, j, k, n = 0;
+
+    for (k = 0; k < (b->Z != NULL ? NUM_SWEEP : 1); k++) {
+        for (j = 0; j < (b->Y != NULL ? NUM_SWEEP : 1); j++) {
+            for (i = 0; i < NUM_SWEEP; i++) {
+                xs[n] = sweep(b->X, b->A, (j % 2) ? NUM_SWEEP - 1 - i : i);
+                ys[n] = b->Y != NULL ? sweep(b->Y, b->B, j) : 0;
+                zs[n] = b->Z != NULL ? sweep(b->Z, b->C, k) : 0;
+                n++;
+            }
+        }
+    }
+    xs[n] = ys[n] = zs[n] = mxGetNaN();
+    return n + 1;
+}
+
+/* Values of the tables of a map at one point, read together */
+static void map_lookup(const struct BenchMap *p, double x, double y, double z, int *cell, double *v, int *err)
+{
+    const struct BenchTable *b = &bench[p->first];
+    double *V[INTERP_MAP_MAX];
+    int k;
+
+    for (k = 0; k < p->num; k++)
+        V[k] = bench[p->first + k].V;
+    if (b->Z != NULL)
+        interp3Am(p->M, b->X, b->Y, b->Z, V, p->num, x, y, z, b->A, b->B, b->C, cell, v, err);
+    else
+        interp2Am(p->M, b->X, b->Y, V, p->num, x, y, b->A, b->B, cell, v, err);
+}
+
+static double ns_per_call(clock_t start, unsigned int calls)
+{
+    return 1e9 * (double)(clock() - start) / CLOCKS_PER_SEC / calls;
+}
+
+static double lookup(const struct BenchTable *b, int kernel, double x, double y, double z, int *cell, int *err)
+{
+    if (b->Z != NULL)
+        return kernel ? interp3At(b->K, b->X, b->Y, b->Z, b->V, x, y, z, b->A, b->B, b->C, cell, err)
+                      : interp3Ac(b->X, b->Y, b->Z, b->V, x, y, z, b->A, b->B, b->C, err);
+    if (b->Y != NULL)
+        return kernel ? interp2At(b->K, b->X, b->Y, b->V, x, y, b->A, b->B, cell, err)
+                      : interp2Ac(b->X, b->Y, b->V, x, y, b->A, b->B, err);
+    return kernel ? interp1At(b->K, b->X, b->V, x, b->A, cell, err)
+                  : interp1Ac(b->X, b->V, x, b->A, err);
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],
+                 int nrhs, const mxArray *prhs[])
+{
+    static double xs[MAX_PTS], ys[MAX_PTS], zs[MAX_PTS], val[2][MAX_PTS];
+    static double mval[2][INTERP_MAP_MAX][MAX_PTS];
+    static int errs[2][MAX_PTS];
+    const AGTF30Model *mdl;
+    const struct BenchTable *b;
+    const struct BenchMap *p;
+    double acc, v[INTERP_MAP_MAX], *results, *maps;
+    clock_t start;
+    unsigned int num_repeats = 200, rep;
+    int cell[3], t, k, n, m, kernel, ax, err;
+
+    if (nrhs > 1) {
+    mexErrMsgTxt("At most 1 input to MEX interpolation benchmark");
+    } else if (nlhs > 2) {
+    mexErrMsgTxt("At most 2 output arguments from MEX interpolation benchmark");
+    }
+    if (nrhs == 1) {
+        if (mxGetScalar(NUM_REPEATS_IN) < 1) {
+        mexErrMsgTxt("NUM_REPEATS must be at least 1.");
+        }
+        num_repeats = (unsigned int)mxGetScalar(NUM_REPEATS_IN);
+    }
+
+    /*--- Tables of the model, in the order of benchmark_interp.m ---*/
+    mdl = AGTF30_model_init();
+    num_bench = 0;
+    num_maps = 0;
+    add1(mdl->ambient.K_A_Ts, mdl->ambient.X_A_AltVec, mdl->ambient.T_A_TsVec, mdl->ambient.A);
+    add1(mdl->ambient.K_A_Ps, mdl->ambient.X_A_AltVec, mdl->ambient.T_A_PsVec, mdl->ambient.A);
+    add1(mdl->ambient.K_A_Rt, mdl->ambient.X_A_FARVec, mdl->ambient.T_A_RtArray, mdl->ambient.B);
+    add2(mdl->ambient.K_A_gamma, mdl->ambient.X_A_FARVec, mdl->ambient.Y_A_TVec, mdl->ambient.T_A_gammaArray,
+         mdl->ambient.B, mdl->ambient.C, 0);
+    add1(mdl->inlet.K_eRam_M, mdl->inlet.X_eRamVec_M, mdl->inlet.T_eRamtbl_M, mdl->inlet.A);
+    add_compressor(&mdl->fan);
+    add_compressor(&mdl->lpc);
+    add1(mdl->vbv.K_V_Wc, mdl->vbv.X_V_PRVec, mdl->vbv.T_V_WcVec, mdl->vbv.A);
+    add_nozzle(&mdl->nozbyp);
+    add_compressor(&mdl->hpc);
+    add1(mdl->hpcstatic.K_Rt, mdl->hpcstatic.X_FARVec, mdl->hpcstatic.T_RtArray, mdl->hpcstatic.A);
+    add2(mdl->hpcstatic.K_gamma, mdl->hpcstatic.X_FARVec, mdl->hpcstatic.Y_TtVec, mdl->hpcstatic.T_gammaArray,
+         mdl->hpcstatic.A, mdl->hpcstatic.B, 0);
+    add_turbine(&mdl->hpt);
+    add_turbine(&mdl->lpt);
+    add_nozzle(&mdl->nozcor);
+
+    results = mxGetPr(RESULTS_OUT = mxCreateDoubleMatrix(NUM_TABLES, 7, mxREAL));
+
+    for (t = 0; t < num_bench; t++) {
+        b = &bench[t];
+
+        n = sweep_points(b, xs, ys, zs);
+
+        /*--- interp*Ac, then interp*At ---*/
+        for (kernel = 0; kernel < 2; kernel++) {
+            acc = 0;
+            cell[0] = cell[1] = cell[2] = 0;
+            start = clock();
+            for (rep = 0; rep < num_repeats; rep++) {
+                for (m = 0; m < n; m++) {
+                    val[kernel][m] = lookup(b, kernel, xs[m], ys[m], zs[m], b->compressor ? cell : NULL,
+                                            &errs[kernel][m]);
+                    acc += val[kernel][m];
+                }
+            }
+            results[t + (4 + kernel)*NUM_TABLES] = ns_per_call(start, num_repeats*n);
+            sink = acc;
+        }
+
+        /*--- Kernel chosen and bit for bit comparison ---*/
+        results[t] = b->K != NULL && b->K->constant;
+        for (ax = 0; ax < 3; ax++)
+            results[t + (1 + ax)*NUM_TABLES] = (b->K != NULL && !b->K->generic && ax < b->K->dims) ? b->K->ax[ax].kind : -1;
+        results[t + 6*NUM_TABLES] = 0;
+        for (m = 0; m < n; m++)
+            results[t + 6*NUM_TABLES] += differ(val[0][m], val[1][m]) || errs[0][m] != errs[1][m];
+    }
+
+    /*--- Maps: the tables one by one with interp*At, then together ---*/
+    if (nlhs < 2)
+        return;
+    maps = mxGetPr(MAPS_OUT = mxCreateDoubleMatrix(NUM_MAPS, 4, mxREAL));
+    for (t = 0; t < num_maps; t++) {
+        p = &bench_maps[t];
+        n = sweep_points(&bench[p->first], xs, ys, zs);
+
+        acc = 0;
+        cell[0] = cell[1] = cell[2] = 0;
+        start = clock();
+        for (rep = 0; rep < num_repeats; rep++) {
+            for (m = 0; m < n; m++) {
+                for (k = 0; k < p->num; k++) {
+                    b = &bench[p->first + k];
+                    mval[0][k][m] = lookup(b, 1, xs[m], ys[m], zs[m], b->compressor ? cell : NULL, &err);
+                    acc += mval[0][k][m];
+                }
+            }
+        }
+        maps[t + NUM_MAPS] = ns_per_call(start, num_repeats*n);
+        sink = acc;
+
+        acc = 0;
+        cell[0] = cell[1] = cell[2] = 0;
+        start = clock();
+        for (rep = 0; rep < num_repeats; rep++) {
+            for (m = 0; m < n; m++) {
+                map_lookup(p, xs[m], ys[m], zs[m], bench[p->first].compressor ? cell : NULL, v, &err);
+                for (k = 0; k < p->num; k++) {
+                    mval[1][k][m] = v[k];
+                    acc += v[k];
+                }
+            }
+        }
+        maps[t + 2*NUM_MAPS] = ns_per_call(start, num_repeats*n);
+        sink = acc;
+
+        maps[t] = p->num;
+        maps[t + 3*NUM_MAPS] = 0;
+        for (k = 0; k < p->num; k++) {
+            for (m = 0; m < n; m++)
+                maps[t + 3*NUM_MAPS] += differ(mval[0][k][m], mval[1][k][m]);
+        }
+    }
+}
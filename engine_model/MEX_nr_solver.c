@@ -0,0 +1,206 @@
+#include "mex.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "types_TMATS.h"
+#include "types_TMATS_additions.h"
+#include "constants_TMATS.h"
+#include "AGTF30_model.h"
+#include "AGTF30_nr_solver.h"
+
+/*		MEX_nr_solver.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  [DEP,CMD,X,U,Y,E,converged,solver_iterations,model_evals,nozzle_stats,parameter_set] = ...
+%      MEX_nr_solver(ENV_IN,CMD_IN,TAR_OUT,HEALTH_PARAMS_IN,BLDS_IN,Ivec,Dvec,ENABLE_DEBUG,JACOBIAN_METHOD,MAP_INTERP)
+%
+%  Native replacement for nr_solver.m with the same inputs and outputs.
+%  model_evals is the number of engine model evaluations used.
+%  nozzle_stats counts the nozzle runs of the solve, one column for the
+%  bypass and one for the core nozzle: [runs; runs started from the
+%  throat of an earlier run; MN = 1 search iterations; exit pressure
+%  search iterations]. Without TMATS_PROPERTIES_CONVERGED the searches
+%  are the secant iterations, which take no seed, so the second row is 0.
+%  JACOBIAN_METHOD is optional: 0 (default) rebuilds the finite-difference
+%  Jacobian every NRASS iterations as nr_solver.m does, 1 uses Broyden
+%  updates and rebuilds only when progress stalls, 2 takes the exact
+%  Jacobian from forward mode derivatives of every model evaluation.
+%  MAP_INTERP is optional: 0 (default) interpolates the compressor and
+%  turbine maps linearly, 1 and 2 with C1 monotone cubic and Akima
+%  splines (AGTF30_model_init_maps). parameter_set is the solver
+%  parameter set of the last try, 2 when the first did not converge.
+% *************************************************************************/
+
+/* Input Arguments */
+#define	ENV_IN	prhs[0]
+#define	CMD_IN	prhs[1]
+#define TAR_OUT  prhs[2]
+#define HEALTH_PARAMS_IN prhs[3]
+#define BLDS_IN prhs[4]
+#define IVEC_IN prhs[5]
+#define DVEC_IN prhs[6]
+#define ENABLE_DEBUG_IN prhs[7]
+#define JACOBIAN_METHOD_IN prhs[8]
+#define MAP_INTERP_IN prhs[9]
+
+/*--- Workspace kept between calls; the model context it points to is built on the first call ---*/
+static AGTF30Workspace GTF_ws;
+static int GTF_ws_initialized = 0;
+static int GTF_ws_maps = AGTF30_MAPS_LINEAR;
+
+/* Reads a logical or double selection vector. MATLAB allows a logical
+ * index longer than the indexed vector as long as the extra entries are
+ * false, so those are accepted too. Returns 0 on a bad input. */
+static int read_selection(const mxArray *arg, int *sel, unsigned int len)
+{
+    unsigned int i, n = (unsigned int)mxGetNumberOfElements(arg);
+    const mxLogical *lp = NULL;
+    const double *dp = NULL;
+    int v;
+
+    if (mxIsLogical(arg))
+        lp = mxGetLogicals(arg);
+    else if (mxIsDouble(arg) && !mxIsComplex(arg))
+        dp = mxGetPr(arg);
+    else
+        return 0;
+    if (n < len)
+        return 0;
+
+    for (i = 0; i < n; i++) {
+        v = lp ? (lp[i] != 0) : (dp[i] != 0);
+        if (i < len)
+            sel[i] = v;
+        else if (v)
+            return 0;
+    }
+    return 1;
+}
+
+static mxArray* column(const double *v, unsigned int len)
+{
+    mxArray *a = mxCreateDoubleMatrix(len, 1, mxREAL);
+    memcpy(mxGetPr(a), v, len*sizeof(double));
+    return a;
+}
+
+void mexFunction(int nlhs, mxArray *plhs[],
+                 int nrhs, const mxArray *prhs[])
+{
+    int Ivec[AGTF30_NUM_CMD], Dvec[AGTF30_NUM_DEP];
+    double ENABLE_DEBUG;
+    int jacobian_method = AGTF30_JACOBIAN_NEWTON;
+    int maps = AGTF30_MAPS_LINEAR;
+    AGTF30SolverResult res;
+    const NozzleSearch *srch[2];
+    unsigned long counts[2][4];
+    double *stats;
+    mxArray *out[11];
+    int i, status;
+
+    /* Check for proper number of arguments. */
+    if (nrhs < 8 || nrhs > 10) {
+    mexErrMsgTxt("8 to 10 inputs to MEX nr solver required");
+    } else if (nlhs > 11) {
+    mexErrMsgTxt("At most 11 output arguments from MEX nr solver");
+    }
+
+    if (mxGetNumberOfElements(ENV_IN) != AGTF30_NUM_ENV || !mxIsDouble(ENV_IN)) {
+	mexErrMsgTxt("Requires that ENV_IN be a 3 x 1 vector.");
+    }
+    if (mxGetNumberOfElements(CMD_IN) != AGTF30_NUM_CMD || !mxIsDouble(CMD_IN)) {
+	mexErrMsgTxt("Requires that CMD_IN be a 14 x 1 vector.");
+    }
+    if (mxGetNumberOfElements(TAR_OUT) != AGTF30_NUM_TAR || !mxIsDouble(TAR_OUT)) {
+	mexErrMsgTxt("Requires that TAR_OUT be a 3 x 1 vector.");
+    }
+    if (mxGetNumberOfElements(HEALTH_PARAMS_IN) != AGTF30_NUM_HEALTH || !mxIsDouble(HEALTH_PARAMS_IN)) {
+	mexErrMsgTxt("Requires that HEALTH_PARAMS_IN be a 13 x 1 vector.");
+    }
+    if (mxGetNumberOfElements(BLDS_IN) != AGTF30_NUM_BLDS || !mxIsDouble(BLDS_IN)) {
+	mexErrMsgTxt("Requires that BLDS_IN be a 4 x 1 vector.");
+    }
+    if (!read_selection(IVEC_IN, Ivec, AGTF30_NUM_CMD)) {
+	mexErrMsgTxt("Requires that Ivec be a logical vector selecting from the 14 independents.");
+    }
+    if (!read_selection(DVEC_IN, Dvec, AGTF30_NUM_DEP)) {
+	mexErrMsgTxt("Requires that Dvec be a logical vector selecting from the 12 dependents.");
+    }
+    ENABLE_DEBUG = mxGetScalar(ENABLE_DEBUG_IN);
+    if (nrhs > 8) {
+        jacobian_method = (int)mxGetScalar(JACOBIAN_METHOD_IN);
+        if (jacobian_method != AGTF30_JACOBIAN_NEWTON && jacobian_method != AGTF30_JACOBIAN_BROYDEN
+            && jacobian_method != AGTF30_JACOBIAN_EXACT) {
+        mexErrMsgTxt("JACOBIAN_METHOD must be 0 (finite difference), 1 (Broyden) or 2 (exact).");
+        }
+    }
+    if (nrhs > 9) {
+        maps = (int)mxGetScalar(MAP_INTERP_IN);
+        if (maps != AGTF30_MAPS_LINEAR && maps != AGTF30_MAPS_PCHIP && maps != AGTF30_MAPS_AKIMA) {
+        mexErrMsgTxt("MAP_INTERP must be 0 (linear), 1 (monotone cubic) or 2 (Akima).");
+        }
+    }
+
+    /*--- Build the model context once and reuse it on later calls, until
+     *    other maps are asked for ---*/
+    if (!GTF_ws_initialized || maps != GTF_ws_maps) {
+        AGTF30_workspace_init(&GTF_ws, AGTF30_model_init_maps(maps));
+        GTF_ws_initialized = 1;
+        GTF_ws_maps = maps;
+    }
+
+    /*--- Nozzle counts before the solve ---*/
+    srch[0] = &GTF_ws.nozbyp_search;
+    srch[1] = &GTF_ws.nozcor_search;
+    for (i = 0; i < 2; i++) {
+        counts[i][0] = srch[i]->calls;
+        counts[i][1] = srch[i]->seeded_calls;
+        counts[i][2] = srch[i]->iter;
+        counts[i][3] = srch[i]->iterx;
+    }
+
+    status = AGTF30_nr_solver(&GTF_ws, mxGetPr(ENV_IN), mxGetPr(CMD_IN), mxGetPr(TAR_OUT),
+                              mxGetPr(HEALTH_PARAMS_IN), mxGetPr(BLDS_IN), Ivec, Dvec, ENABLE_DEBUG,
+                              jacobian_method, &res);
+
+    if (status != 0) {
+        /*--- Mismatched independents and dependents: NaN outputs, as nr_solver.m ---*/
+        for (i = 0; i < 6; i++)
+            out[i] = mxCreateDoubleScalar(mxGetNaN());
+        out[6] = mxCreateDoubleScalar(0);
+        out[7] = mxCreateDoubleScalar(0);
+        out[8] = mxCreateDoubleScalar(0);
+        out[10] = mxCreateDoubleScalar(0);
+    }
+    else {
+        out[0] = column(res.DEP, AGTF30_NUM_DEP);
+        /* CMD keeps the shape of CMD_IN */
+        out[1] = mxCreateDoubleMatrix(mxGetM(CMD_IN), mxGetN(CMD_IN), mxREAL);
+        memcpy(mxGetPr(out[1]), res.CMD, AGTF30_NUM_CMD*sizeof(double));
+        out[2] = column(res.X, AGTF30_NUM_X);
+        out[3] = column(res.U, AGTF30_NUM_U);
+        out[4] = column(res.Y, AGTF30_NUM_Y);
+        out[5] = column(res.E, AGTF30_NUM_E);
+        out[6] = mxCreateDoubleScalar(res.converged);
+        out[7] = mxCreateDoubleScalar(res.solver_iterations);
+        out[8] = mxCreateDoubleScalar(res.model_evals);
+        out[10] = mxCreateDoubleScalar(res.parameter_set);
+    }
+
+    out[9] = mxCreateDoubleMatrix(4, 2, mxREAL);
+    stats = mxGetPr(out[9]);
+    for (i = 0; i < 2; i++) {
+        stats[4*i]     = (double)(srch[i]->calls - counts[i][0]);
+        stats[4*i + 1] = (double)(srch[i]->seeded_calls - counts[i][1]);
+        stats[4*i + 2] = (double)(srch[i]->iter - counts[i][2]);
+        stats[4*i + 3] = (double)(srch[i]->iterx - counts[i][3]);
+    }
+
+    for (i = 0; i < 11; i++) {
+        if (i < nlhs || (i == 0 && nlhs == 0))
+            plhs[i] = out[i];
+        else
+            mxDestroyArray(out[i]);
+    }
+}
@@ -2,11 +2,32 @@
 #include "constants_TMATS.h"
 #include "functions_TMATS.h"
 #include <math.h>
+#include <stddef.h>
 
 #ifdef MATLAB_MEX_FILE
 #include "simstruc.h"
 #endif
 
+/* Static pressure searches. By default Ps at MN = 1 and, for a choked CD
+ * nozzle, Ps at the exit area are found by the secant iterations of the
+ * original block (MN within 0.001, area within 0.01%), on which the
+ * stored trim points are converged. Built with TMATS_PROPERTIES_CONVERGED
+ * they are found by Newton iterations with the slopes of
+ * static_state_slope, kept inside a bracket of the root and bisected when
+ * a step leaves it. A last MN = 1 step that is small enough is taken to
+ * first order, without evaluating the statics again. The MN = 1 search
+ * starts from the seed in prm->Search when that is a throat at nearly
+ * the same Tt and FAR, else from the flow function table prm->Flow (the
+ * isentropic estimate outside it), and leaves the throat it finds in
+ * prm->Search->last. The exit search starts from the supersonic Ps of the
+ * table at the exit area, else from Pamb. */
+#define NOZ_MAXITER     200
+#define NOZ_MN_TOL      1e-9    /* |1 - MN| at the throat */
+#define NOZ_MN_STEP     3e-5    /* |1 - MN| from which a Newton step leaves less than NOZ_MN_TOL */
+#define NOZ_AREA_TOL    1e-9    /* |Ax - Axcalc|/Ax at the exit */
+#define NOZ_SEED_DTT    0.02    /* largest relative change of Tt from the seed */
+#define NOZ_SEED_DFAR   0.002   /* largest change of FAR from the seed */
+
 void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, const double enable_debug)
 {
     double WIn       = u[0];     /* Input Flow [pps] 	*/
@@ -24,15 +45,23 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
     double CdTh, Cv, Cfg, Therm_growth, PQPa, PQPaMap, AthroatHot;
     double Rt, TsMN1, PsMN1, Woutcalc;
     double WOut, FgOut, NErrorOut, Ath, Vth, Psth, Ax, Vx, Psx, Tsx, gammasx, MNx;
-    double gammatg, gammasth,gammasMN1, gammasg, MNg, TsMNg, PsMNg, PsMNg_new, PsMNg_old, VMN1;
+    double gammatg, gammasth,gammasMN1, gammasg, MNg, TsMNg, PsMNg, PsMNg_new, VMN1;
     double MNth, Tsth, rhosth, rhosMN1, rhosx;
-    double Axcalc, Psxg, Psxg_new, Psxg_old, Exthr;
-    double Sin, hsg, hs, htin, rhosg, Rs, Vg;
+    double Axcalc, Psxg, Psxg_new, Exthr;
+    double hsg, hs, htin, rhosg, Rs, Vg;
     double gammas_s, MN_s, V_s, rhos_s, Ts_s;
-    double Ex, Ex_old;
-    double erMN_old, erMN, erthr;
-    int maxiter, iter, maxiterx, iterx, CDNoz;
+    double Ex, erMN, erthr;
+#ifndef TMATS_PROPERTIES_CONVERGED
+    double PsMNg_old, Psxg_old, Ex_old, erMN_old;
+#else
+    double PsLo, PsHi, dPs, dTs, dhs, dMN, dEx, dgammas, gammas_old, Ts_old;
+    double f[FLOW_NF], df[FLOW_NF];
+#endif
+    int maxiter, iter, maxiterx, iterx = 0, CDNoz, seeded = 0;
     int interpErr = 0;
+    NozzleSearch *srch = prm->Search;
+    GasMix mix;
+    StaticState ss;
     
     
     /* Determine Nozzle Type                  */
@@ -44,15 +73,19 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
     else
         CDNoz = 1;
     
-    /* Calc entropy */
-    Sin = pt2sc(PtIn, TtIn, FARcIn);
-    
-    /*-- Compute Input enthalpy --------*/
+    /* Gas composition, the same for every property evaluation below */
+    gasmix(&mix, FARcIn);
+
+    /*-- Compute Input enthalpy, or take it from the incoming station --------*/
     
-    htin = t2hc(TtIn,FARcIn);
+#ifndef TMATS_PROPERTIES_CONVERGED
+    htin = t2hc_mix(&mix, TtIn);
+#else
+    htin = htIn;
+#endif
     
     /*  Where gas constant is R = f(FAR), but NOT P & T */
-    Rt = interp1Ac(prm->Y_N_FARVec,prm->T_N_RtArray,FARcIn,prm->A,&interpErr);
+    Rt = interp1At(prm->K_N_Rt,prm->Y_N_FARVec,prm->T_N_RtArray,FARcIn,prm->A,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er1)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -77,9 +110,12 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
             *(prm->IWork+Er2) = 1;
         }
     }
+    /* Total state of the Ps searches below */
+    static_state(&ss, &mix, Ptin, TtIn, htin, Rt);
+
     /* Determine ideal velocity defined by perfect expansion to Pambient */
-    PcalcStat(Ptin, PambIn, TtIn, htin, FARcIn, Rt, &Sin, &Ts, &hs, &rhos, &V);
-    gammas_s = interp2Ac(prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,Ts,prm->A,prm->B,&interpErr);
+    PcalcStat_state(&ss, PambIn, &Ts, &hs, &rhos, &V);
+    gammas_s = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,Ts,prm->A,prm->B,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er3)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -97,7 +133,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
     /* Determine if nozzle throat is choked by comparing pressure when MN = 1 to ambient pressure
      * ---- set MN = 1 and calc throat Ps for iteration IC --------*/
     MNg = 1;
-    gammatg = interp2Ac(prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,TtIn,prm->A,prm->B,&interpErr);
+    gammatg = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,TtIn,prm->A,prm->B,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er4)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -106,13 +142,14 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
         #endif
         *(prm->IWork+Er4) = 1;
     }
+#ifndef TMATS_PROPERTIES_CONVERGED
     /* use isentropic equations for a first cut guess */
     TsMNg = TtIn*divby(1+MNg*MNg*(gammatg-1)/2);
     PsMNg = Ptin*powT((TsMNg*divby(TtIn)),(gammatg*divby(gammatg-1)));
     
     /* Calculate velcocity and MN using guessed static pressure */
-    PcalcStat(Ptin, PsMNg, TtIn, htin, FARcIn, Rt, &Sin, &TsMNg, &hsg, &rhosg, &Vg);
-    gammasg = interp2Ac(prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,TsMNg,prm->A,prm->B,&interpErr);
+    PcalcStat_state(&ss, PsMNg, &TsMNg, &hsg, &rhosg, &Vg);
+    gammasg = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,TsMNg,prm->A,prm->B,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er4)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -127,7 +164,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
     erMN =1 - MNg;
     
     PsMNg_new = PsMNg + 0.05;
-    maxiter = 200;
+    maxiter = NOZ_MAXITER;
     iter = 0;
     erthr = 0.001;
     
@@ -139,8 +176,8 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
             PsMNg = PsMNg + 0.005;
         else
             PsMNg = PsMNg_new;
-        PcalcStat(Ptin, PsMNg, TtIn, htin, FARcIn, Rt, &Sin, &TsMNg, &hsg, &rhosg, &Vg);
-        gammasg = interp2Ac(prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,TsMNg,prm->A,prm->B,&interpErr);
+        PcalcStat_state(&ss, PsMNg, &TsMNg, &hsg, &rhosg, &Vg);
+        gammasg = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,TsMNg,prm->A,prm->B,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er5)==0){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -157,6 +194,92 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
         }
         iter = iter + 1;
     }
+#else
+    /* Newton search on erMN = 1 - MN, safeguarded by the bracket [PsLo, PsHi]:
+     * MN falls from infinity at Ps = 0 to 0 at Ps = Ptin */
+    PsLo = 0;
+    PsHi = Ptin;
+    seeded = srch != NULL && srch->seeded && fabs(TtIn - srch->seed.Tt) < NOZ_SEED_DTT*srch->seed.Tt
+             && fabs(FARcIn - srch->seed.FAR) < NOZ_SEED_DFAR && srch->seed.Ps < srch->seed.Pt;
+    if (seeded) {
+        /* the throat of a nearby run, the pressure ratio of the throat
+         * depends on Tt and FAR only */
+        PsMNg = srch->seed.Ps*Ptin*divby(srch->seed.Pt);
+    }
+    else if (flow_table(prm->Flow, TtIn, FARcIn, 1, f, df)) {
+        /* Ps/Pt at MN = 1 from the flow function table */
+        PsMNg = Ptin*f[FLOW_PSQPT];
+    }
+    else {
+        /* use isentropic equations for a first cut guess */
+        TsMNg = TtIn*divby(1+MNg*MNg*(gammatg-1)/2);
+        PsMNg = Ptin*powT((TsMNg*divby(TtIn)),(gammatg*divby(gammatg-1)));
+    }
+    maxiter = NOZ_MAXITER;
+    iter = 0;
+    erthr = NOZ_MN_TOL;
+    Ts_old = gammas_old = 0;
+    while (1) {
+        /* Calculate velcocity and MN at the guessed static pressure */
+        PcalcStat_state(&ss, PsMNg, &TsMNg, &hsg, &rhosg, &Vg);
+        gammasg = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,TsMNg,prm->A,prm->B,NULL,&interpErr);
+        if (interpErr == 1 && iter == 0 && *(prm->IWork+Er4)==0){
+            #ifdef MATLAB_MEX_FILE
+            if (enable_debug) {
+            printf("Warning in %s, Error calculating gammasg. Vector definitions may need to be expanded.\n", prm->BlkNm);
+            }
+            #endif
+            *(prm->IWork+Er4) = 1;
+        }
+        if (interpErr == 1 && iter > 0 && *(prm->IWork+Er5)==0){
+            #ifdef MATLAB_MEX_FILE
+            if (enable_debug) {
+            printf("Warning in %s, Error calculating iteration gammasg. Vector definitions may need to be expanded.\n", prm->BlkNm);
+            }
+            #endif
+            *(prm->IWork+Er5) = 1;
+        }
+        MNg = Vg*divby(sqrtT(gammasg*Rs*TsMNg*C_GRAVITY*JOULES_CONST));
+        erMN = 1 - MNg;
+        if (fabs(erMN) <= erthr || iter == maxiter)
+            break;
+        if (erMN > 0)
+            PsHi = PsMNg;
+        else
+            PsLo = PsMNg;
+
+        /* Newton step: MN = V/sqrt(gammas*Rs*Ts*g*J) with dV = -g*J*dhs/V,
+         * dgammas/dTs from the last two iterates. Without a slope the
+         * bracket is bisected. */
+        PsMNg_new = PsLo;
+        dTs = dhs = dgammas = 0;
+        if (static_state_slope(&ss, PsMNg, &dTs, &dhs) && Vg > 0) {
+            dgammas = (iter > 0 && TsMNg != Ts_old) ? (gammasg - gammas_old)/(TsMNg - Ts_old) : 0;
+            dMN = MNg*(-C_GRAVITY*JOULES_CONST*dhs/(Vg*Vg) - 0.5*(dgammas*divby(gammasg) + 1/TsMNg)*dTs);
+            if (dMN < 0)
+                PsMNg_new = PsMNg + erMN/dMN;
+        }
+        /* bisect when the step leaves the bracket */
+        if (!(PsMNg_new > PsLo && PsMNg_new < PsHi))
+            PsMNg_new = 0.5*(PsLo + PsHi);
+        else if (fabs(erMN) <= NOZ_MN_STEP) {
+            /* the error left by this step is below erthr: take it to
+             * first order instead of evaluating the statics again */
+            dPs = PsMNg_new - PsMNg;
+            PsMNg = PsMNg_new;
+            TsMNg = TsMNg + dTs*dPs;
+            hsg = hsg + dhs*dPs;
+            gammasg = gammasg + dgammas*dTs*dPs;
+            rhosg = PsMNg * C_PSItoPSF*divby(Rs*TsMNg*JOULES_CONST);
+            Vg = sqrtT(2*(htin - hsg)*C_GRAVITY*JOULES_CONST);
+            break;
+        }
+        Ts_old = TsMNg;
+        gammas_old = gammasg;
+        PsMNg = PsMNg_new;
+        iter = iter + 1;
+    }
+#endif
     if (iter == maxiter && *(prm->IWork+Er6)==0 ){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -192,7 +315,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
         Psth = PsMN1;
         Tsth = TsMN1;
         MNth = 1;
-        gammasth = interp2Ac(prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,Tsth,prm->A,prm->B,&interpErr);
+        gammasth = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,Tsth,prm->A,prm->B,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er7)==0){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -223,7 +346,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
     PQPaMap = PQPa;
     
     /* look up Flow Coefficient */
-    CdTh = interp1Ac(prm->X_N_PEQPaVec,prm->T_N_CdThArray,PQPaMap,prm->B1,&interpErr);
+    CdTh = interp1At(prm->K_N_CdTh,prm->X_N_PEQPaVec,prm->T_N_CdThArray,PQPaMap,prm->B1,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er9)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -232,7 +355,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
         #endif
         *(prm->IWork+Er9) = 1;
     }
-    Therm_growth = interp1Ac(prm->X_N_TtVecTG,prm->T_N_TGArray,TtIn,prm->C,&interpErr);
+    Therm_growth = interp1At(prm->K_N_TG,prm->X_N_TtVecTG,prm->T_N_TGArray,TtIn,prm->C,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er10)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -288,14 +411,15 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
         else /* Use calculated area value when using Cv method  */
             Ax = AexitIn;
         
+#ifndef TMATS_PROPERTIES_CONVERGED
         /* start iteration to find Psx */
         Psxg = PambIn;
-        PcalcStat(Ptin, Psxg, TtIn, htin, FARcIn, Rt, &Sin, &Ts, &hs, &rhos, &V);
+        PcalcStat_state(&ss, Psxg, &Ts, &hs, &rhos, &V);
         Axcalc = WIn*divby(V * rhos/C_SINtoSFT); /* Will not be used for the Cfg method */
         
         Ex = fabs((Ax - Axcalc)*divby(Ax));
         /* iterate to find static pressure, calculated area should be close to actual area */
-        maxiterx = 200;
+        maxiterx = NOZ_MAXITER;
         iterx = 0;
         Psxg_new = Psxg + 0.05;
         Exthr = 0.0001;
@@ -308,7 +432,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
                 Psxg = Psxg_new;
             
             /* calculate flow velocity and rhos */
-            PcalcStat(Ptin, Psxg, TtIn, htin, FARcIn, Rt, &Sin, &Ts, &hs, &rhos, &V);
+            PcalcStat_state(&ss, Psxg, &Ts, &hs, &rhos, &V);
             /* calculated Area */
             Axcalc = WIn*divby(V * rhos/C_SINtoSFT);
             /*determine error */
@@ -326,6 +450,47 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
             }
             iterx = iterx + 1;
         }
+#else
+        /* Newton search on Ex, safeguarded by the bracket [PsLo, PsHi]:
+         * downstream of the throat the flow area falls as Ps rises to PsMN1 */
+        PsLo = 0;
+        PsHi = PsMN1;
+        Psxg = PambIn;
+        if (WIn > 0 && Ax > 0 && flow_table_MN(prm->Flow, TtIn, FARcIn, WIn*sqrtT(TtIn)*divby(Ax*Ptin), 1, &MNx)
+            && flow_table(prm->Flow, TtIn, FARcIn, MNx, f, df))
+            Psxg = Ptin*f[FLOW_PSQPT];  /* supersonic Ps at the exit area from the table */
+        maxiterx = NOZ_MAXITER;
+        iterx = 0;
+        Exthr = NOZ_AREA_TOL;
+        while (1) {
+            /* calculate flow velocity and rhos */
+            PcalcStat_state(&ss, Psxg, &Ts, &hs, &rhos, &V);
+            /* calculated Area */
+            Axcalc = WIn*divby(V * rhos/C_SINtoSFT); /* Will not be used for the Cfg method */
+            /*determine error */
+            Ex = (Ax - Axcalc)*divby(Ax);
+            if (fabs(Ex) <= Exthr || iterx == maxiterx)
+                break;
+            if (Ex > 0)
+                PsHi = Psxg;
+            else
+                PsLo = Psxg;
+
+            /* Newton step: Axcalc ~ 1/(V*rhos) with dV = -g*J*dhs/V and
+             * drhos/rhos = dPs/Ps - dTs/Ts */
+            Psxg_new = PsLo;
+            if (static_state_slope(&ss, Psxg, &dTs, &dhs) && V > 0) {
+                dEx = Axcalc*divby(Ax)*(-C_GRAVITY*JOULES_CONST*dhs/(V*V) + 1/Psxg - dTs/Ts);
+                if (dEx > 0)
+                    Psxg_new = Psxg - Ex/dEx;
+            }
+            /* bisect when the step leaves the bracket */
+            if (!(Psxg_new > PsLo && Psxg_new < PsHi))
+                Psxg_new = 0.5*(PsLo + PsHi);
+            Psxg = Psxg_new;
+            iterx = iterx + 1;
+        }
+#endif
         if (iterx == maxiterx && *(prm->IWork+Er12)==0 ){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -341,7 +506,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
             Vx = V;
             Psx = Psxg;
             rhosx = rhos;
-            gammasx = interp2Ac(prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,Ts,prm->A,prm->B,&interpErr);
+            gammasx = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,Ts,prm->A,prm->B,NULL,&interpErr);
             if (interpErr == 1 && *(prm->IWork+Er13)==0){
                 #ifdef MATLAB_MEX_FILE
                 if (enable_debug) {
@@ -378,7 +543,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
     
     /* look up Thrust and velocity coefficients */
     if (prm->CfgEn < 0.5){
-        Cv = interp1Ac(prm->X_N_PEQPaVec,prm->T_N_CvArray,PQPaMap,prm->B1,&interpErr);
+        Cv = interp1At(prm->K_N_Cv,prm->X_N_PEQPaVec,prm->T_N_CvArray,PQPaMap,prm->B1,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er15)==0){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -390,7 +555,7 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
         Cfg = 1;
     }
     else {
-        Cfg = interp1Ac(prm->X_N_PEQPaVec,prm->T_N_CfgArray,PQPaMap,prm->B1,&interpErr);
+        Cfg = interp1At(prm->K_N_Cfg,prm->X_N_PEQPaVec,prm->T_N_CfgArray,PQPaMap,prm->B1,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er16)==0){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -425,6 +590,18 @@ void Nozzle_TMATS_body(double* y, const double* u, const NozzleStruct* prm, cons
     else {
         NErrorOut = (WIn-Woutcalc)*divby(WIn);
     }
+    /* throat and iteration counts */
+    if (srch != NULL) {
+        srch->last.Pt = Ptin;
+        srch->last.Tt = TtIn;
+        srch->last.FAR = FARcIn;
+        srch->last.Ps = PsMN1;
+        srch->calls++;
+        srch->seeded_calls += seeded;
+        srch->iter += iter;
+        srch->iterx += iterx;
+    }
+
     /*------Assign output values------------*/
     y[0] = WOut;          /* Outlet Total Flow [pps]	*/
     y[1] = FgOut;         /* Gross Thrust [lbf] */
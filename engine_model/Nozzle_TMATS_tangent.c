@@ -0,0 +1,188 @@
+/*		T-MATS -- Nozzle_TMATS_tangent.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Tangent version of Nozzle_TMATS_body for off-design operation
+%  (IDes >= 0.5). du holds the tangents of the inputs u[0..7]
+%  (W, ht, Tt, Pt, FAR, Pamb, Athroat, Aexit) and y the outputs of the
+%  body. The throat static pressure of a choked nozzle solves MN = 1 and
+%  is differentiated through that equation. The divergent section of a
+%  choked CD nozzle is not differentiated.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+void Nozzle_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du, const NozzleStruct* prm)
+{
+    double WIn       = u[0];     /* Input Flow [pps] 	*/
+    double TtIn      = u[2];     /* Temperature Input [degR] 	*/
+    double PtIn      = u[3];     /* Pressure Input [psia] 	*/
+    double FARcIn    = u[4];     /* Combusted Fuel to Air Ratio [frac] 	*/
+    double PambIn    = u[5];     /* Ambient Pressure [psia] 	*/
+    double AthroatIn = u[6];     /* Throat area [in2] 	*/
+    double AexitIn   = u[7];     /* Exit area [in2] 	*/
+
+    const double *dWIn = du[0], *dTtIn = du[2], *dFARcIn = du[4], *dPambIn = du[5];
+
+    /*--- Outputs of the body ---*/
+    double Psth = y[5], Woutcalc = y[13], choked = y[14];
+
+    /*--------Define Constants-------*/
+    double Ptin, htin, Rt, Ts_s, rhos_s, V_s, MN_s, Tsth, rhosth, Vth, MNth, gammasth, q;
+    double Ts_P, rhos_P, V_P, MN_P, PQPa, CdTh, TG, Cfg, Cv, Ath, c;
+    int CDNoz, i, k;
+    int interpErr = 0;
+    tan_t zero, unit, dPtin, dhtin, dRt, dTs_s, drhos_s, dV_s, dgammas_s, dMN_s;
+    tan_t dTsth, drhosth, dVth, dMNth, dgammasth, dPsth;
+    tan_t dTs_P, drhos_P, dV_P, dgammas_P, dMN_P, dq, dPQPa, dCdTh, dTG, dCfg, dCv, dAth;
+
+    /*--- Design point calculations are not differentiated ---*/
+    if (prm->IDes < 0.5) {
+        for (i = 0; i < 17; i++)
+            tan_nan(dy[i]);
+        return;
+    }
+    tan_zero(zero);
+    tan_fill(unit, 1);
+
+    CDNoz = prm->SwitchType < 1.5 ? 0 : 1;
+
+    /*-- Input enthalpy and gas constant --------*/
+#ifndef TMATS_PROPERTIES_CONVERGED
+    htin = t2hc(TtIn,FARcIn);
+    t2hc_tangent(dhtin, TtIn, dTtIn, FARcIn, dFARcIn);
+#else
+    htin = u[1];
+    tan_copy(dhtin, du[1]);
+#endif
+    Rt = interp1Ac_tangent(dRt, prm->Y_N_FARVec, prm->T_N_RtArray, FARcIn, dFARcIn, prm->A);
+
+    /* back flow protection */
+    Ptin = PtIn;
+    tan_copy(dPtin, du[3]);
+    if (Ptin <= PambIn) {
+        Ptin = PambIn + 0.1;
+        tan_copy(dPtin, dPambIn);
+    }
+
+    /* ideal expansion to Pambient */
+    PcalcStatMN_tangent(Ptin, PambIn, TtIn, htin, FARcIn, Rt, dPtin, dPambIn, dTtIn, dhtin, dFARcIn, dRt,
+                        prm->Y_N_FARVec, prm->X_N_TtVec, prm->T_N_MAP_gammaArray, prm->A, prm->B,
+                        &Ts_s, &rhos_s, &V_s, &MN_s, dTs_s, drhos_s, dV_s, dgammas_s, dMN_s);
+
+    /*--- throat conditions ---*/
+    if (choked == 0) {
+        Tsth = Ts_s;
+        rhosth = rhos_s;
+        Vth = V_s;
+        MNth = MN_s;
+        tan_copy(dPsth, dPambIn);
+        tan_copy(dTsth, dTs_s);
+        tan_copy(drhosth, drhos_s);
+        tan_copy(dVth, dV_s);
+        tan_copy(dMNth, dMN_s);
+    }
+    else {
+        /* MN(Psth, inputs) = 1: tangents at fixed Psth, then the Psth partials */
+        PcalcStatMN_tangent(Ptin, Psth, TtIn, htin, FARcIn, Rt, dPtin, zero, dTtIn, dhtin, dFARcIn, dRt,
+                            prm->Y_N_FARVec, prm->X_N_TtVec, prm->T_N_MAP_gammaArray, prm->A, prm->B,
+                            &Tsth, &rhosth, &Vth, &MNth, dTsth, drhosth, dVth, dgammasth, dMNth);
+        PcalcStatMN_tangent(Ptin, Psth, TtIn, htin, FARcIn, Rt, zero, unit, zero, zero, zero, zero,
+                            prm->Y_N_FARVec, prm->X_N_TtVec, prm->T_N_MAP_gammaArray, prm->A, prm->B,
+                            &Ts_P, &rhos_P, &V_P, &MN_P, dTs_P, drhos_P, dV_P, dgammas_P, dMN_P);
+        c = -divby(dMN_P[0]);
+        tan_scale(dPsth, c, dMNth);
+        for (k = 0; k < AGTF30_NUM_DIR; k++) {
+            dTsth[k] += dTs_P[0]*dPsth[k];
+            drhosth[k] += drhos_P[0]*dPsth[k];
+            dgammasth[k] += dgammas_P[0]*dPsth[k];
+            dMNth[k] = 0;
+        }
+        /* Vth = MNth*sqrtT(gammasth*Rs*Tsth*g*J) with MNth = 1 */
+        gammasth = interp2At(prm->K_N_gamma,prm->Y_N_FARVec,prm->X_N_TtVec,prm->T_N_MAP_gammaArray,FARcIn,Tsth,prm->A,prm->B,NULL,&interpErr);
+        q = gammasth*Rt*Tsth*C_GRAVITY*JOULES_CONST;
+        tan_lin3(dq, Rt*Tsth*C_GRAVITY*JOULES_CONST, dgammasth, gammasth*Tsth*C_GRAVITY*JOULES_CONST, dRt,
+                 gammasth*Rt*C_GRAVITY*JOULES_CONST, dTsth);
+        Vth = sqrtT(q);
+        tan_scale(dVth, sqrtT_d(q), dq);
+        MNth = 1;
+    }
+
+    /*--- Flow, thrust and velocity coefficients ---*/
+    PQPa = Ptin*divby(PambIn);
+    tan_lin2(dPQPa, divby(PambIn), dPtin, Ptin*divby_d(PambIn), dPambIn);
+    CdTh = interp1Ac_tangent(dCdTh, prm->X_N_PEQPaVec, prm->T_N_CdThArray, PQPa, dPQPa, prm->B1);
+    TG = interp1Ac_tangent(dTG, prm->X_N_TtVecTG, prm->T_N_TGArray, TtIn, dTtIn, prm->C);
+
+    /*--- Throat area ---*/
+    if (CDNoz == 1 && AthroatIn > AexitIn) {
+        Ath = AexitIn;
+        tan_copy(dAth, du[7]);
+        CDNoz = 0;
+    }
+    else {
+        Ath = AthroatIn;
+        tan_copy(dAth, du[6]);
+    }
+
+    /* Woutcalc = (1-flowLoss/100)*Ath*TG*CdTh*rhosth*Vth/C_PSItoPSF */
+    c = (1-prm->flowLoss/100)/C_PSItoPSF;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dy[13][k] = c*(dAth[k]*TG*CdTh*rhosth*Vth + Ath*dTG[k]*CdTh*rhosth*Vth + Ath*TG*dCdTh[k]*rhosth*Vth
+                       + Ath*TG*CdTh*drhosth[k]*Vth + Ath*TG*CdTh*rhosth*dVth[k]);
+
+    /*--- Exit conditions ---*/
+    if (CDNoz == 1 && choked == 1) {
+        for (i = 9; i < 13; i++)
+            tan_nan(dy[i]);
+        tan_nan(dy[16]);
+        tan_copy(dy[4], du[7]);
+    }
+    else {
+        tan_copy(dy[4], dAth);
+        tan_copy(dy[9], dPsth);
+        tan_copy(dy[10], dTsth);
+        tan_copy(dy[11], dMNth);
+        tan_copy(dy[12], dVth);
+        tan_copy(dy[16], dPsth);
+    }
+
+    /*----- gross thrust -----------*/
+    if (prm->CfgEn > 0.5) {
+        Cfg = interp1Ac_tangent(dCfg, prm->X_N_PEQPaVec, prm->T_N_CfgArray, PQPa, dPQPa, prm->B1);
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dy[1][k] = (dWIn[k]*V_s*Cfg + WIn*dV_s[k]*Cfg + WIn*V_s*dCfg[k])/C_GRAVITY;
+    }
+    else if (CDNoz == 1) {
+        tan_nan(dy[1]);
+    }
+    else {
+        Cv = interp1Ac_tangent(dCv, prm->X_N_PEQPaVec, prm->T_N_CvArray, PQPa, dPQPa, prm->B1);
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dy[1][k] = (dWIn[k]*Vth*Cv + WIn*dVth[k]*Cv + WIn*Vth*dCv[k])/C_GRAVITY
+                       + (dPsth[k] - dPambIn[k])*Ath + (Psth - PambIn)*dAth[k];
+    }
+
+    /* ----- Normalized Flow Error (WIn-Woutcalc)*divby(WIn) ----- */
+    if (WIn == 0)
+        tan_zero(dy[2]);
+    else {
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dq[k] = dWIn[k] - dy[13][k];
+        tan_lin2(dy[2], divby(WIn), dq, (WIn - Woutcalc)*divby_d(WIn), dWIn);
+    }
+
+    /*------Assign output tangents------------*/
+    tan_copy(dy[0], dWIn);
+    tan_copy(dy[3], dAth);
+    tan_copy(dy[5], dPsth);
+    tan_copy(dy[6], dTsth);
+    tan_copy(dy[7], dMNth);
+    tan_copy(dy[8], dVth);
+    tan_zero(dy[14]);
+    tan_copy(dy[15], dV_s);
+}
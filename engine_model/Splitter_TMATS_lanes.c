@@ -0,0 +1,32 @@
+/*		T-MATS -- Splitter_TMATS_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane version of Splitter_TMATS.
+% *************************************************************************/
+
+#include "AGTF30_lanes.h"
+
+void Splitter_TMATS_lanes(lane_t *y, lane_t *y1, const lane_t *u, const lane_t *u1)
+{
+    double BPR2;
+    int k, l;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        if (u1[0][l] > 0)
+            BPR2 = u1[0][l];
+        else
+            BPR2 = 0;
+
+        y[0][l] = u[0][l] * BPR2 * (1/(BPR2+1));     /* Bypass mass flow */
+        y1[0][l] = u[0][l] * (1/(BPR2+1));           /* Core mass flow */
+    }
+
+    /* Enthalpy, temperature, pressure and fuel-air ratio pass through */
+    for (k = 1; k < 5; k++) {
+        for (l = 0; l < AGTF30_LANES; l++) {
+            y[k][l] = u[k][l];
+            y1[k][l] = u[k][l];
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+/* Tangent version of Splitter_TMATS. du holds the tangents of the flow
+ * inputs u[0..4] and du1 that of BPR. */
+void Splitter_TMATS_tangent(tan_t *dy, tan_t *dy1, const double *u, tan_t *du,
+                            const double *u1, tan_t *du1)
+{
+    double WIn    = u[0];     /* Mass flow */
+    double BPR    = u1[0];
+
+    /*--------Define Parameters -------*/
+    double BPR2, r;
+    tan_t dBPR2;
+    int i, k;
+
+    if(BPR > 0) {
+        BPR2 = BPR;
+        tan_copy(dBPR2, du1[0]);
+    }
+    else {
+        BPR2 = 0;
+        tan_zero(dBPR2);
+    }
+    r = 1/(BPR2+1);
+
+    /* Wbp = WIn*BPR2*r, Wcore = WIn*r, dr = -r*r*dBPR2 */
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dy[0][k] = du[0][k]*BPR2*r + WIn*dBPR2[k]*r*r;
+        dy1[0][k] = du[0][k]*r - WIn*r*r*dBPR2[k];
+    }
+
+    /*------ Stream properties pass through ------------*/
+    for (i = 1; i < 5; i++) {
+        tan_copy(dy[i], du[i]);
+        tan_copy(dy1[i], du[i]);
+    }
+}
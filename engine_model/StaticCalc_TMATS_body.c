@@ -17,26 +17,38 @@ void StaticCalc_TMATS_body(double *y, const double *u, const StaticCalcStruct* p
     
     /*--------Define Constants-------*/
     double PsOut, TsOut, rhosOut, MNOut, AthOut;
-    double Sin, htin;
+    double htin;
     double Rt, Rs;
-    double TsMNg, PsMNg, MNg;
-    double Tsg, Psg, Psg_new, Psg_old, Acalc, erA, erA_old;
+    double MNg;
+    double Tsg, Psg, Psg_new, Acalc;
     double  gammatg, gammasg, hsg, rhosg, Vg;
-    double erMN_old, erMN, PsMNg_old, PsMNg_new;
     double erthr;
+#ifndef TMATS_PROPERTIES_CONVERGED
+    double TsMNg, PsMNg, Psg_old, erA, erA_old;
+    double erMN_old, erMN, PsMNg_old, PsMNg_new;
+#else
+    double f[FLOW_NF], df[FLOW_NF];
+    double er, der, PsLo, PsHi, dTs, dhs, dgammas, gammas_old, Ts_old;
+#endif
     int maxiter, iter;
     int interpErr = 0;
+    GasMix mix;
+    StaticState ss;
     
         
-    /* Calc entropy */
-    Sin = pt2sc(PtIn, TtIn, FARcIn);
-    
-    /*-- Compute Input enthalpy --------*/
+    /* Gas composition, the same for every property evaluation below */
+    gasmix(&mix, FARcIn);
+
+    /*-- Compute Input enthalpy, or take it from the incoming station --------*/
     
-    htin = t2hc(TtIn,FARcIn);
+#ifndef TMATS_PROPERTIES_CONVERGED
+    htin = t2hc_mix(&mix, TtIn);
+#else
+    htin = htIn;
+#endif
     
     /*  Where gas constant is R = f(FAR), but NOT P & T */
-    Rt = interp1Ac(prm->X_FARVec,prm->T_RtArray,FARcIn,prm->A,&interpErr);
+    Rt = interp1At(prm->K_Rt,prm->X_FARVec,prm->T_RtArray,FARcIn,prm->A,NULL,&interpErr);
     if (interpErr == 1 && *(prm->IWork+Er1)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -46,12 +58,18 @@ void StaticCalc_TMATS_body(double *y, const double *u, const StaticCalcStruct* p
         *(prm->IWork+Er1) = 1;
     }
     Rs = Rt;
+
+    /* Total state of the Ps searches below */
+    static_state(&ss, &mix, PtIn, TtIn, htin, Rt);
     
+    /* The secant searches of the original block, on which the stored trim
+     * points are converged, unless built with TMATS_PROPERTIES_CONVERGED */
+#ifndef TMATS_PROPERTIES_CONVERGED
     /* Solve for Ts and Ps when MN is known*/
     if (prm->SolveType == 1) {
         /*---- set MN = prm->MNIn and calc SS Ps for iteration IC --------*/
         MNg = prm->MNIn;
-        gammatg = interp2Ac(prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,TtIn,prm->A,prm->B,&interpErr);
+        gammatg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,TtIn,prm->A,prm->B,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er2)==0){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -63,8 +81,8 @@ void StaticCalc_TMATS_body(double *y, const double *u, const StaticCalcStruct* p
         TsMNg = TtIn*divby(1+MNg*MNg*(gammatg-1)/2);
         PsMNg = PtIn*powT((TsMNg*divby(TtIn)),(gammatg*divby(gammatg-1)));
         
-        PcalcStat(PtIn, PsMNg, TtIn, htin, FARcIn, Rt, &Sin, &TsMNg, &hsg, &rhosg, &Vg);
-        gammasg = interp2Ac(prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,TsMNg,prm->A,prm->B,&interpErr);
+        PcalcStat_state(&ss, PsMNg, &TsMNg, &hsg, &rhosg, &Vg);
+        gammasg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,TsMNg,prm->A,prm->B,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er2)==0){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -94,8 +112,8 @@ void StaticCalc_TMATS_body(double *y, const double *u, const StaticCalcStruct* p
                 PsMNg = PsMNg + 0.005;
             else
                 PsMNg = PsMNg_new;
-            PcalcStat(PtIn, PsMNg, TtIn, htin, FARcIn, Rt, &Sin, &TsMNg, &hsg, &rhosg, &Vg);
-            gammasg = interp2Ac(prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,TsMNg,prm->A,prm->B,&interpErr);
+            PcalcStat_state(&ss, PsMNg, &TsMNg, &hsg, &rhosg, &Vg);
+            gammasg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,TsMNg,prm->A,prm->B,NULL,&interpErr);
             if (interpErr == 1 && *(prm->IWork+Er2)==0){
                 #ifdef MATLAB_MEX_FILE
                 if (enable_debug) {
@@ -140,9 +158,9 @@ void StaticCalc_TMATS_body(double *y, const double *u, const StaticCalcStruct* p
         gammatg = 1.4;
         Tsg = TtIn*divby(1+MNg*MNg*(gammatg-1)/2);
         Psg = PtIn*powT((Tsg*divby(TtIn)),(gammatg*divby(gammatg-1)));
-        PcalcStat(PtIn, Psg, TtIn, htin, FARcIn, Rt, &Sin, &Tsg, &hsg, &rhosg, &Vg);
+        PcalcStat_state(&ss, Psg, &Tsg, &hsg, &rhosg, &Vg);
         Acalc = WIn*divby(Vg * rhosg/C_SINtoSFT);
-        gammasg = interp2Ac(prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,Tsg,prm->A,prm->B,&interpErr);
+        gammasg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,Tsg,prm->A,prm->B,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er4)==0){
             #ifdef MATLAB_MEX_FILE
             if (enable_debug) {
@@ -172,9 +190,9 @@ void StaticCalc_TMATS_body(double *y, const double *u, const StaticCalcStruct* p
                 Psg = Psg_new;
             }
             /* calculate flow velocity and rhos */
-            PcalcStat(PtIn, Psg, TtIn, htin, FARcIn, Rt, &Sin, &Tsg, &hsg, &rhosg, &Vg);
+            PcalcStat_state(&ss, Psg, &Tsg, &hsg, &rhosg, &Vg);
             
-            gammasg = interp2Ac(prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,Tsg,prm->A,prm->B,&interpErr);
+            gammasg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,Tsg,prm->A,prm->B,NULL,&interpErr);
             if (interpErr == 1 && *(prm->IWork+Er4)==0){
                 #ifdef MATLAB_MEX_FILE
                 if (enable_debug) {
@@ -217,6 +235,123 @@ void StaticCalc_TMATS_body(double *y, const double *u, const StaticCalcStruct* p
         MNOut = MNg;
         AthOut = Acalc;
     }
+#else
+    /* Solve for Ts and Ps when MN is known (SolveType 1) or Ath is known
+     * (SolveType 0). The search starts from the flow function table of the
+     * gas and takes Newton steps with the slopes of static_state_slope,
+     * kept inside a bracket of the root and bisected when a step leaves
+     * it: MN falls from infinity at Ps = 0 to 0 at Ps = PtIn, the flow
+     * area is smallest near MN = 1 and grows with Ps above it. */
+    if (prm->SolveType == 1 || prm->SolveType == 0) {
+        MNg = prm->MNIn;
+        if (prm->SolveType == 1 && flow_table(prm->Flow, TtIn, FARcIn, MNg, f, df)) {
+            Psg = PtIn*f[FLOW_PSQPT];
+        }
+        else if (prm->SolveType == 0 && WIn > 0 && prm->AthroatIn > 0
+                 && flow_table_MN(prm->Flow, TtIn, FARcIn, WIn*sqrtT(TtIn)*divby(prm->AthroatIn*PtIn), 0, &MNg)
+                 && flow_table(prm->Flow, TtIn, FARcIn, MNg, f, df)) {
+            Psg = PtIn*f[FLOW_PSQPT];
+        }
+        else {
+            /* outside the table: isentropic guess */
+            MNg = prm->MNIn;
+            gammatg = 1.4;
+            if (prm->SolveType == 1) {
+                gammatg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,TtIn,prm->A,prm->B,NULL,&interpErr);
+                if (interpErr == 1 && *(prm->IWork+Er2)==0){
+                    #ifdef MATLAB_MEX_FILE
+                    if (enable_debug) {
+                    printf("Warning in %s, Error calculating gammatg. Vector definitions may need to be expanded.\n", prm->BlkNm);
+                    }
+                    #endif
+                    *(prm->IWork+Er2) = 1;
+                }
+            }
+            Tsg = TtIn*divby(1+MNg*MNg*(gammatg-1)/2);
+            Psg = PtIn*powT((Tsg*divby(TtIn)),(gammatg*divby(gammatg-1)));
+        }
+        PsLo = 0;
+        PsHi = PtIn;
+        maxiter = 100;
+        iter = 0;
+        erthr = 1e-9;
+        Ts_old = gammas_old = 0;
+        while (1) {
+            /* calculate flow velocity and rhos */
+            PcalcStat_state(&ss, Psg, &Tsg, &hsg, &rhosg, &Vg);
+            gammasg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn,Tsg,prm->A,prm->B,NULL,&interpErr);
+            if (interpErr == 1 && *(prm->IWork+(prm->SolveType == 1 ? Er2 : Er4))==0){
+                #ifdef MATLAB_MEX_FILE
+                if (enable_debug) {
+                printf("Warning in %s, Error calculating iteration gammasg. Vector definitions may need to be expanded.\n", prm->BlkNm);
+                }
+                #endif
+                *(prm->IWork+(prm->SolveType == 1 ? Er2 : Er4)) = 1;
+            }
+            MNg = Vg*divby(sqrtT(gammasg*Rs*Tsg*C_GRAVITY*JOULES_CONST));
+
+            if (Vg > 0.0001) {
+                /* calculated Area */
+                Acalc = WIn*divby(Vg * rhosg/C_SINtoSFT);
+            }
+            else if (prm->SolveType == 1) {
+                Acalc = 999; /* if velocity is close to zero assume a very large Ath */
+            }
+            else {
+                Psg = PtIn;
+                Tsg = TtIn;
+                Acalc = 999;
+                break;
+            }
+            if (prm->SolveType == 1)
+                er = prm->MNIn - MNg;
+            else
+                er = (prm->AthroatIn - Acalc)*divby(prm->AthroatIn);
+            if (fabs(er) <= erthr || iter == maxiter)
+                break;
+
+            /* Newton step: MN = V/sqrt(gammas*Rs*Ts*g*J) and Acalc ~ 1/(V*rhos)
+             * with dV = -g*J*dhs/V and drhos/rhos = dPs/Ps - dTs/Ts;
+             * dgammas/dTs from the last two iterates */
+            der = 0;
+            if (static_state_slope(&ss, Psg, &dTs, &dhs) && Vg > 0) {
+                if (prm->SolveType == 1) {
+                    dgammas = (iter > 0 && Tsg != Ts_old) ? (gammasg - gammas_old)/(Tsg - Ts_old) : 0;
+                    der = -MNg*(-C_GRAVITY*JOULES_CONST*dhs/(Vg*Vg) - 0.5*(dgammas*divby(gammasg) + 1/Tsg)*dTs);
+                }
+                else
+                    der = Acalc*divby(prm->AthroatIn)*(-C_GRAVITY*JOULES_CONST*dhs/(Vg*Vg) + 1/Psg - dTs/Tsg);
+            }
+            /* MN below MNIn or flow area below Ath (or on its supersonic
+             * side) means Ps is too high, respectively too low */
+            if (prm->SolveType == 1 ? er > 0 : (er < 0 && der <= 0))
+                PsHi = Psg;
+            else
+                PsLo = Psg;
+            Psg_new = (der != 0) ? Psg - er/der : PsLo;
+            /* bisect when the step leaves the bracket */
+            if (!(Psg_new > PsLo && Psg_new < PsHi))
+                Psg_new = 0.5*(PsLo + PsHi);
+            Ts_old = Tsg;
+            gammas_old = gammasg;
+            Psg = Psg_new;
+            iter = iter + 1;
+        }
+        if (prm->SolveType == 1 && iter == maxiter && *(prm->IWork+Er3)==0 ){
+            #ifdef MATLAB_MEX_FILE
+            if (enable_debug) {
+            printf("Warning in %s, Error calculating Ps at MN = prm->MNIn. There may be error in block outputs\n", prm->BlkNm);
+            }
+            #endif
+            *(prm->IWork+Er3) = 1;
+        }
+        TsOut = Tsg;
+        PsOut = Psg;
+        rhosOut = rhosg;
+        MNOut = (prm->SolveType == 1) ? prm->MNIn : MNg;
+        AthOut = Acalc;
+    }
+#endif
     else {
         if (*(prm->IWork+Er5)==0 ){
             #ifdef MATLAB_MEX_FILE
@@ -0,0 +1,290 @@
+/*		T-MATS -- StaticCalc_TMATS_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane version of StaticCalc_TMATS_body. The static pressure search runs
+%  in lock step over the lanes; a lane stops updating once its own error is
+%  within erthr, exactly where the scalar loop for that point would exit.
+%  The flow function lookups of the starting point are made lane by lane.
+%  Both follow TMATS_PROPERTIES_CONVERGED: without it the search is the
+%  secant iteration of the original block.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_lanes.h"
+
+void StaticCalc_TMATS_lanes(lane_t *y, const lane_t *u, const StaticCalcStruct* prm)
+{
+    const double *WIn    = u[0];     /* Input Flow [pps] 	*/
+    const double *TtIn   = u[2];     /* Temperature Input [degR] 	*/
+    const double *PtIn   = u[3];     /* Pressure Input [psia] 	*/
+    const double *FARcIn = u[4];     /* Combusted Fuel to Air Ratio [frac] 	*/
+
+    /*--------Define Constants-------*/
+    lane_t htin, Rt;
+    lane_t Psg, Tsg, rhosg, MNg, Acalc;
+    lane_t Ts_try, hs_try, rhos_try, V_try, gammasg;
+    int    run[AGTF30_LANES];
+    double gammatg;
+#ifndef TMATS_PROPERTIES_CONVERGED
+    lane_t er, er_old, Psg_old, Psg_new, Ps_try;
+    double MN_try, A_try, er_try;
+    double erthr = 0.0001;
+#else
+    lane_t er, PsLo, PsHi, Ts_old, gammas_old, dTs, dhs;
+    int    ok[AGTF30_LANES];
+    double f[FLOW_NF], df[FLOW_NF];
+    double der, dgammas, Psg_new;
+    double erthr = 1e-9;
+#endif
+    int maxiter, iter, any, l;
+    int interpErr = 0;
+    StaticStateLanes ss;
+
+    /* Input enthalpy, computed or taken from the incoming station */
+#ifndef TMATS_PROPERTIES_CONVERGED
+    t2hc_lanes(htin, TtIn, FARcIn);
+#else
+    for (l = 0; l < AGTF30_LANES; l++)
+        htin[l] = u[1][l];
+#endif
+
+    /*  Where gas constant is R = f(FAR), but NOT P & T; Rs = Rt */
+    for (l = 0; l < AGTF30_LANES; l++)
+        Rt[l] = interp1At(prm->K_Rt,prm->X_FARVec,prm->T_RtArray,FARcIn[l],prm->A,NULL,&interpErr);
+
+    /* Total states of the Ps searches below */
+    static_state_lanes(&ss, PtIn, TtIn, htin, FARcIn, Rt);
+
+    if (prm->SolveType != 0 && prm->SolveType != 1) {
+        for (l = 0; l < AGTF30_LANES; l++) {
+            y[0][l] = TtIn[l];
+            y[1][l] = PtIn[l];
+            y[2][l] = 1;
+            y[3][l] = 0;
+            y[4][l] = 100;
+        }
+        return;
+    }
+
+#ifndef TMATS_PROPERTIES_CONVERGED
+    /*---- initial guess from the isentropic relations ----*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        MNg[l] = prm->MNIn;
+        if (prm->SolveType == 1)
+            gammatg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn[l],TtIn[l],prm->A,prm->B,NULL,&interpErr);
+        else
+            gammatg = 1.4;
+        Tsg[l] = TtIn[l]*DIVBY_L(1+MNg[l]*MNg[l]*(gammatg-1)/2);
+        Psg[l] = PtIn[l]*powT((Tsg[l]*DIVBY_L(TtIn[l])),(gammatg*DIVBY_L(gammatg-1)));
+    }
+    PcalcStat_state_lanes(&ss, Psg, Tsg, hs_try, rhosg, V_try, 0);
+    for (l = 0; l < AGTF30_LANES; l++)
+        gammasg[l] = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn[l],Tsg[l],prm->A,prm->B,NULL,&interpErr);
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        MNg[l] = V_try[l]*DIVBY_L(SQRTT_L(gammasg[l]*Rt[l]*Tsg[l]*C_GRAVITY*JOULES_CONST));
+        if (prm->SolveType == 1) {
+            if (V_try[l] > 0.0001)
+                Acalc[l] = WIn[l]*DIVBY_L(V_try[l] * rhosg[l]/C_SINtoSFT);
+            else
+                Acalc[l] = 999; /* if velocity is close to zero assume a very large Ath */
+            er[l] = prm->MNIn - MNg[l];
+            Psg_new[l] = Psg[l] + 0.05;
+        }
+        else {
+            Acalc[l] = WIn[l]*DIVBY_L(V_try[l] * rhosg[l]/C_SINtoSFT);
+            er[l] = (prm->AthroatIn - Acalc[l])*DIVBY_L(prm->AthroatIn);
+            Psg_new[l] = Psg[l] + 0.05;
+        }
+        er_old[l] = er[l];
+        Psg_old[l] = Psg[l];
+    }
+
+    maxiter = (prm->SolveType == 1) ? 15 : 1000;
+
+    /* Solve for Ps at MN = MNIn (SolveType 1) or at A = AthroatIn (SolveType 0) */
+    for (iter = 0; iter < maxiter; iter++) {
+        any = 0;
+        for (l = 0; l < AGTF30_LANES; l++) {
+            run[l] = (fabs(er[l]) > erthr);
+            any |= run[l];
+        }
+        if (!any)
+            break;
+
+        for (l = 0; l < AGTF30_LANES; l++) {
+            if (prm->SolveType == 1)
+                Ps_try[l] = (fabs(Psg[l] - Psg_new[l]) < 0.003) ? Psg[l] + 0.005 : Psg_new[l];
+            else
+                Ps_try[l] = (fabs(Psg[l] - Psg_new[l]) < 0.0003) ? Psg[l] + 0.0005 : Psg_new[l];
+        }
+
+        /* calculate flow velocity and rhos */
+        PcalcStat_state_lanes(&ss, Ps_try, Ts_try, hs_try, rhos_try, V_try, run);
+        for (l = 0; l < AGTF30_LANES; l++) {
+            if (run[l])
+                gammasg[l] = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn[l],Ts_try[l],prm->A,prm->B,NULL,&interpErr);
+        }
+
+        for (l = 0; l < AGTF30_LANES; l++) {
+            if (!run[l])
+                continue;
+            MN_try = V_try[l]*DIVBY_L(SQRTT_L(gammasg[l]*Rt[l]*Ts_try[l]*C_GRAVITY*JOULES_CONST));
+
+            er_old[l] = er[l];
+            Psg_old[l] = Psg[l];
+            Psg[l] = Ps_try[l];
+            Tsg[l] = Ts_try[l];
+            rhosg[l] = rhos_try[l];
+            MNg[l] = MN_try;
+
+            if (prm->SolveType == 1) {
+                /* calculated Area */
+                if (V_try[l] > 0.0001)
+                    A_try = WIn[l]*DIVBY_L(V_try[l] * rhos_try[l]/C_SINtoSFT);
+                else
+                    A_try = 999;
+                er_try = prm->MNIn - MN_try;
+                Acalc[l] = A_try;
+                er[l] = er_try;
+                if (fabs(er_try) > erthr) {
+                    /* determine next guess pressure by secant algorithm */
+                    Psg_new[l] = Psg[l] - er_try *(Psg[l] - Psg_old[l])*DIVBY_L(er_try - er_old[l]);
+                }
+            }
+            else {
+                if (V_try[l] > 0.0001) {
+                    /* calculated Area */
+                    Acalc[l] = WIn[l]*DIVBY_L(V_try[l] * rhos_try[l]/C_SINtoSFT);
+                    /*determine error */
+                    er[l] = (prm->AthroatIn - Acalc[l])*DIVBY_L(prm->AthroatIn);
+                }
+                else {
+                    er[l] = 0;
+                    Psg[l] = PtIn[l];
+                    Tsg[l] = TtIn[l];
+                    Acalc[l] = 999;
+                }
+                if (fabs(er[l]) > erthr) {
+                    /* determine next guess pressure by secant algorithm */
+                    Psg_new[l] = Psg[l] - er[l] *(Psg[l] - Psg_old[l])*DIVBY_L(er[l] - er_old[l]);
+                    /* limit algorthim change */
+                    if (Psg_new[l] > 1.001*Psg[l])
+                        Psg_new[l] = 1.002 * Psg[l];
+                    else if (Psg_new[l] < 0.999 * Psg[l])
+                        Psg_new[l] = 0.998 * Psg[l];
+                }
+            }
+        }
+    }
+
+#else
+    /*---- initial guess from the flow function table ----*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        MNg[l] = prm->MNIn;
+        if (prm->SolveType == 1 && flow_table(prm->Flow, TtIn[l], FARcIn[l], MNg[l], f, df)) {
+            Psg[l] = PtIn[l]*f[FLOW_PSQPT];
+        }
+        else if (prm->SolveType == 0 && WIn[l] > 0 && prm->AthroatIn > 0
+                 && flow_table_MN(prm->Flow, TtIn[l], FARcIn[l], WIn[l]*SQRTT_L(TtIn[l])*DIVBY_L(prm->AthroatIn*PtIn[l]),
+                                  0, &MNg[l])
+                 && flow_table(prm->Flow, TtIn[l], FARcIn[l], MNg[l], f, df)) {
+            Psg[l] = PtIn[l]*f[FLOW_PSQPT];
+        }
+        else {
+            /* outside the table: isentropic guess */
+            MNg[l] = prm->MNIn;
+            gammatg = 1.4;
+            if (prm->SolveType == 1)
+                gammatg = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn[l],TtIn[l],prm->A,prm->B,NULL,&interpErr);
+            Tsg[l] = TtIn[l]*DIVBY_L(1+MNg[l]*MNg[l]*(gammatg-1)/2);
+            Psg[l] = PtIn[l]*powT((Tsg[l]*DIVBY_L(TtIn[l])),(gammatg*DIVBY_L(gammatg-1)));
+        }
+        PsLo[l] = 0;
+        PsHi[l] = PtIn[l];
+        Ts_old[l] = gammas_old[l] = 0;
+        run[l] = 1;
+    }
+    maxiter = 100;
+
+    /* Newton search of StaticCalc_TMATS_body on MN (SolveType 1) or on the
+     * flow area (SolveType 0) */
+    for (iter = 0; ; iter++) {
+        /* calculate flow velocity and rhos */
+        PcalcStat_state_lanes(&ss, Psg, Ts_try, hs_try, rhos_try, V_try, run);
+        any = 0;
+        for (l = 0; l < AGTF30_LANES; l++) {
+            if (!run[l])
+                continue;
+            Tsg[l] = Ts_try[l];
+            rhosg[l] = rhos_try[l];
+            gammasg[l] = interp2At(prm->K_gamma,prm->X_FARVec,prm->Y_TtVec,prm->T_gammaArray,FARcIn[l],Tsg[l],prm->A,prm->B,NULL,&interpErr);
+            MNg[l] = V_try[l]*DIVBY_L(SQRTT_L(gammasg[l]*Rt[l]*Tsg[l]*C_GRAVITY*JOULES_CONST));
+
+            if (V_try[l] > 0.0001) {
+                /* calculated Area */
+                Acalc[l] = WIn[l]*DIVBY_L(V_try[l] * rhosg[l]/C_SINtoSFT);
+            }
+            else if (prm->SolveType == 1) {
+                Acalc[l] = 999; /* if velocity is close to zero assume a very large Ath */
+            }
+            else {
+                Psg[l] = PtIn[l];
+                Tsg[l] = TtIn[l];
+                Acalc[l] = 999;
+                run[l] = 0;
+                continue;
+            }
+            if (prm->SolveType == 1)
+                er[l] = prm->MNIn - MNg[l];
+            else
+                er[l] = (prm->AthroatIn - Acalc[l])*DIVBY_L(prm->AthroatIn);
+            run[l] = !(fabs(er[l]) <= erthr || iter == maxiter);
+            any |= run[l];
+        }
+        if (!any)
+            break;
+
+        static_state_slope_lanes(&ss, Psg, dTs, dhs, ok);
+        for (l = 0; l < AGTF30_LANES; l++) {
+            if (!run[l])
+                continue;
+            der = 0;
+            if (ok[l] && V_try[l] > 0) {
+                if (prm->SolveType == 1) {
+                    dgammas = (iter > 0 && Tsg[l] != Ts_old[l]) ? (gammasg[l] - gammas_old[l])/(Tsg[l] - Ts_old[l]) : 0;
+                    der = -MNg[l]*(-C_GRAVITY*JOULES_CONST*dhs[l]/(V_try[l]*V_try[l])
+                                   - 0.5*(dgammas*DIVBY_L(gammasg[l]) + 1/Tsg[l])*dTs[l]);
+                }
+                else
+                    der = Acalc[l]*DIVBY_L(prm->AthroatIn)*(-C_GRAVITY*JOULES_CONST*dhs[l]/(V_try[l]*V_try[l])
+                                                             + 1/Psg[l] - dTs[l]/Tsg[l]);
+            }
+            if (prm->SolveType == 1 ? er[l] > 0 : (er[l] < 0 && der <= 0))
+                PsHi[l] = Psg[l];
+            else
+                PsLo[l] = Psg[l];
+            Psg_new = (der != 0) ? Psg[l] - er[l]/der : PsLo[l];
+            /* bisect when the step leaves the bracket */
+            if (!(Psg_new > PsLo[l] && Psg_new < PsHi[l]))
+                Psg_new = 0.5*(PsLo[l] + PsHi[l]);
+            Ts_old[l] = Tsg[l];
+            gammas_old[l] = gammasg[l];
+            Psg[l] = Psg_new;
+        }
+    }
+#endif
+
+    /*------Assign output values------------*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        y[0][l] = Tsg[l];       /* static Temperature [degR] */
+        y[1][l] = Psg[l];       /* static Pressure [psia] */
+        y[2][l] = rhosg[l];     /* static rho [lbm/ft3]*/
+        y[3][l] = (prm->SolveType == 1) ? prm->MNIn : MNg[l];  /* mach number [frac]*/
+        y[4][l] = Acalc[l];     /* throat area [in^2] */
+    }
+}
@@ -0,0 +1,164 @@
+/*		T-MATS -- StaticCalc_TMATS_tangent.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Tangent versions of StaticCalc_TMATS_body and Duct_TMATS_body.
+%
+%  The static pressure found by StaticCalc is differentiated through the
+%  condition its search solves: MN(Ps) = MNIn for SolveType 1 and
+%  A(Ps) = AthroatIn for SolveType 0. Both sides of that condition are
+%  evaluated at the converged Ps once with the input tangents and once
+%  with a unit tangent in Ps, which gives dPs = -dF/F_Ps.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+extern void StaticCalc_TMATS_body(double *y1, const double *u1, const StaticCalcStruct* prm, const double enable_debug);
+
+/* dy: Ts, Ps, rhos, MN, Ath. y holds the outputs of StaticCalc_TMATS_body for u. */
+void StaticCalc_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du,
+                              const StaticCalcStruct* prm)
+{
+    double WIn    = u[0];     /* Input Flow [pps] 	*/
+    double TtIn   = u[2];     /* Temperature Input [degR] 	*/
+    double PtIn   = u[3];     /* Pressure Input [psia] 	*/
+    double FARcIn = u[4];     /* Combusted Fuel to Air Ratio [frac] 	*/
+    double Ps     = y[1];     /* converged static pressure */
+
+    tan_t dhtin, dRt, dPs, zero, unit;
+    tan_t dTs, drhos, dV, dgammas, dMN, dq, dAcalc;
+    tan_t dTs_P, drhos_P, dV_P, dgammas_P, dMN_P;
+    double htin, Rt, Ts, rhos, V, MN, q, Acalc_P, F_P;
+    int i, k;
+
+    tan_zero(zero);
+    tan_fill(unit, 1);
+
+    if (prm->SolveType != 0 && prm->SolveType != 1) {
+        tan_copy(dy[0], du[2]);
+        tan_copy(dy[1], du[3]);
+        for (i = 2; i < 5; i++)
+            tan_zero(dy[i]);
+        return;
+    }
+
+    /* No flow (SolveType 0 sets Ath = 999 and gives up the search) */
+    if (prm->SolveType == 0 && y[4] == 999) {
+        for (i = 0; i < 5; i++)
+            tan_nan(dy[i]);
+        return;
+    }
+
+#ifndef TMATS_PROPERTIES_CONVERGED
+    htin = t2hc(TtIn, FARcIn);
+    t2hc_tangent(dhtin, TtIn, du[2], FARcIn, du[4]);
+#else
+    htin = u[1];
+    tan_copy(dhtin, du[1]);
+#endif
+    Rt = interp1Ac_tangent(dRt, prm->X_FARVec, prm->T_RtArray, FARcIn, du[4], prm->A);
+
+    /*--- Static state at the converged Ps: input tangents (Ps fixed) and unit Ps tangent ---*/
+    PcalcStatMN_tangent(PtIn, Ps, TtIn, htin, FARcIn, Rt, du[3], zero, du[2], dhtin, du[4], dRt,
+                        prm->X_FARVec, prm->Y_TtVec, prm->T_gammaArray, prm->A, prm->B,
+                        &Ts, &rhos, &V, &MN, dTs, drhos, dV, dgammas, dMN);
+    PcalcStatMN_tangent(PtIn, Ps, TtIn, htin, FARcIn, Rt, zero, unit, zero, zero, zero, zero,
+                        prm->X_FARVec, prm->Y_TtVec, prm->T_gammaArray, prm->A, prm->B,
+                        &Ts, &rhos, &V, &MN, dTs_P, drhos_P, dV_P, dgammas_P, dMN_P);
+
+    /* Calculated area A = W/(V*rhos/C_SINtoSFT) */
+    q = V * rhos/C_SINtoSFT;
+    tan_lin2(dq, rhos/C_SINtoSFT, dV, V/C_SINtoSFT, drhos);
+    tan_lin2(dAcalc, divby(q), du[0], WIn*divby_d(q), dq);
+    Acalc_P = WIn*divby_d(q)*(rhos*dV_P[0] + V*drhos_P[0])/C_SINtoSFT;
+
+    /*--- dPs from the solved condition ---*/
+    if (prm->SolveType == 1)
+        F_P = dMN_P[0];
+    else
+        F_P = Acalc_P;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dPs[k] = -((prm->SolveType == 1) ? dMN[k] : dAcalc[k])*divby(F_P);
+
+    /*--- Outputs: input tangent plus the Ps contribution ---*/
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dy[0][k] = dTs[k] + dTs_P[0]*dPs[k];
+        dy[1][k] = dPs[k];
+        dy[2][k] = drhos[k] + drhos_P[0]*dPs[k];
+        if (prm->SolveType == 1) {
+            dy[3][k] = 0;
+            dy[4][k] = (V > 0.0001) ? dAcalc[k] + Acalc_P*dPs[k] : 0;
+        }
+        else {
+            dy[3][k] = dMN[k] + dMN_P[0]*dPs[k];
+            dy[4][k] = dAcalc[k] + Acalc_P*dPs[k];
+        }
+    }
+}
+
+/* Duct_TMATS_body with the tangents of its outputs. y is computed here with
+ * the same operations as Duct_TMATS_body. */
+void Duct_TMATS_tangent(double *y, tan_t *dy, const double *u, tan_t *du, const DuctStruct* prm,
+                        const double enable_debug)
+{
+    double PtIn = u[3];     /* Total Pressure [psia] 	*/
+
+    /*--- Define StaticCalc I/O ---*/
+    double staticcalc_y[5];
+    tan_t staticcalc_dy[5];
+
+    /*--------Define Constants-------*/
+    double MN, r;
+    int k;
+
+    /*--- Define StaticCalc structure (same as Duct_TMATS_body) ---*/
+    double AthroatIn = prm->Ath;
+    double MNIn = 0.45;
+    int SolveType = 0;
+    static double X_FARVec[7] = {0, 0.0050, 0.0100, 0.0150, 0.0200, 0.0250, 0.0300};
+    static double T_RtArray[7] = {0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686, 0.0686};
+    static double Y_TtVec[7] = {300, 10000};
+    static double T_gammaArray[14] = {1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4, 1.4};
+    int IWork[5] = {0, 0, 0, 0, 0};
+    int  A = 7;
+    int  B = 2;
+    struct StaticCalcStruct duct = {
+        AthroatIn,
+        MNIn,
+        SolveType,
+        &X_FARVec[0],
+        &T_RtArray[0],
+        &Y_TtVec[0],
+        &T_gammaArray[0],
+        &prm->BlkNm[0],
+        &IWork[0],
+        A,
+        B,
+        NULL,
+        /* Interpolation kernels: none, the generic interp*Ac routines are used */
+        .K_Rt = NULL,
+        .K_gamma = NULL,
+    };
+
+    /*---- call StaticCalc to retrieve Mach number --- */
+    StaticCalc_TMATS_body(&staticcalc_y[0], &u[0], &duct, enable_debug);
+    StaticCalc_TMATS_tangent(staticcalc_dy, staticcalc_y, u, du, &duct);
+    MN = staticcalc_y[3];
+
+    /*------Assign output values------------*/
+    y[0] = u[0];      /* Mass flow */
+    y[1] = u[1];      /* Total enthalpy */
+    y[2] = u[2];      /* Total Temperature [degR] */
+    y[3] = (1 - (MN/prm->MNdes) * (MN/prm->MNdes) * prm->dP_M) * PtIn;  /* Total Pressure [psia] */
+    y[4] = u[4];      /* Fuel to Air Ratio */
+
+    /* PtOut = (1 - r^2*dP_M)*PtIn with r = MN/MNdes */
+    r = MN/prm->MNdes;
+    for (k = 0; k < 5; k++)
+        tan_copy(dy[k], du[k]);
+    tan_lin2(dy[3], 1 - r * r * prm->dP_M, du[3], -2*r*prm->dP_M*PtIn/prm->MNdes, staticcalc_dy[3]);
+}
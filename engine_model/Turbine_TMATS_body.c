@@ -30,14 +30,15 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
     double dHcools1, dHcoolout, Wfcools1, Wfcoolout, Ws1in,hts1in, Tts1in, FARs1in;
     double Ss1in, Wcoolout, Wcools1, PRmapRead;
     double C_Eff, C_PR, C_Nc, C_Wc;
+    double *MapTbl[2], MapVal[2];      /* Wc and Eff maps, read together */
     
     int interpErr = 0;
     double Wcool[100];
     double htcool[100];
-    double Ttcool[100];
     double Ptcool[100];
     double FARcool[100];
     int Vtest, i;
+    GasMix mix, mix_s1;
         
     /* Verify input bleed vector is a multiple of 5 */
     Vtest = cfWidth/5;
@@ -65,16 +66,18 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
         if (prm->CoolFlwEn < 0.5){
             Wcool[i] = 0;
             htcool[i] = 0;
-            Ttcool[i] = 0;
             Ptcool[i] = 0;
             FARcool[i] = 0;
         }
         else {
             Wcool[i] = CoolFlow[5*i];
-            Ttcool[i] = CoolFlow[5*i+2];
             Ptcool[i] = CoolFlow[5*i+3];
             FARcool[i] = CoolFlow[5*i+4];
-            htcool[i] = t2hc(Ttcool[i],FARcool[i]);
+#ifndef TMATS_PROPERTIES_CONVERGED
+            htcool[i] = t2hc(CoolFlow[5*i+2],FARcool[i]);
+#else
+            htcool[i] = CoolFlow[5*i+1];    /* enthalpy of the bleed from the compressor */
+#endif
         }
     }
     
@@ -116,6 +119,8 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
     
     FARs1in = (FARcIn* WIn*divby(1+FARcIn) + Wfcools1)*divby(WIn*divby(1+FARcIn) + Wcools1- Wfcools1);
     FARcOut = (FARcIn* WIn*divby(1+FARcIn)+ Wfcoolout)*divby(WIn*divby(1+FARcIn) + Wcoolout- Wfcoolout);
+    gasmix(&mix, FARcOut);
+    gasmix(&mix_s1, FARs1in);
     
     /* calc input enthalpy of cooling flow for stage 1 */
     for (i = 0; i < cfWidth/5; i++)
@@ -127,15 +132,19 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
     }
     
     /*-- Compute avg enthalpy at stage 1 --------*/
+#ifndef TMATS_PROPERTIES_CONVERGED
     htin = t2hc(TtIn,FARcIn);
+#else
+    htin = htIn;
+#endif
     hts1in = (htin* WIn + dHcools1)*divby(Ws1in);
     
     /*-- Compute  stage 1 total temp--------*/
     
-    Tts1in = h2tc(hts1in,FARs1in);
+    Tts1in = h2tc_from(&mix_s1, hts1in, TtIn);
     
     /*-- Compute Stage 1 entropy, assuming PtIn = Pts1in  --------*/
-    Ss1in = pt2sc(PtIn,Tts1in,FARs1in);
+    Ss1in = pt2sc_mix(&mix_s1, PtIn, Tts1in);
     
     /*---- calculate misc. fluid condition related variables --------*/
     delta = PtIn / C_PSTD;
@@ -168,9 +177,14 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
     
     PtOut = PtIn*divby(PRIn);	/* using PR from input */
     
+    /*-- Look up Wc and Eff at the map point in one search  --------*/
+    MapTbl[0] = prm->T_T_Map_WcArray;
+    MapTbl[1] = prm->T_T_Map_EffArray;
+    interp2Am(prm->M_T_Map,prm->X_T_PRVec,prm->Y_T_NcVec,MapTbl,2,PRmapRead,NcMap,prm->B,prm->A,NULL,MapVal,&interpErr);
+
     /*-- Compute Total Flow input (from Turbine map)  --------*/
     
-    WcMap = interp2Ac(prm->X_T_PRVec,prm->Y_T_NcVec,prm->T_T_Map_WcArray,PRmapRead,NcMap,prm->B,prm->A,&interpErr);
+    WcMap = MapVal[0];
     if ((prm->WcMapCol != prm->B || prm->WcMapRw != prm->A) && *(prm->IWork+Er4)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -209,7 +223,7 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
     
     /*-- Compute Turbine Efficiency (from Turbine map)  --------*/
     
-    EffMap = interp2Ac(prm->X_T_PRVec,prm->Y_T_NcVec,prm->T_T_Map_EffArray,PRmapRead,NcMap,prm->B,prm->A,&interpErr);
+    EffMap = MapVal[1];
     if ((prm->EffMapCol != prm->B || prm->EffMapRw != prm->A) && *(prm->IWork+Er5)==0){
         #ifdef MATLAB_MEX_FILE
         if (enable_debug) {
@@ -237,8 +251,8 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
     /*------ enthalpy calculations ---------*/
     /* ---- Ideal enthalpy  ----*/
     Sout = Ss1in;
-    TtIdealout = sp2tc(Sout,PtOut,FARcOut);
-    htIdealout = t2hc(TtIdealout,FARcOut); /* may need to be updated due to TtIdealout not being correct */
+    TtIdealout = sp2tc_from(&mix, Sout, PtOut, Tts1in, PtIn);
+    htIdealout = t2hc_mix(&mix, TtIdealout); /* may need to be updated due to TtIdealout not being correct */
     
     /*-Compute power output only takes into account cooling flow that enters at front of engine (stage 1)-*/
     
@@ -250,7 +264,7 @@ void Turbine_TMATS_body(double* y, const double* u, const double* CoolFlow, cons
     
     /*------ Compute Temperature output (empirical) ---------*/
     
-    TtOut = h2tc(htOut,FARcOut);
+    TtOut = h2tc_from(&mix, htOut, TtIdealout);
     
     /*----- Compute output Torque to shaft ----*/
     TorqueOut = C_HP_PER_RPMtoFT_LBF * Pwrout*divby(Nmech);
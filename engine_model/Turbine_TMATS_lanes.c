@@ -0,0 +1,234 @@
+/*		T-MATS -- Turbine_TMATS_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane version of Turbine_TMATS_body. The cooling flow vector length
+%  (u[11]) is taken from lane 0; it is a model constant.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_lanes.h"
+
+#define MAX_COOL_FLOWS 20
+
+void Turbine_TMATS_lanes(lane_t *y, const lane_t *u, const lane_t *CoolFlow, const TurbineStruct* prm)
+{
+    const double *WIn    = u[0];     /* Input Flow [pps]	*/
+    const double *TtIn   = u[2];     /* Temperature Input [degR]  */
+    const double *PtIn   = u[3];     /* Pressure Input [psia] 	 */
+    const double *FARcIn = u[4];     /* Compusted Fuel to Air Ratio [frac] */
+    const double *Nmech  = u[5];     /* Mechancial Shaft Speed [rpm]*/
+    const double *PRIn   = u[6];     /* Pressure Ratio [NA] 	 */
+    const double *s_T_Nc = u[7];     /* Nc map scalar [NA]	*/
+    const double *s_T_Wc = u[8];     /* Wc map scalar [NA]	*/
+    const double *s_T_PR = u[9];     /* PR map scalar [NA]	*/
+    const double *s_T_Eff = u[10];   /* Eff map scalar [NA]	*/
+    int    cfWidth  = (int)u[11][0]; /* Cooling Flow vector length	*/
+
+    /*--------Define Constants-------*/
+    lane_t htcool[MAX_COOL_FLOWS];
+    lane_t dHcools1, dHcoolout, Wcools1, Wcoolout, Wfcools1, Wfcoolout;
+    lane_t Ws1in, WOut, FARs1in, FARcOut, htin, hts1in, Tts1in, Ss1in, PtOut;
+    lane_t Eff, TtIdealout, htIdealout, htOut;
+    double theta, delta, ptheta, pdelta, Nc, C_Nc, NcMap, C_PR, PRmapRead, WcMap, C_Wc, WcCalcin;
+    double Wcin, Wcs1in, EffMap, C_Eff, Pwrout, NErrorOut, Wcool, FARcool;
+    double *MapTbl[2], MapVal[2];
+    int interpErr = 0;
+    int i, l, nCool;
+
+    nCool = cfWidth/5;
+    if (nCool > MAX_COOL_FLOWS)
+        nCool = MAX_COOL_FLOWS;
+
+    MapTbl[0] = prm->T_T_Map_WcArray;
+    MapTbl[1] = prm->T_T_Map_EffArray;
+
+    /* Initialize cooling flow sum constants */
+    for (l = 0; l < AGTF30_LANES; l++) {
+        dHcools1[l] = 0;   /* enthalpy * mass cooling flow rate at stage 1 of turbine */
+        dHcoolout[l] = 0;  /* enthalpy * mass cooling flow rate at exit of turbine */
+        Wcools1[l] = 0;    /* total cooling flow at stage 1 of turbine*/
+        Wcoolout[l] = 0;   /* total cooling flow at output of turbine */
+        Wfcools1[l] = 0;   /* combusted fuel flow in cooling at stage 1 of turbine */
+        Wfcoolout[l] = 0;  /* combusted fuel flow in cooling at exit of turbine */
+    }
+
+    /* enthalpy of the cooling flows */
+    for (i = 0; i < nCool; i++) {
+        if (prm->CoolFlwEn < 0.5) {
+            for (l = 0; l < AGTF30_LANES; l++)
+                htcool[i][l] = 0;
+        }
+        else {
+#ifndef TMATS_PROPERTIES_CONVERGED
+            t2hc_lanes(htcool[i], CoolFlow[5*i+2], CoolFlow[5*i+4]);
+#else
+            for (l = 0; l < AGTF30_LANES; l++)
+                htcool[i][l] = CoolFlow[5*i+1][l];  /* enthalpy of the bleed from the compressor */
+#endif
+        }
+    }
+
+    /* calc cooling flow constants for stage 1 and output of the turbine */
+    for (i = 0; i < nCool; i++) {
+        for (l = 0; l < AGTF30_LANES; l++) {
+            Wcool = (prm->CoolFlwEn < 0.5) ? 0 : CoolFlow[5*i][l];
+            FARcool = (prm->CoolFlwEn < 0.5) ? 0 : CoolFlow[5*i+4][l];
+
+            /* calc mass flow for cooling flows */
+            Wcools1[l] = Wcools1[l] + Wcool*(1-prm->T_BldPos[i]);
+            Wcoolout[l] = Wcoolout[l] + Wcool;
+
+            /* calc fuel mass flow for cooling flows*/
+            Wfcools1[l] = Wfcools1[l] + FARcool*Wcool*(1-prm->T_BldPos[i])*DIVBY_L(1+FARcool);
+            Wfcoolout[l] = Wfcoolout[l] + FARcool*Wcool*DIVBY_L(1+FARcool);
+        }
+    }
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        /*-- Compute Total Flow  --------*/
+        Ws1in[l] = WIn[l] + Wcools1[l];  /* mass flow at station 1 */
+        WOut[l] = WIn[l] + Wcoolout[l];  /* mass flow at turbine exit */
+
+        /*-- Compute Fuel to Air Ratios ---*/
+        FARs1in[l] = (FARcIn[l]* WIn[l]*DIVBY_L(1+FARcIn[l]) + Wfcools1[l])*DIVBY_L(WIn[l]*DIVBY_L(1+FARcIn[l]) + Wcools1[l]- Wfcools1[l]);
+        FARcOut[l] = (FARcIn[l]* WIn[l]*DIVBY_L(1+FARcIn[l])+ Wfcoolout[l])*DIVBY_L(WIn[l]*DIVBY_L(1+FARcIn[l]) + Wcoolout[l]- Wfcoolout[l]);
+    }
+
+    /* calc input enthalpy of cooling flow for stage 1 */
+    for (i = 0; i < nCool; i++) {
+        for (l = 0; l < AGTF30_LANES; l++) {
+            Wcool = (prm->CoolFlwEn < 0.5) ? 0 : CoolFlow[5*i][l];
+            dHcools1[l] = dHcools1[l] + htcool[i][l]*Wcool*(1-prm->T_BldPos[i]);
+            dHcoolout[l] = dHcoolout[l] + htcool[i][l]*Wcool*prm->T_BldPos[i];
+        }
+    }
+
+    /*-- Compute avg enthalpy at stage 1 --------*/
+#ifndef TMATS_PROPERTIES_CONVERGED
+    t2hc_lanes(htin, TtIn, FARcIn);
+#else
+    for (l = 0; l < AGTF30_LANES; l++)
+        htin[l] = u[1][l];
+#endif
+    for (l = 0; l < AGTF30_LANES; l++)
+        hts1in[l] = (htin[l]* WIn[l] + dHcools1[l])*DIVBY_L(Ws1in[l]);
+
+    /*-- Compute stage 1 total temp and entropy, assuming PtIn = Pts1in --------*/
+    h2tc_from_lanes(Tts1in, hts1in, FARs1in, TtIn);
+    pt2sc_lanes(Ss1in, PtIn, Tts1in, FARs1in);
+
+    /*-- Map lookups and scalars --------*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        delta = PtIn[l] / C_PSTD;
+        pdelta = PtIn[l];
+        theta = TtIn[l] / C_TSTD;
+        ptheta = TtIn[l];
+
+        /*------ Calculate corrected speed ---------*/
+        if (prm->ConfigNPSS > 0.5) /* In NPSS, turbine corrected values do not include standard day temp or pres. */
+            Nc = Nmech[l]*DIVBY_L(SQRTT_L(ptheta));
+        else
+            Nc = Nmech[l]*DIVBY_L(SQRTT_L(theta));
+
+        if (prm->IDes < 0.5)
+            C_Nc = Nc*DIVBY_L(prm->NcDes);
+        else
+            C_Nc = s_T_Nc[l];
+
+        NcMap = Nc*DIVBY_L(C_Nc);
+
+        /*------ Compute pressure output --------*/
+        if (prm->IDes < 0.5)
+            C_PR = (PRIn[l] - 1)*DIVBY_L(prm->PRmapDes -1);
+        else
+            C_PR = s_T_PR[l];
+
+        PRmapRead = ((PRIn[l] -1)*DIVBY_L(C_PR))+1;
+
+        PtOut[l] = PtIn[l]*DIVBY_L(PRIn[l]);	/* using PR from input */
+
+        /*-- Compute Total Flow input and Efficiency (from Turbine map)  --------*/
+        interp2Am(prm->M_T_Map,prm->X_T_PRVec,prm->Y_T_NcVec,MapTbl,2,PRmapRead,NcMap,prm->B,prm->A,NULL,MapVal,&interpErr);
+        WcMap = MapVal[0];
+        if (prm->IDes < 0.5) {
+            if (prm->ConfigNPSS > 0.5)
+                C_Wc = WIn[l]  *SQRTT_L(ptheta)*DIVBY_L(pdelta)*DIVBY_L(WcMap);
+            else
+                C_Wc = Ws1in[l]*SQRTT_L( theta)*DIVBY_L( delta)*DIVBY_L(WcMap);
+        }
+        else
+            C_Wc = s_T_Wc[l];
+
+        WcCalcin = WcMap * C_Wc;
+        if (prm->ConfigNPSS > 0.5) {
+            Wcin   = WIn[l]*SQRTT_L(ptheta)*DIVBY_L(pdelta);
+            Wcs1in = Ws1in[l]*SQRTT_L(ptheta)*DIVBY_L(pdelta);
+        }
+        else {
+            Wcin   = WIn[l]*SQRTT_L( theta)*DIVBY_L( delta);
+            Wcs1in = Ws1in[l]*SQRTT_L( theta)*DIVBY_L( delta);
+        }
+
+        /*-- Compute Turbine Efficiency (from Turbine map)  --------*/
+        EffMap = MapVal[1];
+        if (prm->IDes < 0.5)
+            C_Eff = prm->EffDes*DIVBY_L(EffMap);
+        else
+            C_Eff = s_T_Eff[l];
+
+        Eff[l] = EffMap * C_Eff;
+
+        /* ----- Compute Normalized Flow Error ----- */
+        if (prm->IDes < 0.5 && prm->NDes == 0)
+            NErrorOut = 100;
+        else if (prm->IDes < 0.5)
+            NErrorOut = (Nmech[l] - prm->NDes)*DIVBY_L(prm->NDes);
+        else if (Ws1in[l] == 0)
+            NErrorOut = 100;
+        else if (prm->ConfigNPSS > 0.5)
+            NErrorOut = (Wcin-WcCalcin)*DIVBY_L(Wcin);       /* map contains turbine input flow only */
+        else
+            NErrorOut = (Wcs1in-WcCalcin)*DIVBY_L(Wcs1in);   /* map contains turbine input flow and input bleed flow */
+
+        y[6][l] = NErrorOut;       /* Normalized turbine Error [frac]*/
+        y[7][l] = C_Nc;            /* Corrected Shaft Speed Scalar */
+        y[8][l] = C_Wc;            /* Corrected Flow Scalar */
+        y[9][l] = C_PR;            /* Pressure Ratio Scalar */
+        y[10][l] = C_Eff;          /* Efficiency Scalar */
+        y[11][l] = Wcin;           /* Corrected input flow [pps] */
+        y[12][l] = Wcs1in;         /* Station 1 corrected input flow [pps] */
+        y[13][l] = Nc;             /* Corrected speed [rpm]*/
+        y[14][l] = NcMap;          /* Map corrected speed */
+        y[15][l] = WcMap;          /* Map corrected flow */
+        y[16][l] = PRmapRead;      /* Map pressure ratio */
+        y[17][l] = EffMap;         /* Map efficiency */
+        y[19][l] = PRmapRead;      /* Test */
+    }
+
+    /*------ enthalpy calculations ---------*/
+    /* ---- Ideal enthalpy  ----*/
+    sp2tc_from_lanes(TtIdealout, Ss1in, PtOut, FARcOut, Tts1in, PtIn);
+    t2hc_lanes(htIdealout, TtIdealout, FARcOut);
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        /*-Compute power output only takes into account cooling flow that enters at front of engine (stage 1)-*/
+        Pwrout = ((hts1in[l] - htIdealout[l])*Eff[l])*Ws1in[l] * C_BTU_PER_SECtoHP;
+
+        /* ---- enthalpy output ----*/
+        htOut[l] = ((((htIdealout[l] - hts1in[l])*Eff[l]) + hts1in[l])*Ws1in[l] + dHcoolout[l])*DIVBY_L(WOut[l]);
+
+        y[0][l] = WOut[l];         /* Outlet Total Flow [pps]   */
+        y[1][l] = htOut[l];        /* Outlet Enthalpy [BTU/lbm]*/
+        y[3][l] = PtOut[l];        /* Outlet Pressure  [psia]     */
+        y[4][l] = FARcOut[l];      /* Outlet Fuel to Air Ratio [NA]	*/
+        y[5][l] = C_HP_PER_RPMtoFT_LBF * Pwrout*DIVBY_L(Nmech[l]);   /* Torque Output [lbf*ft]       */
+        y[18][l] = Pwrout;         /* Output power [hp]*/
+    }
+
+    /*------ Compute Temperature output (empirical) ---------*/
+    h2tc_from_lanes(y[2], htOut, FARcOut, TtIdealout);
+}
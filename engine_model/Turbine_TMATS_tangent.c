@@ -0,0 +1,251 @@
+/*		T-MATS -- Turbine_TMATS_tangent.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Tangent version of Turbine_TMATS_body for off-design operation
+%  (IDes >= 0.5). du holds the tangents of the gas path inputs u[0..6]
+%  (W, ht, Tt, Pt, FAR, Nmech, PR) and dCoolFlow those of the cooling
+%  flow vector; the map scalars are constants of the model. y holds the
+%  outputs of the body.
+% *************************************************************************/
+
+#include <math.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+/* Map lookup at (PRmapRead, NcMap) with its tangent */
+static void map_tangent(double *dz, double *T_Array, double PRmapRead, const double *dPRmapRead,
+                        double NcMap, const double *dNcMap, const TurbineStruct* prm)
+{
+    double z, zx, zy;
+
+    /* C1 maps (interp_map_init with INTERP_PCHIP or INTERP_AKIMA) */
+    if (interp2Amd(prm->M_T_Map, prm->X_T_PRVec, prm->Y_T_NcVec, T_Array, PRmapRead, NcMap, prm->B, prm->A,
+                   &z, &zx, &zy)) {
+        tan_lin2(dz, zx, dPRmapRead, zy, dNcMap);
+        return;
+    }
+    interp2Ac_tangent(dz, prm->X_T_PRVec, prm->Y_T_NcVec, T_Array, PRmapRead, dPRmapRead, NcMap, dNcMap,
+                      prm->B, prm->A);
+}
+
+void Turbine_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du,
+                           const double *CoolFlow, tan_t *dCoolFlow, const TurbineStruct* prm)
+{
+    double WIn      = u[0];     /* Input Flow [pps]	*/
+    double TtIn     = u[2];     /* Temperature Input [degR]  */
+    double PtIn     = u[3];     /* Pressure Input [psia] 	 */
+    double FARcIn   = u[4];     /* Compusted Fuel to Air Ratio [frac] */
+    double Nmech    = u[5];     /* Mechancial Shaft Speed [rpm]*/
+    double PRIn     = u[6];     /* Pressure Ratio [NA] 	 */
+    int    cfWidth  = u[11];    /* Cooling Flow vector length	*/
+
+    const double *dWIn = du[0], *dTtIn = du[2], *dPtIn = du[3], *dFARcIn = du[4], *dNmech = du[5], *dPRIn = du[6];
+
+    /*--- Outputs of the body ---*/
+    double WOut = y[0], TtOut = y[2], PtOut = y[3], FARcOut = y[4];
+    double C_Wc = y[8], C_PR = y[9], C_Eff = y[10], Wcin = y[11], Wcs1in = y[12];
+    double NcMap = y[14], WcMap = y[15], PRmapRead = y[16], EffMap = y[17], Pwrout = y[18];
+    double WcCalcin = WcMap * C_Wc;
+
+    /*--------Define Constants-------*/
+    double Wcool, FARcool, htcool, pos, Wa, Ws1in, FARs1in, num, den, htin, hts1in, Tts1in;
+    double dHcools1, dHcoolout, Wcools1, Wcoolout, Wfcools1, Wfcoolout;
+    double Ss1in, pth, pde, sth, Eff, TtIdealout, htIdealout, a, b;
+    tan_t dhtcool, dWcools1, dWcoolout, dWfcools1, dWfcoolout, ddHcools1, ddHcoolout, dWa, dWs1in;
+    tan_t dFARs1in, dFARcOut, dnum, dden, dhtin, dhts1in, dTts1in, dSs1in, dsth, dNc, dNcMap, dPRmapRead;
+    tan_t dPtOut, dWcMap, dEffMap, dEff, dTtIdealout, dhtIdealout, dWcin, dWcs1in, dPwrout, dhtOut, dtmp;
+    GasMix mix;
+    int i, k;
+
+    /*--- Design point scalars are not differentiated ---*/
+    if (prm->IDes < 0.5) {
+        for (i = 0; i < 20; i++)
+            tan_nan(dy[i]);
+        return;
+    }
+
+    /*--- cooling flow sums for stage 1 and output of the turbine ---*/
+    dHcools1 = 0;
+    dHcoolout = 0;
+    Wcools1 = 0;
+    Wcoolout = 0;
+    Wfcools1 = 0;
+    Wfcoolout = 0;
+    tan_zero(ddHcools1);
+    tan_zero(ddHcoolout);
+    tan_zero(dWcools1);
+    tan_zero(dWcoolout);
+    tan_zero(dWfcools1);
+    tan_zero(dWfcoolout);
+    if (prm->CoolFlwEn >= 0.5) {
+        for (i = 0; i < cfWidth/5; i++)
+        {
+            Wcool = CoolFlow[5*i];
+            FARcool = CoolFlow[5*i+4];
+#ifndef TMATS_PROPERTIES_CONVERGED
+            htcool = t2hc(CoolFlow[5*i+2],FARcool);
+            t2hc_tangent(dhtcool, CoolFlow[5*i+2], dCoolFlow[5*i+2], FARcool, dCoolFlow[5*i+4]);
+#else
+            htcool = CoolFlow[5*i+1];
+            tan_copy(dhtcool, dCoolFlow[5*i+1]);
+#endif
+            pos = prm->T_BldPos[i];
+
+            Wcools1 = Wcools1 + Wcool*(1-pos);
+            Wcoolout = Wcoolout + Wcool;
+            a = FARcool*divby(1+FARcool);
+            b = divby(1+FARcool) + FARcool*divby_d(1+FARcool);   /* da/dFARcool */
+            Wfcools1 = Wfcools1 + a*Wcool*(1-pos);
+            Wfcoolout = Wfcoolout + a*Wcool;
+            dHcools1 = dHcools1 + htcool*Wcool*(1-pos);
+            dHcoolout = dHcoolout + htcool*Wcool*pos;
+            for (k = 0; k < AGTF30_NUM_DIR; k++) {
+                dWcools1[k] += dCoolFlow[5*i][k]*(1-pos);
+                dWcoolout[k] += dCoolFlow[5*i][k];
+                dtmp[k] = b*dCoolFlow[5*i+4][k]*Wcool + a*dCoolFlow[5*i][k];
+                dWfcools1[k] += dtmp[k]*(1-pos);
+                dWfcoolout[k] += dtmp[k];
+                dtmp[k] = dhtcool[k]*Wcool + htcool*dCoolFlow[5*i][k];
+                ddHcools1[k] += dtmp[k]*(1-pos);
+                ddHcoolout[k] += dtmp[k]*pos;
+            }
+        }
+    }
+
+    /*-- Flows and Fuel to Air Ratios ---*/
+    Ws1in = WIn + Wcools1;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dWs1in[k] = dWIn[k] + dWcools1[k];
+
+    Wa = WIn*divby(1+FARcIn);
+    tan_lin2(dWa, divby(1+FARcIn), dWIn, WIn*divby_d(1+FARcIn), dFARcIn);
+
+    num = FARcIn*Wa + Wfcools1;
+    den = Wa + Wcools1 - Wfcools1;
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dnum[k] = dFARcIn[k]*Wa + FARcIn*dWa[k] + dWfcools1[k];
+        dden[k] = dWa[k] + dWcools1[k] - dWfcools1[k];
+    }
+    FARs1in = num*divby(den);
+    tan_lin2(dFARs1in, divby(den), dnum, num*divby_d(den), dden);
+
+    num = FARcIn*Wa + Wfcoolout;
+    den = Wa + Wcoolout - Wfcoolout;
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dnum[k] = dFARcIn[k]*Wa + FARcIn*dWa[k] + dWfcoolout[k];
+        dden[k] = dWa[k] + dWcoolout[k] - dWfcoolout[k];
+    }
+    tan_lin2(dFARcOut, divby(den), dnum, num*divby_d(den), dden);
+
+    /*-- stage 1 enthalpy, temperature and entropy --------*/
+#ifndef TMATS_PROPERTIES_CONVERGED
+    htin = t2hc(TtIn,FARcIn);
+    t2hc_tangent(dhtin, TtIn, dTtIn, FARcIn, dFARcIn);
+#else
+    htin = u[1];
+    tan_copy(dhtin, du[1]);
+#endif
+    num = htin*WIn + dHcools1;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        dnum[k] = dhtin[k]*WIn + htin*dWIn[k] + ddHcools1[k];
+    hts1in = num*divby(Ws1in);
+    tan_lin2(dhts1in, divby(Ws1in), dnum, num*divby_d(Ws1in), dWs1in);
+    gasmix(&mix, FARs1in);
+    Tts1in = h2tc_from(&mix, hts1in, TtIn);
+    h2tc_tangent(dTts1in, Tts1in, dhts1in, FARs1in, dFARs1in);
+    Ss1in = pt2sc(PtIn,Tts1in,FARs1in);
+    pt2sc_tangent(dSs1in, PtIn, Tts1in, FARs1in, dPtIn, dTts1in, dFARs1in);
+
+    /*------ corrected speed ---------*/
+    if (prm->ConfigNPSS > 0.5) {
+        pth = TtIn;
+        pde = PtIn;
+        tan_copy(dtmp, dTtIn);
+        tan_copy(dden, dPtIn);
+    }
+    else {
+        pth = TtIn / C_TSTD;
+        pde = PtIn / C_PSTD;
+        tan_scale(dtmp, 1/C_TSTD, dTtIn);
+        tan_scale(dden, 1/C_PSTD, dPtIn);
+    }
+    sth = sqrtT(pth);
+    tan_scale(dsth, sqrtT_d(pth), dtmp);
+    tan_lin2(dNc, divby(sth), dNmech, Nmech*divby_d(sth), dsth);
+    tan_scale(dNcMap, divby(y[7]), dNc);
+
+    /*------ pressure output and map pressure ratio --------*/
+    tan_scale(dPRmapRead, divby(C_PR), dPRIn);
+    tan_lin2(dPtOut, divby(PRIn), dPtIn, PtIn*divby_d(PRIn), dPRIn);
+
+    /*-- Map lookups --------*/
+    map_tangent(dWcMap, prm->T_T_Map_WcArray, PRmapRead, dPRmapRead, NcMap, dNcMap, prm);
+    map_tangent(dEffMap, prm->T_T_Map_EffArray, PRmapRead, dPRmapRead, NcMap, dNcMap, prm);
+    Eff = EffMap * C_Eff;
+    tan_scale(dEff, C_Eff, dEffMap);
+
+    /*-- corrected flows W*sqrtT(theta)*divby(delta) --*/
+    tan_lin3(dWcin, sth*divby(pde), dWIn, WIn*divby(pde), dsth, WIn*sth*divby_d(pde), dden);
+    tan_lin3(dWcs1in, sth*divby(pde), dWs1in, Ws1in*divby(pde), dsth, Ws1in*sth*divby_d(pde), dden);
+
+    /*------ enthalpy calculations ---------*/
+    gasmix(&mix, FARcOut);
+    TtIdealout = sp2tc_from(&mix, Ss1in, PtOut, Tts1in, PtIn);
+    sp2tc_tangent(dTtIdealout, TtIdealout, PtOut, dSs1in, dPtOut, FARcOut, dFARcOut);
+    htIdealout = t2hc(TtIdealout,FARcOut);
+    t2hc_tangent(dhtIdealout, TtIdealout, dTtIdealout, FARcOut, dFARcOut);
+
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        /* Pwrout = ((hts1in - htIdealout)*Eff)*Ws1in*C */
+        dPwrout[k] = ((dhts1in[k] - dhtIdealout[k])*Eff*Ws1in + (hts1in - htIdealout)*(dEff[k]*Ws1in + Eff*dWs1in[k]))
+                     * C_BTU_PER_SECtoHP;
+        /* htOut = ((((htIdealout - hts1in)*Eff) + hts1in)*Ws1in + dHcoolout)*divby(WOut) */
+        a = ((htIdealout - hts1in)*Eff) + hts1in;
+        dtmp[k] = ((dhtIdealout[k] - dhts1in[k])*Eff + (htIdealout - hts1in)*dEff[k] + dhts1in[k])*Ws1in
+                  + a*dWs1in[k] + ddHcoolout[k];
+        dden[k] = dWIn[k] + dWcoolout[k];
+    }
+    num = a*Ws1in + dHcoolout;
+    tan_lin2(dhtOut, divby(WOut), dtmp, num*divby_d(WOut), dden);
+    h2tc_tangent(dy[2], TtOut, dhtOut, FARcOut, dFARcOut);
+
+    /*----- output Torque to shaft ----*/
+    tan_lin2(dy[5], C_HP_PER_RPMtoFT_LBF*divby(Nmech), dPwrout, C_HP_PER_RPMtoFT_LBF*Pwrout*divby_d(Nmech), dNmech);
+
+    /* ----- Normalized Flow Error ----- */
+    if (Ws1in == 0)
+        tan_zero(dy[6]);
+    else if (prm->ConfigNPSS > 0.5) {
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dtmp[k] = dWcin[k] - C_Wc*dWcMap[k];
+        tan_lin2(dy[6], divby(Wcin), dtmp, (Wcin - WcCalcin)*divby_d(Wcin), dWcin);
+    }
+    else {
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dtmp[k] = dWcs1in[k] - C_Wc*dWcMap[k];
+        tan_lin2(dy[6], divby(Wcs1in), dtmp, (Wcs1in - WcCalcin)*divby_d(Wcs1in), dWcs1in);
+    }
+
+    /*------Assign output tangents------------*/
+    for (k = 0; k < AGTF30_NUM_DIR; k++) {
+        dy[0][k] = dden[k];                 /* WOut */
+        dy[1][k] = dhtOut[k];
+        dy[3][k] = dPtOut[k];
+        dy[4][k] = dFARcOut[k];
+        dy[7][k] = 0;                       /* map scalars */
+        dy[8][k] = 0;
+        dy[9][k] = 0;
+        dy[10][k] = 0;
+        dy[11][k] = dWcin[k];
+        dy[12][k] = dWcs1in[k];
+        dy[13][k] = dNc[k];
+        dy[14][k] = dNcMap[k];
+        dy[15][k] = dWcMap[k];
+        dy[16][k] = dPRmapRead[k];
+        dy[17][k] = dEffMap[k];
+        dy[18][k] = dPwrout[k];
+        dy[19][k] = dPRmapRead[k];          /* Test */
+    }
+}
@@ -38,7 +38,7 @@ void Valve_TMATS_body(double* y, const double* u, const ValveStruct* prm)
         Valve_active_Ae = ValveFrac*prm->Valve_Ae;
 
         /* compute corrected flow based on pressure ratio */
-        bleedFlxCr = interp1Ac(prm->X_V_PRVec,prm->T_V_WcVec,ValvePR,prm->A,&interpErr);
+        bleedFlxCr = interp1At(prm->K_V_Wc,prm->X_V_PRVec,prm->T_V_WcVec,ValvePR,prm->A,NULL,&interpErr);
         if (interpErr == 1 && *(prm->IWork+Er1)==0){
             #ifdef MATLAB_MEX_FILE
             printf("Warning in %s, Error calculating bleedFlxCr. Vector definitions may need to be expanded.\n", prm->BlkNm);
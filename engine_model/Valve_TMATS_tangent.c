@@ -0,0 +1,49 @@
+/*		T-MATS -- Valve_TMATS_tangent.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Tangent version of Valve_TMATS_body. du holds the tangents of the
+%  inputs u[0..4] (Ptby, VlvPos, Wmfp, Ttmfp, Ptmfp) and y the outputs of
+%  the body.
+% *************************************************************************/
+
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+void Valve_TMATS_tangent(tan_t *dy, const double *y, const double *u, tan_t *du, const ValveStruct* prm)
+{
+    double PtbyIn   = u[0];     /* Bypass disch. pressure [psia] 	*/
+    double VlvPosIn	= u[1];     /* Valve Position [frac, 0-1] 	*/
+    double WmfpIn	= u[2];     /* Main flow path flow rate [pps] 	*/
+    double TtmfpIn	= u[3];     /* Main flow path Temprature [degR] 	*/
+    double PtmfpIn	= u[4];     /* Main flow path Pressure Input [psia] 	*/
+
+    /*--------Define Constants-------*/
+    double ValveFrac, ValvePR, bleedFlxCr, s, a;
+    tan_t dValveFrac, dValvePR, dbleedFlxCr, ds;
+    int k;
+
+    ValveFrac = (VlvPosIn-prm->VlvdeadZone)*divby(prm->VlvfullyOpen-prm->VlvdeadZone);
+    ValvePR = PtmfpIn*divby(PtbyIn);
+
+    if ((ValveFrac <= 0) || (ValvePR <= 1.0))	/* dead zone or one-way valve */
+        tan_zero(dy[0]);
+    else if (y[0] == WmfpIn)                    /* flow check active */
+        tan_copy(dy[0], du[2]);
+    else {
+        tan_scale(dValveFrac, divby(prm->VlvfullyOpen-prm->VlvdeadZone), du[1]);
+        tan_lin2(dValvePR, divby(PtbyIn), du[4], PtmfpIn*divby_d(PtbyIn), du[0]);
+        bleedFlxCr = interp1Ac_tangent(dbleedFlxCr, prm->X_V_PRVec, prm->T_V_WcVec, ValvePR, dValvePR, prm->A);
+        s = sqrtT(TtmfpIn);
+        tan_scale(ds, sqrtT_d(TtmfpIn), du[3]);
+
+        /* WthOut = bleedFlxCr*PtmfpIn*divby(s)*ValveFrac*Valve_Ae */
+        a = divby(s);
+        for (k = 0; k < AGTF30_NUM_DIR; k++)
+            dy[0][k] = (dbleedFlxCr[k]*PtmfpIn*a*ValveFrac + bleedFlxCr*du[4][k]*a*ValveFrac
+                        + bleedFlxCr*PtmfpIn*divby_d(s)*ds[k]*ValveFrac + bleedFlxCr*PtmfpIn*a*dValveFrac[k])
+                       * prm->Valve_Ae;
+    }
+    tan_copy(dy[1], dy[0]);
+}
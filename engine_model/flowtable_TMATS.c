@@ -0,0 +1,279 @@
+/*		T-MATS -- flowtable_TMATS.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Isentropic flow functions of a component gas.
+%
+%  Along the isentrope of a total state (Tt, Pt) the ratios Ps/Pt and
+%  Ts/Tt and the flow per unit area W*sqrt(Tt)/(A*Pt) depend on Tt, the
+%  fuel-air ratio and the Mach number only, the Mach number being defined
+%  as the components define it: V/sqrt(gamma*Rt*Ts*g*J) with gamma and Rt
+%  from the component maps. flow_table_init tabulates them over
+%
+%      FAR  0 to 0.05 in steps of FLOW_FAR_STEP,
+%      Tt   FLOW_TT_LO to FLOW_TT_LO + (FLOW_NTT-1)*FLOW_TT_STEP,
+%      MN   0 to (FLOW_NMN-1)*FLOW_MN_STEP,
+%
+%  from t2hc_mix and pt2sc_mix, together with their derivatives in MN.
+%  flow_table interpolates them linearly in FAR, by cubic convolution in
+%  Tt and by cubic Hermite polynomials in MN; flow_table_MN inverts the flow per unit area
+%  for MN on the subsonic or the supersonic branch.
+%
+%  The pressure searches of Ambient, StaticCalc and the nozzle start from
+%  these values, which are within about 5e-4 in MN of the property
+%  routines, and refine them by Newton steps: StaticCalc now takes two or
+%  three PcalcStat evaluations where its secant search took about thirty.
+%  Each component has its own table, since MN is defined by its gamma and
+%  Rt maps. The tables are filled once by AGTF30_model_init and only read
+%  afterwards.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+
+#define FLOW_MN1    ((int)(1/FLOW_MN_STEP + 0.5))  /* node at MN = 1 */
+
+/*------ One point of an isentrope, for filling the table ------*/
+/* Static conditions at Ts on the isentrope through (Tt, ht, S1t): S1t is
+ * the entropy at Tt and 14.696 psia, c the change of entropy with
+ * log(P) at fixed T. f receives Ps/Pt, Ts/Tt and W*sqrt(Tt)/(A*Pt);
+ * the Mach number is returned. */
+static double flow_point(const GasMix *m, double Tt, double ht, double S1t, double c, double Rt,
+                         double *FARVec, double *TVec, double *gammaArray, int nFAR, int nT,
+                         double Ts, double *f)
+{
+    double hs, V, gammas, PsQPt;
+    int interpErr = 0;
+
+    hs = t2hc_mix(m, Ts);
+    V = sqrtT(2*(ht - hs)*C_GRAVITY*JOULES_CONST);
+    gammas = interp2Ac(FARVec, TVec, gammaArray, m->fa, Ts, nFAR, nT, &interpErr);
+    PsQPt = exp((pt2sc_mix(m, 14.696, Ts) - S1t)/c);
+
+    f[FLOW_PSQPT] = PsQPt;
+    f[FLOW_TSQTT] = Ts/Tt;
+    f[FLOW_WQ] = PsQPt*C_PSItoPSF/(Rt*Ts*JOULES_CONST)*V*sqrt(Tt)/C_SINtoSFT;
+    return V/sqrt(gammas*Rt*Ts*C_GRAVITY*JOULES_CONST);
+}
+
+/*------ flow_table_init: tabulate the flow functions of a component ------*/
+/* FARVec, RtArray (nFAR values) and TVec, gammaArray (nFAR x nT) are the
+ * gas constant and gamma maps of the component, as passed to interp1Ac
+ * and interp2Ac. */
+void flow_table_init(FlowTable *ft, double *FARVec, double *RtArray, double *TVec, double *gammaArray,
+                     int nFAR, int nT)
+{
+    GasMix m;
+    double FAR, Rt, Tt, ht, S1t, c, gammat, MN, Ts, Tsg, MNg, Tsg_old, MNg_old, dTs, MNp, MNm;
+    double f[FLOW_NF], fp[FLOW_NF], fm[FLOW_NF];
+    int i, j, k, n, ii;
+    int interpErr = 0;
+
+    for (i = 0; i < FLOW_NFAR; i++) {
+        FAR = i*FLOW_FAR_STEP;
+        gasmix(&m, FAR);
+        Rt = interp1Ac(FARVec, RtArray, FAR, nFAR, &interpErr);
+        for (j = 0; j < FLOW_NTT; j++) {
+            Tt = FLOW_TT_LO + j*FLOW_TT_STEP;
+            ht = t2hc_mix(&m, Tt);
+            S1t = pt2sc_mix(&m, 14.696, Tt);
+            c = (pt2sc_mix(&m, 14.696, Tt) - pt2sc_mix(&m, 2*14.696, Tt))/log(2.0);
+            gammat = interp2Ac(FARVec, TVec, gammaArray, FAR, Tt, nFAR, nT, &interpErr);
+
+            /* MN = 0: the total state, with V = MN*sqrt(gamma*Rt*Tt*g*J) */
+            for (n = 0; n < FLOW_NF; n++)
+                ft->df[n][i][j][0] = 0;
+            ft->f[FLOW_PSQPT][i][j][0] = 1;
+            ft->f[FLOW_TSQTT][i][j][0] = 1;
+            ft->f[FLOW_WQ][i][j][0] = 0;
+            ft->df[FLOW_WQ][i][j][0] = C_PSItoPSF/(Rt*Tt*JOULES_CONST)
+                                       *sqrt(gammat*Rt*Tt*C_GRAVITY*JOULES_CONST)*sqrt(Tt)/C_SINtoSFT;
+
+            Ts = Tt;
+            for (k = 1; k < FLOW_NMN; k++) {
+                MN = k*FLOW_MN_STEP;
+
+                /* Ts at MN by secant iteration from the isentropic estimate
+                 * and the previous node */
+                Tsg_old = Ts;
+                MNg_old = (k == 1) ? 0 : (k - 1)*FLOW_MN_STEP;
+                Tsg = Tt/(1 + MN*MN*(gammat - 1)/2);
+                for (ii = 0; ii < 50; ii++) {
+                    MNg = flow_point(&m, Tt, ht, S1t, c, Rt, FARVec, TVec, gammaArray, nFAR, nT, Tsg, f);
+                    if (fabs(MN - MNg) < 1e-14 || MNg == MNg_old)
+                        break;
+                    dTs = (MN - MNg)*(Tsg - Tsg_old)/(MNg - MNg_old);
+                    Tsg_old = Tsg;
+                    MNg_old = MNg;
+                    Tsg = Tsg + dTs;
+                }
+                Ts = Tsg;
+                flow_point(&m, Tt, ht, S1t, c, Rt, FARVec, TVec, gammaArray, nFAR, nT, Ts, f);
+
+                /* slopes in MN by central differences in Ts */
+                dTs = 1e-5*Ts;
+                MNp = flow_point(&m, Tt, ht, S1t, c, Rt, FARVec, TVec, gammaArray, nFAR, nT, Ts + dTs, fp);
+                MNm = flow_point(&m, Tt, ht, S1t, c, Rt, FARVec, TVec, gammaArray, nFAR, nT, Ts - dTs, fm);
+                for (n = 0; n < FLOW_NF; n++) {
+                    ft->f[n][i][j][k] = f[n];
+                    ft->df[n][i][j][k] = (fp[n] - fm[n])/(MNp - MNm);
+                }
+            }
+        }
+    }
+}
+
+/*------ Grid cell and weights of (Tt, FAR) ------*/
+/* Linear weights in FAR (rows i and i+1) and cubic convolution
+ * (Catmull-Rom) weights in Tt (nodes j-1 to j+2, linear in the end cells) */
+static int flow_cell(double Tt, double FAR, int *i, int *j, double *wf, double *wt)
+{
+    double x, y, t;
+
+    x = FAR/FLOW_FAR_STEP;
+    y = (Tt - FLOW_TT_LO)/FLOW_TT_STEP;
+    if (!(x >= 0 && x <= FLOW_NFAR - 1 && y >= 0 && y <= FLOW_NTT - 1))
+        return 0;
+    *i = (int)x;
+    *j = (int)y;
+    if (*i > FLOW_NFAR - 2)
+        *i = FLOW_NFAR - 2;
+    if (*j > FLOW_NTT - 2)
+        *j = FLOW_NTT - 2;
+    *wf = x - *i;
+    t = y - *j;
+    if (*j == 0 || *j == FLOW_NTT - 2) {
+        wt[0] = wt[3] = 0;
+        wt[1] = 1 - t;
+        wt[2] = t;
+    }
+    else {
+        wt[0] = t*((2 - t)*t - 1)/2;
+        wt[1] = (t*t*(3*t - 5) + 2)/2;
+        wt[2] = t*((4 - 3*t)*t + 1)/2;
+        wt[3] = t*t*(t - 1)/2;
+    }
+    return 1;
+}
+
+/* Value of a[.][.][k] at the weights of flow_cell */
+static double flow_blend(const double a[FLOW_NFAR][FLOW_NTT][FLOW_NMN], int i, int j, int k, double wf,
+                         const double *wt)
+{
+    double a0, a1;
+    int jj;
+
+    a0 = a1 = 0;
+    for (jj = 0; jj < 4; jj++) {
+        if (wt[jj] != 0) {
+            a0 += wt[jj]*a[i][j-1+jj][k];
+            a1 += wt[jj]*a[i+1][j-1+jj][k];
+        }
+    }
+    return (1 - wf)*a0 + wf*a1;
+}
+
+/*------ flow_table: flow functions at (Tt, FAR, MN) ------*/
+/* f[FLOW_PSQPT] = Ps/Pt, f[FLOW_TSQTT] = Ts/Tt, f[FLOW_WQ] = W*sqrt(Tt)/(A*Pt)
+ * [lbm*sqrt(degR)/(s*in^2*psia)] and df their derivatives in MN. Returns 0
+ * and leaves f and df untouched outside the table. */
+int flow_table(const FlowTable *ft, double Tt, double FAR, double MN, double *f, double *df)
+{
+    double wf, wt[4], x, t, h00, h10, h01, h11, d00, d10, d01, d11, p0, p1, m0, m1;
+    int i, j, k, n;
+
+    x = MN/FLOW_MN_STEP;
+    if (ft == NULL || !flow_cell(Tt, FAR, &i, &j, &wf, wt) || !(x >= 0 && x <= FLOW_NMN - 1))
+        return 0;
+    k = (int)x;
+    if (k > FLOW_NMN - 2)
+        k = FLOW_NMN - 2;
+    t = x - k;
+
+    /* cubic Hermite basis and its derivative in t */
+    h00 = (1 + 2*t)*(1 - t)*(1 - t);
+    h10 = t*(1 - t)*(1 - t);
+    h01 = t*t*(3 - 2*t);
+    h11 = t*t*(t - 1);
+    d00 = 6*t*(t - 1);
+    d10 = (1 - t)*(1 - 3*t);
+    d01 = -d00;
+    d11 = t*(3*t - 2);
+
+    for (n = 0; n < FLOW_NF; n++) {
+        p0 = flow_blend(ft->f[n], i, j, k, wf, wt);
+        p1 = flow_blend(ft->f[n], i, j, k+1, wf, wt);
+        m0 = flow_blend(ft->df[n], i, j, k, wf, wt)*FLOW_MN_STEP;
+        m1 = flow_blend(ft->df[n], i, j, k+1, wf, wt)*FLOW_MN_STEP;
+        f[n] = h00*p0 + h10*m0 + h01*p1 + h11*m1;
+        df[n] = (d00*p0 + d10*m0 + d01*p1 + d11*m1)/FLOW_MN_STEP;
+    }
+    return 1;
+}
+
+/*------ flow_table_MN: Mach number of a flow per unit area ------*/
+/* MN at which W*sqrt(Tt)/(A*Pt) = WQ, below the maximum of the flow per
+ * unit area (supersonic = 0) or above it (supersonic = 1). Returns 0 and
+ * leaves MN untouched outside the table and when WQ is above the maximum
+ * or below the range of the supersonic branch. */
+int flow_table_MN(const FlowTable *ft, double Tt, double FAR, double WQ, int supersonic, double *MN)
+{
+    double col[FLOW_NMN], dcol[FLOW_NMN];
+    double wf, wt[4], t, h00, h10, h01, h11, p, dp;
+    int i, j, k, kmax, ii;
+
+    if (ft == NULL || !flow_cell(Tt, FAR, &i, &j, &wf, wt) || !(WQ >= 0))
+        return 0;
+    for (k = 0; k < FLOW_NMN; k++) {
+        col[k] = flow_blend(ft->f[FLOW_WQ], i, j, k, wf, wt);
+        dcol[k] = flow_blend(ft->df[FLOW_WQ], i, j, k, wf, wt)*FLOW_MN_STEP;
+    }
+
+    /* node of the largest flow, near MN = 1 */
+    kmax = FLOW_MN1;
+    while (kmax > 0 && col[kmax-1] > col[kmax])
+        kmax--;
+    while (kmax < FLOW_NMN - 1 && col[kmax+1] > col[kmax])
+        kmax++;
+    if (WQ > col[kmax])
+        return 0;
+
+    /* cell of the branch that holds WQ */
+    if (!supersonic) {
+        if (kmax == 0)
+            return 0;
+        for (k = 0; k < kmax - 1 && col[k+1] < WQ; k++)
+            ;
+    }
+    else {
+        if (kmax == FLOW_NMN - 1)
+            return 0;
+        for (k = kmax; k < FLOW_NMN - 2 && col[k+1] > WQ; k++)
+            ;
+        if (col[k+1] > WQ)
+            return 0;
+    }
+
+    /* Newton iterations on the Hermite polynomial of the cell, from the
+     * linear estimate */
+    t = (col[k+1] != col[k]) ? (WQ - col[k])/(col[k+1] - col[k]) : 0.5;
+    for (ii = 0; ii < 8; ii++) {
+        h00 = (1 + 2*t)*(1 - t)*(1 - t);
+        h10 = t*(1 - t)*(1 - t);
+        h01 = t*t*(3 - 2*t);
+        h11 = t*t*(t - 1);
+        p = h00*col[k] + h10*dcol[k] + h01*col[k+1] + h11*dcol[k+1];
+        dp = 6*t*(t - 1)*(col[k] - col[k+1]) + (1 - t)*(1 - 3*t)*dcol[k] + t*(3*t - 2)*dcol[k+1];
+        if (dp == 0)
+            break;
+        t = t - (p - WQ)/dp;
+        if (t < 0)
+            t = 0;
+        else if (t > 1)
+            t = 1;
+    }
+    *MN = (k + t)*FLOW_MN_STEP;
+    return 1;
+}
@@ -25,6 +25,113 @@ extern double pt2sc(double aa, double ba, double ca);
 /* sp2tc_TMATS.c */
 extern double sp2tc(double da, double ea, double fa);
 
+/* properties_TMATS.c */
+/* Built with TMATS_PROPERTIES_CONVERGED the property inversions start
+ * from inverse tables or nearby states and converge by Newton iteration
+ * (properties_TMATS.c), as do the Pt and Ps searches of the ambient,
+ * StaticCalc and nozzle, and the components take the total enthalpy
+ * carried by the incoming station instead of t2hc(Tt); otherwise they
+ * take the secant iterations of h2tc, sp2tc and the original blocks, on
+ * which the stored trim points are converged. Reference builds call the
+ * original routines and ignore it. */
+#ifdef TMATS_PROPERTIES_REFERENCE
+#undef TMATS_PROPERTIES_CONVERGED
+#endif
+
+/* Composition of the gas for one fuel-air ratio, see gasmix */
+struct GasMix{
+    double fa;          /* fuel-air ratio */
+    double zmea;        /* moles of unburned air */
+    double zmsp;        /* moles of stoichiometric products */
+    double tmlsr;       /* 1/total moles */
+    double zz;          /* tmlsr * molecular weight ratio */
+    double rcas;        /* gas constant [BTU/(lbm*degR)] */
+    int products;       /* fa > 0 */
+    int air;            /* fa == 0 */
+    /* TMATS_PROPERTIES_CONVERGED builds only, see gas_tables_init */
+    int inv_row;        /* inverse table row below fa, -1 outside the tables */
+    double inv_w;       /* weight of row inv_row+1 */
+    double hlo;         /* enthalpy at GAS_INV_TLO [BTU/lbm] */
+    double hscale;      /* inverse table cells per BTU/lbm */
+    double philo;       /* entropy function phi at GAS_INV_TLO */
+    double phiscale;    /* inverse table cells per unit of phi */
+};
+typedef struct GasMix GasMix;
+
+/* Inverse tables of enthalpy and entropy function phi, see gas_tables_init */
+#define GAS_INV_N          32       /* cells per row */
+#define GAS_INV_ROWS       16       /* fuel-air ratios 0 to 0.075 */
+#define GAS_INV_FAR_STEP   0.005
+#define GAS_INV_TLO        200.0    /* temperature range [degR] */
+#define GAS_INV_THI        4500.0
+struct GasInverse{
+    double Th[GAS_INV_ROWS][GAS_INV_N+1];      /* T on the enthalpy grid */
+    double dTh[GAS_INV_ROWS][GAS_INV_N+1];     /* dT per cell */
+    double Tphi[GAS_INV_ROWS][GAS_INV_N+1];    /* T on the phi grid */
+    double dTphi[GAS_INV_ROWS][GAS_INV_N+1];   /* dT per cell */
+};
+typedef struct GasInverse GasInverse;
+
+extern void gasmix(GasMix *m, double fa);
+extern void gas_tables_init(void);
+extern const GasInverse *gas_inverse_tables(void);
+extern double t2hc_mix(const GasMix *m, double T);
+extern double h2tc_mix(const GasMix *m, double H);
+extern double pt2sc_mix(const GasMix *m, double P, double T);
+extern double sp2tc_mix(const GasMix *m, double S, double P);
+extern double t2hc_air(double T);
+extern double h2tc_air(double H);
+extern double pt2sc_air(double P, double T);
+extern double sp2tc_air(double S, double P);
+extern double h2tc_from(const GasMix *m, double H, double T1);
+extern double sp2tc_from(const GasMix *m, double S, double P, double T1, double P1);
+extern void isentropic_mix(const GasMix *m, double Tt, double Pt, double PtOut, double eff, int expansion,
+                           double *ht, double *S, double *TtIdeal, double *htIdeal, double *TtOut, double *htOut);
+extern void PcalcStat_mix(const GasMix *m, double Pt, double Ps, double Tt, double ht, double Rt,
+                          double *S, double *Ts, double *hs, double *rhos, double *V);
+
+/* Total state of a static pressure search, see static_state */
+struct StaticState{
+    const GasMix *m;    /* gas composition */
+    double Pt, Tt, ht;  /* total conditions */
+    double Rt;          /* gas constant */
+    double S;           /* entropy pt2sc(Pt, Tt) */
+    double phiS;        /* entropy function phi at S and 14.696 psia */
+    int warm;           /* Ts, phi and dphi hold the last static temperature */
+    double Ts;          /* last static temperature, before limiting to Tt */
+    double phi;         /* phi at Ts */
+    double dphi;        /* dphi/dT near Ts */
+};
+typedef struct StaticState StaticState;
+
+extern void static_state(StaticState *ss, const GasMix *m, double Pt, double Tt, double ht, double Rt);
+extern void PcalcStat_state(StaticState *ss, double Ps, double *Ts, double *hs, double *rhos, double *V);
+extern int static_state_slope(const StaticState *ss, double Ps, double *dTs, double *dhs);
+
+/* flowtable_TMATS.c */
+/* Isentropic flow functions of a component gas over FAR, Tt and MN, see flow_table_init */
+#define FLOW_NFAR       11      /* fuel-air ratios 0 to 0.05 */
+#define FLOW_FAR_STEP   0.005
+#define FLOW_NTT        23      /* total temperatures 300 to 3600 degR */
+#define FLOW_TT_LO      300.0
+#define FLOW_TT_STEP    150.0
+#define FLOW_NMN        21      /* Mach numbers 0 to 2.5 */
+#define FLOW_MN_STEP    0.125
+#define FLOW_PSQPT      0       /* Ps/Pt */
+#define FLOW_TSQTT      1       /* Ts/Tt */
+#define FLOW_WQ         2       /* W*sqrt(Tt)/(A*Pt) */
+#define FLOW_NF         3
+struct FlowTable{
+    double f[FLOW_NF][FLOW_NFAR][FLOW_NTT][FLOW_NMN];     /* flow functions */
+    double df[FLOW_NF][FLOW_NFAR][FLOW_NTT][FLOW_NMN];    /* d/dMN */
+};
+typedef struct FlowTable FlowTable;
+
+extern void flow_table_init(FlowTable *ft, double *FARVec, double *RtArray, double *TVec, double *gammaArray,
+                            int nFAR, int nT);
+extern int flow_table(const FlowTable *ft, double Tt, double FAR, double MN, double *f, double *df);
+extern int flow_table_MN(const FlowTable *ft, double Tt, double FAR, double WQ, int supersonic, double *MN);
+
 /* interp1Ac_TMATS.c */
 extern double interp1Ac(double a1[], double b1[], double c1, int d1,int *error);
 /* interp2Ac_TMATS.c */
@@ -32,6 +139,99 @@ extern double interp2Ac(double a2[], double b2[], double c2[], double d2, double
 /* interp3Ac_TMATS.c */
 extern double interp3Ac(double a3[], double b3[], double c3[], double d3[], double e3, double f3, double g3,int h3, int i3, int j3, int *error);
 
+/* interpAt_TMATS.c */
+/* Search for the cell of an interpolation axis, see interp_table_init */
+#define INTERP_SCAN     0       /* backwards linear scan, as interp1Ac */
+#define INTERP_UNIFORM  1       /* index from the spacing of the first cell, then a step or two */
+#define INTERP_BINARY   2       /* bisection */
+#define INTERP_CURSOR   3       /* walk from the cell of the last lookup */
+#define INTERP_SCAN_MAX 16      /* longest irregular axis searched by INTERP_SCAN */
+#define INTERP_SLOPES   4096    /* slopes kept for all tables together */
+struct InterpAxis{
+    int kind;           /* INTERP_SCAN, ... */
+    int n;              /* number of values */
+    const double *X;    /* values, strictly increasing */
+    double x0;          /* X[0] */
+    double rdx;         /* 1/(X[1] - X[0]) */
+};
+typedef struct InterpAxis InterpAxis;
+
+/* Interpolation kernel of one table, chosen by interp_table_init */
+struct InterpTable{
+    int generic;        /* interp1Ac/2Ac/3Ac do the lookups */
+    int dims;           /* 1 to 3 */
+    int constant;       /* every value of the table is value, only the bounds are checked */
+    double value;
+    InterpAxis ax[3];   /* axes in the order of the interp*Ac arguments */
+    const double *V;    /* values the kernel was chosen for */
+    const double *dV;   /* slopes along the first axis, indexed as the values, may be NULL */
+};
+typedef struct InterpTable InterpTable;
+
+extern void interp_table_init(InterpTable *t, double *X, double *Y, double *Z, double *V, int A, int B, int C,
+                              int cursor);
+extern double interp1At(const InterpTable *t, double a1[], double b1[], double c1, int d1, int *cell, int *error);
+extern double interp2At(const InterpTable *t, double a2[], double b2[], double c2[], double d2, double e2,
+                        int f2, int g2, int *cell, int *error);
+extern double interp3At(const InterpTable *t, double a3[], double b3[], double c3[], double d3[], double e3,
+                        double f3, double g3, int h3, int i3, int j3, int *cell, int *error);
+
+/* Fused lookup of the tables of a turbomachinery map on one grid, see interp_map_init */
+#define INTERP_MAP_MAX  3       /* tables of a map: Wc, PR and Eff of a compressor */
+#define INTERP_MAP_POOL 32768   /* doubles of node storage kept for all maps together */
+#define INTERP_LINEAR   0       /* piecewise linear, as interp1Ac/2Ac/3Ac */
+#define INTERP_PCHIP    1       /* C1 cubic Hermite, monotone slopes of Fritsch and Butland */
+#define INTERP_AKIMA    2       /* C1 cubic Hermite, slopes of Akima */
+struct InterpMap{
+    int generic;        /* interp1Ac/2Ac/3Ac do the lookups, table by table */
+    int dims;           /* 1 to 3 */
+    int num;            /* tables, at most INTERP_MAP_MAX */
+    int kernel;         /* INTERP_LINEAR, INTERP_PCHIP or INTERP_AKIMA */
+    int stride;         /* doubles per grid node, 4, 8 or 16 */
+    InterpAxis ax[3];   /* axes in the order of the interp*Ac arguments */
+    const double *V[INTERP_MAP_MAX];    /* values the map was built from */
+    const double *node; /* per grid node, indexed as the values: the values of the tables, then their
+                           slopes along the first axis (INTERP_LINEAR: of the cell that starts at the
+                           node), then for the C1 kernels their slopes along the second axis and the
+                           cross derivatives; nodes of 8 or 16 doubles start on a 64 byte line */
+};
+typedef struct InterpMap InterpMap;
+
+extern void interp_map_init(InterpMap *m, double *X, double *Y, double *Z, double *const *V, int num, int A, int B,
+                            int C, int cursor, int kernel);
+extern void interp1Am(const InterpMap *m, double a1[], double *const b1[], int num, double c1, int d1, int *cell,
+                      double v[], int *error);
+extern void interp2Am(const InterpMap *m, double a2[], double b2[], double *const c2[], int num, double d2,
+                      double e2, int f2, int g2, int *cell, double v[], int *error);
+extern void interp3Am(const InterpMap *m, double a3[], double b3[], double c3[], double *const d3[], int num,
+                      double e3, double f3, double g3, int h3, int i3, int j3, int *cell, double v[], int *error);
+extern int interp2Amd(const InterpMap *m, double a2[], double b2[], double c2[], double d2, double e2, int f2,
+                      int g2, double *v, double *vx, double *vy);
+extern int interp3Amd(const InterpMap *m, double a3[], double b3[], double c3[], double d3[], double e3,
+                      double f3, double g3, int h3, int i3, int j3, double *v, double *vx, double *vy, double *vz);
+
+/* stallline_TMATS.c */
+/* Stall point of a compressor map per speed line, see stall_line_init */
+#define STALL_MAX       256     /* speed lines times Alpha values */
+#define STALL_WC        0       /* map corrected flow at stall */
+#define STALL_PR        1       /* map pressure ratio at stall */
+#define STALL_ERR       2       /* (SPR - PR)/SPR left at the stall point */
+#define STALL_TOL       0.01    /* largest |STALL_ERR| of a speed line that reaches the surge line */
+struct StallLine{
+    int valid;          /* the tables are filled, the map has at most STALL_MAX speed lines and Alpha values */
+    int A, C;           /* speed lines, Alpha values */
+    double *NcVec;      /* axes of the map */
+    double *AlphaVec;
+    double v[3][STALL_MAX];     /* STALL_WC, ... per speed line, Alpha varying fastest */
+    double *V[3];       /* v[0] to v[2] */
+    InterpMap M;        /* the three tables over NcMap (and Alpha) */
+};
+typedef struct StallLine StallLine;
+
+extern void stall_line_init(StallLine *sl, double *NcVec, double *RlineVec, double *AlphaVec, double *WcArray,
+                            double *PRArray, double *WcSurgeVec, double *PRSurgeVec, int A, int B, int C, int D);
+extern int stall_line(const StallLine *sl, double NcMap, double Alpha, double *WcMap, double *PRMap);
+
 /* PcalcStat_TMATS.c */
 extern void PcalcStat(double A1,double B1,double C1,double D1,double E1,double F1,double *G1,double *H1,double *I1,double *J1,double *K1);
 
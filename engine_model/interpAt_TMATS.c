@@ -0,0 +1,743 @@
+/*		T-MATS -- interpAt_TMATS.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Interpolation kernels chosen per table at model init.
+%
+%  interp1Ac, interp2Ac and interp3Ac find the cell of every axis by a
+%  backwards linear scan from the top of the axis on every call, whatever
+%  the table. interp_table_init looks at a table once and picks for it:
+%
+%   - a constant table (every value the same, e.g. the gamma and Rt maps
+%     of the AGTF30): no lookup, only the bounds are checked,
+%   - per axis, the search for the cell:
+%       INTERP_UNIFORM  axes whose values are within one cell of a uniform
+%                       grid with the spacing of the first cell (the
+%                       turbine PR axes end with a wider cell): the index
+%                       follows from the spacing and is corrected by a
+%                       step or two,
+%       INTERP_CURSOR   other axes whose caller keeps the cells of its last
+%                       lookup (cell argument of interp1At/2At/3At): the
+%                       search walks from there,
+%       INTERP_SCAN     other axes of at most INTERP_SCAN_MAX values: the
+%                       scan of interp1Ac, whose branches are predicted
+%                       well enough that bisection does not pay,
+%       INTERP_BINARY   longer axes,
+%     INTERP_CURSOR axes read without cells are searched as the others,
+%   - the slopes of the cells along the first axis, so that a lookup
+%     makes no division in place of one (1-D), one in place of three
+%     (2-D) or three in place of seven (3-D).
+%
+%  interp1At, interp2At and interp3At take the arguments of interp1Ac,
+%  interp2Ac and interp3Ac plus the table kernel and the cells. The values
+%  are clamped and interpErr is set as by those routines, the cell found
+%  is the one their scan finds and the interpolation is the same
+%  arithmetic, so the results are bit for bit those of interp*Ac. A NULL
+%  kernel, one of a table with an axis that is not strictly increasing or
+%  shorter than two values, or one given other table values than it was
+%  chosen for falls back to interp*Ac.
+%
+%  The Wc, PR and Eff maps of a compressor (Wc and Eff of a turbine) are
+%  read at the same point. interp_map_init builds for them one map whose
+%  grid nodes hold the values of all its tables followed by their slopes
+%  along the first axis, so that interp1Am, interp2Am and interp3Am find
+%  the cells and the offsets in them once, read the one (1-D), two (2-D)
+%  or four (3-D) nodes of one or two cache lines and return the values of
+%  the tables, each bit for bit the one of interp1At/2At/3At. The axes
+%  are those of the tables, so interpErr is the same for all of them and
+%  returned once.
+%
+%  Piecewise linear maps have kinks at every grid line, so the residuals
+%  of the engine model do too and a finite-difference Jacobian that
+%  straddles one costs Newton its quadratic convergence. A map built with
+%  the INTERP_PCHIP or INTERP_AKIMA kernel interpolates its tables instead
+%  with C1 cubic Hermite splines along the first two axes (bicubic on the
+%  cells of a 2-D map, linear between the planes of the third axis). The
+%  slopes at the grid nodes come from the values along each grid line
+%  once at init: the monotone slopes of Fritsch and Butland (those of the
+%  MATLAB pchip, no overshoot between monotone nodes) or those of Akima
+%  (closer to the data along curved lines). The cross derivatives are the
+%  slopes along the second axis of the slopes along the first. Such maps
+%  take the values at the grid nodes and the axes and interpErr of the
+%  linear ones. interp2Amd and interp3Amd return a value of a map with
+%  its derivatives, for the tangents of the components.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "functions_TMATS.h"
+
+/* Slopes along the first axis of the tables, filled by interp_table_init */
+static double interp_slopes[INTERP_SLOPES];
+static int interp_slopes_used = 0;
+
+/* Node storage of the maps, filled by interp_map_init from the first
+ * 64 byte boundary */
+static double interp_map_pool[INTERP_MAP_POOL + 8];
+static double *interp_map_next = NULL;
+static double *interp_map_end = NULL;
+
+/*------ Analysis of one axis ------*/
+/* Returns 0 when the axis is not strictly increasing or has fewer than
+ * two values. */
+static int interp_axis_init(InterpAxis *ax, const double *X, int n, int cursor)
+{
+    double k;
+    int i;
+
+    ax->X = X;
+    ax->n = n;
+    ax->kind = INTERP_SCAN;
+    ax->x0 = 0;
+    ax->rdx = 0;
+    if (X == NULL || n < 2)
+        return 0;
+    for (i = 1; i < n; i++) {
+        if (!(X[i] > X[i-1]))
+            return 0;
+    }
+
+    ax->x0 = X[0];
+    ax->rdx = 1/(X[1] - X[0]);
+
+    /* Uniform when every value is within one cell of the uniform grid */
+    ax->kind = INTERP_UNIFORM;
+    for (i = 1; i < n; i++) {
+        k = (X[i] - ax->x0)*ax->rdx;
+        if (!(k >= i - 1 && k < i + 2)) {
+            ax->kind = cursor ? INTERP_CURSOR : (n <= INTERP_SCAN_MAX ? INTERP_SCAN : INTERP_BINARY);
+            break;
+        }
+    }
+    return 1;
+}
+
+/*------ Kernel of a 1-D (Y and Z NULL), 2-D (Z NULL) or 3-D table ------*/
+/* X, Y, Z and A, B, C are the axes and their lengths as passed to
+ * interp1Ac/2Ac/3Ac, V the table values. cursor selects INTERP_CURSOR for
+ * the irregular axes; the caller then passes the cells of its last
+ * lookup to interp*At. */
+void interp_table_init(InterpTable *t, double *X, double *Y, double *Z, double *V, int A, int B, int C,
+                       int cursor)
+{
+    double *axX[3], *dV;
+    int axN[3], i, ii, num, stride;
+
+    axX[0] = X; axX[1] = Y; axX[2] = Z;
+    axN[0] = A; axN[1] = B; axN[2] = C;
+    t->dims = Y == NULL ? 1 : (Z == NULL ? 2 : 3);
+    t->generic = 0;
+    num = 1;
+    for (i = 0; i < 3; i++) {
+        if (i < t->dims) {
+            if (!interp_axis_init(&t->ax[i], axX[i], axN[i], cursor))
+                t->generic = 1;
+            num *= axN[i];
+        }
+        else
+            interp_axis_init(&t->ax[i], NULL, 0, 0);
+    }
+
+    /* + 0 as the interpolation adds to a -0 value; infinite values are interpolated to NaN */
+    t->V = V;
+    t->constant = !t->generic && V[0] - V[0] == 0;
+    t->value = V[0] + 0;
+    for (i = 1; i < num && t->constant; i++) {
+        if (!(V[i] == V[0]))
+            t->constant = 0;
+    }
+
+    /* Slopes of the cells along the first axis, the divisions interp*Ac
+     * makes on every call, while the shared storage lasts */
+    t->dV = NULL;
+    if (t->generic || t->constant || interp_slopes_used + num > INTERP_SLOPES)
+        return;
+    stride = t->dims == 1 ? 1 : B;
+    dV = &interp_slopes[interp_slopes_used];
+    interp_slopes_used += num;
+    for (i = 0; i < num; i++) {
+        ii = (i/stride) % A;
+        dV[i] = ii < A - 1 ? (V[i+stride] - V[i])/(X[ii+1] - X[ii]) : 0;
+    }
+    t->dV = dV;
+}
+
+/*------ Cell of an axis ------*/
+/* Bounds check of interp1Ac: xi is clamped to the axis range (NaN to
+ * X[0]) and *error set when it was. */
+static double interp_clamp(const InterpAxis *ax, double xi, int *error)
+{
+    const double *X = ax->X;
+
+    if (xi < X[0]){
+        *error = 1;
+        return X[0];
+    }
+    else if (xi > X[ax->n-1]){
+        *error = 1;
+        return X[ax->n-1];
+    }
+    else if (!(xi >= X[0])){
+        *error = 1;
+        return X[0];
+    }
+    return xi;
+}
+
+/* Largest i <= n-2 with X[i] <= xi, the cell the scan of interp1Ac finds,
+ * for xi within the axis range. cell holds the cell of the last lookup
+ * for INTERP_CURSOR and receives this one; it may be NULL. */
+static int interp_find(const InterpAxis *ax, double xi, int *cell)
+{
+    const double *X = ax->X;
+    int top = ax->n - 2;
+    int i, len, half;
+
+    if (ax->kind == INTERP_UNIFORM) {
+        i = (int)((xi - ax->x0)*ax->rdx);
+        if (i > top)
+            i = top;
+    }
+    else if (ax->kind == INTERP_CURSOR && cell != NULL) {
+        i = *cell;
+        if (i < 0 || i > top)
+            i = 0;
+    }
+    else if (ax->n <= INTERP_SCAN_MAX) {
+        i = top;
+        while (i > 0 && !(xi >= X[i]))
+            i = i - 1;
+        return i;
+    }
+    else {
+        /* bisection, written so that the compiler can select instead of branch */
+        i = 0;
+        len = top + 1;
+        while (len > 1) {
+            half = len/2;
+            i = xi >= X[i+half] ? i + half : i;
+            len = len - half;
+        }
+        return i;
+    }
+
+    /* step to the cell from the estimate */
+    while (i > 0 && !(xi >= X[i]))
+        i = i - 1;
+    while (i < top && xi >= X[i+1])
+        i = i + 1;
+    if (cell != NULL)
+        *cell = i;
+    return i;
+}
+
+/*------ interp1Ac with the kernel of the table ------*/
+double interp1At(const InterpTable *t, double *X, double *Y, double xi, int A, int *cell, int *error)
+{
+    int ii;
+    double slope;
+
+    if (t == NULL || t->generic || t->V != Y)
+        return interp1Ac(X, Y, xi, A, error);
+
+    *error = 0;
+    xi = interp_clamp(&t->ax[0], xi, error);
+    if (t->constant)
+        return t->value;
+
+    ii = interp_find(&t->ax[0], xi, cell);
+    slope = t->dV ? t->dV[ii] : (Y[ii+1] - Y[ii])/(X[ii+1] - X[ii]);
+    return Y[ii] + (slope * (xi - X[ii]));
+}
+
+/*------ interp2Ac with the kernel of the table ------*/
+double interp2At(const InterpTable *t, double *X, double *Y, double *Z, double xi, double yi, int A, int B,
+                 int *cell, int *error)
+{
+    int ii, jj, errValue = 0;
+    double slope1, slope2, slope3, z1, z2;
+
+    if (t == NULL || t->generic || t->V != Z)
+        return interp2Ac(X, Y, Z, xi, yi, A, B, error);
+
+    xi = interp_clamp(&t->ax[0], xi, &errValue);
+    yi = interp_clamp(&t->ax[1], yi, &errValue);
+    *error = errValue;
+    if (t->constant)
+        return t->value;
+
+    ii = interp_find(&t->ax[0], xi, cell ? &cell[0] : NULL);
+    jj = interp_find(&t->ax[1], yi, cell ? &cell[1] : NULL);
+
+    if (t->dV) {
+        slope1 = t->dV[jj+B*ii];
+        slope2 = t->dV[jj+1+B*ii];
+    }
+    else {
+        slope1 = (Z[jj+B*(ii+1)] - Z[jj+B*ii])/(X[ii+1] - X[ii]);
+        slope2 = (Z[jj+1+B*(ii+1)] - Z[jj+1+B*ii])/(X[ii+1] - X[ii]);
+    }
+
+    /*--- find z1 value for Y(jj) ---*/
+    z1 = Z[jj+B*ii] + (slope1 * (xi - X[ii]));
+
+    /*--- find z2 value for Y(jj+1) ---*/
+    z2 = Z[jj+1+B*ii] + (slope2 * (xi - X[ii]));
+
+    /*--- zi along the line between z1 and z2 ---*/
+    slope3 = (z2 - z1)/(Y[jj+1] - Y[jj]);
+    return z1 + (slope3 * (yi - Y[jj]));
+}
+
+/*------ interp3Ac with the kernel of the table ------*/
+double interp3At(const InterpTable *t, double *X, double *Y, double *Z, double *V, double xi, double yi,
+                 double zi, int A, int B, int C, int *cell, int *error)
+{
+    int ii, jj, kk, errValue = 0;
+    double v11, v21, v31, v12, v22, v32;
+    double slope1a, slope2a, slope3a, slope1b, slope2b, slope3b, slope4;
+
+    if (t == NULL || t->generic || t->V != V)
+        return interp3Ac(X, Y, Z, V, xi, yi, zi, A, B, C, error);
+
+    xi = interp_clamp(&t->ax[0], xi, &errValue);
+    yi = interp_clamp(&t->ax[1], yi, &errValue);
+    zi = interp_clamp(&t->ax[2], zi, &errValue);
+    *error = errValue;
+    if (t->constant)
+        return t->value;
+
+    ii = interp_find(&t->ax[0], xi, cell ? &cell[0] : NULL);
+    jj = interp_find(&t->ax[1], yi, cell ? &cell[1] : NULL);
+    kk = interp_find(&t->ax[2], zi, cell ? &cell[2] : NULL);
+
+    if (t->dV) {
+        slope1a = t->dV[jj+B*ii+(B*A)*kk];
+        slope2a = t->dV[jj+1+B*ii+(B*A)*kk];
+        slope1b = t->dV[jj+B*ii+(B*A)*(kk+1)];
+        slope2b = t->dV[jj+1+B*ii+(B*A)*(kk+1)];
+    }
+    else {
+        slope1a = (V[jj+B*(ii+1)+(B*A)*kk] - V[jj+B*ii+(B*A)*kk])/(X[ii+1] - X[ii]);
+        slope2a = (V[jj+1+B*(ii+1)+(B*A)*kk] - V[jj+1+B*ii+(B*A)*kk])/(X[ii+1] - X[ii]);
+        slope1b = (V[jj+B*(ii+1)+(B*A)*(kk+1)] - V[jj+B*ii+(B*A)*(kk+1)])/(X[ii+1] - X[ii]);
+        slope2b = (V[jj+1+B*(ii+1)+(B*A)*(kk+1)] - V[jj+1+B*ii+(B*A)*(kk+1)])/(X[ii+1] - X[ii]);
+    }
+
+    /*--- at Z(kk) ---*/
+    v11 = V[jj+B*ii+(B*A)*kk] + (slope1a * (xi - X[ii]));
+    v21 = V[jj+1+B*ii+(B*A)*kk] + (slope2a * (xi - X[ii]));
+    slope3a = (v21 - v11)/(Y[jj+1] - Y[jj]);
+    v31 = v11 + slope3a * (yi - Y[jj]);
+
+    /*--- at Z(kk+1) ---*/
+    v12 = V[jj+B*ii+(B*A)*(kk+1)] + (slope1b * (xi - X[ii]));
+    v22 = V[jj+1+B*ii+(B*A)*(kk+1)] + (slope2b * (xi - X[ii]));
+    slope3b = (v22 - v12)/(Y[jj+1] - Y[jj]);
+    v32 = v12 + slope3b * (yi - Y[jj]);
+
+    /*--- between Z(kk) and Z(kk+1) ---*/
+    slope4 = (v32 - v31)/(Z[kk+1] - Z[kk]);
+    return v31 + slope4 * (zi - Z[kk]);
+}
+
+/*------ Slopes at the nodes of one grid line ------*/
+/* Slope of cell k of the line, for k outside 0 to n-2 continued
+ * linearly as Akima does */
+static double interp_line_delta(const double *X, const double *f, int fs, int n, int k)
+{
+    if (n < 3)
+        return (f[fs] - f[0])/(X[1] - X[0]);
+    if (k < 0)
+        return (1 - k)*interp_line_delta(X, f, fs, n, 0) + k*interp_line_delta(X, f, fs, n, 1);
+    if (k > n - 2)
+        return (k - n + 3)*interp_line_delta(X, f, fs, n, n - 2) - (k - n + 2)*interp_line_delta(X, f, fs, n, n - 3);
+    return (f[(k+1)*fs] - f[k*fs])/(X[k+1] - X[k]);
+}
+
+/* Slopes d (stride ds) at the n nodes of the line f (stride fs) over the
+ * axis values X for the kernel INTERP_PCHIP or INTERP_AKIMA */
+static void interp_line_slopes(int kernel, const double *X, const double *f, int fs, int n, double *d, int ds)
+{
+    double d0, d1, h0, h1, w0, w1;
+    int i, e;
+
+    for (i = 0; i < n; i++) {
+        if (kernel == INTERP_AKIMA) {
+            w0 = fabs(interp_line_delta(X, f, fs, n, i+1) - interp_line_delta(X, f, fs, n, i));
+            w1 = fabs(interp_line_delta(X, f, fs, n, i-1) - interp_line_delta(X, f, fs, n, i-2));
+            d0 = interp_line_delta(X, f, fs, n, i-1);
+            d1 = interp_line_delta(X, f, fs, n, i);
+            d[i*ds] = w0 + w1 > 0 ? (w0*d0 + w1*d1)/(w0 + w1) : (d0 + d1)/2;
+        }
+        else if (n < 3)
+            d[i*ds] = interp_line_delta(X, f, fs, n, 0);
+        else if (i > 0 && i < n - 1) {
+            /* weighted harmonic mean of the cell slopes, 0 at an extremum */
+            d0 = interp_line_delta(X, f, fs, n, i-1);
+            d1 = interp_line_delta(X, f, fs, n, i);
+            h0 = X[i] - X[i-1];
+            h1 = X[i+1] - X[i];
+            w0 = 2*h1 + h0;
+            w1 = h1 + 2*h0;
+            d[i*ds] = d0*d1 > 0 ? (w0 + w1)/(w0/d0 + w1/d1) : 0;
+        }
+        else {
+            /* ends: three point slope, kept to the sign of the end cell
+             * and to three times its slope when the data turn */
+            e = i == 0 ? 1 : -1;
+            d0 = interp_line_delta(X, f, fs, n, i == 0 ? 0 : n - 2);
+            d1 = interp_line_delta(X, f, fs, n, i == 0 ? 1 : n - 3);
+            h0 = e*(X[i+e] - X[i]);
+            h1 = e*(X[i+2*e] - X[i+e]);
+            d[i*ds] = ((2*h0 + h1)*d0 - h0*d1)/(h0 + h1);
+            if (d[i*ds]*d0 <= 0)
+                d[i*ds] = 0;
+            else if (d0*d1 < 0 && fabs(d[i*ds]) > fabs(3*d0))
+                d[i*ds] = 3*d0;
+        }
+    }
+}
+
+/*------ Map of num tables on the grid of the axes X (Y, Z) ------*/
+/* Arguments as interp_table_init, V the values of the num tables, each
+ * laid out as interp1Ac/2Ac/3Ac reads it, kernel INTERP_LINEAR,
+ * INTERP_PCHIP or INTERP_AKIMA. The map is generic, and its lookups
+ * those of interp1Ac/2Ac/3Ac, when an axis is not strictly increasing or
+ * shorter than two values, num is not 1 to INTERP_MAP_MAX or the node
+ * storage is used up. */
+void interp_map_init(InterpMap *m, double *X, double *Y, double *Z, double *const *V, int num, int A, int B,
+                     int C, int cursor, int kernel)
+{
+    double *axX[3], *node;
+    int axN[3], i, k, ii, jj, nodes, lines, s;
+
+    axX[0] = X; axX[1] = Y; axX[2] = Z;
+    axN[0] = A; axN[1] = B; axN[2] = C;
+    m->dims = Y == NULL ? 1 : (Z == NULL ? 2 : 3);
+    m->num = num;
+    m->kernel = kernel == INTERP_PCHIP || kernel == INTERP_AKIMA ? kernel : INTERP_LINEAR;
+    if (m->kernel == INTERP_LINEAR)
+        m->stride = 2*num <= 4 ? 4 : 8;
+    else
+        m->stride = 4*num <= 4 ? 4 : (4*num <= 8 ? 8 : 16);
+    m->generic = num < 1 || num > INTERP_MAP_MAX;
+    m->node = NULL;
+    nodes = 1;
+    for (i = 0; i < 3; i++) {
+        if (i < m->dims) {
+            if (!interp_axis_init(&m->ax[i], axX[i], axN[i], cursor))
+                m->generic = 1;
+            nodes *= axN[i];
+        }
+        else
+            interp_axis_init(&m->ax[i], NULL, 0, 0);
+    }
+    for (k = 0; k < INTERP_MAP_MAX; k++)
+        m->V[k] = k < num ? V[k] : NULL;
+
+    if (interp_map_next == NULL) {
+        interp_map_next = interp_map_pool;
+        while ((size_t)interp_map_next % 64 != 0)
+            interp_map_next++;
+        interp_map_end = interp_map_next + INTERP_MAP_POOL;
+    }
+    if (m->generic || interp_map_end - interp_map_next < nodes*m->stride) {
+        m->generic = 1;
+        return;
+    }
+
+    node = interp_map_next;
+    interp_map_next += (nodes*m->stride + 7)/8*8;
+    s = m->dims == 1 ? 1 : B;
+    if (m->kernel == INTERP_LINEAR) {
+        /* Values and slopes of the cells along the first axis, as interp_table_init */
+        for (i = 0; i < nodes; i++) {
+            ii = (i/s) % A;
+            for (k = 0; k < num; k++) {
+                node[m->stride*i + k] = V[k][i];
+                node[m->stride*i + num + k] = ii < A - 1 ? (V[k][i+s] - V[k][i])/(X[ii+1] - X[ii]) : 0;
+            }
+        }
+        m->node = node;
+        return;
+    }
+
+    /* Values, slopes along the lines of the first axis (one line per
+     * value of the other axes) and along those of the second, and the
+     * slopes of the first along the second */
+    lines = nodes/A;
+    for (i = 0; i < nodes; i++) {
+        for (k = 0; k < 4*num; k++)
+            node[m->stride*i + k] = k < num ? V[k][i] : 0;
+    }
+    for (k = 0; k < num; k++) {
+        for (i = 0; i < lines; i++) {
+            jj = i % s + (i/s)*s*A;
+            interp_line_slopes(m->kernel, X, &V[k][jj], s, A, &node[m->stride*jj + num + k], m->stride*s);
+        }
+        if (m->dims == 1)
+            continue;
+        for (i = 0; i < nodes/B; i++) {
+            interp_line_slopes(m->kernel, Y, &V[k][B*i], 1, B, &node[m->stride*B*i + 2*num + k], m->stride);
+            interp_line_slopes(m->kernel, Y, &node[m->stride*B*i + num + k], m->stride, B,
+                               &node[m->stride*B*i + 3*num + k], m->stride);
+        }
+    }
+    m->node = node;
+}
+
+/* The map holds the first num of the tables V */
+static int interp_map_holds(const InterpMap *m, double *const *V, int num)
+{
+    int k;
+
+    if (m == NULL || m->generic || num > m->num)
+        return 0;
+    for (k = 0; k < num; k++) {
+        if (m->V[k] != V[k])
+            return 0;
+    }
+    return 1;
+}
+
+/*------ Bicubic Hermite interpolation in a cell of a C1 map ------*/
+/* Values v of the first num tables at the offsets t and u (0 to 1) of the
+ * cell of node n, whose neighbours along the first and second axis are
+ * nx and ny doubles away and whose sides are hx and hy long. With vx not
+ * NULL also the derivatives vx and vy along the two axes. */
+static void interp_map_hermite(const InterpMap *m, const double *n, int nx, int ny, double t, double u,
+                               double hx, double hy, int num, double v[], double vx[], double vy[])
+{
+    const double *a = n, *b = n + nx, *c = n + ny, *d = n + nx + ny;
+    int q = m->num, k;
+    double h00, h01, h10, h11, k00, k01, k10, k11;
+    double g0, g1, e0, e1;
+
+    /* Hermite basis in t (along the first axis) and u */
+    h00 = (1 + 2*t)*(1 - t)*(1 - t);
+    h01 = t*t*(3 - 2*t);
+    h10 = t*(1 - t)*(1 - t)*hx;
+    h11 = t*t*(t - 1)*hx;
+    k00 = (1 + 2*u)*(1 - u)*(1 - u);
+    k01 = u*u*(3 - 2*u);
+    k10 = u*(1 - u)*(1 - u)*hy;
+    k11 = u*u*(u - 1)*hy;
+
+    for (k = 0; k < num; k++) {
+        /*--- values and slopes along the second axis on the lines Y(jj) and Y(jj+1) ---*/
+        g0 = h00*a[k] + h01*b[k] + h10*a[q+k] + h11*b[q+k];
+        e0 = h00*a[2*q+k] + h01*b[2*q+k] + h10*a[3*q+k] + h11*b[3*q+k];
+        g1 = h00*c[k] + h01*d[k] + h10*c[q+k] + h11*d[q+k];
+        e1 = h00*c[2*q+k] + h01*d[2*q+k] + h10*c[3*q+k] + h11*d[3*q+k];
+
+        /*--- between the lines ---*/
+        v[k] = k00*g0 + k01*g1 + k10*e0 + k11*e1;
+        if (vx == NULL)
+            continue;
+        vy[k] = (6*u*(u - 1)*(g0 - g1))/hy + (1 - u)*(1 - 3*u)*e0 + u*(3*u - 2)*e1;
+        g0 = (6*t*(t - 1)*(a[k] - b[k]))/hx + (1 - t)*(1 - 3*t)*a[q+k] + t*(3*t - 2)*b[q+k];
+        e0 = (6*t*(t - 1)*(a[2*q+k] - b[2*q+k]))/hx + (1 - t)*(1 - 3*t)*a[3*q+k] + t*(3*t - 2)*b[3*q+k];
+        g1 = (6*t*(t - 1)*(c[k] - d[k]))/hx + (1 - t)*(1 - 3*t)*c[q+k] + t*(3*t - 2)*d[q+k];
+        e1 = (6*t*(t - 1)*(c[2*q+k] - d[2*q+k]))/hx + (1 - t)*(1 - 3*t)*c[3*q+k] + t*(3*t - 2)*d[3*q+k];
+        vx[k] = k00*g0 + k01*g1 + k10*e0 + k11*e1;
+    }
+}
+
+/*------ interp1Ac of the first num tables Y of a map ------*/
+/* Values in v[0] to v[num-1] */
+void interp1Am(const InterpMap *m, double *X, double *const Y[], int num, double xi, int A, int *cell,
+               double v[], int *error)
+{
+    const double *n1;
+    int ii, k;
+    double dx;
+
+    if (!interp_map_holds(m, Y, num)) {
+        for (k = 0; k < num; k++)
+            v[k] = interp1Ac(X, Y[k], xi, A, error);
+        return;
+    }
+
+    *error = 0;
+    xi = interp_clamp(&m->ax[0], xi, error);
+
+    ii = interp_find(&m->ax[0], xi, cell);
+    dx = xi - X[ii];
+    if (m->kernel != INTERP_LINEAR) {
+        interp_map_hermite(m, m->node + m->stride*ii, m->stride, 0, dx/(X[ii+1] - X[ii]), 0,
+                           X[ii+1] - X[ii], 1, num, v, NULL, NULL);
+        return;
+    }
+
+    /*--- node at X(ii) ---*/
+    n1 = m->node + m->stride*ii;
+    for (k = 0; k < num; k++)
+        v[k] = n1[k] + (n1[m->num+k] * dx);
+}
+
+/*------ interp2Ac of the first num tables Z of a map ------*/
+/* Values in v[0] to v[num-1] */
+void interp2Am(const InterpMap *m, double *X, double *Y, double *const Z[], int num, double xi, double yi, int A,
+               int B, int *cell, double v[], int *error)
+{
+    const double *n1, *n2;
+    int ii, jj, k, errValue = 0;
+    double dx, dy, hy, z1, z2;
+
+    if (!interp_map_holds(m, Z, num)) {
+        for (k = 0; k < num; k++)
+            v[k] = interp2Ac(X, Y, Z[k], xi, yi, A, B, error);
+        return;
+    }
+
+    xi = interp_clamp(&m->ax[0], xi, &errValue);
+    yi = interp_clamp(&m->ax[1], yi, &errValue);
+    *error = errValue;
+
+    ii = interp_find(&m->ax[0], xi, cell ? &cell[0] : NULL);
+    jj = interp_find(&m->ax[1], yi, cell ? &cell[1] : NULL);
+    dx = xi - X[ii];
+    dy = yi - Y[jj];
+    hy = Y[jj+1] - Y[jj];
+    if (m->kernel != INTERP_LINEAR) {
+        interp_map_hermite(m, m->node + m->stride*(jj+B*ii), m->stride*B, m->stride, dx/(X[ii+1] - X[ii]),
+                           dy/hy, X[ii+1] - X[ii], hy, num, v, NULL, NULL);
+        return;
+    }
+
+    /*--- nodes at X(ii), Y(jj) and Y(jj+1) ---*/
+    n1 = m->node + m->stride*(jj+B*ii);
+    n2 = n1 + m->stride;
+    for (k = 0; k < num; k++) {
+        z1 = n1[k] + (n1[m->num+k] * dx);
+        z2 = n2[k] + (n2[m->num+k] * dx);
+        v[k] = z1 + ((z2 - z1)/hy * dy);
+    }
+}
+
+/*------ interp3Ac of the first num tables V of a map ------*/
+/* Values in v[0] to v[num-1] */
+void interp3Am(const InterpMap *m, double *X, double *Y, double *Z, double *const V[], int num, double xi, double yi,
+               double zi, int A, int B, int C, int *cell, double v[], int *error)
+{
+    const double *n11, *n21, *n12, *n22;
+    int ii, jj, kk, k, errValue = 0;
+    double dx, dy, dz, hy, hz, v11, v21, v31, v12, v22, v32, w[INTERP_MAP_MAX];
+
+    if (!interp_map_holds(m, V, num)) {
+        for (k = 0; k < num; k++)
+            v[k] = interp3Ac(X, Y, Z, V[k], xi, yi, zi, A, B, C, error);
+        return;
+    }
+
+    xi = interp_clamp(&m->ax[0], xi, &errValue);
+    yi = interp_clamp(&m->ax[1], yi, &errValue);
+    zi = interp_clamp(&m->ax[2], zi, &errValue);
+    *error = errValue;
+
+    ii = interp_find(&m->ax[0], xi, cell ? &cell[0] : NULL);
+    jj = interp_find(&m->ax[1], yi, cell ? &cell[1] : NULL);
+    kk = interp_find(&m->ax[2], zi, cell ? &cell[2] : NULL);
+    dx = xi - X[ii];
+    dy = yi - Y[jj];
+    dz = zi - Z[kk];
+    hy = Y[jj+1] - Y[jj];
+    hz = Z[kk+1] - Z[kk];
+    if (m->kernel != INTERP_LINEAR) {
+        /*--- in the planes Z(kk) and Z(kk+1), then linearly between them ---*/
+        interp_map_hermite(m, m->node + m->stride*(jj+B*ii+(B*A)*kk), m->stride*B, m->stride,
+                           dx/(X[ii+1] - X[ii]), dy/hy, X[ii+1] - X[ii], hy, num, v, NULL, NULL);
+        interp_map_hermite(m, m->node + m->stride*(jj+B*ii+(B*A)*(kk+1)), m->stride*B, m->stride,
+                           dx/(X[ii+1] - X[ii]), dy/hy, X[ii+1] - X[ii], hy, num, w, NULL, NULL);
+        for (k = 0; k < num; k++)
+            v[k] = v[k] + (w[k] - v[k])/hz * dz;
+        return;
+    }
+
+    /*--- nodes at X(ii), Y(jj) and Y(jj+1), Z(kk) and Z(kk+1) ---*/
+    n11 = m->node + m->stride*(jj+B*ii+(B*A)*kk);
+    n21 = n11 + m->stride;
+    n12 = m->node + m->stride*(jj+B*ii+(B*A)*(kk+1));
+    n22 = n12 + m->stride;
+    for (k = 0; k < num; k++) {
+        v11 = n11[k] + (n11[m->num+k] * dx);
+        v21 = n21[k] + (n21[m->num+k] * dx);
+        v31 = v11 + (v21 - v11)/hy * dy;
+        v12 = n12[k] + (n12[m->num+k] * dx);
+        v22 = n22[k] + (n22[m->num+k] * dx);
+        v32 = v12 + (v22 - v12)/hy * dy;
+        v[k] = v31 + (v32 - v31)/hz * dz;
+    }
+}
+
+/*------ Value of one table of a C1 map with its derivatives ------*/
+/* Z is one of the tables of the map m. The value is that of interp2Am,
+ * vx and vy its derivatives along X and Y, 0 along an axis clamped to
+ * its range. Returns 0, and looks up nothing, when m is not a C1 map
+ * holding Z; linear maps are differentiated by interp2Ac_tangent. */
+int interp2Amd(const InterpMap *m, double *X, double *Y, double *Z, double xi, double yi, int A, int B,
+               double *v, double *vx, double *vy)
+{
+    int ii, jj, k, errX = 0, errY = 0;
+    double hx, hy, w[INTERP_MAP_MAX], wx[INTERP_MAP_MAX], wy[INTERP_MAP_MAX];
+
+    (void)A;    /* the row length of Z is not needed, B gives the stride */
+    if (m == NULL || m->generic || m->kernel == INTERP_LINEAR || m->dims != 2)
+        return 0;
+    for (k = 0; k < m->num && m->V[k] != Z; k++)
+        ;
+    if (k == m->num)
+        return 0;
+
+    xi = interp_clamp(&m->ax[0], xi, &errX);
+    yi = interp_clamp(&m->ax[1], yi, &errY);
+    ii = interp_find(&m->ax[0], xi, NULL);
+    jj = interp_find(&m->ax[1], yi, NULL);
+    hx = X[ii+1] - X[ii];
+    hy = Y[jj+1] - Y[jj];
+    interp_map_hermite(m, m->node + m->stride*(jj+B*ii), m->stride*B, m->stride, (xi - X[ii])/hx,
+                       (yi - Y[jj])/hy, hx, hy, k + 1, w, wx, wy);
+    *v = w[k];
+    *vx = errX ? 0 : wx[k];
+    *vy = errY ? 0 : wy[k];
+    return 1;
+}
+
+/*------ Value of one table of a 3-D C1 map with its derivatives ------*/
+/* As interp2Amd, vz the derivative along Z */
+int interp3Amd(const InterpMap *m, double *X, double *Y, double *Z, double *V, double xi, double yi,
+               double zi, int A, int B, int C, double *v, double *vx, double *vy, double *vz)
+{
+    int ii, jj, kk, k, errX = 0, errY = 0, errZ = 0;
+    double hx, hy, hz, dz, w1[INTERP_MAP_MAX], wx1[INTERP_MAP_MAX], wy1[INTERP_MAP_MAX];
+    double w2[INTERP_MAP_MAX], wx2[INTERP_MAP_MAX], wy2[INTERP_MAP_MAX];
+
+    (void)C;    /* the number of Z planes is not needed, A and B give the strides */
+    if (m == NULL || m->generic || m->kernel == INTERP_LINEAR || m->dims != 3)
+        return 0;
+    for (k = 0; k < m->num && m->V[k] != V; k++)
+        ;
+    if (k == m->num)
+        return 0;
+
+    xi = interp_clamp(&m->ax[0], xi, &errX);
+    yi = interp_clamp(&m->ax[1], yi, &errY);
+    zi = interp_clamp(&m->ax[2], zi, &errZ);
+    ii = interp_find(&m->ax[0], xi, NULL);
+    jj = interp_find(&m->ax[1], yi, NULL);
+    kk = interp_find(&m->ax[2], zi, NULL);
+    hx = X[ii+1] - X[ii];
+    hy = Y[jj+1] - Y[jj];
+    hz = Z[kk+1] - Z[kk];
+    dz = zi - Z[kk];
+    interp_map_hermite(m, m->node + m->stride*(jj+B*ii+(B*A)*kk), m->stride*B, m->stride, (xi - X[ii])/hx,
+                       (yi - Y[jj])/hy, hx, hy, k + 1, w1, wx1, wy1);
+    interp_map_hermite(m, m->node + m->stride*(jj+B*ii+(B*A)*(kk+1)), m->stride*B, m->stride, (xi - X[ii])/hx,
+                       (yi - Y[jj])/hy, hx, hy, k + 1, w2, wx2, wy2);
+    *v = w1[k] + (w2[k] - w1[k])/hz * dz;
+    *vx = errX ? 0 : wx1[k] + (wx2[k] - wx1[k])/hz * dz;
+    *vy = errY ? 0 : wy1[k] + (wy2[k] - wy1[k])/hz * dz;
+    *vz = errZ ? 0 : (w2[k] - w1[k])/hz;
+    return 1;
+}
@@ -1,6 +1,12 @@
 % This is a make file for the standalone Ambient MEX function. The 
 % standalone ambient MEX function is called to determine inlet conditions, 
 % which inform initial guess estimates before calling the main engine model.
+%
+% Ambient_C.c sets up the interpolation kernels (interpAt_TMATS.c) and, in
+% builds with -DTMATS_PROPERTIES_CONVERGED, the flow table
+% (flowtable_TMATS.c) of its tables as AGTF30_model_init does for the engine
+% model, so both return the same inlet conditions.
 
 mex Ambient_C.c Ambient_TMATS_body.c  ...
-    t2hc_TMATS.c pt2sc_TMATS.c interp1Ac_TMATS.c interp2Ac_TMATS.c sp2tc_TMATS.c functions_TMATS.c 
+    t2hc_TMATS.c pt2sc_TMATS.c interp1Ac_TMATS.c interp2Ac_TMATS.c interp3Ac_TMATS.c interpAt_TMATS.c  ...
+    sp2tc_TMATS.c functions_TMATS.c h2tc_TMATS.c properties_TMATS.c flowtable_TMATS.c
@@ -1,9 +1,52 @@
-% This is a make file for the AGTF30 MEX engine model. This function needs
-% to be run to recompile the MEX function whenever any of the files listed 
-% below are changed.
-
-mex MEX_engine_model.c Ambient_TMATS_body.c Inlet_TMATS_body.c Compressor_TMATS_body.c ...
-Duct_TMATS_body.c Valve_TMATS_body.c Nozzle_TMATS_body.c Burner_TMATS_body.c ...
-Turbine_TMATS_body.c t2hc_TMATS.c pt2sc_TMATS.c interp1Ac_TMATS.c interp2Ac_TMATS.c ...
-interp3Ac_TMATS.c sp2tc_TMATS.c h2tc_TMATS.c functions_TMATS.c PcalcStat_TMATS.c SFCCalc_TMATS.c ...
-Splitter_TMATS.c StaticCalc_TMATS_body.c Shaft_TMATS_body.c
+% This is a make file for the AGTF30 MEX engine model and MEX solver. This
+% function needs to be run to recompile the MEX functions whenever any of
+% the files listed below are changed.
+%
+% The lane kernels (*_lanes.c) are written so that the compiler can
+% vectorize them. To build them for AVX2 add the flags below to the mex
+% calls (gcc/clang; keep -ffp-contract=off so results match the scalar
+% bodies bit for bit):
+%   CFLAGS='$CFLAGS -mavx2 -mfma -ffp-contract=off'
+% or on MSVC:
+%   COMPFLAGS='$COMPFLAGS /arch:AVX2 /fp:precise'
+% With AVX-512 (-mavx512f) the lane groups hold 8 points instead of 4.
+%
+% Adding -DTMATS_PROPERTIES_CONVERGED to the mex calls selects the Newton
+% and inverse table forms of the gas property inversions and the Newton
+% forms of the ambient, StaticCalc and nozzle pressure searches (see
+% functions_TMATS.h). They converge tighter than the secant iterations of
+% the default build, on which the stored trim points in outputs.mat are
+% converged, and move the residuals at those points by up to 0.8.
+
+% Engine model sources shared by every MEX function
+engine_src = {'Ambient_TMATS_body.c', 'Inlet_TMATS_body.c', 'Compressor_TMATS_body.c', ...
+    'Duct_TMATS_body.c', 'Valve_TMATS_body.c', 'Nozzle_TMATS_body.c', 'Burner_TMATS_body.c', ...
+    'Turbine_TMATS_body.c', 't2hc_TMATS.c', 'pt2sc_TMATS.c', 'interp1Ac_TMATS.c', 'interp2Ac_TMATS.c', ...
+    'interp3Ac_TMATS.c', 'interpAt_TMATS.c', 'sp2tc_TMATS.c', 'h2tc_TMATS.c', 'functions_TMATS.c', 'PcalcStat_TMATS.c', 'properties_TMATS.c', 'flowtable_TMATS.c', 'stallline_TMATS.c', 'SFCCalc_TMATS.c', ...
+    'Splitter_TMATS.c', 'StaticCalc_TMATS_body.c', 'Shaft_TMATS_body.c', ...
+    'AGTF30_model_data.c', 'AGTF30_engine_eval.c', 'AGTF30_thread_pool.c', 'AGTF30_diagnostics.c', ...
+    'properties_TMATS_lanes.c', 'StaticCalc_TMATS_lanes.c', 'Duct_TMATS_lanes.c', 'Compressor_TMATS_lanes.c', ...
+    'Splitter_TMATS_lanes.c', 'Burner_TMATS_lanes.c', 'Turbine_TMATS_lanes.c', 'AGTF30_engine_eval_lanes.c', ...
+    'properties_TMATS_tangent.c', 'StaticCalc_TMATS_tangent.c', 'Compressor_TMATS_tangent.c', ...
+    'Turbine_TMATS_tangent.c', 'Nozzle_TMATS_tangent.c', 'Burner_TMATS_tangent.c', 'Splitter_TMATS_tangent.c', ...
+    'Valve_TMATS_tangent.c', 'AGTF30_engine_eval_tangent.c'};
+
+% Engine model
+mex('MEX_engine_model.c', engine_src{:});
+
+% Engine model sessions with reused output buffers (benchmark_engine_session.m)
+mex('MEX_engine_session.c', engine_src{:});
+
+% Newton-Raphson solver (native version of nr_solver.m)
+mex('MEX_nr_solver.c', 'AGTF30_nr_solver.c', engine_src{:});
+
+% Gas property microbenchmark (benchmark_gas_properties.m)
+mex('MEX_gas_properties_benchmark.c', 'properties_TMATS.c', 't2hc_TMATS.c', 'h2tc_TMATS.c', 'pt2sc_TMATS.c', ...
+    'sp2tc_TMATS.c', 'PcalcStat_TMATS.c', 'functions_TMATS.c');
+
+% Interpolation kernel microbenchmark (benchmark_interp.m)
+mex('MEX_interp_benchmark.c', engine_src{:});
+
+% Gas properties over arrays
+mex('MEX_gas_properties.c', 'properties_TMATS_lanes.c', 'properties_TMATS.c', 't2hc_TMATS.c', 'h2tc_TMATS.c', ...
+    'pt2sc_TMATS.c', 'sp2tc_TMATS.c', 'functions_TMATS.c');
@@ -0,0 +1,887 @@
+/*		T-MATS -- properties_TMATS.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Gas property routines on a precomputed gas mixture.
+%
+%  t2hc, h2tc, pt2sc and sp2tc derive the composition of the gas (moles
+%  of air and of stoichiometric products, molecular weight) from the
+%  fuel-air ratio on every call. A component calls them many times at
+%  one fuel-air ratio, most often inside the Ps searches of StaticCalc and
+%  the nozzle. gasmix computes the composition once into a GasMix and the
+%  *_mix routines below take it in place of the fuel-air ratio:
+%
+%      GasMix mix;
+%      gasmix(&mix, FAR);
+%      S  = pt2sc_mix(&mix, Pt, Tt);
+%      Ts = sp2tc_mix(&mix, S, Ps);
+%
+%  t2hc_mix and pt2sc_mix perform the floating point operations of t2hc
+%  and pt2sc, so results are the same bit for bit. The differences in form
+%  are that the property tables are static and read only and the segment
+%  index "integer part of T/100" is formed without fmod.
+%
+%  Compiled with TMATS_PROPERTIES_CONVERGED, h2tc_mix and sp2tc_mix do
+%  not iterate. Inverse tables give T as a function of h, and of the
+%  entropy function phi, which S and P fix (S + R ln(P/14.696) depends on
+%  T only). The tables have 32 cells from 200 to 4500 degR for fuel-air
+%  ratios 0 to 0.075 in steps of 0.005 (gas_tables_init). The estimate,
+%  Hermite interpolated in h or phi and linear in fuel-air ratio, is within
+%  0.03 degR; one Newton step with the analytic dh/dT or dphi/dT brings it
+%  within 2e-7 degR of the exact inverse. The secant iterations of h2tc
+%  and sp2tc stop at 1e-3 BTU/lbm and 1e-4 BTU/(lbm degR), about 0.01 degR
+%  away; the difference moves the residuals at the stored trim points by
+%  up to 6e-4. Points outside the tables, and every point of the default
+%  build, take the secant iterations of h2tc and sp2tc with the same
+%  results (log(P/14.696) is evaluated once per call instead of every
+%  iteration).
+%
+%  A mixture of pure air (fa == 0, everything upstream of the burner) is
+%  evaluated by versions of the routines specialized for air: the
+%  composition constants are compile time constants and the terms of the
+%  stoichiometric products, which are zero for air, are not evaluated.
+%  The *_mix routines select them through GasMix.air; t2hc_air, h2tc_air,
+%  pt2sc_air and sp2tc_air call them directly. In TMATS_PROPERTIES_CONVERGED
+%  builds the air mixture itself is computed once, with the inverse tables
+%  below, and gasmix copies it for fa == 0.
+%
+%  Compiled with TMATS_PROPERTIES_CONVERGED, h2tc_from, sp2tc_from and
+%  isentropic_mix replace the secant iterations of h2tc and sp2tc, which
+%  start from fixed guesses, by Newton iterations with the analytic
+%  derivatives of the polynomials, started from a nearby state the caller
+%  knows (the component inlet). They converge to tighter tolerances in
+%  fewer iterations, so their results differ from h2tc and sp2tc by the
+%  iteration error of those (well below 0.01 degR). That is enough to move
+%  the residuals at the stored trim points, which are converged on the
+%  secant results, by up to 0.07 (N3dot), so by default the three routines
+%  evaluate the h2tc and sp2tc chain with the *_mix routines.
+%
+%  static_state and PcalcStat_state evaluate PcalcStat along the static
+%  pressure searches of StaticCalc and the nozzle: the entropy of the total
+%  state is computed once and, with TMATS_PROPERTIES_CONVERGED, each static
+%  temperature is started from the previous one. static_state_slope gives
+%  the derivatives of Ts and hs with Ps along that entropy, for the Newton
+%  searches of StaticCalc and the nozzle.
+%
+%  Compiling with TMATS_PROPERTIES_REFERENCE defined makes these routines
+%  and the *_mix routines call t2hc, h2tc, pt2sc and sp2tc themselves
+%  (reference mode), for checking the model against the original property
+%  routines.
+% *************************************************************************/
+
+#include <math.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+
+#ifndef TMATS_PROPERTIES_REFERENCE
+
+/*--------Gas property tables (same values as t2hc, h2tc, pt2sc, sp2tc)----------*/
+static const int ITAB[60] = {1,1,1,2,3,3,4,4,4,5,5,5,5,6,6,6,6,6,7,7,7,7,7,7,
+         8,8,8,8,8,8,9,9,9,9,9,9,10,10,10,10,10,10,10,10,
+         11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11};
+static const double TTTAB[11] = {300,400,500,700,1000,1400,1900,2500,3100,3700,4500};
+static const double AHAIR[11] = {2.074402000000e3,2.767580000000e3,3.461230000000e3,
+         4.854285000000e3,6.981156000000e3,9.933801000000e3,
+         1.382117000000e4,1.870811000000e4,2.375618000000e4,
+         2.891518000000e4,3.591874000000e4};
+static const double BHAIR[11] = {6.930375143000e0,6.933262304370e0,6.941415639521e0,
+         6.999806554132e0,7.201291270059e0,7.564016167549e0,
+         7.965574033453e0,8.298411651745e0,8.515829359567e0,
+         8.673620909986e0,8.825346607306e0};
+static const double CHAIR[11] = {1.327409630363e-5,1.559751739222e-5,6.593583412638e-5,
+         2.260187389251e-4,4.455969808316e-4,4.612152628951e-4,
+         3.419004689130e-4,2.128288949057e-4,1.495339514650e-4,
+         1.134519659006e-4,7.620515574828e-5};
+static const double DHAIR[11] = {7.744736961966e-9,1.677943891139e-7,2.668048413312e-7,
+         2.439758243406e-7,1.301523505289e-8,-7.954319598805e-8,
+         -7.170643000405e-8,-3.51638574671e-8,-2.004554753575e-8,
+         -1.551950423014e-8,2.007781800899e-22};
+static const double AHSTOC[11] = {2.116286000000e3,2.831822000000e3,3.556413000000e3,
+         5.033766000000e3,7.326000000000e3,1.054811000000e4,
+         1.483580000000e4,2.028520000000e4,2.596610000000e4,
+         3.180568000000e4,3.976139000000e4};
+static const double BHSTOC[11] = {7.113538900000e0,7.199470008152e0,7.292391067390e0,
+         7.482468579354e0,7.811853002145e0,8.297006217518e0,
+         8.832077018487e0,9.300821657633e0,9.616136350979e0,
+         9.837032938452e0,1.003677698592e1};
+static const double CHSTOC[11] = {3.953219184767e-4,4.639891630481e-4,4.652214293286e-4,
+         4.851661304903e-4,6.127819454796e-4,6.001010929530e-4,
+         4.700405089856e-4,3.112005562576e-4,2.143239326515e-4,
+         1.538370464703e-4,9.584301286375e-5};
+static const double DHSTOC[11] = {2.288908152379e-7,4.107554268465e-9,3.324116860284e-8,
+         1.417953499881e-7,-1.056737710548e-8,-8.670705597826e-8,
+         -8.824441818226e-8,-5.382034644785e-8,-3.360382565619e-8,
+         -2.416418066940e-8,6.080973759837e-15};
+static const double APAIR[11] = {4.229854000000e1,4.429218000000e1,4.584067000000e1,
+         4.818303000000e1,5.070949000000e1,5.318950000000e1,
+         5.556056000000e1,5.779398000000e1,5.960312000000e1,
+         6.112402000000e1,6.283719000000e1};
+static const double BPAIR[11] = {2.305525000000e-2,1.732687898835e-2,1.390113404660e-2,
+         9.984237743689e-3,7.194810211645e-3,5.398110354070e-3,
+         4.191444392129e-3,3.318644249749e-3,2.746778608874e-3,
+         2.344441314755e-3,1.960623219312e-3};
+static const double CPAIR[11] = {-3.628178988352e-5,-2.100192023298e-5,
+         -1.325552918449e-5,-6.328952330080e-6,-2.969139443401e-6,
+         -1.522610200538e-6,-8.907217233446e-7,-5.639451806208e-7,
+         -3.891642208381e-7,-2.813979360273e-7,-1.983746832756e-7};
+static const double DPAIR[11] = {5.093289883514e-8,2.582130349498e-8,1.154429475734e-8,
+         3.733125429643e-9,1.205441035719e-9,4.212589847953e-10,
+         1.815425237354e-10,9.710053321261e-11,5.987015822823e-11,
+         3.459302197988e-11,2.445751324881e-11};
+static const double APSTOC[11] = {4.208565000000e1,4.414325000000e1,4.576019000000e1,
+         4.824312000000e1,5.096532000000e1,5.367114000000e1,
+         5.628635000000e1,5.877705000000e1,6.081328000000e1,
+         6.253552000000e1,6.448296000000e1};
+static const double BPSTOC[11] = {2.361110000000e-2,1.800764547338e-2,1.459451810646e-2,
+         1.067795041447e-2,7.806395767972e-3,5.922535863503e-3,
+         4.648916404273e-3,3.720736784998e-3,3.102786455737e-3,
+         2.660467392055e-3,2.231936896092e-3};
+static const double CPSTOC[11] = {-3.50184547338e-5,-2.10160905323e-5,-1.31151831369e-5,
+         -6.467655323031e-6,-3.104193498621e-6,-1.605456262554e-6,
+         -9.417826559062e-7,-6.051833762187e-7,-4.247338392160e-7,
+         -3.124646002534e-7,-2.231985197004e-7};
+static const double DPSTOC[11] = {4.667454733830e-8,2.633635798468e-8,1.107921302316e-8,
+         3.737179804900e-9,1.248947696722e-9,4.424490710984e-10,
+         1.869995998264e-10,1.002497427793e-10,6.237179942365e-11,
+         3.719420023041e-11,2.698623281668e-11};
+
+/* Table segment for temperature T; the ITAB lookup on the integer part of
+ * 0.01*(T - fmod(T,100)) in t2hc and the others, without the fmod */
+static int segment(double T)
+{
+    int k;
+
+    if (!(T >= 200))            /* also NaN */
+        return 0;
+    if (!(T < 6100))
+        return (T - T == 0) ? ITAB[59] - 1 : 0;   /* fmod(Inf,100) is NaN */
+    k = (int)(T * 0.01);
+    if (k * 100.0 > T)
+        k = k - 1;
+    else if ((k + 1) * 100.0 <= T)
+        k = k + 1;
+    return ITAB[k - 1] - 1;
+}
+
+/* Composition of pure air (fa == 0). The products of the constants are
+ * formed at compile time. */
+#define AIR_ZMEA    4.7642
+#define AIR_TMLSR   0.2098988288
+#define AIR_ZMWTR   0.0345194683
+#define AIR_ZZ      (AIR_TMLSR*AIR_ZMWTR)
+#define AIR_RCAS    (1.98587*AIR_ZMWTR)
+
+/* Enthalpy polynomial of the mixture at temperature T */
+static double enthalpy(const GasMix *m, double T)
+{
+    int it = segment(T);
+    double dl = T - TTTAB[it];
+    double hgea = ((DHAIR[it]*dl + CHAIR[it])*dl + BHAIR[it])*dl + AHAIR[it];
+    double hgsp = 0;
+
+    if (m->products)
+        hgsp = ((DHSTOC[it]*dl + CHSTOC[it])*dl + BHSTOC[it])*dl + AHSTOC[it];
+    return (hgsp*m->zmsp + hgea*m->zmea)*m->zz;
+}
+
+/* enthalpy for pure air */
+static double enthalpy_air(double T)
+{
+    int it = segment(T);
+    double dl = T - TTTAB[it];
+    double hgea = ((DHAIR[it]*dl + CHAIR[it])*dl + BHAIR[it])*dl + AHAIR[it];
+
+    return (hgea*AIR_ZMEA)*AIR_ZZ;
+}
+
+/* Entropy function phi of the mixture at temperature T */
+static double entropy_phi(const GasMix *m, double T)
+{
+    int it = segment(T);
+    double dl = T - TTTAB[it];
+    double phiea = ((DPAIR[it]*dl + CPAIR[it])*dl + BPAIR[it])*dl + APAIR[it];
+    double phisp = 0;
+
+    if (m->products)
+        phisp = ((DPSTOC[it]*dl + CPSTOC[it])*dl + BPSTOC[it])*dl + APSTOC[it];
+    return (phisp*m->zmsp + phiea*m->zmea)*m->tmlsr;
+}
+
+/* entropy_phi for pure air */
+static double entropy_phi_air(double T)
+{
+    int it = segment(T);
+    double dl = T - TTTAB[it];
+    double phiea = ((DPAIR[it]*dl + CPAIR[it])*dl + BPAIR[it])*dl + APAIR[it];
+
+    return (phiea*AIR_ZMEA)*AIR_TMLSR;
+}
+
+/* The iterations below take air as a constant: air = 1 selects the pure
+ * air polynomials (m is not used), air = 0 those of the mixture m. */
+
+/* Temperature from enthalpy (secant iteration of h2tc) */
+static double h2t(const GasMix *m, double H, const int air)
+{
+    double tg, tgo, hgo, hg, hh, d;
+    int ii;
+
+    tg = 3.55*H;
+    tgo = 1;
+    hgo = 0.282;
+
+    ii = 0;
+    hh = 99.99;
+
+    while (fabs(hh)>1e-3 && ii<11) {
+        ii = ii+1;
+        hg = air ? enthalpy_air(tg) : enthalpy(m, tg);
+        hh = H - hg;
+
+        d = (tg - tgo)/(hg - hgo);
+        tgo = tg;
+        hgo = hg;
+        tg = tg + d*hh;
+    }
+
+    return tg;
+}
+
+/* Entropy from pressure and temperature */
+static double pt2s(const GasMix *m, double P, double T, const int air)
+{
+    double rcas = air ? AIR_RCAS : m->rcas;
+
+    return ((air ? entropy_phi_air(T) : entropy_phi(m, T))*0.5035576347-23.0258509)*rcas - 0.1841304 - rcas * log(P/14.696);
+}
+
+/* Temperature from entropy and pressure (secant iteration of sp2tc) */
+static double sp2t(const GasMix *m, double S, double P, const int air)
+{
+    double rcas = air ? AIR_RCAS : m->rcas;
+    double lnP, Sg, Sg1, Tg, Tg1, dTdS;
+    double Stol = 1e-4;
+    int jj, Jmax = 10;
+
+    lnP = log(P/14.696);
+
+    /*---- guess starting temperature ----------------*/
+    Tg = 1000;
+    jj = 0;
+    Sg = 1e3;
+    Sg1 = 0;
+    Tg1 = 0;
+
+    /* at least two iterations, as in sp2tc */
+    while ((fabs(S - Sg) >= Stol && jj < Jmax) || (jj < 2)) {
+        Sg = ((air ? entropy_phi_air(Tg) : entropy_phi(m, Tg))*0.5035576347-23.0258509)*rcas - 0.1841304 - rcas * lnP;
+
+        if (jj == 0) {
+            Sg1 = Sg;
+            Tg1 = Tg;
+            Tg = Tg1 + 50;
+        }
+        else {
+            dTdS = (Tg - Tg1)/(Sg - Sg1);
+            Tg1 = Tg;
+            Sg1 = Sg;
+            Tg = Tg1 + (S - Sg1)*dTdS;
+        }
+        ++jj;
+    }
+    return Tg;
+}
+
+#ifdef TMATS_PROPERTIES_CONVERGED
+/* Enthalpy of the mixture at temperature T, in table segment it, and
+ * its derivative cp = dh/dT */
+static double enthalpy_d(const GasMix *m, double T, int it, double *cp)
+{
+    double dl = T - TTTAB[it];
+    double hgea = ((DHAIR[it]*dl + CHAIR[it])*dl + BHAIR[it])*dl + AHAIR[it];
+    double dhgea = (3*DHAIR[it]*dl + 2*CHAIR[it])*dl + BHAIR[it];
+    double hgsp = 0, dhgsp = 0;
+
+    if (m->products) {
+        hgsp = ((DHSTOC[it]*dl + CHSTOC[it])*dl + BHSTOC[it])*dl + AHSTOC[it];
+        dhgsp = (3*DHSTOC[it]*dl + 2*CHSTOC[it])*dl + BHSTOC[it];
+    }
+    *cp = (dhgsp*m->zmsp + dhgea*m->zmea)*m->zz;
+    return (hgsp*m->zmsp + hgea*m->zmea)*m->zz;
+}
+
+/* Entropy function phi of the mixture at temperature T, in table segment
+ * it, and dphi/dT */
+static double entropy_phi_d(const GasMix *m, double T, int it, double *dphi)
+{
+    double dl = T - TTTAB[it];
+    double phiea = ((DPAIR[it]*dl + CPAIR[it])*dl + BPAIR[it])*dl + APAIR[it];
+    double dphiea = (3*DPAIR[it]*dl + 2*CPAIR[it])*dl + BPAIR[it];
+    double phisp = 0, dphisp = 0;
+
+    if (m->products) {
+        phisp = ((DPSTOC[it]*dl + CPSTOC[it])*dl + BPSTOC[it])*dl + APSTOC[it];
+        dphisp = (3*DPSTOC[it]*dl + 2*CPSTOC[it])*dl + BPSTOC[it];
+    }
+    *dphi = (dphisp*m->zmsp + dphiea*m->zmea)*m->tmlsr;
+    return (phisp*m->zmsp + phiea*m->zmea)*m->tmlsr;
+}
+
+/* Temperature from enthalpy by Newton iteration from Tg. Returns the
+ * enthalpy and cp of the last iterate in *hg and *cp. */
+static double h2t_newton(const GasMix *m, double H, double Tg, double *hg, double *cp)
+{
+    int ii;
+
+    for (ii = 0; ii < 11; ii++) {
+        *hg = enthalpy_d(m, Tg, segment(Tg), cp);
+        Tg = Tg + (H - *hg)/(*cp);
+        if (fabs(H - *hg) < 1e-6)
+            break;
+    }
+    return Tg;
+}
+
+/* Temperature from entropy and pressure by Newton iteration from Tg */
+static double sp2t_newton(const GasMix *m, double S, double P, double Tg)
+{
+    double lnP = log(P/14.696);
+    double dphi, Sg;
+    int jj;
+
+    for (jj = 0; jj < 10; jj++) {
+        Sg = (entropy_phi_d(m, Tg, segment(Tg), &dphi)*0.5035576347-23.0258509)*m->rcas - 0.1841304 - m->rcas * lnP;
+        Tg = Tg + (S - Sg)/(dphi*0.5035576347*m->rcas);
+        if (fabs(S - Sg) < 1e-7)
+            break;
+    }
+    return Tg;
+}
+
+/* Ideal gas estimate of the temperature at pressure P on the isentrope
+ * through (T1, P1), for a heat capacity cp1 at T1 */
+static double isentrope_guess(const GasMix *m, double T1, double P1, double cp1, double P)
+{
+    return T1*exp(m->rcas*log(P/P1)/cp1);
+}
+
+/*--------Inverse tables of t2hc and pt2sc----------*/
+/* Row k holds, for fa = k*GAS_INV_FAR_STEP, the temperatures T[i] at
+ * which the enthalpy (or phi) takes the values lo + i*(hi - lo)/GAS_INV_N,
+ * lo and hi being the enthalpy (phi) at GAS_INV_TLO and GAS_INV_THI, and
+ * the slopes dT/di. They are filled by gas_tables_init. */
+static GasInverse inv;
+static int inv_initialized = 0;
+
+/* Exact inverse of t2hc (phi = 0) or of the entropy function phi
+ * (phi = 1) by Newton iteration from Tg, for filling the tables */
+static double invert(const GasMix *m, double y, int phi, double Tg, double *dydT)
+{
+    double yg, dT;
+    int ii;
+
+    for (ii = 0; ii < 50; ii++) {
+        yg = phi ? entropy_phi_d(m, Tg, segment(Tg), dydT) : enthalpy_d(m, Tg, segment(Tg), dydT);
+        dT = (y - yg)/(*dydT);
+        Tg = Tg + dT;
+        if (fabs(dT) < 1e-12*Tg)
+            break;
+    }
+    if (phi)
+        entropy_phi_d(m, Tg, segment(Tg), dydT);
+    else
+        enthalpy_d(m, Tg, segment(Tg), dydT);
+    return Tg;
+}
+
+#ifdef TMATS_PROPERTIES_CONVERGED
+/* Hermite interpolation in cell i of a table row at fraction t */
+static double row_hermite(const double *T, const double *D, int i, double t)
+{
+    return ((2*t - 3)*t*t + 1)*T[i] + ((t - 2)*t + 1)*t*D[i] + (3 - 2*t)*t*t*T[i+1] + (t - 1)*t*t*D[i+1];
+}
+
+/* Temperature estimate at grid position x, x in [0, GAS_INV_N), from
+ * rows T0, D0 and T1, D1 of an inverse table with weight w on T1, D1 */
+static double inverse_guess(const double *T0, const double *D0, const double *T1, const double *D1,
+                            double w, double x)
+{
+    int i = (int)x;
+    double t = x - i;
+
+    return (1 - w)*row_hermite(T0, D0, i, t) + w*row_hermite(T1, D1, i, t);
+}
+
+/* Temperature from enthalpy: table estimate and one Newton step. Falls
+ * back to the secant iteration of h2tc outside the tables. */
+static double h2t_table(const GasMix *m, double H)
+{
+    double x = (H - m->hlo)*m->hscale;
+    double T, hg, cp;
+
+    if (m->inv_row < 0 || !(x >= 0 && x < GAS_INV_N))
+        return m->air ? h2t(m, H, 1) : h2t(m, H, 0);
+    T = inverse_guess(inv.Th[m->inv_row], inv.dTh[m->inv_row], inv.Th[m->inv_row+1],
+                      inv.dTh[m->inv_row+1], m->inv_w, x);
+    hg = enthalpy_d(m, T, segment(T), &cp);
+    return T + (H - hg)/cp;
+}
+
+/* Temperature from entropy and pressure: table estimate and one Newton
+ * step. Falls back to the secant iteration of sp2tc outside the tables. */
+static double sp2t_table(const GasMix *m, double S, double P)
+{
+    double lnP = log(P/14.696);
+    double x = (((S + 0.1841304)/m->rcas + lnP + 23.0258509)/0.5035576347 - m->philo)*m->phiscale;
+    double T, Sg, dphi;
+
+    if (m->inv_row < 0 || !(x >= 0 && x < GAS_INV_N))
+        return m->air ? sp2t(m, S, P, 1) : sp2t(m, S, P, 0);
+    T = inverse_guess(inv.Tphi[m->inv_row], inv.dTphi[m->inv_row], inv.Tphi[m->inv_row+1],
+                      inv.dTphi[m->inv_row+1], m->inv_w, x);
+    Sg = (entropy_phi_d(m, T, segment(T), &dphi)*0.5035576347-23.0258509)*m->rcas - 0.1841304 - m->rcas * lnP;
+    return T + (S - Sg)/(dphi*0.5035576347*m->rcas);
+}
+#endif
+
+/* Pure air mixture for h2tc_air and sp2tc_air, and of every gasmix with
+ * fa == 0 (all stations ahead of the burner) */
+static GasMix air_mix;
+#endif
+
+#endif /* TMATS_PROPERTIES_REFERENCE */
+
+/*------ gasmix: composition of the gas for fuel-air ratio fa ------*/
+static void composition(GasMix *m, double fa)
+{
+    double tmls, zmwtr;
+
+    m->fa = fa;
+    if (fa == 0) {
+        m->zmea = 4.7642;                    /* moles of unburned air */
+        m->zmsp = 0;                         /* moles of stoichiometric products */
+        m->tmlsr = 0.2098988288;
+        zmwtr = 0.0345194683;
+    }
+    else {
+        m->zmea = 4.7642-fa*69.69056873;     /* eqn 35 */
+        m->zmsp = fa*74.411931335;           /* eqn 38 */
+        tmls = 4.7642+fa*4.721362582;        /* eqn 39 */
+        zmwtr = tmls/(138.0148721*(1+fa));   /* eqn 42 */
+        m->tmlsr = 1/tmls;
+    }
+    m->zz = m->tmlsr*zmwtr;
+    m->rcas = 1.98587*zmwtr;
+    m->products = (fa > 0);
+    m->air = (fa == 0);
+}
+
+#ifdef TMATS_PROPERTIES_CONVERGED
+/* Position of the mixture on the inverse tables */
+static void mixture_grid(GasMix *m)
+{
+    double xf = m->fa*(1/GAS_INV_FAR_STEP);
+    double hhi, phihi;
+
+    /* rows of the inverse tables and position of fa between them */
+    if (xf >= 0 && xf <= GAS_INV_ROWS - 1) {
+        m->inv_row = (int)xf;
+        if (m->inv_row > GAS_INV_ROWS - 2)
+            m->inv_row = GAS_INV_ROWS - 2;
+        m->inv_w = xf - m->inv_row;
+    }
+    else {
+        m->inv_row = -1;
+        m->inv_w = 0;
+    }
+
+    /* grid of the mixture: range of h and phi over the tables */
+    m->hlo = enthalpy(m, GAS_INV_TLO);
+    hhi = enthalpy(m, GAS_INV_THI);
+    m->hscale = GAS_INV_N/(hhi - m->hlo);
+    m->philo = entropy_phi(m, GAS_INV_TLO);
+    phihi = entropy_phi(m, GAS_INV_THI);
+    m->phiscale = GAS_INV_N/(phihi - m->philo);
+}
+#endif
+
+void gasmix(GasMix *m, double fa)
+{
+#ifdef TMATS_PROPERTIES_CONVERGED
+    if (!inv_initialized)
+        gas_tables_init();
+
+    /* air is the gas of every station ahead of the burner, its mixture is
+     * computed once with the tables */
+    if (fa == 0) {
+        *m = air_mix;
+        return;
+    }
+    composition(m, fa);
+    mixture_grid(m);
+#else
+    composition(m, fa);
+#endif
+}
+
+/*------ gas_tables_init: fill the inverse tables of h2tc_mix and sp2tc_mix ------*/
+/* Called by gasmix on first use. Callers that evaluate the properties
+ * from several threads call it once before starting them. Only
+ * TMATS_PROPERTIES_CONVERGED builds have the tables; in other builds
+ * this does nothing. */
+void gas_tables_init(void)
+{
+#ifdef TMATS_PROPERTIES_CONVERGED
+    GasMix m;
+    double lo, hi, dy, T, dydT;
+    int k, i, phi;
+
+    if (inv_initialized)
+        return;
+    for (k = 0; k < GAS_INV_ROWS; k++) {
+        composition(&m, k*GAS_INV_FAR_STEP);
+        for (phi = 0; phi < 2; phi++) {
+            lo = phi ? entropy_phi(&m, GAS_INV_TLO) : enthalpy(&m, GAS_INV_TLO);
+            hi = phi ? entropy_phi(&m, GAS_INV_THI) : enthalpy(&m, GAS_INV_THI);
+            dy = (hi - lo)/GAS_INV_N;
+            T = GAS_INV_TLO;
+            for (i = 0; i <= GAS_INV_N; i++) {
+                T = invert(&m, lo + i*dy, phi, T, &dydT);
+                if (phi) {
+                    inv.Tphi[k][i] = T;
+                    inv.dTphi[k][i] = dy/dydT;
+                }
+                else {
+                    inv.Th[k][i] = T;
+                    inv.dTh[k][i] = dy/dydT;
+                }
+            }
+        }
+    }
+    composition(&air_mix, 0);
+    mixture_grid(&air_mix);
+    inv_initialized = 1;
+#endif
+}
+
+/*------ gas_inverse_tables: the inverse tables, for the lane routines ------*/
+const GasInverse *gas_inverse_tables(void)
+{
+#ifdef TMATS_PROPERTIES_CONVERGED
+    if (!inv_initialized)
+        gas_tables_init();
+    return &inv;
+#else
+    return 0;
+#endif
+}
+
+/*------ t2hc_mix: enthalpy from temperature ------*/
+double t2hc_mix(const GasMix *m, double T)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return t2hc(T, m->fa);
+#else
+    return m->air ? enthalpy_air(T) : enthalpy(m, T);
+#endif
+}
+
+/*------ h2tc_mix: temperature from enthalpy ------*/
+double h2tc_mix(const GasMix *m, double H)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return h2tc(H, m->fa);
+#elif defined(TMATS_PROPERTIES_CONVERGED)
+    return h2t_table(m, H);
+#else
+    return m->air ? h2t(m, H, 1) : h2t(m, H, 0);
+#endif
+}
+
+/*------ pt2sc_mix: entropy from pressure and temperature ------*/
+double pt2sc_mix(const GasMix *m, double P, double T)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return pt2sc(P, T, m->fa);
+#else
+    return m->air ? pt2s(m, P, T, 1) : pt2s(m, P, T, 0);
+#endif
+}
+
+/*------ sp2tc_mix: temperature from entropy and pressure ------*/
+double sp2tc_mix(const GasMix *m, double S, double P)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return sp2tc(S, P, m->fa);
+#elif defined(TMATS_PROPERTIES_CONVERGED)
+    return sp2t_table(m, S, P);
+#else
+    return m->air ? sp2t(m, S, P, 1) : sp2t(m, S, P, 0);
+#endif
+}
+
+/*------ Pure air (fa == 0) versions ------*/
+double t2hc_air(double T)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return t2hc(T, 0);
+#else
+    return enthalpy_air(T);
+#endif
+}
+
+double h2tc_air(double H)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return h2tc(H, 0);
+#elif defined(TMATS_PROPERTIES_CONVERGED)
+    if (!inv_initialized)
+        gas_tables_init();
+    return h2t_table(&air_mix, H);
+#else
+    return h2t(0, H, 1);
+#endif
+}
+
+double pt2sc_air(double P, double T)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return pt2sc(P, T, 0);
+#else
+    return pt2s(0, P, T, 1);
+#endif
+}
+
+double sp2tc_air(double S, double P)
+{
+#ifdef TMATS_PROPERTIES_REFERENCE
+    return sp2tc(S, P, 0);
+#elif defined(TMATS_PROPERTIES_CONVERGED)
+    if (!inv_initialized)
+        gas_tables_init();
+    return sp2t_table(&air_mix, S, P);
+#else
+    return sp2t(0, S, P, 1);
+#endif
+}
+
+/*------ h2tc_from: temperature from enthalpy, started at T1 ------*/
+/* Newton iteration on t2hc with the analytic cp of the polynomials,
+ * started from a temperature T1 close to the solution (for example the
+ * inlet temperature of the component) instead of the cold guess of h2tc.
+ * Converges to |H - t2hc(T)| < 1e-6 before the last step. Without
+ * TMATS_PROPERTIES_CONVERGED this is h2tc_mix, T1 is not used. */
+double h2tc_from(const GasMix *m, double H, double T1)
+{
+#ifdef TMATS_PROPERTIES_CONVERGED
+    double hg, cp;
+
+    return h2t_newton(m, H, T1, &hg, &cp);
+#else
+    (void)T1;
+    return h2tc_mix(m, H);
+#endif
+}
+
+/*------ sp2tc_from: temperature from entropy and pressure, started from a known state ------*/
+/* Newton iteration on pt2sc started from the ideal gas isentrope through
+ * a state (T1, P1) of about the same entropy S, instead of the cold guess
+ * of sp2tc. Converges to |S - pt2sc(P, T)| < 1e-7 before the last step.
+ * Without TMATS_PROPERTIES_CONVERGED this is sp2tc_mix. */
+double sp2tc_from(const GasMix *m, double S, double P, double T1, double P1)
+{
+#ifdef TMATS_PROPERTIES_CONVERGED
+    double cp1;
+
+    enthalpy_d(m, T1, segment(T1), &cp1);
+    return sp2t_newton(m, S, P, isentrope_guess(m, T1, P1, cp1, P));
+#else
+    (void)T1; (void)P1;
+    return sp2tc_mix(m, S, P);
+#endif
+}
+
+/*------ isentropic_mix: compression or expansion from (Tt, Pt) to PtOut ------*/
+/* Fused form of the chain
+ *     ht = t2hc(Tt), S = pt2sc(Pt, Tt), TtIdeal = sp2tc(S, PtOut),
+ *     htIdeal = t2hc(TtIdeal), htOut from eff, TtOut = h2tc(htOut)
+ * of the compressor and turbine bodies. The inlet enthalpy, entropy and cp
+ * come from one segment lookup, the ideal exit temperature is started
+ * from the ideal gas isentrope and the actual one from the ideal exit
+ * state. Without TMATS_PROPERTIES_CONVERGED the chain itself is evaluated
+ * with the *_mix routines. eff is applied as htOut = ht + (htIdeal - ht)/eff
+ * (compression) or ht + (htIdeal - ht)*eff (expansion != 0). */
+void isentropic_mix(const GasMix *m, double Tt, double Pt, double PtOut, double eff, int expansion,
+                    double *ht, double *S, double *TtIdeal, double *htIdeal, double *TtOut, double *htOut)
+{
+#ifdef TMATS_PROPERTIES_CONVERGED
+    double cp, dphi, hg;
+    int it = segment(Tt);
+
+    *ht = enthalpy_d(m, Tt, it, &cp);
+    *S = (entropy_phi_d(m, Tt, it, &dphi)*0.5035576347-23.0258509)*m->rcas - 0.1841304 - m->rcas * log(Pt/14.696);
+    *TtIdeal = sp2t_newton(m, *S, PtOut, isentrope_guess(m, Tt, Pt, cp, PtOut));
+    *htIdeal = enthalpy_d(m, *TtIdeal, segment(*TtIdeal), &cp);
+#else
+    *ht = t2hc_mix(m, Tt);
+    *S = pt2sc_mix(m, Pt, Tt);
+    *TtIdeal = sp2tc_mix(m, *S, PtOut);
+    *htIdeal = t2hc_mix(m, *TtIdeal);
+#endif
+
+    if (expansion)
+        *htOut = ((*htIdeal - *ht)*eff) + *ht;
+    else
+        *htOut = ((*htIdeal - *ht)*divby(eff)) + *ht;
+
+#ifdef TMATS_PROPERTIES_CONVERGED
+    *TtOut = h2t_newton(m, *htOut, *TtIdeal + (*htOut - *htIdeal)/cp, &hg, &cp);
+#else
+    *TtOut = h2tc_mix(m, *htOut);
+#endif
+}
+
+/*------ PcalcStat_mix: PcalcStat on a precomputed mixture ------*/
+void PcalcStat_mix(const GasMix *m, double Pt, double Ps, double Tt, double ht, double Rt,
+                   double *S, double *Ts, double *hs, double *rhos, double *V)
+{
+    double Rs;
+
+    /* Compute entropy */
+    *S = pt2sc_mix(m, Pt, Tt);
+    /* Compute Static Temperature */
+    *Ts = sp2tc_mix(m, *S, Ps);
+    if (*Ts > Tt) {
+        *Ts = Tt;
+    }
+    /* Compute static enthalpy */
+    *hs = t2hc_mix(m, *Ts);
+    if (*hs > ht) {
+        *hs = ht;
+    }
+    /* Assume Rt = Rs */
+    Rs = Rt;
+    /* Compute static rho */
+    *rhos = Ps * C_PSItoPSF*divby(Rs* *Ts * JOULES_CONST);
+    /* Compute Velocity */
+    *V = sqrtT(2 * (ht - *hs)*C_GRAVITY*JOULES_CONST);
+}
+
+/*------ static_state: total state of a static pressure search ------*/
+/* StaticCalc and the nozzle search for the static pressure Ps at which
+ * the flow meets a Mach number or an area, evaluating PcalcStat at every
+ * iterate with the same total conditions. static_state computes what
+ * depends on those only (the entropy, and the entropy function phi it
+ * fixes at 14.696 psia) once; PcalcStat_state then gives the static
+ * conditions at Ps:
+ *
+ *     static_state(&ss, &mix, Pt, Tt, ht, Rt);
+ *     PcalcStat_state(&ss, Ps, &Ts, &hs, &rhos, &V);
+ *
+ * Without TMATS_PROPERTIES_CONVERGED the static temperature is
+ * sp2tc_mix(m, S, Ps), as in PcalcStat_mix. With it, the static
+ * temperature is started from that of the previous call:
+ * phi(Ts) = phiS + ln(Ps/14.696)/0.5035576347, so the previous Ts and
+ * the change in ln(Ps) predict the new Ts to first order. When the
+ * prediction moves Ts by less than STATE_WARM_DT it replaces the table
+ * estimate of sp2tc_mix ahead of the Newton step; the prediction error,
+ * about dT^2/(2T), is then below 0.02 degR and the Newton step leaves
+ * less than 1e-7 degR. Larger steps (the first iterates of a search) take
+ * the table estimate. */
+#define STATE_WARM_DT 5.0
+
+void static_state(StaticState *ss, const GasMix *m, double Pt, double Tt, double ht, double Rt)
+{
+    ss->m = m;
+    ss->Pt = Pt;
+    ss->Tt = Tt;
+    ss->ht = ht;
+    ss->Rt = Rt;
+    ss->S = pt2sc_mix(m, Pt, Tt);
+    ss->phiS = ((ss->S + 0.1841304)/m->rcas + 23.0258509)/0.5035576347;
+    ss->warm = 0;
+    ss->Ts = ss->phi = ss->dphi = 0;
+}
+
+#ifdef TMATS_PROPERTIES_CONVERGED
+/* Static temperature at Ps on the entropy of the state */
+static double sp2t_state(StaticState *ss, double Ps)
+{
+    const GasMix *m = ss->m;
+    double phit = ss->phiS + log(Ps/14.696)/0.5035576347;
+    double T = 0, x, phig, dphi;
+
+    if (ss->warm) {
+        T = ss->Ts + (phit - ss->phi)/ss->dphi;
+        if (!(fabs(T - ss->Ts) < STATE_WARM_DT))
+            ss->warm = 0;
+    }
+    if (!ss->warm) {
+        x = (phit - m->philo)*m->phiscale;
+        if (m->inv_row < 0 || !(x >= 0 && x < GAS_INV_N))
+            return m->air ? sp2t(m, ss->S, Ps, 1) : sp2t(m, ss->S, Ps, 0);
+        T = inverse_guess(inv.Tphi[m->inv_row], inv.dTphi[m->inv_row], inv.Tphi[m->inv_row+1],
+                          inv.dTphi[m->inv_row+1], m->inv_w, x);
+    }
+    phig = entropy_phi_d(m, T, segment(T), &dphi);
+    T = T + (phit - phig)/dphi;
+
+    ss->warm = 1;
+    ss->Ts = T;
+    ss->phi = phit;
+    ss->dphi = dphi;
+    return T;
+}
+#endif
+
+/*------ PcalcStat_state: PcalcStat at Ps for the total state ss ------*/
+/* Same outputs as PcalcStat_mix(m, Pt, Ps, Tt, ht, Rt, ...) but the
+ * entropy, which is ss->S */
+void PcalcStat_state(StaticState *ss, double Ps, double *Ts, double *hs, double *rhos, double *V)
+{
+    double Rs;
+
+    /* Compute Static Temperature */
+#ifdef TMATS_PROPERTIES_CONVERGED
+    *Ts = sp2t_state(ss, Ps);
+#else
+    *Ts = sp2tc_mix(ss->m, ss->S, Ps);
+#endif
+    if (*Ts > ss->Tt) {
+        *Ts = ss->Tt;
+    }
+    /* Compute static enthalpy */
+    *hs = t2hc_mix(ss->m, *Ts);
+    if (*hs > ss->ht) {
+        *hs = ss->ht;
+    }
+    /* Assume Rt = Rs */
+    Rs = ss->Rt;
+    /* Compute static rho */
+    *rhos = Ps * C_PSItoPSF*divby(Rs* *Ts * JOULES_CONST);
+    /* Compute Velocity */
+    *V = sqrtT(2 * (ss->ht - *hs)*C_GRAVITY*JOULES_CONST);
+}
+
+/*------ static_state_slope: dTs/dPs and dhs/dPs at the last PcalcStat_state ------*/
+/* Along the entropy of the state dphi = dPs/(0.5035576347*Ps), so
+ * dTs/dPs = 1/(0.5035576347*Ps*dphi/dT) and dhs/dPs = cp*dTs/dPs.
+ * Returns 0 and leaves dTs and dhs untouched when the slope at Ps is not
+ * known: in builds without TMATS_PROPERTIES_CONVERGED, after a static
+ * temperature outside the inverse tables and where Ts is limited to Tt. */
+int static_state_slope(const StaticState *ss, double Ps, double *dTs, double *dhs)
+{
+#ifdef TMATS_PROPERTIES_CONVERGED
+    double cp;
+
+    if (!ss->warm || !(ss->Ts < ss->Tt))
+        return 0;
+    enthalpy_d(ss->m, ss->Ts, segment(ss->Ts), &cp);
+    *dTs = 1/(0.5035576347*Ps*ss->dphi);
+    *dhs = cp* *dTs;
+    return 1;
+#else
+    (void)ss; (void)Ps; (void)dTs; (void)dhs;
+    return 0;
+#endif
+}
@@ -0,0 +1,813 @@
+/*		T-MATS -- properties_TMATS_lanes.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Lane versions of the gas property routines t2hc, h2tc, pt2sc, sp2tc and
+%  PcalcStat. Each routine evaluates AGTF30_LANES independent points and
+%  performs, for every lane, the same floating point operations as the
+%  scalar routine on a GasMix (t2hc_mix, ... in properties_TMATS.c), so
+%  results match the scalar routines point for point.
+%
+%  Differences in form only:
+%  - the segment index "integer part of T/100" is formed without fmod so
+%    that the lane loops contain no library calls,
+%  - log(P/14.696) in sp2tc is evaluated once instead of every iteration.
+%
+%  h2tc_from_lanes, sp2tc_from_lanes, isentropic_lanes, static_state_lanes,
+%  PcalcStat_state_lanes and static_state_slope_lanes are the lane versions
+%  of h2tc_from, sp2tc_from, isentropic_mix, static_state, PcalcStat_state
+%  and static_state_slope (properties_TMATS.c) and follow
+%  TMATS_PROPERTIES_CONVERGED and TMATS_PROPERTIES_REFERENCE in the same
+%  way.
+%
+%  t2hc_array, h2tc_array, pt2sc_array and sp2tc_array evaluate arrays of
+%  any length by lane groups (MEX_gas_properties.c).
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_lanes.h"
+
+/*--------Gas property tables (same values as t2hc, h2tc, pt2sc, sp2tc)----------*/
+static const int ITAB[60] = {1,1,1,2,3,3,4,4,4,5,5,5,5,6,6,6,6,6,7,7,7,7,7,7,
+         8,8,8,8,8,8,9,9,9,9,9,9,10,10,10,10,10,10,10,10,
+         11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11};
+static const double TTTAB[11] = {300,400,500,700,1000,1400,1900,2500,3100,3700,4500};
+static const double AHAIR[11] = {2.074402000000e3,2.767580000000e3,3.461230000000e3,
+         4.854285000000e3,6.981156000000e3,9.933801000000e3,
+         1.382117000000e4,1.870811000000e4,2.375618000000e4,
+         2.891518000000e4,3.591874000000e4};
+static const double BHAIR[11] = {6.930375143000e0,6.933262304370e0,6.941415639521e0,
+         6.999806554132e0,7.201291270059e0,7.564016167549e0,
+         7.965574033453e0,8.298411651745e0,8.515829359567e0,
+         8.673620909986e0,8.825346607306e0};
+static const double CHAIR[11] = {1.327409630363e-5,1.559751739222e-5,6.593583412638e-5,
+         2.260187389251e-4,4.455969808316e-4,4.612152628951e-4,
+         3.419004689130e-4,2.128288949057e-4,1.495339514650e-4,
+         1.134519659006e-4,7.620515574828e-5};
+static const double DHAIR[11] = {7.744736961966e-9,1.677943891139e-7,2.668048413312e-7,
+         2.439758243406e-7,1.301523505289e-8,-7.954319598805e-8,
+         -7.170643000405e-8,-3.51638574671e-8,-2.004554753575e-8,
+         -1.551950423014e-8,2.007781800899e-22};
+static const double AHSTOC[11] = {2.116286000000e3,2.831822000000e3,3.556413000000e3,
+         5.033766000000e3,7.326000000000e3,1.054811000000e4,
+         1.483580000000e4,2.028520000000e4,2.596610000000e4,
+         3.180568000000e4,3.976139000000e4};
+static const double BHSTOC[11] = {7.113538900000e0,7.199470008152e0,7.292391067390e0,
+         7.482468579354e0,7.811853002145e0,8.297006217518e0,
+         8.832077018487e0,9.300821657633e0,9.616136350979e0,
+         9.837032938452e0,1.003677698592e1};
+static const double CHSTOC[11] = {3.953219184767e-4,4.639891630481e-4,4.652214293286e-4,
+         4.851661304903e-4,6.127819454796e-4,6.001010929530e-4,
+         4.700405089856e-4,3.112005562576e-4,2.143239326515e-4,
+         1.538370464703e-4,9.584301286375e-5};
+static const double DHSTOC[11] = {2.288908152379e-7,4.107554268465e-9,3.324116860284e-8,
+         1.417953499881e-7,-1.056737710548e-8,-8.670705597826e-8,
+         -8.824441818226e-8,-5.382034644785e-8,-3.360382565619e-8,
+         -2.416418066940e-8,6.080973759837e-15};
+static const double APAIR[11] = {4.229854000000e1,4.429218000000e1,4.584067000000e1,
+         4.818303000000e1,5.070949000000e1,5.318950000000e1,
+         5.556056000000e1,5.779398000000e1,5.960312000000e1,
+         6.112402000000e1,6.283719000000e1};
+static const double BPAIR[11] = {2.305525000000e-2,1.732687898835e-2,1.390113404660e-2,
+         9.984237743689e-3,7.194810211645e-3,5.398110354070e-3,
+         4.191444392129e-3,3.318644249749e-3,2.746778608874e-3,
+         2.344441314755e-3,1.960623219312e-3};
+static const double CPAIR[11] = {-3.628178988352e-5,-2.100192023298e-5,
+         -1.325552918449e-5,-6.328952330080e-6,-2.969139443401e-6,
+         -1.522610200538e-6,-8.907217233446e-7,-5.639451806208e-7,
+         -3.891642208381e-7,-2.813979360273e-7,-1.983746832756e-7};
+static const double DPAIR[11] = {5.093289883514e-8,2.582130349498e-8,1.154429475734e-8,
+         3.733125429643e-9,1.205441035719e-9,4.212589847953e-10,
+         1.815425237354e-10,9.710053321261e-11,5.987015822823e-11,
+         3.459302197988e-11,2.445751324881e-11};
+static const double APSTOC[11] = {4.208565000000e1,4.414325000000e1,4.576019000000e1,
+         4.824312000000e1,5.096532000000e1,5.367114000000e1,
+         5.628635000000e1,5.877705000000e1,6.081328000000e1,
+         6.253552000000e1,6.448296000000e1};
+static const double BPSTOC[11] = {2.361110000000e-2,1.800764547338e-2,1.459451810646e-2,
+         1.067795041447e-2,7.806395767972e-3,5.922535863503e-3,
+         4.648916404273e-3,3.720736784998e-3,3.102786455737e-3,
+         2.660467392055e-3,2.231936896092e-3};
+static const double CPSTOC[11] = {-3.50184547338e-5,-2.10160905323e-5,-1.31151831369e-5,
+         -6.467655323031e-6,-3.104193498621e-6,-1.605456262554e-6,
+         -9.417826559062e-7,-6.051833762187e-7,-4.247338392160e-7,
+         -3.124646002534e-7,-2.231985197004e-7};
+static const double DPSTOC[11] = {4.667454733830e-8,2.633635798468e-8,1.107921302316e-8,
+         3.737179804900e-9,1.248947696722e-9,4.424490710984e-10,
+         1.869995998264e-10,1.002497427793e-10,6.237179942365e-11,
+         3.719420023041e-11,2.698623281668e-11};
+
+/* Table segment for temperature T; same result as the ITAB lookup on the
+ * integer part of 0.01*(T - fmod(T,100)) used by the scalar routines */
+static int seg_index(double T)
+{
+    double Tc;
+    int k;
+
+    Tc = (T > 0) ? T : 0;       /* also maps NaN to the first segment */
+    Tc = (Tc < 6100) ? Tc : 6100;
+    k = (int)(Tc * 0.01);
+    if (k * 100.0 > Tc)
+        k = k - 1;
+    else if ((k + 1) * 100.0 <= Tc)
+        k = k + 1;
+    k = (k > 1) ? k : 1;
+    k = (k < 60) ? k : 60;
+    return ITAB[k - 1] - 1;
+}
+
+/* Mole fractions of the combustion products for fuel-air ratio fa */
+static void mixture(double fa, double *zmea, double *zmsp, double *tmlsr, double *zmwtr)
+{
+    double tmls;
+
+    if (fa == 0) {
+        *zmea = 4.7642;
+        *zmsp = 0;
+        *tmlsr = 0.2098988288;
+        *zmwtr = 0.0345194683;
+    }
+    else {
+        tmls = 4.7642+fa*4.721362582;
+        *zmea = 4.7642-fa*69.69056873;
+        *zmsp = fa*74.411931335;
+        *zmwtr = tmls/(138.0148721*(1+fa));
+        *tmlsr = 1/tmls;
+    }
+}
+
+/* Enthalpy of air/combustion products from the H tables at temperature T */
+static double enthalpy(double T, double fa, double zmea, double zmsp, double zz)
+{
+    int it = seg_index(T);
+    double dl = T - TTTAB[it];
+    double hgea = ((DHAIR[it]*dl + CHAIR[it])*dl + BHAIR[it])*dl + AHAIR[it];
+    double hgsp = 0;
+
+    if (fa > 0)
+        hgsp = ((DHSTOC[it]*dl + CHSTOC[it])*dl + BHSTOC[it])*dl + AHSTOC[it];
+    return (hgsp*zmsp + hgea*zmea)*zz;
+}
+
+/* Entropy function phi from the P tables at temperature T */
+static double entropy_phi(double T, double fa, double zmea, double zmsp, double tmlsr)
+{
+    int it = seg_index(T);
+    double dl = T - TTTAB[it];
+    double phiea = ((DPAIR[it]*dl + CPAIR[it])*dl + BPAIR[it])*dl + APAIR[it];
+    double phisp = 0;
+
+    if (fa > 0)
+        phisp = ((DPSTOC[it]*dl + CPSTOC[it])*dl + BPSTOC[it])*dl + APSTOC[it];
+    return (phisp*zmsp + phiea*zmea)*tmlsr;
+}
+
+#ifdef TMATS_PROPERTIES_CONVERGED
+/* Enthalpy of air/combustion products at temperature T and its
+ * derivative cp = dh/dT (enthalpy_d in properties_TMATS.c) */
+static double enthalpy_d(double T, double fa, double zmea, double zmsp, double zz, double *cp)
+{
+    int it = seg_index(T);
+    double dl = T - TTTAB[it];
+    double hgea = ((DHAIR[it]*dl + CHAIR[it])*dl + BHAIR[it])*dl + AHAIR[it];
+    double dhgea = (3*DHAIR[it]*dl + 2*CHAIR[it])*dl + BHAIR[it];
+    double hgsp = 0, dhgsp = 0;
+
+    if (fa > 0) {
+        hgsp = ((DHSTOC[it]*dl + CHSTOC[it])*dl + BHSTOC[it])*dl + AHSTOC[it];
+        dhgsp = (3*DHSTOC[it]*dl + 2*CHSTOC[it])*dl + BHSTOC[it];
+    }
+    *cp = (dhgsp*zmsp + dhgea*zmea)*zz;
+    return (hgsp*zmsp + hgea*zmea)*zz;
+}
+
+/* Entropy function phi at temperature T and dphi/dT (entropy_phi_d in
+ * properties_TMATS.c) */
+static double entropy_phi_d(double T, double fa, double zmea, double zmsp, double tmlsr, double *dphi)
+{
+    int it = seg_index(T);
+    double dl = T - TTTAB[it];
+    double phiea = ((DPAIR[it]*dl + CPAIR[it])*dl + BPAIR[it])*dl + APAIR[it];
+    double dphiea = (3*DPAIR[it]*dl + 2*CPAIR[it])*dl + BPAIR[it];
+    double phisp = 0, dphisp = 0;
+
+    if (fa > 0) {
+        phisp = ((DPSTOC[it]*dl + CPSTOC[it])*dl + BPSTOC[it])*dl + APSTOC[it];
+        dphisp = (3*DPSTOC[it]*dl + 2*CPSTOC[it])*dl + BPSTOC[it];
+    }
+    *dphi = (dphisp*zmsp + dphiea*zmea)*tmlsr;
+    return (phisp*zmsp + phiea*zmea)*tmlsr;
+}
+
+/* Newton iteration on enthalpy from Tg (h2t_newton in properties_TMATS.c).
+ * Each lane stops once its own residual is below the tolerance. */
+static void h2t_newton_lanes(double *Tg, const double *H, const double *fa, const double *zmea,
+                             const double *zmsp, const double *zz)
+{
+    int run[AGTF30_LANES];
+    double hg, cp;
+    int l, ii, any;
+
+    for (l = 0; l < AGTF30_LANES; l++)
+        run[l] = 1;
+
+    for (ii = 0; ii < 11; ii++) {
+        any = 0;
+        for (l = 0; l < AGTF30_LANES; l++) {
+            hg = enthalpy_d(Tg[l], fa[l], zmea[l], zmsp[l], zz[l], &cp);
+            if (run[l]) {
+                Tg[l] = Tg[l] + (H[l] - hg)/cp;
+                run[l] = !(fabs(H[l] - hg) < 1e-6);
+            }
+            any |= run[l];
+        }
+        if (!any)
+            break;
+    }
+}
+
+/* Newton iteration on entropy from Tg (sp2t_newton in properties_TMATS.c) */
+static void sp2t_newton_lanes(double *Tg, const double *S, const double *P, const double *fa,
+                              const double *zmea, const double *zmsp, const double *tmlsr, const double *rcas)
+{
+    double lnP[AGTF30_LANES];
+    int run[AGTF30_LANES];
+    double dphi, Sg;
+    int l, jj, any;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        lnP[l] = log(P[l]/14.696);
+        run[l] = 1;
+    }
+
+    for (jj = 0; jj < 10; jj++) {
+        any = 0;
+        for (l = 0; l < AGTF30_LANES; l++) {
+            Sg = (entropy_phi_d(Tg[l], fa[l], zmea[l], zmsp[l], tmlsr[l], &dphi)*0.5035576347-23.0258509)*rcas[l]
+                 - 0.1841304 - rcas[l] * lnP[l];
+            if (run[l]) {
+                Tg[l] = Tg[l] + (S[l] - Sg)/(dphi*0.5035576347*rcas[l]);
+                run[l] = !(fabs(S[l] - Sg) < 1e-7);
+            }
+            any |= run[l];
+        }
+        if (!any)
+            break;
+    }
+}
+#endif
+
+/*------ t2hc: enthalpy from temperature ------*/
+void t2hc_lanes(double *H, const double *T, const double *fa)
+{
+    double zmea, zmsp, tmlsr, zmwtr;
+    int l;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea, &zmsp, &tmlsr, &zmwtr);
+        H[l] = enthalpy(T[l], fa[l], zmea, zmsp, tmlsr*zmwtr);
+    }
+}
+
+/*------ h2tc: temperature from enthalpy (secant iteration) ------*/
+static void h2t_secant_lanes(double *T, const double *H, const double *fa)
+{
+    double zmea[AGTF30_LANES], zmsp[AGTF30_LANES], zz[AGTF30_LANES];
+    double tg[AGTF30_LANES], tgo[AGTF30_LANES], hgo[AGTF30_LANES], hh[AGTF30_LANES];
+    double tmlsr, zmwtr, hg, hhn, d;
+    int l, ii, active, any;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea[l], &zmsp[l], &tmlsr, &zmwtr);
+        zz[l] = tmlsr*zmwtr;
+        tg[l] = 3.55*H[l];
+        tgo[l] = 1;
+        hgo[l] = 0.282;
+        hh[l] = 99.99;
+    }
+
+    for (ii = 0; ii < 11; ii++) {
+        any = 0;
+        for (l = 0; l < AGTF30_LANES; l++)
+            any |= (fabs(hh[l]) > 1e-3);
+        if (!any)
+            break;
+
+        for (l = 0; l < AGTF30_LANES; l++) {
+            active = (fabs(hh[l]) > 1e-3);
+            hg = enthalpy(tg[l], fa[l], zmea[l], zmsp[l], zz[l]);
+            hhn = H[l] - hg;
+            d = (tg[l] - tgo[l])/(hg - hgo[l]);
+            if (active) {
+                tgo[l] = tg[l];
+                hgo[l] = hg;
+                tg[l] = tg[l] + d*hhn;
+                hh[l] = hhn;
+            }
+        }
+    }
+
+    for (l = 0; l < AGTF30_LANES; l++)
+        T[l] = tg[l];
+}
+
+/*------ pt2sc: entropy from pressure and temperature ------*/
+void pt2sc_lanes(double *S, const double *P, const double *T, const double *fa)
+{
+    double lnP[AGTF30_LANES];
+    double zmea, zmsp, tmlsr, zmwtr, rcas, phig;
+    int l;
+
+    for (l = 0; l < AGTF30_LANES; l++)
+        lnP[l] = log(P[l]/14.696);
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea, &zmsp, &tmlsr, &zmwtr);
+        phig = entropy_phi(T[l], fa[l], zmea, zmsp, tmlsr);
+        rcas = 1.98587*zmwtr;
+        S[l] = (phig*0.5035576347-23.0258509)*rcas - 0.1841304 - rcas * lnP[l];
+    }
+}
+
+/*------ sp2tc: temperature from entropy and pressure (secant iteration) ------*/
+/* Lanes with active[l] == 0 are not iterated past the two iterations every
+ * lane takes; active may be NULL when all lanes are wanted. */
+static void sp2t_secant_lanes(double *T, const double *S, const double *P, const double *fa, const int *active)
+{
+    double zmea[AGTF30_LANES], zmsp[AGTF30_LANES], tmlsr[AGTF30_LANES], rcas[AGTF30_LANES], lnP[AGTF30_LANES];
+    double Tg[AGTF30_LANES], Sg[AGTF30_LANES], Tg1[AGTF30_LANES], Sg1[AGTF30_LANES];
+    int    run[AGTF30_LANES];
+    double zmwtr, Sgn, dTdS;
+    double Stol = 1e-4;
+    int Jmax = 10;
+    int l, jj, any;
+
+    for (l = 0; l < AGTF30_LANES; l++)
+        lnP[l] = log(P[l]/14.696);
+
+    /*---- guess starting temperature ----------------*/
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea[l], &zmsp[l], &tmlsr[l], &zmwtr);
+        rcas[l] = 1.98587*zmwtr;
+        Tg[l] = 1000;
+        Sg[l] = 1e3;
+        Tg1[l] = 0;
+        Sg1[l] = 0;
+        run[l] = 1;
+    }
+
+    /* At least two iterations are taken by every lane, as in sp2tc */
+    for (jj = 0; jj < Jmax; jj++) {
+        if (jj >= 2) {
+            any = 0;
+            for (l = 0; l < AGTF30_LANES; l++) {
+                run[l] = (fabs(S[l] - Sg[l]) >= Stol) && (active == 0 || active[l]);
+                any |= run[l];
+            }
+            if (!any)
+                break;
+        }
+
+        for (l = 0; l < AGTF30_LANES; l++) {
+            Sgn = (entropy_phi(Tg[l], fa[l], zmea[l], zmsp[l], tmlsr[l])*0.5035576347-23.0258509)*rcas[l]
+                  - 0.1841304 - rcas[l] * lnP[l];
+            if (jj == 0) {
+                Sg1[l] = Sgn;
+                Tg1[l] = Tg[l];
+                Tg[l] = Tg1[l] + 50;
+                Sg[l] = Sgn;
+            }
+            else {
+                dTdS = (Tg[l] - Tg1[l])/(Sgn - Sg1[l]);
+                if (run[l]) {
+                    Tg1[l] = Tg[l];
+                    Sg1[l] = Sgn;
+                    Tg[l] = Tg[l] + (S[l] - Sgn)*dTdS;
+                    Sg[l] = Sgn;
+                }
+            }
+        }
+    }
+
+    for (l = 0; l < AGTF30_LANES; l++)
+        T[l] = Tg[l];
+}
+
+#ifdef TMATS_PROPERTIES_CONVERGED
+/* Hermite interpolation in cell i of an inverse table row (row_hermite in
+ * properties_TMATS.c) */
+static double row_hermite(const double *T, const double *D, int i, double t)
+{
+    return ((2*t - 3)*t*t + 1)*T[i] + ((t - 2)*t + 1)*t*D[i] + (3 - 2*t)*t*t*T[i+1] + (t - 1)*t*t*D[i+1];
+}
+
+/* Inverse table row below fa and weight of the next row, as in gasmix;
+ * returns -1 outside the tables */
+static int inverse_row(double fa, double *w)
+{
+    double xf = fa*(1/GAS_INV_FAR_STEP);
+    int k;
+
+    if (!(xf >= 0 && xf <= GAS_INV_ROWS - 1)) {
+        *w = 0;
+        return -1;
+    }
+    k = (int)xf;
+    if (k > GAS_INV_ROWS - 2)
+        k = GAS_INV_ROWS - 2;
+    *w = xf - k;
+    return k;
+}
+#endif
+
+/*------ h2tc: temperature from enthalpy ------*/
+/* Table estimate and one Newton step, as h2tc_mix; lanes outside the
+ * tables take the secant iteration, as do all lanes of builds without
+ * TMATS_PROPERTIES_CONVERGED */
+void h2tc_lanes(double *T, const double *H, const double *fa)
+{
+#ifndef TMATS_PROPERTIES_CONVERGED
+    h2t_secant_lanes(T, H, fa);
+#else
+    const GasInverse *inv = gas_inverse_tables();
+    double Tsec[AGTF30_LANES];
+    int out[AGTF30_LANES];
+    double zmea, zmsp, tmlsr, zmwtr, zz, w, hlo, x, t, Tg, hg, cp;
+    int l, k, i, any = 0;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea, &zmsp, &tmlsr, &zmwtr);
+        zz = tmlsr*zmwtr;
+        k = inverse_row(fa[l], &w);
+        hlo = enthalpy(GAS_INV_TLO, fa[l], zmea, zmsp, zz);
+        x = (H[l] - hlo)*(GAS_INV_N/(enthalpy(GAS_INV_THI, fa[l], zmea, zmsp, zz) - hlo));
+        out[l] = (k < 0 || !(x >= 0 && x < GAS_INV_N));
+        any |= out[l];
+        if (out[l]) {
+            T[l] = 0;
+            continue;
+        }
+        i = (int)x;
+        t = x - i;
+        Tg = (1 - w)*row_hermite(inv->Th[k], inv->dTh[k], i, t) + w*row_hermite(inv->Th[k+1], inv->dTh[k+1], i, t);
+        hg = enthalpy_d(Tg, fa[l], zmea, zmsp, zz, &cp);
+        T[l] = Tg + (H[l] - hg)/cp;
+    }
+
+    if (any) {
+        h2t_secant_lanes(Tsec, H, fa);
+        for (l = 0; l < AGTF30_LANES; l++)
+            if (out[l])
+                T[l] = Tsec[l];
+    }
+#endif
+}
+
+/*------ sp2tc: temperature from entropy and pressure ------*/
+/* Table estimate and one Newton step, as sp2tc_mix; lanes outside the
+ * tables take the secant iteration, as do all lanes of builds without
+ * TMATS_PROPERTIES_CONVERGED, for which active is as in sp2t_secant_lanes */
+void sp2tc_lanes(double *T, const double *S, const double *P, const double *fa, const int *active)
+{
+#ifndef TMATS_PROPERTIES_CONVERGED
+    sp2t_secant_lanes(T, S, P, fa, active);
+#else
+    const GasInverse *inv = gas_inverse_tables();
+    double Tsec[AGTF30_LANES];
+    int out[AGTF30_LANES];
+    double zmea, zmsp, tmlsr, zmwtr, rcas, lnP, w, philo, x, t, Tg, Sg, dphi;
+    int l, k, i, any = 0;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea, &zmsp, &tmlsr, &zmwtr);
+        rcas = 1.98587*zmwtr;
+        lnP = log(P[l]/14.696);
+        k = inverse_row(fa[l], &w);
+        philo = entropy_phi(GAS_INV_TLO, fa[l], zmea, zmsp, tmlsr);
+        x = (((S[l] + 0.1841304)/rcas + lnP + 23.0258509)/0.5035576347 - philo)
+            *(GAS_INV_N/(entropy_phi(GAS_INV_THI, fa[l], zmea, zmsp, tmlsr) - philo));
+        out[l] = (k < 0 || !(x >= 0 && x < GAS_INV_N));
+        any |= out[l];
+        if (out[l]) {
+            T[l] = 0;
+            continue;
+        }
+        i = (int)x;
+        t = x - i;
+        Tg = (1 - w)*row_hermite(inv->Tphi[k], inv->dTphi[k], i, t)
+             + w*row_hermite(inv->Tphi[k+1], inv->dTphi[k+1], i, t);
+        Sg = (entropy_phi_d(Tg, fa[l], zmea, zmsp, tmlsr, &dphi)*0.5035576347-23.0258509)*rcas - 0.1841304 - rcas * lnP;
+        T[l] = Tg + (S[l] - Sg)/(dphi*0.5035576347*rcas);
+    }
+
+    if (any) {
+        sp2t_secant_lanes(Tsec, S, P, fa, active);
+        for (l = 0; l < AGTF30_LANES; l++)
+            if (out[l])
+                T[l] = Tsec[l];
+    }
+#endif
+}
+
+/*------ h2tc_from: temperature from enthalpy, started at T1 ------*/
+void h2tc_from_lanes(double *T, const double *H, const double *fa, const double *T1)
+{
+#ifndef TMATS_PROPERTIES_CONVERGED
+    (void)T1;
+    h2tc_lanes(T, H, fa);
+#else
+    double zmea[AGTF30_LANES], zmsp[AGTF30_LANES], zz[AGTF30_LANES];
+    double tmlsr, zmwtr;
+    int l;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea[l], &zmsp[l], &tmlsr, &zmwtr);
+        zz[l] = tmlsr*zmwtr;
+        T[l] = T1[l];
+    }
+    h2t_newton_lanes(T, H, fa, zmea, zmsp, zz);
+#endif
+}
+
+/*------ sp2tc_from: temperature from entropy and pressure, started from (T1, P1) ------*/
+void sp2tc_from_lanes(double *T, const double *S, const double *P, const double *fa,
+                      const double *T1, const double *P1)
+{
+#ifndef TMATS_PROPERTIES_CONVERGED
+    (void)T1; (void)P1;
+    sp2tc_lanes(T, S, P, fa, 0);
+#else
+    double zmea[AGTF30_LANES], zmsp[AGTF30_LANES], tmlsr[AGTF30_LANES], rcas[AGTF30_LANES];
+    double zmwtr, cp1;
+    int l;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea[l], &zmsp[l], &tmlsr[l], &zmwtr);
+        rcas[l] = 1.98587*zmwtr;
+        enthalpy_d(T1[l], fa[l], zmea[l], zmsp[l], tmlsr[l]*zmwtr, &cp1);
+        T[l] = T1[l]*exp(rcas[l]*log(P[l]/P1[l])/cp1);
+    }
+    sp2t_newton_lanes(T, S, P, fa, zmea, zmsp, tmlsr, rcas);
+#endif
+}
+
+/*------ isentropic: compression or expansion from (Tt, Pt) to PtOut ------*/
+/* Lane version of isentropic_mix; eff is applied as a divisor unless
+ * expansion != 0 */
+void isentropic_lanes(const double *Tt, const double *Pt, const double *PtOut, const double *fa,
+                      const double *eff, int expansion, double *ht, double *S, double *TtIdeal,
+                      double *htIdeal, double *TtOut, double *htOut)
+{
+    int l;
+#ifndef TMATS_PROPERTIES_CONVERGED
+    t2hc_lanes(ht, Tt, fa);
+    pt2sc_lanes(S, Pt, Tt, fa);
+    sp2tc_lanes(TtIdeal, S, PtOut, fa, 0);
+    t2hc_lanes(htIdeal, TtIdeal, fa);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        if (expansion)
+            htOut[l] = ((htIdeal[l] - ht[l])*eff[l]) + ht[l];
+        else
+            htOut[l] = ((htIdeal[l] - ht[l])*DIVBY_L(eff[l])) + ht[l];
+    }
+    h2tc_lanes(TtOut, htOut, fa);
+#else
+    double zmea[AGTF30_LANES], zmsp[AGTF30_LANES], tmlsr[AGTF30_LANES], zz[AGTF30_LANES], rcas[AGTF30_LANES];
+    double zmwtr, cp, dphi;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        mixture(fa[l], &zmea[l], &zmsp[l], &tmlsr[l], &zmwtr);
+        zz[l] = tmlsr[l]*zmwtr;
+        rcas[l] = 1.98587*zmwtr;
+        ht[l] = enthalpy_d(Tt[l], fa[l], zmea[l], zmsp[l], zz[l], &cp);
+        S[l] = (entropy_phi_d(Tt[l], fa[l], zmea[l], zmsp[l], tmlsr[l], &dphi)*0.5035576347-23.0258509)*rcas[l]
+               - 0.1841304 - rcas[l] * log(Pt[l]/14.696);
+        TtIdeal[l] = Tt[l]*exp(rcas[l]*log(PtOut[l]/Pt[l])/cp);
+    }
+    sp2t_newton_lanes(TtIdeal, S, PtOut, fa, zmea, zmsp, tmlsr, rcas);
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        htIdeal[l] = enthalpy_d(TtIdeal[l], fa[l], zmea[l], zmsp[l], zz[l], &cp);
+        if (expansion)
+            htOut[l] = ((htIdeal[l] - ht[l])*eff[l]) + ht[l];
+        else
+            htOut[l] = ((htIdeal[l] - ht[l])*DIVBY_L(eff[l])) + ht[l];
+        TtOut[l] = TtIdeal[l] + (htOut[l] - htIdeal[l])/cp;
+    }
+    h2t_newton_lanes(TtOut, htOut, fa, zmea, zmsp, zz);
+#endif
+}
+
+/*------ static_state: total states of a static pressure search ------*/
+/* Lane version of static_state and PcalcStat_state (properties_TMATS.c):
+ * the entropy, the composition and the position in the inverse tables are
+ * computed once per state and, with TMATS_PROPERTIES_CONVERGED, the static
+ * temperature is started from that of the previous call when it moves by
+ * less than STATE_WARM_DT. */
+#define STATE_WARM_DT 5.0
+
+void static_state_lanes(StaticStateLanes *ss, const double *Pt, const double *Tt, const double *ht,
+                        const double *FAR, const double *Rt)
+{
+    double zmwtr;
+    int l;
+
+    pt2sc_lanes(ss->S, Pt, Tt, FAR);
+    for (l = 0; l < AGTF30_LANES; l++) {
+        ss->fa[l] = FAR[l];
+        ss->Tt[l] = Tt[l];
+        ss->ht[l] = ht[l];
+        ss->Rt[l] = Rt[l];
+        mixture(FAR[l], &ss->zmea[l], &ss->zmsp[l], &ss->tmlsr[l], &zmwtr);
+        ss->zz[l] = ss->tmlsr[l]*zmwtr;
+        ss->rcas[l] = 1.98587*zmwtr;
+        ss->phiS[l] = ((ss->S[l] + 0.1841304)/ss->rcas[l] + 23.0258509)/0.5035576347;
+#ifndef TMATS_PROPERTIES_CONVERGED
+        ss->row[l] = -1;
+        ss->w[l] = ss->philo[l] = ss->phiscale[l] = 0;
+#else
+        ss->row[l] = inverse_row(FAR[l], &ss->w[l]);
+        ss->philo[l] = entropy_phi(GAS_INV_TLO, FAR[l], ss->zmea[l], ss->zmsp[l], ss->tmlsr[l]);
+        ss->phiscale[l] = GAS_INV_N/(entropy_phi(GAS_INV_THI, FAR[l], ss->zmea[l], ss->zmsp[l], ss->tmlsr[l])
+                                     - ss->philo[l]);
+#endif
+        ss->warm[l] = 0;
+        ss->Ts[l] = ss->phi[l] = ss->dphi[l] = 0;
+    }
+}
+
+/*------ PcalcStat: static conditions at static pressure Ps ------*/
+/* Lanes with active[l] == 0 are not evaluated (Ts = Tt) and keep their
+ * state; active may be NULL when all lanes are wanted. */
+void PcalcStat_state_lanes(StaticStateLanes *ss, const double *Ps, double *Ts, double *hs,
+                           double *rhos, double *V, const int *active)
+{
+    int l;
+#ifndef TMATS_PROPERTIES_CONVERGED
+    /* Compute Static Temperature */
+    sp2tc_lanes(Ts, ss->S, Ps, ss->fa, active);
+#else
+    const GasInverse *inv = gas_inverse_tables();
+    double Tsec[AGTF30_LANES];
+    int out[AGTF30_LANES];
+    double phit, x, t, T, phig, dphi;
+    int k, i, any = 0;
+
+    /* Compute Static Temperature */
+    for (l = 0; l < AGTF30_LANES; l++) {
+        out[l] = 0;
+        if (active && !active[l]) {
+            Ts[l] = ss->Tt[l];
+            continue;
+        }
+        phit = ss->phiS[l] + log(Ps[l]/14.696)/0.5035576347;
+        T = 0;
+        if (ss->warm[l]) {
+            T = ss->Ts[l] + (phit - ss->phi[l])/ss->dphi[l];
+            if (!(fabs(T - ss->Ts[l]) < STATE_WARM_DT))
+                ss->warm[l] = 0;
+        }
+        if (!ss->warm[l]) {
+            k = ss->row[l];
+            x = (phit - ss->philo[l])*ss->phiscale[l];
+            if (k < 0 || !(x >= 0 && x < GAS_INV_N)) {
+                out[l] = any = 1;
+                continue;
+            }
+            i = (int)x;
+            t = x - i;
+            T = (1 - ss->w[l])*row_hermite(inv->Tphi[k], inv->dTphi[k], i, t)
+                + ss->w[l]*row_hermite(inv->Tphi[k+1], inv->dTphi[k+1], i, t);
+        }
+        phig = entropy_phi_d(T, ss->fa[l], ss->zmea[l], ss->zmsp[l], ss->tmlsr[l], &dphi);
+        T = T + (phit - phig)/dphi;
+        ss->warm[l] = 1;
+        ss->Ts[l] = T;
+        ss->phi[l] = phit;
+        ss->dphi[l] = dphi;
+        Ts[l] = T;
+    }
+
+    if (any) {
+        sp2t_secant_lanes(Tsec, ss->S, Ps, ss->fa, out);
+        for (l = 0; l < AGTF30_LANES; l++)
+            if (out[l])
+                Ts[l] = Tsec[l];
+    }
+#endif
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        if (Ts[l] > ss->Tt[l])
+            Ts[l] = ss->Tt[l];
+        /* Compute static enthalpy */
+        hs[l] = enthalpy(Ts[l], ss->fa[l], ss->zmea[l], ss->zmsp[l], ss->zz[l]);
+        if (hs[l] > ss->ht[l])
+            hs[l] = ss->ht[l];
+        /* Compute static rho, assuming Rt = Rs */
+        rhos[l] = Ps[l] * C_PSItoPSF*DIVBY_L(ss->Rt[l]* Ts[l] * JOULES_CONST);
+        /* Compute Velocity */
+        V[l] = SQRTT_L(2 * (ss->ht[l] - hs[l])*C_GRAVITY*JOULES_CONST);
+    }
+}
+
+/*------ static_state_slope: dTs/dPs and dhs/dPs at the last PcalcStat_state_lanes ------*/
+/* Lane version of static_state_slope; ok[l] = 0 where the slope of lane l
+ * is not known, as where static_state_slope returns 0. */
+void static_state_slope_lanes(const StaticStateLanes *ss, const double *Ps, double *dTs, double *dhs, int *ok)
+{
+    int l;
+#ifndef TMATS_PROPERTIES_CONVERGED
+    (void)ss; (void)Ps; (void)dTs; (void)dhs;
+    for (l = 0; l < AGTF30_LANES; l++)
+        ok[l] = 0;
+#else
+    double cp;
+
+    for (l = 0; l < AGTF30_LANES; l++) {
+        ok[l] = ss->warm[l] && ss->Ts[l] < ss->Tt[l];
+        if (!ok[l])
+            continue;
+        enthalpy_d(ss->Ts[l], ss->fa[l], ss->zmea[l], ss->zmsp[l], ss->zz[l], &cp);
+        dTs[l] = 1/(0.5035576347*Ps[l]*ss->dphi[l]);
+        dhs[l] = cp*dTs[l];
+    }
+#endif
+}
+
+/*------ Array versions: n points in lane groups ------*/
+/* Each input x comes with an increment incx: point i reads x[i*incx], so
+ * incx = 0 gives all points the same value (a scalar). The last lane
+ * group is padded with copies of the last point. Results are those of the
+ * *_mix routines (properties_TMATS.c) point for point. */
+static unsigned int gather(double *buf, const double *x, int incx, unsigned int i, unsigned int n)
+{
+    unsigned int cnt = (n - i < AGTF30_LANES) ? n - i : AGTF30_LANES;
+    unsigned int l;
+
+    for (l = 0; l < AGTF30_LANES; l++)
+        buf[l] = x[(size_t)(i + (l < cnt ? l : cnt - 1))*incx];
+    return cnt;
+}
+
+void t2hc_array(double *H, const double *T, int incT, const double *fa, int incfa, unsigned int n)
+{
+    double t[AGTF30_LANES], f[AGTF30_LANES], h[AGTF30_LANES];
+    unsigned int i, l, cnt;
+
+    for (i = 0; i < n; i += AGTF30_LANES) {
+        cnt = gather(t, T, incT, i, n);
+        gather(f, fa, incfa, i, n);
+        t2hc_lanes(h, t, f);
+        for (l = 0; l < cnt; l++)
+            H[i + l] = h[l];
+    }
+}
+
+void h2tc_array(double *T, const double *H, int incH, const double *fa, int incfa, unsigned int n)
+{
+    double h[AGTF30_LANES], f[AGTF30_LANES], t[AGTF30_LANES];
+    unsigned int i, l, cnt;
+
+    for (i = 0; i < n; i += AGTF30_LANES) {
+        cnt = gather(h, H, incH, i, n);
+        gather(f, fa, incfa, i, n);
+        h2tc_lanes(t, h, f);
+        for (l = 0; l < cnt; l++)
+            T[i + l] = t[l];
+    }
+}
+
+void pt2sc_array(double *S, const double *P, int incP, const double *T, int incT,
+                 const double *fa, int incfa, unsigned int n)
+{
+    double p[AGTF30_LANES], t[AGTF30_LANES], f[AGTF30_LANES], s[AGTF30_LANES];
+    unsigned int i, l, cnt;
+
+    for (i = 0; i < n; i += AGTF30_LANES) {
+        cnt = gather(p, P, incP, i, n);
+        gather(t, T, incT, i, n);
+        gather(f, fa, incfa, i, n);
+        pt2sc_lanes(s, p, t, f);
+        for (l = 0; l < cnt; l++)
+            S[i + l] = s[l];
+    }
+}
+
+void sp2tc_array(double *T, const double *S, int incS, const double *P, int incP,
+                 const double *fa, int incfa, unsigned int n)
+{
+    double s[AGTF30_LANES], p[AGTF30_LANES], f[AGTF30_LANES], t[AGTF30_LANES];
+    unsigned int i, l, cnt;
+
+    for (i = 0; i < n; i += AGTF30_LANES) {
+        cnt = gather(s, S, incS, i, n);
+        gather(p, P, incP, i, n);
+        gather(f, fa, incfa, i, n);
+        sp2tc_lanes(t, s, p, f, 0);
+        for (l = 0; l < cnt; l++)
+            T[i + l] = t[l];
+    }
+}
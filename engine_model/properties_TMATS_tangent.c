@@ -0,0 +1,427 @@
+/*		T-MATS -- properties_TMATS_tangent.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Tangent (forward mode derivative) versions of the gas property routines
+%  t2hc, h2tc, pt2sc, sp2tc and PcalcStat, of the table interpolations
+%  interp1Ac, interp2Ac and interp3Ac, and the tangent helpers.
+%
+%  t2hc and pt2sc are differentiated analytically from their polynomial
+%  tables. h2tc and sp2tc are the inverses of t2hc and pt2sc; their
+%  tangents come from the partial derivatives of t2hc and pt2sc at the
+%  converged temperature. The mixture derivatives use the fa > 0 formulas,
+%  which are continuous with the fa = 0 branch of the scalar routines.
+% *************************************************************************/
+
+#include <math.h>
+#include "constants_TMATS.h"
+#include "functions_TMATS.h"
+#include "AGTF30_tangent.h"
+
+/*--------Gas property tables (same values as t2hc and pt2sc)----------*/
+static const int ITAB[60] = {1,1,1,2,3,3,4,4,4,5,5,5,5,6,6,6,6,6,7,7,7,7,7,7,
+         8,8,8,8,8,8,9,9,9,9,9,9,10,10,10,10,10,10,10,10,
+         11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11};
+static const double TTTAB[11] = {300,400,500,700,1000,1400,1900,2500,3100,3700,4500};
+static const double AHAIR[11] = {2.074402000000e3,2.767580000000e3,3.461230000000e3,
+         4.854285000000e3,6.981156000000e3,9.933801000000e3,
+         1.382117000000e4,1.870811000000e4,2.375618000000e4,
+         2.891518000000e4,3.591874000000e4};
+static const double BHAIR[11] = {6.930375143000e0,6.933262304370e0,6.941415639521e0,
+         6.999806554132e0,7.201291270059e0,7.564016167549e0,
+         7.965574033453e0,8.298411651745e0,8.515829359567e0,
+         8.673620909986e0,8.825346607306e0};
+static const double CHAIR[11] = {1.327409630363e-5,1.559751739222e-5,6.593583412638e-5,
+         2.260187389251e-4,4.455969808316e-4,4.612152628951e-4,
+         3.419004689130e-4,2.128288949057e-4,1.495339514650e-4,
+         1.134519659006e-4,7.620515574828e-5};
+static const double DHAIR[11] = {7.744736961966e-9,1.677943891139e-7,2.668048413312e-7,
+         2.439758243406e-7,1.301523505289e-8,-7.954319598805e-8,
+         -7.170643000405e-8,-3.51638574671e-8,-2.004554753575e-8,
+         -1.551950423014e-8,2.007781800899e-22};
+static const double AHSTOC[11] = {2.116286000000e3,2.831822000000e3,3.556413000000e3,
+         5.033766000000e3,7.326000000000e3,1.054811000000e4,
+         1.483580000000e4,2.028520000000e4,2.596610000000e4,
+         3.180568000000e4,3.976139000000e4};
+static const double BHSTOC[11] = {7.113538900000e0,7.199470008152e0,7.292391067390e0,
+         7.482468579354e0,7.811853002145e0,8.297006217518e0,
+         8.832077018487e0,9.300821657633e0,9.616136350979e0,
+         9.837032938452e0,1.003677698592e1};
+static const double CHSTOC[11] = {3.953219184767e-4,4.639891630481e-4,4.652214293286e-4,
+         4.851661304903e-4,6.127819454796e-4,6.001010929530e-4,
+         4.700405089856e-4,3.112005562576e-4,2.143239326515e-4,
+         1.538370464703e-4,9.584301286375e-5};
+static const double DHSTOC[11] = {2.288908152379e-7,4.107554268465e-9,3.324116860284e-8,
+         1.417953499881e-7,-1.056737710548e-8,-8.670705597826e-8,
+         -8.824441818226e-8,-5.382034644785e-8,-3.360382565619e-8,
+         -2.416418066940e-8,6.080973759837e-15};
+static const double APAIR[11] = {4.229854000000e1,4.429218000000e1,4.584067000000e1,
+         4.818303000000e1,5.070949000000e1,5.318950000000e1,
+         5.556056000000e1,5.779398000000e1,5.960312000000e1,
+         6.112402000000e1,6.283719000000e1};
+static const double BPAIR[11] = {2.305525000000e-2,1.732687898835e-2,1.390113404660e-2,
+         9.984237743689e-3,7.194810211645e-3,5.398110354070e-3,
+         4.191444392129e-3,3.318644249749e-3,2.746778608874e-3,
+         2.344441314755e-3,1.960623219312e-3};
+static const double CPAIR[11] = {-3.628178988352e-5,-2.100192023298e-5,
+         -1.325552918449e-5,-6.328952330080e-6,-2.969139443401e-6,
+         -1.522610200538e-6,-8.907217233446e-7,-5.639451806208e-7,
+         -3.891642208381e-7,-2.813979360273e-7,-1.983746832756e-7};
+static const double DPAIR[11] = {5.093289883514e-8,2.582130349498e-8,1.154429475734e-8,
+         3.733125429643e-9,1.205441035719e-9,4.212589847953e-10,
+         1.815425237354e-10,9.710053321261e-11,5.987015822823e-11,
+         3.459302197988e-11,2.445751324881e-11};
+static const double APSTOC[11] = {4.208565000000e1,4.414325000000e1,4.576019000000e1,
+         4.824312000000e1,5.096532000000e1,5.367114000000e1,
+         5.628635000000e1,5.877705000000e1,6.081328000000e1,
+         6.253552000000e1,6.448296000000e1};
+static const double BPSTOC[11] = {2.361110000000e-2,1.800764547338e-2,1.459451810646e-2,
+         1.067795041447e-2,7.806395767972e-3,5.922535863503e-3,
+         4.648916404273e-3,3.720736784998e-3,3.102786455737e-3,
+         2.660467392055e-3,2.231936896092e-3};
+static const double CPSTOC[11] = {-3.50184547338e-5,-2.10160905323e-5,-1.31151831369e-5,
+         -6.467655323031e-6,-3.104193498621e-6,-1.605456262554e-6,
+         -9.417826559062e-7,-6.051833762187e-7,-4.247338392160e-7,
+         -3.124646002534e-7,-2.231985197004e-7};
+static const double DPSTOC[11] = {4.667454733830e-8,2.633635798468e-8,1.107921302316e-8,
+         3.737179804900e-9,1.248947696722e-9,4.424490710984e-10,
+         1.869995998264e-10,1.002497427793e-10,6.237179942365e-11,
+         3.719420023041e-11,2.698623281668e-11};
+
+/* Table segment for temperature T; same result as the ITAB lookup on the
+ * integer part of 0.01*(T - fmod(T,100)) used by the scalar routines */
+static int seg_index(double T)
+{
+    double Tc;
+    int k;
+
+    Tc = (T > 0) ? T : 0;       /* also maps NaN to the first segment */
+    Tc = (Tc < 6100) ? Tc : 6100;
+    k = (int)(Tc * 0.01);
+    if (k * 100.0 > Tc)
+        k = k - 1;
+    else if ((k + 1) * 100.0 <= Tc)
+        k = k + 1;
+    k = (k > 1) ? k : 1;
+    k = (k < 60) ? k : 60;
+    return ITAB[k - 1] - 1;
+}
+
+/*------ Tangent helpers; d may alias any argument ------*/
+void tan_zero(double *d)
+{
+    int k;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        d[k] = 0;
+}
+
+void tan_fill(double *d, double v)
+{
+    int k;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        d[k] = v;
+}
+
+/* NaN tangent, for quantities that are not differentiated */
+void tan_nan(double *d)
+{
+    double inf = HUGE_VAL;
+    tan_fill(d, inf - inf);
+}
+
+void tan_copy(double *d, const double *a)
+{
+    int k;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        d[k] = a[k];
+}
+
+/* d = ca*a */
+void tan_scale(double *d, double ca, const double *a)
+{
+    int k;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        d[k] = ca*a[k];
+}
+
+/* d = ca*a + cb*b */
+void tan_lin2(double *d, double ca, const double *a, double cb, const double *b)
+{
+    int k;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        d[k] = ca*a[k] + cb*b[k];
+}
+
+/* d = ca*a + cb*b + cc*c */
+void tan_lin3(double *d, double ca, const double *a, double cb, const double *b, double cc, const double *c)
+{
+    int k;
+    for (k = 0; k < AGTF30_NUM_DIR; k++)
+        d[k] = ca*a[k] + cb*b[k] + cc*c[k];
+}
+
+/* Derivative of divby (zero where divby returns its +-1e10 limit) */
+double divby_d(double X)
+{
+    if (X < 1e-10 && X > -1e-10)
+        return 0;
+    return -1/(X*X);
+}
+
+/* Derivative of sqrtT (zero where sqrtT returns 0) */
+double sqrtT_d(double X)
+{
+    if (X > 0)
+        return 0.5/sqrt(X);
+    return 0;
+}
+
+/* Mixture terms of the gas tables and their derivatives with respect to fa */
+static void mixture_d(double fa, double *zmea, double *zmsp, double *tmlsr, double *zmwtr,
+                      double *zmea_fa, double *zmsp_fa, double *tmlsr_fa, double *zmwtr_fa)
+{
+    double tmls = 4.7642+fa*4.721362582;
+
+    *zmea = 4.7642-fa*69.69056873;
+    *zmsp = fa*74.411931335;
+    *zmwtr = tmls/(138.0148721*(1+fa));
+    *tmlsr = 1/tmls;
+    *zmea_fa = -69.69056873;
+    *zmsp_fa = 74.411931335;
+    *zmwtr_fa = (4.721362582*(1+fa) - tmls)/(138.0148721*(1+fa)*(1+fa));
+    *tmlsr_fa = -4.721362582/(tmls*tmls);
+}
+
+/* Partial derivatives of H = t2hc(T, fa) */
+static void t2hc_partials(double T, double fa, double *H_T, double *H_fa)
+{
+    double zmea, zmsp, tmlsr, zmwtr, zmea_fa, zmsp_fa, tmlsr_fa, zmwtr_fa, zz, zz_fa;
+    int it = seg_index(T);
+    double dl = T - TTTAB[it];
+    double hgea = ((DHAIR[it]*dl + CHAIR[it])*dl + BHAIR[it])*dl + AHAIR[it];
+    double hgsp = ((DHSTOC[it]*dl + CHSTOC[it])*dl + BHSTOC[it])*dl + AHSTOC[it];
+    double hgea_T = (3*DHAIR[it]*dl + 2*CHAIR[it])*dl + BHAIR[it];
+    double hgsp_T = (3*DHSTOC[it]*dl + 2*CHSTOC[it])*dl + BHSTOC[it];
+
+    mixture_d(fa, &zmea, &zmsp, &tmlsr, &zmwtr, &zmea_fa, &zmsp_fa, &tmlsr_fa, &zmwtr_fa);
+    zz = tmlsr*zmwtr;
+    zz_fa = tmlsr_fa*zmwtr + tmlsr*zmwtr_fa;
+
+    *H_T = (hgsp_T*zmsp + hgea_T*zmea)*zz;
+    *H_fa = (hgsp*zmsp_fa + hgea*zmea_fa)*zz + (hgsp*zmsp + hgea*zmea)*zz_fa;
+}
+
+/* Partial derivatives of S = pt2sc(P, T, fa) */
+static void pt2sc_partials(double P, double T, double fa, double *S_P, double *S_T, double *S_fa)
+{
+    double zmea, zmsp, tmlsr, zmwtr, zmea_fa, zmsp_fa, tmlsr_fa, zmwtr_fa;
+    double phig, phig_T, phig_fa, rcas, rcas_fa;
+    int it = seg_index(T);
+    double dl = T - TTTAB[it];
+    double phiea = ((DPAIR[it]*dl + CPAIR[it])*dl + BPAIR[it])*dl + APAIR[it];
+    double phisp = ((DPSTOC[it]*dl + CPSTOC[it])*dl + BPSTOC[it])*dl + APSTOC[it];
+    double phiea_T = (3*DPAIR[it]*dl + 2*CPAIR[it])*dl + BPAIR[it];
+    double phisp_T = (3*DPSTOC[it]*dl + 2*CPSTOC[it])*dl + BPSTOC[it];
+
+    mixture_d(fa, &zmea, &zmsp, &tmlsr, &zmwtr, &zmea_fa, &zmsp_fa, &tmlsr_fa, &zmwtr_fa);
+    phig = (phisp*zmsp + phiea*zmea)*tmlsr;
+    phig_T = (phisp_T*zmsp + phiea_T*zmea)*tmlsr;
+    phig_fa = (phisp*zmsp_fa + phiea*zmea_fa)*tmlsr + (phisp*zmsp + phiea*zmea)*tmlsr_fa;
+    rcas = 1.98587*zmwtr;
+    rcas_fa = 1.98587*zmwtr_fa;
+
+    *S_P = -rcas/P;
+    *S_T = phig_T*0.5035576347*rcas;
+    *S_fa = phig_fa*0.5035576347*rcas + (phig*0.5035576347-23.0258509)*rcas_fa - rcas_fa*log(P/14.696);
+}
+
+/*------ t2hc: dH for H = t2hc(T, fa) ------*/
+void t2hc_tangent(double *dH, double T, const double *dT, double fa, const double *dfa)
+{
+    double H_T, H_fa;
+
+    t2hc_partials(T, fa, &H_T, &H_fa);
+    tan_lin2(dH, H_T, dT, H_fa, dfa);
+}
+
+/*------ h2tc: dT for the converged T = h2tc(H, fa) ------*/
+void h2tc_tangent(double *dT, double T, const double *dH, double fa, const double *dfa)
+{
+    double H_T, H_fa;
+
+    t2hc_partials(T, fa, &H_T, &H_fa);
+    tan_lin2(dT, divby(H_T), dH, -H_fa*divby(H_T), dfa);
+}
+
+/*------ pt2sc: dS for S = pt2sc(P, T, fa) ------*/
+void pt2sc_tangent(double *dS, double P, double T, double fa, const double *dP, const double *dT, const double *dfa)
+{
+    double S_P, S_T, S_fa;
+
+    pt2sc_partials(P, T, fa, &S_P, &S_T, &S_fa);
+    tan_lin3(dS, S_P, dP, S_T, dT, S_fa, dfa);
+}
+
+/*------ sp2tc: dT for the converged T = sp2tc(S, P, fa) ------*/
+void sp2tc_tangent(double *dT, double T, double P, const double *dS, const double *dP, double fa, const double *dfa)
+{
+    double S_P, S_T, S_fa;
+
+    pt2sc_partials(P, T, fa, &S_P, &S_T, &S_fa);
+    tan_lin3(dT, divby(S_T), dS, -S_P*divby(S_T), dP, -S_fa*divby(S_T), dfa);
+}
+
+/* Cell of an interpolation axis, as found by interp1Ac/2Ac/3Ac. *xi is
+ * clamped to the axis range (NaN to X[0]); *inside is 0 when it was. */
+static int interp_cell(const double *X, int A, double *xi, int *inside)
+{
+    int i = A - 2;
+
+    *inside = 1;
+    if (*xi < X[0] || !(*xi >= X[0])) {
+        *xi = X[0];
+        *inside = 0;
+    }
+    else if (*xi > X[A-1]) {
+        *xi = X[A-1];
+        *inside = 0;
+    }
+    while (i > 0 && !(*xi >= X[i]))
+        i = i - 1;
+    return i;
+}
+
+/*------ interp1Ac with the tangent dyi ------*/
+double interp1Ac_tangent(double *dyi, double *X, double *Y, double xi, const double *dxi, int A)
+{
+    int interpErr = 0;
+    double yi = interp1Ac(X, Y, xi, A, &interpErr);
+    int in, ii = interp_cell(X, A, &xi, &in);
+    double slope = (Y[ii+1] - Y[ii])/(X[ii+1] - X[ii]);
+
+    tan_scale(dyi, in ? slope : 0, dxi);
+    return yi;
+}
+
+/*------ interp2Ac with the tangent dzi ------*/
+double interp2Ac_tangent(double *dzi, double *X, double *Y, double *Z, double xi, const double *dxi,
+                         double yi, const double *dyi, int A, int B)
+{
+    int interpErr = 0;
+    double zi = interp2Ac(X, Y, Z, xi, yi, A, B, &interpErr);
+    int inx, iny;
+    int ii = interp_cell(X, A, &xi, &inx);
+    int jj = interp_cell(Y, B, &yi, &iny);
+    double slope1, slope2, z1, z2, ty, zx, zy;
+
+    slope1 = (Z[jj+B*(ii+1)] - Z[jj+B*ii])/(X[ii+1] - X[ii]);
+    z1 = Z[jj+B*ii] + (slope1 * (xi - X[ii]));
+    slope2 = (Z[jj+1+B*(ii+1)] - Z[jj+1+B*ii])/(X[ii+1] - X[ii]);
+    z2 = Z[jj+1+B*ii] + (slope2 * (xi - X[ii]));
+    ty = (yi - Y[jj])/(Y[jj+1] - Y[jj]);
+
+    zx = inx ? slope1 + (slope2 - slope1)*ty : 0;
+    zy = iny ? (z2 - z1)/(Y[jj+1] - Y[jj]) : 0;
+    tan_lin2(dzi, zx, dxi, zy, dyi);
+    return zi;
+}
+
+/*------ interp3Ac with the tangent dvi ------*/
+double interp3Ac_tangent(double *dvi, double *X, double *Y, double *Z, double *V, double xi, const double *dxi,
+                         double yi, const double *dyi, double zi, const double *dzi, int A, int B, int C)
+{
+    int interpErr = 0;
+    double vi = interp3Ac(X, Y, Z, V, xi, yi, zi, A, B, C, &interpErr);
+    int inx, iny, inz, kk, q;
+    int ii = interp_cell(X, A, &xi, &inx);
+    int jj = interp_cell(Y, B, &yi, &iny);
+    double slope1[2], slope2[2], v1[2], v2[2], v3[2], ty, tz, vx, vy, vz;
+
+    kk = interp_cell(Z, C, &zi, &inz);
+    ty = (yi - Y[jj])/(Y[jj+1] - Y[jj]);
+    tz = (zi - Z[kk])/(Z[kk+1] - Z[kk]);
+
+    /* layers Z(kk) and Z(kk+1) */
+    for (q = 0; q < 2; q++) {
+        slope1[q] = (V[jj+B*(ii+1)+(B*A)*(kk+q)] - V[jj+B*ii+(B*A)*(kk+q)])/(X[ii+1] - X[ii]);
+        v1[q] = V[jj+B*ii+(B*A)*(kk+q)] + (slope1[q] * (xi - X[ii]));
+        slope2[q] = (V[jj+1+B*(ii+1)+(B*A)*(kk+q)] - V[jj+1+B*ii+(B*A)*(kk+q)])/(X[ii+1] - X[ii]);
+        v2[q] = V[jj+1+B*ii+(B*A)*(kk+q)] + (slope2[q] * (xi - X[ii]));
+        v3[q] = v1[q] + (v2[q] - v1[q])*ty;
+    }
+
+    vx = inx ? (1-tz)*(slope1[0] + (slope2[0] - slope1[0])*ty) + tz*(slope1[1] + (slope2[1] - slope1[1])*ty) : 0;
+    vy = iny ? ((1-tz)*(v2[0] - v1[0]) + tz*(v2[1] - v1[1]))/(Y[jj+1] - Y[jj]) : 0;
+    vz = inz ? (v3[1] - v3[0])/(Z[kk+1] - Z[kk]) : 0;
+    tan_lin3(dvi, vx, dxi, vy, dyi, vz, dzi);
+    return vi;
+}
+
+/*------ PcalcStat: static conditions at Ps and their tangents ------*/
+void PcalcStat_tangent(double Pt, double Ps, double Tt, double ht, double FAR, double Rt,
+                       const double *dPt, const double *dPs, const double *dTt, const double *dht,
+                       const double *dFAR, const double *dRt,
+                       double *Ts, double *rhos, double *V, double *dTs, double *drhos, double *dV)
+{
+    tan_t dS, dhs, dq;
+    double S, hs, q, Vsq;
+    GasMix mix;
+
+    /* Compute entropy */
+    gasmix(&mix, FAR);
+    S = pt2sc_mix(&mix, Pt, Tt);
+    pt2sc_tangent(dS, Pt, Tt, FAR, dPt, dTt, dFAR);
+
+    /* Compute Static Temperature */
+    *Ts = sp2tc_mix(&mix, S, Ps);
+    if (*Ts > Tt) {
+        *Ts = Tt;
+        tan_copy(dTs, dTt);
+    }
+    else
+        sp2tc_tangent(dTs, *Ts, Ps, dS, dPs, FAR, dFAR);
+
+    /* Compute static enthalpy */
+    hs = t2hc(*Ts, FAR);
+    if (hs > ht) {
+        hs = ht;
+        tan_copy(dhs, dht);
+    }
+    else
+        t2hc_tangent(dhs, *Ts, dTs, FAR, dFAR);
+
+    /* Compute static rho, assuming Rt = Rs */
+    q = Rt* *Ts * JOULES_CONST;
+    tan_lin2(dq, *Ts * JOULES_CONST, dRt, Rt * JOULES_CONST, dTs);
+    *rhos = Ps * C_PSItoPSF*divby(q);
+    tan_lin2(drhos, C_PSItoPSF*divby(q), dPs, Ps * C_PSItoPSF*divby_d(q), dq);
+
+    /* Compute Velocity */
+    Vsq = 2 * (ht - hs)*C_GRAVITY*JOULES_CONST;
+    *V = sqrtT(Vsq);
+    tan_lin2(dV, sqrtT_d(Vsq)*2*C_GRAVITY*JOULES_CONST, dht, -sqrtT_d(Vsq)*2*C_GRAVITY*JOULES_CONST, dhs);
+}
+
+/*------ PcalcStat plus static gamma and Mach number at Ps ------*/
+void PcalcStatMN_tangent(double Pt, double Ps, double Tt, double ht, double FAR, double Rt,
+                         const double *dPt, const double *dPs, const double *dTt, const double *dht,
+                         const double *dFAR, const double *dRt,
+                         double *X_FARVec, double *Y_TtVec, double *T_gammaArray, int A, int B,
+                         double *Ts, double *rhos, double *V, double *MN,
+                         double *dTs, double *drhos, double *dV, double *dgammas, double *dMN)
+{
+    tan_t dq, da;
+    double gammas, q, a;
+
+    PcalcStat_tangent(Pt, Ps, Tt, ht, FAR, Rt, dPt, dPs, dTt, dht, dFAR, dRt, Ts, rhos, V, dTs, drhos, dV);
+    gammas = interp2Ac_tangent(dgammas, X_FARVec, Y_TtVec, T_gammaArray, FAR, dFAR, *Ts, dTs, A, B);
+
+    /* MN = V/sqrt(gammas*Rs*Ts*g*J), Rs = Rt */
+    q = gammas*Rt* *Ts*C_GRAVITY*JOULES_CONST;
+    tan_lin3(dq, Rt* *Ts*C_GRAVITY*JOULES_CONST, dgammas, gammas* *Ts*C_GRAVITY*JOULES_CONST, dRt,
+             gammas*Rt*C_GRAVITY*JOULES_CONST, dTs);
+    a = sqrtT(q);
+    tan_scale(da, sqrtT_d(q), dq);
+    *MN = *V*divby(a);
+    tan_lin2(dMN, divby(a), dV, *V*divby_d(a), da);
+}
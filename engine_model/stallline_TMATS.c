@@ -0,0 +1,154 @@
+/*		T-MATS -- stallline_TMATS.c
+% *************************************************************************
+% NASA Glenn Research Center, Cleveland, OH
+%
+%  Stall line of a compressor map.
+%
+%  With SMNEn the compressor measures its stall margin at constant speed:
+%  from the operating point along the speed line NcMap to the R-line
+%  where the map pressure ratio meets the surge line, PRMap = SPRMap(WcMap).
+%  Compressor_TMATS_body finds that R-line by a bisection of up to 20
+%  steps, each of which reads the Wc and PR maps and the surge line, and
+%  stops once |(SPR - PR)/SPR| is within 0.01.
+%
+%  stall_line_init makes the same bisection once on every speed line of
+%  the map (and every Alpha of a 3-D map), down to the resolution of the
+%  R-line rather than to 0.01, and keeps Wc and PR of the stall point and
+%  the (SPR - PR)/SPR left there. stall_line interpolates the three
+%  linearly in NcMap (and Alpha) with one lookup (interp1Am/2Am). On the
+%  speed lines of the map its values are those of the converged
+%  bisection; between them they differ from the stall point of the
+%  interpolated speed line by the error of interpolating in NcMap. The
+%  AGTF30 surge lines run along R-line 1 of their maps, so there the two
+%  agree to rounding, while the bisection stopped at 0.01 is off by up to
+%  14% in Wc and 0.7% in PR. A speed line
+%  that does not reach the surge line within the R-line range keeps a
+%  residual above STALL_TOL, which stall_line reports as the bisection
+%  reports that it could not converge. The tables are filled once by
+%  AGTF30_model_init and only read afterwards.
+% *************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include "functions_TMATS.h"
+
+#define STALL_ITER  60      /* bisection steps, enough to resolve the R-line range */
+
+/* The map and surge line of a compressor at one Alpha */
+struct StallMap {
+    double *NcVec, *RlineVec, *AlphaVec, *WcArray, *PRArray;
+    double *SMWcVec, *SMPRVec;     /* surge line at Alpha */
+    int A, B, C, nS;
+    double Alpha;
+};
+
+/*------ (SPR - PR)/SPR at one point of a speed line ------*/
+/* As the bisection of Compressor_TMATS_body computes it, at R-line R of
+ * the speed line Nc; Wc and PR receive the map values there. */
+static double stall_err(const struct StallMap *s, double R, double Nc, double *Wc, double *PR)
+{
+    double SPR;
+    int interpErr = 0;
+
+    if (s->C > 1) {
+        *Wc = interp3Ac(s->RlineVec, s->NcVec, s->AlphaVec, s->WcArray, R, Nc, s->Alpha, s->B, s->A, s->C, &interpErr);
+        *PR = interp3Ac(s->RlineVec, s->NcVec, s->AlphaVec, s->PRArray, R, Nc, s->Alpha, s->B, s->A, s->C, &interpErr);
+    }
+    else {
+        *Wc = interp2Ac(s->RlineVec, s->NcVec, s->WcArray, R, Nc, s->B, s->A, &interpErr);
+        *PR = interp2Ac(s->RlineVec, s->NcVec, s->PRArray, R, Nc, s->B, s->A, &interpErr);
+    }
+    SPR = interp1Ac(s->SMWcVec, s->SMPRVec, *Wc, s->nS, &interpErr);
+    return (SPR - *PR) / SPR;
+}
+
+/*------ Stall points of the speed lines of a compressor map ------*/
+/* Arguments as in CompressorStruct: NcVec (A speed lines), RlineVec (B),
+ * AlphaVec (C), the Wc and PR maps and the surge line of D points. The
+ * stall line stays invalid, and Compressor_TMATS_body searches for the
+ * stall point, when the map has more than STALL_MAX speed lines and Alpha
+ * values or fewer than two speed lines. */
+void stall_line_init(StallLine *sl, double *NcVec, double *RlineVec, double *AlphaVec, double *WcArray,
+                     double *PRArray, double *WcSurgeVec, double *PRSurgeVec, int A, int B, int C, int D)
+{
+    static double SMWcVec[STALL_MAX], SMPRVec[STALL_MAX];
+    struct StallMap s;
+    double bounds[2], R, Wc, PR, err;
+    int i, j, k, it, interpErr = 0;
+
+    sl->valid = 0;
+    sl->A = A;
+    sl->C = C;
+    sl->NcVec = NcVec;
+    sl->AlphaVec = AlphaVec;
+    for (i = 0; i < 3; i++)
+        sl->V[i] = sl->v[i];
+    if (A < 2 || B < 2 || (C > 1 ? A*C : A) > STALL_MAX || (C > 1 ? D/C : D) > STALL_MAX)
+        return;
+
+    s.NcVec = NcVec; s.RlineVec = RlineVec; s.AlphaVec = AlphaVec;
+    s.WcArray = WcArray; s.PRArray = PRArray;
+    s.A = A; s.B = B; s.C = C;
+    for (k = 0; k < (C > 1 ? C : 1); k++) {
+        /* surge line at Alpha, as Compressor_TMATS_body builds it */
+        if (C > 1) {
+            s.Alpha = AlphaVec[k];
+            s.nS = D/C;
+            for (i = 0; i < s.nS; i++) {
+                SMWcVec[i] = interp1Ac(AlphaVec, WcSurgeVec + C*i, s.Alpha, C, &interpErr);
+                SMPRVec[i] = interp1Ac(AlphaVec, PRSurgeVec + C*i, s.Alpha, C, &interpErr);
+            }
+            s.SMWcVec = SMWcVec;
+            s.SMPRVec = SMPRVec;
+        }
+        else {
+            s.Alpha = 0;
+            s.nS = D;
+            s.SMWcVec = WcSurgeVec;
+            s.SMPRVec = PRSurgeVec;
+        }
+
+        for (j = 0; j < A; j++) {
+            /* bisection of Compressor_TMATS_body, to the end of its bounds */
+            bounds[0] = RlineVec[0];
+            bounds[1] = RlineVec[B - 1];
+            for (it = 0; it < STALL_ITER; it++) {
+                R = (bounds[0] + bounds[1]) / 2;
+                if (stall_err(&s, R, NcVec[j], &Wc, &PR) > 0)
+                    bounds[1] = R;
+                else
+                    bounds[0] = R;
+            }
+            R = (bounds[0] + bounds[1]) / 2;
+            err = stall_err(&s, R, NcVec[j], &Wc, &PR);
+            i = C > 1 ? k + C*j : j;
+            sl->v[STALL_WC][i] = Wc;
+            sl->v[STALL_PR][i] = PR;
+            sl->v[STALL_ERR][i] = err;
+        }
+    }
+
+    if (C > 1)
+        interp_map_init(&sl->M, NcVec, AlphaVec, NULL, sl->V, 3, A, C, 0, 0, INTERP_LINEAR);
+    else
+        interp_map_init(&sl->M, NcVec, NULL, NULL, sl->V, 3, A, 0, 0, 0, INTERP_LINEAR);
+    sl->valid = 1;
+}
+
+/*------ Stall point at NcMap (and Alpha) ------*/
+/* Map corrected flow and pressure ratio of the stall point at the speed
+ * NcMap, NcMap and Alpha being limited to the map. Returns 1 when the
+ * speed line does not reach the surge line, |STALL_ERR| > STALL_TOL. */
+int stall_line(const StallLine *sl, double NcMap, double Alpha, double *WcMap, double *PRMap)
+{
+    double v[3];
+    int interpErr = 0;
+
+    if (sl->C > 1)
+        interp2Am(&sl->M, sl->NcVec, sl->AlphaVec, sl->V, 3, NcMap, Alpha, sl->A, sl->C, NULL, v, &interpErr);
+    else
+        interp1Am(&sl->M, sl->NcVec, sl->V, 3, NcMap, sl->A, NULL, v, &interpErr);
+    *WcMap = v[STALL_WC];
+    *PRMap = v[STALL_PR];
+    return !(fabs(v[STALL_ERR]) <= STALL_TOL);
+}
@@ -36,6 +36,13 @@ struct TurbineStruct {
     int EffMapCol;
     int WcMapRw;
     int EffMapRw;
+
+    /* Interpolation kernels of the maps, may be NULL */
+    const struct InterpTable *K_T_Wc;
+    const struct InterpTable *K_T_Eff;
+
+    /* Wc and Eff maps read together, may be NULL */
+    const struct InterpMap *M_T_Map;
 };
 typedef struct TurbineStruct TurbineStruct;
 
@@ -49,6 +56,33 @@ struct BurnStruct {
 };
 typedef struct BurnStruct BurnStruct;
 
+/* Isentropic flow functions of a component gas (functions_TMATS.h) */
+struct FlowTable;
+
+/* Interpolation kernel of a table (functions_TMATS.h) */
+struct InterpTable;
+struct InterpMap;
+struct StallLine;
+
+/* Nozzle throat at MN = 1 */
+struct NozzleThroat {
+    double Pt, Tt, FAR;          /* total conditions */
+    double Ps;                   /* static pressure at MN = 1 */
+};
+typedef struct NozzleThroat NozzleThroat;
+
+/* Throat search state of a nozzle, see Nozzle_TMATS_body */
+struct NozzleSearch {
+    int seeded;                  /* seed holds a throat to start the MN = 1 search from */
+    NozzleThroat seed;
+    NozzleThroat last;           /* throat of the last run */
+    unsigned long calls;         /* runs of the nozzle */
+    unsigned long seeded_calls;  /* runs whose MN = 1 search started from the seed */
+    unsigned long iter;          /* iterations of the MN = 1 search */
+    unsigned long iterx;         /* iterations of the exit pressure search */
+};
+typedef struct NozzleSearch NozzleSearch;
+
 /* Nozzle block parameters structure */
 struct NozzleStruct {
 	double SwitchType;
@@ -76,6 +110,20 @@ struct NozzleStruct {
     int B;
     int B1;
     int C;
+
+    /* Throat search state, may be NULL */
+    NozzleSearch *Search;
+
+    /* Flow functions of the gas, may be NULL */
+    const struct FlowTable *Flow;
+
+    /* Interpolation kernels of the maps, may be NULL */
+    const struct InterpTable *K_N_Rt;
+    const struct InterpTable *K_N_gamma;
+    const struct InterpTable *K_N_CdTh;
+    const struct InterpTable *K_N_Cv;
+    const struct InterpTable *K_N_Cfg;
+    const struct InterpTable *K_N_TG;
 };
 typedef struct NozzleStruct NozzleStruct;
 
@@ -122,6 +170,24 @@ struct CompressorStruct {
     int WcMapLay;
     int PRMapLay;
     int EffMapLay;
+
+    /* Interpolation kernels of the maps, may be NULL */
+    const struct InterpTable *K_C_Wc;
+    const struct InterpTable *K_C_PR;
+    const struct InterpTable *K_C_Eff;
+    const struct InterpTable *K_C_PRSurge;
+
+    /* Wc, PR and Eff maps read together, may be NULL */
+    const struct InterpMap *M_C_Map;
+
+    /* Stall point per speed line for SMNEn, may be NULL */
+    const struct StallLine *StallLine;
+
+    /* Rline, Nc and Alpha cells of the last map lookup, may be NULL */
+    int *MapCell;
+
+    /* Nonzero to skip the stall margin; SMavail, SPR, SMMap and SPRMap are then NaN */
+    int SMSkip;
 };
 typedef struct CompressorStruct CompressorStruct;
 
@@ -165,6 +231,9 @@ struct ValveStruct {
 
     /* Dimensions of parameter arrays */
     int A;
+
+    /* Interpolation kernel of the flow table, may be NULL */
+    const struct InterpTable *K_V_Wc;
 };
 typedef struct ValveStruct ValveStruct;
 
@@ -187,6 +256,14 @@ struct AmbientStruct{
     int B;
     int C;
     
+    /* Flow functions of the gas, may be NULL */
+    const struct FlowTable *Flow;
+
+    /* Interpolation kernels of the tables, may be NULL */
+    const struct InterpTable *K_A_Ts;
+    const struct InterpTable *K_A_Ps;
+    const struct InterpTable *K_A_Rt;
+    const struct InterpTable *K_A_gamma;
 };
 typedef struct AmbientStruct AmbientStruct;
 
@@ -216,6 +293,13 @@ struct StaticCalcStruct{
     /* Dimensions of parameter arrays */
     int A;
     int B;
+
+    /* Flow functions of the gas, may be NULL */
+    const struct FlowTable *Flow;
+
+    /* Interpolation kernels of the maps, may be NULL */
+    const struct InterpTable *K_Rt;
+    const struct InterpTable *K_gamma;
 };
 typedef struct StaticCalcStruct StaticCalcStruct;
 
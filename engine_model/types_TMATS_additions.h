@@ -1,3 +1,6 @@
+#ifndef TMATS_TYPES_ADDITIONS_H
+#define TMATS_TYPES_ADDITIONS_H
+
 struct InletStruct{
     double eRambase_M;
     
@@ -9,7 +12,9 @@ struct InletStruct{
     
     /* Dimensions of parameter arrays */
     int A;
-    
+
+    /* Interpolation kernel of the ram recovery table, may be NULL */
+    const struct InterpTable *K_eRam_M;
 };
 typedef struct InletStruct InletStruct;
 
@@ -37,3 +42,5 @@ struct PwrSavingStruct{
     int A;
 };
 typedef struct PwrSavingStruct PwrSavingStruct;
+
+#endif /* TMATS_TYPES_ADDITIONS_H */
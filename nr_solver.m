@@ -5,8 +5,27 @@
 
 % This function iteratively executes the MEX engine model, varying
 % independent variables to drive dependent variables to zero.
+% Without debug output the iterations only evaluate the residuals
+% (evaluation level 0 of the MEX engine model); the outputs Y of the
+% returned point are evaluated in full once, at the end.
 
 function [DEP,CMD,X,U,Y,E,converged, solver_iterations] = nr_solver(ENV_IN,CMD_IN,TAR_OUT,HEALTH_PARAMS_IN,BLDS_IN,Ivec,Dvec,ENABLE_DEBUG)
+[DEP,CMD,X,U,Y,E,converged,solver_iterations] = nr_iterate(ENV_IN,CMD_IN,TAR_OUT,HEALTH_PARAMS_IN,BLDS_IN,Ivec,Dvec,ENABLE_DEBUG);
+if ~ENABLE_DEBUG && numel(Y) > 1
+    [~,~,~,Y] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, [ENABLE_DEBUG 0 1 2]);
+end
+return;
+
+
+%% Solver iterations
+function [DEP,CMD,X,U,Y,E,converged, solver_iterations] = nr_iterate(ENV_IN,CMD_IN,TAR_OUT,HEALTH_PARAMS_IN,BLDS_IN,Ivec,Dvec,ENABLE_DEBUG)
+% Settings of the MEX engine model: residuals only, unless debugging
+if ENABLE_DEBUG
+    MODEL_SETTINGS = [ENABLE_DEBUG 0 1 2];
+else
+    MODEL_SETTINGS = [ENABLE_DEBUG 0 1 0];
+end
+
 %% Set solver parameters
 % Arrays have sets of parameters which are progressively used by the
 % solver as needed. For example, if the parameters in the first indices 
@@ -96,7 +115,7 @@ for solver_paramater_index = 1:length(MaxIter_array)
     CMD(CMD > IMinMax(:,2)) = IMinMax(CMD > IMinMax(:,2),2); % Set any max violations to maximum 
     CMD(CMD < IMinMax(:,1)) = IMinMax(CMD < IMinMax(:,1),1); % Set any min violations to minimum 
     
-    [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, ENABLE_DEBUG);
+    [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS);
     
     % check for convergence 
     if (max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0)
@@ -117,39 +136,17 @@ for solver_paramater_index = 1:length(MaxIter_array)
     CMD0 = CMD_IN;
 
     % Positive Perturbation Matrix Calculation 
-    for i1 = 1:sum(Ivec)
-        CMD = CMD0;
-        CMD(Ivec_range(i1)) = CMD(Ivec_range(i1)) * (1 + JPerSS);
-    
-        if (CMD(Ivec_range(i1)) <= IMinMax(Ivec_range(i1),2))
-            [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, ENABLE_DEBUG);
-            
-            % check for convergence 
-            if (max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0)
-                converged = 1;
-                return;
-            end
-
-            Jpos(:,i1) = (DEP(Dvec_range) - DEP0(Dvec_range)) / (CMD(Ivec_range(i1))*JPerSS);
-        end
+    [Jpos, converged, CMD, DEP, X, U, Y, E] = perturbation_jacobian(1, CMD0, DEP0, CMD, DEP, X, U, Y, E, ...
+        ENV_IN, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS, Ivec_range, Dvec_range, Dvec, Dtol, IMinMax, JPerSS);
+    if converged
+        return;
     end
     
     % Negative Perturbation Matrix Calculation 
-    for i1 = 1:sum(Ivec)
-        CMD = CMD0;
-        CMD(Ivec_range(i1)) = CMD(Ivec_range(i1)) * (1 - JPerSS);
-    
-        if (CMD(Ivec_range(i1)) >= IMinMax(Ivec_range(i1),1))
-            [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, ENABLE_DEBUG);
-            
-            % check for convergence 
-            if (max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0)
-                converged = 1;
-                return;
-            end
-            
-            Jneg(:,i1) = (DEP(Dvec_range) - DEP0(Dvec_range)) / (-1.0*CMD(Ivec_range(i1))*JPerSS);
-        end
+    [Jneg, converged, CMD, DEP, X, U, Y, E] = perturbation_jacobian(-1, CMD0, DEP0, CMD, DEP, X, U, Y, E, ...
+        ENV_IN, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS, Ivec_range, Dvec_range, Dvec, Dtol, IMinMax, JPerSS);
+    if converged
+        return;
     end
     
     % Form Jacobian
@@ -183,7 +180,7 @@ for solver_paramater_index = 1:length(MaxIter_array)
         
         CMD(CMD > IMinMax(:,2)) = IMinMax(CMD > IMinMax(:,2),2); % Set any max violations to maximum 
         CMD(CMD < IMinMax(:,1)) = IMinMax(CMD < IMinMax(:,1),1); % Set any min violations to minimum 
-        [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, ENABLE_DEBUG);
+        [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS);
         
         % check for convergence 
         if (max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0)
@@ -215,39 +212,17 @@ for solver_paramater_index = 1:length(MaxIter_array)
             Jneg = NaN(sum(Ivec),sum(Dvec)); % Initialize negative perturbation matrix 
     
             % Positive Perturbation Matrix Calculation 
-            for i1 = 1:sum(Ivec)
-                CMD = CMD0;
-                CMD(Ivec_range(i1)) = CMD(Ivec_range(i1)) * (1 + JPerSS);
-    
-                if (CMD(Ivec_range(i1)) <= IMinMax(Ivec_range(i1),2))
-                    [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, ENABLE_DEBUG);
-                    
-                    % check for convergence 
-                    if (max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0)
-                        converged = 1;
-                        return;
-                    end
-                    
-                    Jpos(:,i1) = (DEP(Dvec_range) - DEP0(Dvec_range)) / (CMD(Ivec_range(i1))*JPerSS);
-                end
+            [Jpos, converged, CMD, DEP, X, U, Y, E] = perturbation_jacobian(1, CMD0, DEP0, CMD, DEP, X, U, Y, E, ...
+                ENV_IN, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS, Ivec_range, Dvec_range, Dvec, Dtol, IMinMax, JPerSS);
+            if converged
+                return;
             end
             
             % Negative Perturbation Matrix Calculation 
-            for i1 = 1:sum(Ivec)
-                CMD = CMD0;
-                CMD(Ivec_range(i1)) = CMD(Ivec_range(i1)) * (1 - JPerSS);
-    
-                if (CMD(Ivec_range(i1)) >= IMinMax(Ivec_range(i1),1))
-                    [DEP,X,U,Y,E] = MEX_engine_model(ENV_IN, CMD, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, ENABLE_DEBUG);
-                    
-                    % check for convergence 
-                    if (max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0)
-                        converged = 1;
-                        return;
-                    end
-                    
-                    Jneg(:,i1) = (DEP(Dvec_range) - DEP0(Dvec_range)) / (-1.0*CMD(Ivec_range(i1))*JPerSS);
-                end
+            [Jneg, converged, CMD, DEP, X, U, Y, E] = perturbation_jacobian(-1, CMD0, DEP0, CMD, DEP, X, U, Y, E, ...
+                ENV_IN, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS, Ivec_range, Dvec_range, Dvec, Dtol, IMinMax, JPerSS);
+            if converged
+                return;
             end
             
             for Jcol = 1:sum(Ivec)
@@ -278,9 +253,56 @@ converged = 0;
 return;
 
 
+%% Perturbation Jacobian (one side)
+% Evaluates every single-independent perturbation of CMD0 in one batched
+% call to the MEX engine model and returns the one-sided partial
+% derivatives. direction is 1 for positive and -1 for negative
+% perturbations. Perturbations that would leave the IMinMax range are not
+% evaluated and leave a NaN column. Columns are checked for convergence in
+% the same order as evaluating them one at a time; the first converged
+% point is returned with converged = 1. Otherwise CMD holds the last
+% perturbed command vector and DEP, X, U, Y, E the last evaluated outputs.
+function [Jside, converged, CMD, DEP, X, U, Y, E] = perturbation_jacobian(direction, CMD0, DEP0, CMD, DEP, X, U, Y, E, ...
+    ENV_IN, TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS, Ivec_range, Dvec_range, Dvec, Dtol, IMinMax, JPerSS)
+
+num_indep = length(Ivec_range);
+Jside = NaN(length(Dvec_range), num_indep);
+converged = 0;
+
+% Build one perturbed command vector per independent
+CMD_batch = repmat(CMD0(:), 1, num_indep);
+in_range = false(1, num_indep);
+for i1 = 1:num_indep
+    CMD_batch(Ivec_range(i1), i1) = CMD0(Ivec_range(i1)) * (1 + direction*JPerSS);
 
+    if direction > 0
+        in_range(i1) = (CMD_batch(Ivec_range(i1), i1) <= IMinMax(Ivec_range(i1),2));
+    else
+        in_range(i1) = (CMD_batch(Ivec_range(i1), i1) >= IMinMax(Ivec_range(i1),1));
+    end
+end
 
+eval_cols = find(in_range);
+if ~isempty(eval_cols)
+    [DEP_batch,X_batch,U_batch,Y_batch,E_batch] = MEX_engine_model(ENV_IN, CMD_batch(:,eval_cols), TAR_OUT, HEALTH_PARAMS_IN, BLDS_IN, MODEL_SETTINGS);
 
+    for k = 1:length(eval_cols)
+        i1 = eval_cols(k);
+        DEP = DEP_batch(:,k);
+        X = X_batch(:,k);
+        U = U_batch(:,k);
+        Y = Y_batch(:,k);
+        E = E_batch(:,k);
 
+        % check for convergence 
+        if (max(abs(DEP(Dvec) ./ Dtol(Dvec))) < 1.0)
+            CMD(:) = CMD_batch(:,i1);
+            converged = 1;
+            return;
+        end
 
+        Jside(:,i1) = (DEP(Dvec_range) - DEP0(Dvec_range)) / (direction*CMD_batch(Ivec_range(i1),i1)*JPerSS);
+    end
+end
 
+CMD(:) = CMD_batch(:,num_indep);
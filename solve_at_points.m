@@ -15,6 +15,8 @@ clear; clc;
 DO_ELECTRIC_MOTORS = true; % if true, then the U-vector will include electric motor powers
 DO_ML_CHALLENGE_PROBLEM = true; % enables some scripts for machine-learning challenge problems
 ENABLE_DEBUG = true; % setting to true will enable error and warning messages in the terminal
+USE_NATIVE_SOLVER = true; % if true, the solver runs natively in MEX_nr_solver instead of nr_solver.m (compare_nr_solvers.m checks that both agree)
+NATIVE_JACOBIAN_METHOD = 0; % MEX_nr_solver only: 0 = finite differences as nr_solver.m, 1 = Broyden updates (see compare_jacobian_methods.m)
 
 STANDARD_DAY_TEMPERATURE_R = 518.67; % defined by International Standard Atmosphere
 GEAR_RATIO = 3.1; % AGTF30 gear ratio between low-pressure shaft and fan
@@ -58,6 +60,12 @@ if DO_ML_CHALLENGE_PROBLEM
     addpath('ML_challenge_problem');
 end
 
+if USE_NATIVE_SOLVER
+    solver = @(varargin) MEX_nr_solver(varargin{:}, NATIVE_JACOBIAN_METHOD);
+else
+    solver = @nr_solver;
+end
+
 load("AGTF30_simulink_data.mat");
 construct_gridded_interpolants;
 
@@ -193,7 +201,7 @@ for input_num = 1:num_inputs
 
     %% Run the solver
     [solver_dependents_solution, solver_independents_solution, X, U, Y, E, convergence_reached, ...
-        solver_iterations] = nr_solver(environmental_conditions, solver_initial_guess, ...
+        solver_iterations] = solver(environmental_conditions, solver_initial_guess, ...
         solver_targets, health_params, bleeds, solver_independents_selection, solver_dependents_selection, ENABLE_DEBUG);
     
     if (Y(55) < E(13))
@@ -204,7 +212,7 @@ for input_num = 1:num_inputs
     if convergence_reached
         [A, B, C, D, linearization_failure_mode] = do_linearization(solver_independents_solution, ...
             X, Y, altitude_actual, mach_number_actual, N1c_actual, VAFN_interpolant, VBV_interpolant, ...
-            environmental_conditions, health_params, bleeds, DO_ELECTRIC_MOTORS, ENABLE_DEBUG);
+            environmental_conditions, health_params, bleeds, DO_ELECTRIC_MOTORS, ENABLE_DEBUG, solver);
     else
         A = [];
         B = [];